@@ -0,0 +1,52 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "bloom_filter.hpp"
+#include <cassert>
+#include <string>
+
+int main(){
+    using sc::regular::bloom_filter;
+
+    {
+        bloom_filter<int> f(10000);
+        assert(f.empty() && f.block_count() > 0 && !f.contains(1) && f.false_positive_rate() == 0);
+        for(int i=0; i<10000; ++i)
+            assert(f.insert(i));
+        assert(f.size() == 10000);
+        for(int i=0; i<10000; ++i)
+            assert(f.contains(i));
+
+        // 10 bits per key report about 1% of the other keys
+        int reported = 0;
+        for(int i=10000; i<110000; ++i)
+            reported += f.contains(i);
+        double fpr = f.false_positive_rate();
+        assert(reported > 300 && reported < 2500);
+        assert(fpr > 0.003 && fpr < 0.025);
+        assert(f.bits_per_key() >= 10 && f.bits_per_key() < 11);
+        assert(f.memory() == f.block_count() * 64);
+
+        bloom_filter<int> copy = f;
+        f.clear();
+        assert(f.empty() && !f.contains(1) && copy.contains(1));
+        swap(f, copy);
+        assert(f.contains(9999) && copy.empty());
+    }
+
+    {
+        // more bits per key, fewer false positives
+        bloom_filter<std::string> f(1000, 20);
+        for(int i=0; i<1000; ++i)
+            f.insert(std::to_string(i));
+        int reported = 0;
+        for(int i=1000; i<101000; ++i)
+            reported += f.contains(std::to_string(i));
+        assert(reported < 100 && f.false_positive_rate() < 0.001);
+
+        // an empty filter reports nothing and accepts nothing
+        bloom_filter<int> empty;
+        assert(!empty.insert(1) && !empty.contains(1) && empty.memory() == 0);
+    }
+}
@@ -0,0 +1,144 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "compact_dict.hpp"
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+template <class Dict>
+std::vector<typename Dict::key_type> keys_of(const Dict& d){
+    std::vector<typename Dict::key_type> keys;
+    for(const auto& kv: d)
+        keys.push_back(kv.first);
+    return keys;
+}
+
+// every key hashes to the same value, so all of them share one probe sequence
+struct same_hash{
+    std::size_t operator()(int) const { return 42;}
+};
+
+int main()
+{
+    {
+        // a config object: the keys iterate in the order they were inserted
+        sc::regular::compact_dict<std::string, std::string> config;
+        config["name"] = "server";
+        config["port"] = "8080";
+        config.insert({"host", "localhost"});
+        config.emplace("debug", "false");
+        config.try_emplace("timeout", 5, '9');
+        assert(config.size() == 5 && config.at("timeout") == "99999");
+        assert((keys_of(config) == std::vector<std::string>{"name", "port", "host", "debug", "timeout"}));
+
+        // an existing key keeps its position
+        assert(!config.insert({"port", "9090"}).second && config["port"] == "8080");
+        assert(!config.insert_or_assign("port", "9090").second && config["port"] == "9090");
+        assert((keys_of(config) == std::vector<std::string>{"name", "port", "host", "debug", "timeout"}));
+
+        bool thrown = false;
+        try{ config.at("user");} catch(const std::out_of_range&){ thrown = true;}
+        assert(thrown && !config.contains("user") && config.count("name") == 1);
+    }
+
+    {
+        // erase leaves a tombstone, the order of the others is kept
+        sc::regular::compact_dict<int, int> d;
+        for(int i=0; i<10; ++i)
+            d.emplace(i, i * i);
+        assert(d.index_width() == 1);
+        assert(d.erase(3) == 1 && d.erase(3) == 0);
+        auto iter = d.erase(d.find(7));
+        assert(iter->first == 8);
+        assert(d.size() == 8 && d.tombstones() == 2);
+        assert((keys_of(d) == std::vector<int>{0, 1, 2, 4, 5, 6, 8, 9}));
+
+        // an erased key is appended after the others
+        d[3] = 0;
+        assert((keys_of(d) == std::vector<int>{0, 1, 2, 4, 5, 6, 8, 9, 3}));
+
+        d.compact();
+        assert(d.tombstones() == 0 && d.size() == 9);
+        assert((keys_of(d) == std::vector<int>{0, 1, 2, 4, 5, 6, 8, 9, 3}));
+        for(int i: keys_of(d))
+            assert(d.at(i) == (i == 3 ? 0 : i * i));
+
+        // erase the front while iterating
+        for(auto it = d.begin(); it != d.end();)
+            it = it->first % 2 == 0 ? d.erase(it) : std::next(it);
+        assert((keys_of(d) == std::vector<int>{1, 5, 9, 3}));
+    }
+
+    {
+        // grows from 1-byte to 4-byte slots of the index
+        sc::regular::compact_dict<int, int> d;
+        for(int i=0; i<100000; ++i)
+            d.emplace(i, -i);
+        assert(d.size() == 100000 && d.index_width() == 4);
+        for(int i=0; i<100000; i += 2)
+            d.erase(i);
+        for(int i=0; i<100000; ++i)
+            assert(d.contains(i) == (i % 2 == 1));
+        int expected = 1;
+        for(const auto& kv: d){
+            assert(kv.first == expected && kv.second == -expected);
+            expected += 2;
+        }
+
+        // the copy has no tombstone
+        sc::regular::compact_dict<int, int> copy(d);
+        assert(copy == d && copy.tombstones() == 0);
+        copy[1] = 1;
+        assert(copy != d);
+        d = std::move(copy);
+        assert(d.at(1) == 1 && d.tombstones() == 0);
+
+        d.clear();
+        assert(d.empty() && d.begin() == d.end() && !d.contains(1));
+        d.emplace(1, 1);
+        assert(d.size() == 1);
+    }
+
+    {
+        // the inserts which reuse the deleted slots of one probe sequence
+        sc::regular::compact_dict<int, int, same_hash> d;
+        for(int round=0; round<50; ++round){
+            for(int i=0; i<5; ++i)
+                d.emplace(round * 5 + i, i);
+            for(int i=0; i<4; ++i)
+                d.erase(round * 5 + i);
+        }
+        assert(d.size() == 50);
+        for(int round=0; round<50; ++round)
+            assert(d.at(round * 5 + 4) == 4 && !d.contains(round * 5));
+    }
+
+    {
+        // the elements which aren't trivially destructible, and a move-only value
+        sc::regular::compact_dict<std::string, std::unique_ptr<int>> d;
+        for(int i=0; i<1000; ++i)
+            d.try_emplace(std::to_string(i), std::make_unique<int>(i));
+        for(int i=0; i<1000; i += 3)
+            d.erase(std::to_string(i));
+        d.reserve(5000);
+        assert(d.capacity() >= 5000 && d.tombstones() == 0);
+        for(int i=0; i<1000; ++i){
+            auto iter = d.find(std::to_string(i));
+            assert((iter == d.end()) == (i % 3 == 0));
+            if(iter != d.end())
+                assert(*iter->second == i);
+        }
+
+        std::string key = "moved";
+        d.try_emplace(std::move(key), nullptr);
+        assert(d.contains("moved") && d.at("moved") == nullptr);
+    }
+
+    return 0;
+}
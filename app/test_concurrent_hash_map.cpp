@@ -0,0 +1,98 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "concurrent_hash_map.hpp"
+#include <atomic>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(){
+    using sc::lock_free::concurrent_hash_map;
+
+    {
+        concurrent_hash_map<int, std::string> m;
+        assert(m.empty() && !m.find(1) && m.bucket_count() == m.STRIPES);
+
+        for(int i=0; i<1000; ++i)
+            assert(m.insert(i, std::to_string(i)));
+        assert(!m.insert(5, "x") && *m.find(5) == "5");
+        assert(m.size() == 1000 && m.bucket_count() >= 1000);
+        for(int i=0; i<1000; ++i)
+            assert(m.contains(i) && *m.find(i) == std::to_string(i));
+
+        assert(!m.insert_or_assign(7, "seven") && *m.find(7) == "seven");
+        assert(m.insert_or_assign(1000, "new") && m.size() == 1001);
+
+        std::size_t length = 0;
+        assert(m.visit(7, [&length](const std::string& s){ length = s.size();}) && length == 5);
+        assert(!m.visit(-1, [](const std::string&){}));
+
+        int calls = 0;
+        auto make = [&calls](int key){ ++calls; return std::to_string(-key);};
+        assert(m.compute_if_absent(3, make) == "3" && calls == 0);
+        assert(m.compute_if_absent(-3, make) == "3" && calls == 1);
+        assert(m.compute_if_absent(-3, make) == "3" && calls == 1);
+
+        for(int i=0; i<1000; i+=2)
+            assert(m.erase(i) == 1);
+        assert(m.erase(0) == 0 && m.size() == 502);
+        for(int i=0; i<1000; ++i)
+            assert(m.contains(i) == (i % 2 == 1));
+
+        m.clear();
+        assert(m.empty() && !m.contains(1));
+        m.reserve(5000);
+        assert(m.bucket_count() >= 5000);
+    }
+
+    {
+        // readers run while writers insert, replace and erase and the table grows.
+        // a key which is never erased is always found, and its value is never torn
+        const int keys = 20000, writers = 4, readers = 4;
+        concurrent_hash_map<int, std::vector<int>> m;
+        for(int i=0; i<keys; i+=2)
+            m.insert(i, std::vector<int>(4, i));
+
+        std::atomic<bool> done(false);
+        std::vector<std::thread> threads;
+        for(int w=0; w<writers; ++w){
+            threads.emplace_back([&m, w, keys]{
+                for(int i=w; i<keys; i+=writers){
+                    if(i % 2 == 1){
+                        m.insert(i, std::vector<int>(4, i));
+                        if(i % 3 == 0)
+                            m.erase(i);
+                    } else{
+                        m.insert_or_assign(i, std::vector<int>(4, i));
+                    }
+                }
+            });
+        }
+        for(int r=0; r<readers; ++r){
+            threads.emplace_back([&m, &done, keys]{
+                while(!done.load()){
+                    for(int i=0; i<keys; i+=2){
+                        bool consistent = false;
+                        bool found = m.visit(i, [&consistent, i](const std::vector<int>& v){
+                            consistent = v.size() == 4 && v[0] == i && v[3] == i;
+                        });
+                        assert(found && consistent);
+                        (void)found;
+                        (void)consistent;
+                    }
+                }
+            });
+        }
+        for(int w=0; w<writers; ++w)
+            threads[w].join();
+        done.store(true);
+        for(int r=0; r<readers; ++r)
+            threads[writers + r].join();
+
+        for(int i=0; i<keys; ++i)
+            assert(m.contains(i) == (i % 2 == 0 || i % 3 != 0));
+    }
+}
@@ -0,0 +1,80 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "constexpr_map.hpp"
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+enum class method{ GET, HEAD, POST, PUT, DELETE, CONNECT, OPTIONS, TRACE, PATCH};
+
+constexpr auto methods = sc::regular::make_constexpr_map<std::string_view, method>({
+        {"GET", method::GET}, {"HEAD", method::HEAD}, {"POST", method::POST},
+        {"PUT", method::PUT}, {"DELETE", method::DELETE}, {"CONNECT", method::CONNECT},
+        {"OPTIONS", method::OPTIONS}, {"TRACE", method::TRACE}, {"PATCH", method::PATCH}});
+
+constexpr auto names = sc::regular::make_constexpr_map<method, std::string_view>({
+        {method::GET, "GET"}, {method::HEAD, "HEAD"}, {method::POST, "POST"},
+        {method::PUT, "PUT"}, {method::DELETE, "DELETE"}, {method::CONNECT, "CONNECT"},
+        {method::OPTIONS, "OPTIONS"}, {method::TRACE, "TRACE"}, {method::PATCH, "PATCH"}});
+
+// the squares of 0 to N - 1, built by a constant expression
+template <std::size_t N>
+constexpr std::array<std::pair<int, int>, N> squares(){
+    std::array<std::pair<int, int>, N> init{};
+    // the assignment of a pair is not constexpr before C++20
+    for(std::size_t i=0; i<N; ++i){
+        init[i].first = static_cast<int>(i) * 7;
+        init[i].second = static_cast<int>(i * i);
+    }
+    return init;
+}
+
+// a transparent hasher of strings
+struct string_hash{
+    using is_transparent = void;
+    constexpr std::size_t operator()(std::string_view s) const noexcept { return sc::utils::constexpr_hash<std::string_view>()(s);}
+};
+
+int main(){
+    // the lookups are constant expressions
+    static_assert(methods.size() == 9 && methods.at("PATCH") == method::PATCH);
+    static_assert(methods.contains("OPTIONS") && !methods.contains("get") && !methods.contains(""));
+    static_assert(names.at(method::DELETE) == "DELETE" && names.find(method::TRACE)->second == "TRACE");
+
+    std::string request = "POST";
+    assert(methods.find(request)->second == method::POST && methods.count(request) == 1);
+    assert(methods.find("FOO") == methods.end());
+    for(const auto& entry: methods)
+        assert(names.at(entry.second) == entry.first);
+
+    bool thrown = false;
+    try {
+        (void)methods.at("BREW");
+    }catch (const std::out_of_range&){
+        thrown = true;
+    }
+    assert(thrown);
+
+    // many keys, every slot holds one
+    static constexpr auto big = sc::regular::make_constexpr_map(squares<1000>());
+    static_assert(big.size() == 1000 && big.at(7 * 999) == 999 * 999);
+    for(int i=0; i<7000; ++i)
+        assert(big.contains(i) == (i % 7 == 0) && (i % 7 != 0 || big.at(i) == (i / 7) * (i / 7)));
+    int sum = 0;
+    for(const auto& entry: big)
+        sum += entry.first;
+    assert(sum == 7 * 999 * 1000 / 2);
+
+    // a transparent hasher and comparator look up by any string type
+    constexpr auto colors = sc::regular::make_constexpr_map<std::string_view, unsigned, string_hash, std::equal_to<>>({
+            {"red", 0xff0000u}, {"green", 0x00ff00u}, {"blue", 0x0000ffu}});
+    assert(colors.find(std::string("green"))->second == 0x00ff00u && colors.contains("blue"));
+
+    constexpr sc::regular::constexpr_map<int, int, 0> empty(std::array<std::pair<int, int>, 0>{});
+    static_assert(empty.empty() && !empty.contains(1) && empty.begin() == empty.end());
+    constexpr auto one = sc::regular::make_constexpr_map<int, int>({{5, 25}});
+    static_assert(one.at(5) == 25 && !one.contains(6));
+}
@@ -0,0 +1,71 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "cuckoo_filter.hpp"
+#include <cassert>
+
+int main(){
+    using sc::regular::cuckoo_filter;
+    // the bounds below hold for this seed, the default one is drawn per process
+    const sc::utils::hash<int> hash(42);
+
+    {
+        cuckoo_filter<int> f(10000, hash);
+        assert(f.empty() && f.bucket_count() == 2632 && !f.contains(1) && !f.full());
+        for(int i=0; i<10000; ++i)
+            assert(f.insert(i));
+        assert(f.size() == 10000 && f.load_factor() > 0.9);
+        for(int i=0; i<10000; ++i)
+            assert(f.contains(i));
+
+        int reported = 0;
+        for(int i=10000; i<1010000; ++i)
+            reported += f.contains(i);
+        assert(reported < 300 && f.false_positive_rate() < 0.0002);
+        assert(f.memory() == 2632 * 8 && f.bits_per_key() < 17);
+
+        // an erased key is not reported, the others are
+        for(int i=0; i<10000; i+=2)
+            assert(f.erase(i));
+        assert(f.size() == 5000);
+        for(int i=0; i<10000; ++i)
+            assert(f.contains(i) || i % 2 == 0);
+        reported = 0;
+        for(int i=0; i<10000; i+=2)
+            reported += f.contains(i);
+        assert(reported < 10);
+
+        // a key inserted twice is erased twice
+        assert(f.insert(-1) && f.insert(-1) && f.erase(-1) && f.contains(-1) && f.erase(-1));
+
+        cuckoo_filter<int> copy = f;
+        f.clear();
+        assert(f.empty() && !f.contains(1) && copy.contains(1));
+        swap(f, copy);
+        assert(f.contains(9999) && copy.empty());
+    }
+
+    {
+        // a filter filled past its buckets is full, it still reports every key
+        cuckoo_filter<int> f(100, hash);
+        int inserted = 0;
+        while(f.insert(inserted))
+            ++inserted;
+        assert(f.full() && inserted > 100);
+        for(int i=0; i<=inserted; ++i)
+            assert(f.contains(i));
+        assert(!f.insert(-1));
+
+        // an erasure which frees a bucket of the key kept aside moves it back
+        int erased = 0;
+        while(f.full())
+            assert(f.erase(erased++));
+        assert(!f.full());
+        for(int i=erased; i<=inserted; ++i)
+            assert(f.contains(i));
+
+        cuckoo_filter<int> empty;
+        assert(!empty.insert(1) && !empty.contains(1) && !empty.erase(1) && empty.memory() == 0);
+    }
+}
@@ -4,7 +4,10 @@
 
 
 #include "deque.hpp"
+#include "deque_algorithm.hpp"
 #include <iostream>
+#include <string>
+#include <vector>
 
 template <class T>
 void print(const sc::regular::deque<T>& dq){
@@ -55,9 +58,149 @@ void do_test(){
 
     }
 
+    {
+        // test segmented algorithms, the range spans several blocks
+        deque<T> t(1);
+        for(int i=0; i<50; ++i)
+            t.push_back(i);
+        for(int i=0; i<3; ++i)
+            t.pop_front();
+
+        std::size_t n = 0;
+        for(auto segment: t.segments())
+            n += segment.size();
+        assert(n == t.size());
+
+        assert(sc::regular::accumulate(t.begin(), t.end(), T()) == 47*(3+49)/2);
+        assert(sc::regular::count(t.begin(), t.end(), 10) == 1);
+        assert(*sc::regular::find(t.begin(), t.end(), 17) == 17);
+        assert(sc::regular::find(t.begin(), t.end(), 99) == t.end());
+
+        std::vector<T> v(t.size());
+        sc::regular::copy(t.begin(), t.end(), v.begin());
+        assert(v.front() == 3 && v.back() == 49);
+        assert(sc::regular::equal(t.begin(), t.end(), v.begin()));
+
+        int sum = 0;
+        sc::regular::for_each(t.begin(), t.end(), [&sum](const T& x){ sum += x;});
+        assert(sum == 47*(3+49)/2);
+
+        sc::regular::fill(t.begin(), t.end(), 1);
+        assert(sc::regular::count(t.begin(), t.end(), 1) == 47);
+        assert(sc::regular::copy(v.begin(), v.end(), t.begin()) == t.end());
+        assert(sc::regular::equal(t.begin(), t.end(), v.begin()));
+
+        deque<T> t2(1);
+        for(int i=0; i<50; ++i)
+            t2.push_back(0);
+        sc::regular::copy(t.begin(), t.end(), t2.begin()+1);
+        assert(sc::regular::equal(t.begin(), t.end(), t2.begin()+1));
+        assert(!sc::regular::equal(t.begin(), t.end(), t2.begin()));
+
+        const deque<T>& ct = t;
+        assert(sc::regular::accumulate(ct.begin(), ct.end(), T()) == 47*(3+49)/2);
+    }
+
+    {
+        // test bulk range insertion, the ranges span several blocks
+        std::vector<T> v(100);
+        for(int i=0; i<100; ++i)
+            v[i] = i;
+
+        deque<T> t(v.begin(), v.end());
+        assert(t.size() == 100 && t.front() == 0 && t.back() == 99);
+        assert(sc::regular::equal(t.begin(), t.end(), v.begin()));
+
+        // a multiple of the block size
+        deque<T> t2(v.begin(), v.begin()+16);
+        t2.push_back(16);
+        assert(t2.size() == 17 && t2.back() == 16);
+
+        t.assign(v.begin()+10, v.begin()+30);
+        assert(t.size() == 20 && t.front() == 10 && t.back() == 29);
+
+        t.append_range(v);
+        assert(t.size() == 120 && t[20] == 0 && t.back() == 99);
+
+        int a[] = {-3,-2,-1};
+        t.prepend_range(a);
+        assert(t.size() == 123 && t.front() == -3 && t[3] == 10);
+        for(int i=0; i<20; ++i)
+            t.push_front(i);
+        t.prepend_range(v);
+        assert(t.size() == 243 && t.front() == 0 && t[99] == 99 && t[100] == 19);
 
+        deque<T> t3(1);
+        for(int i=0; i<40; ++i)
+            t3.push_back(i);
+
+        // insert near the back shifts the elements after pos
+        auto iter = t3.insert(t3.begin()+35, v.begin(), v.begin()+3);
+        assert(*iter == 0 && t3.size() == 43 && t3[34] == 34 && t3[38] == 35 && t3.back() == 39);
+        iter = t3.insert(t3.begin()+41, v.begin(), v.begin()+10);
+        assert(*iter == 0 && t3.size() == 53 && t3[40] == 37 && t3[50] == 9 && t3[51] == 38 && t3.back() == 39);
+
+        // insert near the front shifts the elements before pos
+        iter = t3.insert(t3.begin()+5, v.begin()+50, v.begin()+60);
+        assert(*iter == 50 && t3.size() == 63 && t3[4] == 4 && t3[14] == 59 && t3[15] == 5 && t3.front() == 0);
+        iter = t3.insert(t3.begin()+2, v.begin(), v.begin()+3);
+        assert(*iter == 0 && t3.size() == 66 && t3[1] == 1 && t3[4] == 2 && t3[5] == 2 && t3[6] == 3);
+
+        iter = t3.insert(t3.end(), v.begin(), v.begin()+2);
+        assert(*iter == 0 && t3.back() == 1);
+        iter = t3.insert(t3.begin(), v.begin()+7, v.begin()+9);
+        assert(*iter == 7 && t3.front() == 7 && t3.size() == 70);
+
+        iter = t3.insert(t3.begin()+1, 100);
+        assert(*iter == 100 && t3[0] == 7 && t3[2] == 8);
+
+        t3.resize(100, 5);
+        assert(t3.size() == 100 && t3.back() == 5);
+        t3.resize(10);
+        assert(t3.size() == 10 && t3.front() == 7 && t3[1] == 100);
+    }
+
+
+}
+
+void test_string(){
+    using sc::regular::deque;
+
+    {
+        // the moved-from deques are destroyed without touching the moved elements
+        deque<std::string> t(1);
+        for(int i=0; i<40; ++i)
+            t.push_back(std::string(32, 'a' + i % 26));
+        deque<std::string> t2(std::move(t));
+        assert(t.empty() && t2.size() == 40 && t2[27] == std::string(32, 'b'));
+
+        deque<std::string> t3(1);
+        t3.push_back("old");
+        t3 = std::move(t2);
+        assert(t3.size() == 40 && t3.back() == std::string(32, 'n'));
+    }
+
+    {
+        // pop and erase shrink the map, the remaining elements keep their addresses
+        deque<std::string> t(1);
+        for(int i=0; i<200; ++i)
+            t.push_back(std::to_string(i));
+        for(int i=0; i<190; ++i)
+            t.pop_front();
+        const std::string* first = &t.front();
+        t.pop_back();
+        assert(t.size() == 9 && &t.front() == first && t.front() == "190" && t.back() == "198");
+
+        auto iter = t.erase(t.begin() + 2);
+        assert(*iter == "193" && t.size() == 8 && t[1] == "191" && t.back() == "198");
+        t.shrink_to_fit();
+        t.push_front("x");
+        t.push_back("y");
+        assert(t.size() == 10 && t.front() == "x" && t[1] == "190" && t.back() == "y");
+    }
 }
 
 int main(){
     do_test<int>();
+    test_string();
 }
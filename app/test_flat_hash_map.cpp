@@ -0,0 +1,79 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "flat_hash_map.hpp"
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+template <class T>
+void do_test(){
+    using sc::regular::flat_hash_map;
+
+    {
+        flat_hash_map<T, T> m;
+        for(int i=0; i<1000; ++i)
+            m[i] = i * i;
+        assert(m.size() == 1000 && m[30] == 900 && m.at(31) == 961);
+
+        auto result = m.insert({5, 0});
+        assert(!result.second && result.first->second == 25);
+        result.first->second = 1;
+        assert(m.at(5) == 1);
+
+        assert(m.emplace(1000, 7).second && m[1000] == 7);
+
+        bool thrown = false;
+        try {
+            m.at(-1);
+        }catch (const std::out_of_range&){
+            thrown = true;
+        }
+        assert(thrown);
+
+        for(int i=0; i<1000; i+=2)
+            m.erase(i);
+        assert(m.size() == 501 && m.find(2) == m.end() && m.find(3)->second == 9);
+
+        const flat_hash_map<T, T>& cm = m;
+        T sum = 0;
+        for(const auto& pair: cm)
+            sum += pair.first;
+        assert(sum == 500 * 500 + 1000);
+
+        flat_hash_map<T, T> m2 = m;
+        assert(m2 == m);
+        m2[3] = 0;
+        assert(m2 != m);
+    }
+
+    {
+        flat_hash_map<std::string, std::string> m;
+        for(int i=0; i<100; ++i)
+            m["key" + std::to_string(i)] = std::string(40, 'a' + i % 26);
+        assert(m.size() == 100 && m["key27"] == std::string(40, 'b'));
+        assert(m["missing"].empty() && m.size() == 101);
+        m.erase("missing");
+        assert(!m.contains("missing"));
+
+        flat_hash_map<std::string, std::string> m2(std::move(m));
+        assert(m.empty() && m2.size() == 100);
+        m2.rehash(1024);
+        assert(m2.bucket_count() == 1024 && m2.at("key99") == std::string(40, 'v'));
+
+        // the key and the value are moved only if the key is inserted
+        std::string key = "key5", value(40, 'z');
+        auto result = m2.try_emplace(std::move(key), std::move(value));
+        assert(!result.second && key == "key5" && value == std::string(40, 'z') && result.first->second == std::string(40, 'f'));
+        result = m2.try_emplace("new", 3, 'n');
+        assert(result.second && m2.at("new") == "nnn");
+        result = m2.insert_or_assign("new", value);
+        assert(!result.second && m2.at("new") == value);
+        assert(m2.insert_or_assign(m2.begin(), "newer", "x")->second == "x" && m2.size() == 102);
+    }
+}
+
+int main(){
+    do_test<int>();
+}
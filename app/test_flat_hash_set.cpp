@@ -0,0 +1,135 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "flat_hash_set.hpp"
+#include <cassert>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// every key has the same hash, all keys fall into one probe sequence
+struct collide{
+    std::size_t operator()(int) const { return 42;}
+};
+
+// counts the keys constructed from strings
+struct key: std::string{
+    explicit key(const char* s): std::string(s){ ++constructed;}
+    static inline int constructed = 0;
+};
+
+// hashes a key and a string_view alike
+struct key_hash{
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>()(s);}
+};
+
+template <class T>
+void do_test(){
+    using sc::regular::flat_hash_set;
+
+    {
+        flat_hash_set<T> s;
+        assert(s.empty() && s.begin() == s.end() && s.find(1) == s.end());
+
+        for(int i=0; i<1000; ++i)
+            assert(s.insert(i).second);
+        assert(!s.insert(5).second);
+        assert(s.size() == 1000 && s.load_factor() <= s.max_load_factor());
+
+        for(int i=0; i<1000; ++i)
+            assert(s.contains(i) && *s.find(i) == i);
+        assert(!s.contains(1000) && s.count(-1) == 0);
+
+        std::size_t n = 0;
+        for(auto iter = s.begin(); iter != s.end(); ++iter)
+            ++n;
+        assert(n == 1000);
+
+        // erase the even keys, the odd keys are still found
+        for(int i=0; i<1000; i+=2)
+            assert(s.erase(i) == 1);
+        assert(s.size() == 500 && s.erase(0) == 0);
+        for(int i=0; i<1000; ++i)
+            assert(s.contains(i) == (i % 2 == 1));
+
+        // erase through iterators
+        auto iter = s.begin();
+        while(iter != s.end())
+            iter = s.erase(iter);
+        assert(s.empty());
+
+        s.insert({1, 2, 3});
+        flat_hash_set<T> s2(s);
+        flat_hash_set<T> s3(std::move(s2));
+        assert(s3 == s && s2.empty());
+        s3.insert(4);
+        assert(s3 != s);
+        s = s3;
+        assert(s.size() == 4);
+
+        s.clear();
+        assert(s.empty() && !s.contains(1));
+        s.reserve(100);
+        std::size_t buckets = s.bucket_count();
+        for(int i=0; i<100; ++i)
+            s.insert(i);
+        assert(s.bucket_count() == buckets);
+        s.clear();
+        s.rehash(0);
+        assert(s.bucket_count() == 0);
+    }
+
+    {
+        // the probe sequence of colliding keys crosses several groups
+        flat_hash_set<T, collide> s;
+        for(int i=0; i<100; ++i)
+            s.insert(i);
+        for(int i=0; i<100; i+=3)
+            s.erase(i);
+        for(int i=0; i<100; ++i)
+            assert(s.contains(i) == (i % 3 != 0));
+
+        // the tombstones are reused and dropped, the table does not grow forever
+        std::size_t buckets = s.bucket_count();
+        for(int round=0; round<100; ++round){
+            s.insert(1000 + round);
+            s.erase(1000 + round);
+        }
+        assert(s.bucket_count() == buckets && s.size() == 66);
+    }
+
+    {
+        flat_hash_set<std::string> s;
+        std::vector<std::string> words;
+        for(int i=0; i<200; ++i)
+            words.push_back("word" + std::to_string(i));
+        s.insert(words.begin(), words.end());
+        assert(s.size() == 200 && s.contains("word17") && !s.contains("word200"));
+
+        auto range = s.equal_range("word3");
+        assert(range.first != range.second && *range.first == "word3");
+        s.erase(range.first);
+        assert(!s.contains("word3"));
+    }
+}
+
+int main(){
+    do_test<int>();
+
+    {
+        // a transparent hasher and comparator look up and erase by a string_view or a
+        // string literal, no key is constructed
+        sc::regular::flat_hash_set<key, key_hash, std::equal_to<>> s;
+        for(int i=0; i<100; ++i)
+            s.insert(key(std::to_string(i).c_str()));
+        key::constructed = 0;
+        std::string_view view = "42";
+        assert(s.contains(view) && s.count("7") == 1 && s.find("100") == s.end());
+        auto range = s.equal_range(view);
+        assert(range.first != range.second && *range.first == "42");
+        assert(s.erase(view) == 1 && s.erase("42") == 0 && s.size() == 99);
+        assert(key::constructed == 0);
+    }
+}
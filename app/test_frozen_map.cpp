@@ -0,0 +1,172 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "frozen_map.hpp"
+#include "unordered_map.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+int main(){
+    using sc::regular::frozen_map;
+    const std::string path = "test_frozen_map.bin";
+
+    {
+        // string keys and values
+        sc::regular::unordered_map<std::string, std::string> m;
+        for(int i=0; i<10000; ++i)
+            m.emplace("key" + std::to_string(i), std::string(i % 50, 'a' + i % 26));
+        sc::regular::freeze(m, path);
+
+        frozen_map<std::string, std::string> f(path);
+        assert(f.size() == m.size());
+        for(const auto& kv: m)
+            assert(f.at(kv.first) == kv.second);
+        for(int i=10000; i<20000; ++i)
+            assert(!f.contains("key" + std::to_string(i)));
+        assert(!f.contains("") && !f.find("key").has_value());
+
+        std::size_t found = 0;
+        for(std::size_t i=0; i<f.size(); ++i){
+            auto element = f.element(i);
+            found += m.at(std::string(element.first)) == element.second;
+        }
+        assert(found == m.size());
+
+        bool thrown = false;
+        try {
+            f.at("missing");
+        }catch (const std::out_of_range&){
+            thrown = true;
+        }
+        assert(thrown);
+
+        // the map stays valid after it's moved
+        frozen_map<std::string, std::string> f2(std::move(f));
+        assert(f2.at("key7") == m.at("key7") && f.empty());
+
+        // a file of other types is rejected
+        thrown = false;
+        try {
+            frozen_map<std::uint64_t, std::string> wrong(path);
+        }catch (const std::runtime_error&){
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    {
+        // trivially copyable keys and values
+        sc::regular::unordered_map<std::uint64_t, double> m;
+        for(std::uint64_t i=0; i<5000; ++i)
+            m.emplace(i * 7919, i / 2.0);
+        sc::regular::freeze(m, path);
+
+        frozen_map<std::uint64_t, double> f(path);
+        for(std::uint64_t i=0; i<5000; ++i){
+            assert(f.at(i * 7919) == i / 2.0);
+            assert(!f.contains(i * 7919 + 1));
+        }
+    }
+
+    {
+        // an empty map, and a map of one element
+        sc::regular::unordered_map<int, std::string> m;
+        sc::regular::freeze(m, path);
+        frozen_map<int, std::string> empty(path);
+        assert(empty.empty() && !empty.contains(0));
+
+        m.emplace(3, "three");
+        sc::regular::freeze(m, path);
+        frozen_map<int, std::string> one(path);
+        assert(one.size() == 1 && one.at(3) == "three" && !one.contains(4));
+    }
+
+    {
+        // freezing over a mapped file replaces it, the old mapping keeps the old map
+        sc::regular::unordered_map<std::string, std::string> m;
+        m.emplace("old", "map");
+        sc::regular::freeze(m, path);
+        frozen_map<std::string, std::string> old_map(path);
+        m.clear();
+        for(int i=0; i<100; ++i)
+            m.emplace(std::to_string(i), "new");
+        sc::regular::freeze(m, path);
+        frozen_map<std::string, std::string> new_map(path);
+        assert(old_map.size() == 1 && old_map.at("old") == "map");
+        assert(new_map.size() == 100 && new_map.at("42") == "new" && !new_map.contains("old"));
+        std::ifstream tmp(path + ".tmp");
+        assert(!tmp);
+    }
+
+    {
+        // a file whose header is right, but whose slots or strings point out of the file
+        sc::regular::unordered_map<std::string, std::string> m;
+        for(int i=0; i<100; ++i)
+            m.emplace(std::to_string(i), std::string(i, 'x'));
+        sc::regular::freeze(m, path);
+        std::string bytes;
+        {
+            std::ifstream in(path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        sc::utils::frozen_header h{};
+        std::memcpy(&h, bytes.data(), sizeof(h));
+
+        auto rejected = [&path](const std::string& corrupt){
+            {
+                std::ofstream out(path, std::ios::binary | std::ios::trunc);
+                out.write(corrupt.data(), static_cast<std::streamsize>(corrupt.size()));
+            }
+            try {
+                frozen_map<std::string, std::string> f(path);
+            }catch (const std::runtime_error&){
+                return true;
+            }
+            return false;
+        };
+        assert(!rejected(bytes));
+
+        std::string corrupt = bytes;
+        std::uint64_t direct = sc::utils::perfect_hash::DIRECT | h.size_;
+        std::memcpy(&corrupt[h.displacements_], &direct, sizeof(direct));
+        assert(rejected(corrupt));
+
+        corrupt = bytes;
+        std::uint64_t offset = h.file_size_ - h.arena_;
+        std::memcpy(&corrupt[h.entries_ + offsetof(sc::utils::frozen_string, offset_)], &offset, sizeof(offset));
+        std::uint32_t size = 1;
+        std::memcpy(&corrupt[h.entries_ + offsetof(sc::utils::frozen_string, size_)], &size, sizeof(size));
+        assert(rejected(corrupt));
+
+        // an offset so large that the end of the displacements wraps around
+        corrupt = bytes;
+        std::uint64_t wrapped = ~std::uint64_t(63), buckets = 8;
+        std::memcpy(&corrupt[offsetof(sc::utils::frozen_header, displacements_)], &wrapped, sizeof(wrapped));
+        std::memcpy(&corrupt[offsetof(sc::utils::frozen_header, bucket_count_)], &buckets, sizeof(buckets));
+        assert(rejected(corrupt));
+
+        corrupt = bytes;
+        std::uint32_t huge = UINT32_MAX;
+        std::size_t value = h.entries_ + (h.size_ - 1) * h.entry_size_ + h.key_size_;
+        std::memcpy(&corrupt[value + offsetof(sc::utils::frozen_string, size_)], &huge, sizeof(huge));
+        assert(rejected(corrupt));
+    }
+
+    std::remove(path.c_str());
+    bool thrown = false;
+    try {
+        frozen_map<int, int> missing(path);
+    }catch (const std::system_error&){
+        thrown = true;
+    }
+    assert(thrown);
+}
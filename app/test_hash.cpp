@@ -0,0 +1,88 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "hash.hpp"
+#include "unordered_map.hpp"
+#include <cassert>
+#include <set>
+#include <string>
+#include <string_view>
+
+// a key which only std::hash knows
+struct point{
+    int x, y;
+    bool operator==(const point& other) const { return x == other.x && y == other.y;}
+};
+
+template <>
+struct std::hash<point>{
+    std::size_t operator()(const point& p) const noexcept { return std::size_t(p.x) * 31 + std::size_t(p.y);}
+};
+
+int main()
+{
+    {
+        // a string hashes alike as std::string, std::string_view and const char*
+        sc::utils::hash<std::string> h;
+        std::string s = "the quick brown fox jumps over the lazy dog";
+        assert(h(s) == h(std::string_view(s)) && h(s) == h(s.c_str()));
+        assert(sc::utils::hash<std::string_view>()(s) == h(s));
+
+        // every length takes another path: the short reads, the 16-byte steps and the 48-byte blocks
+        std::string bytes;
+        std::set<std::size_t> hashes;
+        for(int length=0; length<300; ++length){
+            hashes.insert(h(bytes));
+            bytes.push_back(static_cast<char>('a' + length % 26));
+        }
+        assert(hashes.size() == 300);
+
+        // one flipped byte changes the hash, wherever it is
+        for(std::size_t i=0; i<bytes.size(); ++i){
+            std::string flipped = bytes;
+            flipped[i] ^= 1;
+            assert(h(flipped) != h(bytes));
+        }
+
+        // a string with the same bytes as another one in a longer buffer
+        assert(h(std::string_view(bytes.data(), 20)) == h(bytes.substr(0, 20)));
+    }
+
+    {
+        // the hashes of one process agree, another seed gives other hashes
+        sc::utils::hash<std::uint64_t> a, b, c(12345);
+        int differ = 0;
+        for(std::uint64_t k=0; k<100; ++k){
+            assert(a(k) == b(k));
+            differ += a(k) != c(k);
+        }
+        assert(differ == 100);
+        assert(sc::utils::hash<std::string>(1)("key") != sc::utils::hash<std::string>(2)("key"));
+
+        // equal values hash alike
+        sc::utils::hash<double> hd;
+        assert(hd(0.0) == hd(-0.0) && hd(1.5) != hd(-1.5));
+        enum class color{ red, green};
+        assert(sc::utils::hash<color>()(color::red) != sc::utils::hash<color>()(color::green));
+        int x = 0;
+        assert(sc::utils::hash<int*>()(&x) == sc::utils::hash<int*>()(&x));
+        assert(sc::utils::hash<point>()(point{1, 2}) == sc::utils::hash<point>()(point{1, 2}));
+    }
+
+    {
+        // the default hash of the containers, keys which differ only in the high bits
+        sc::regular::unordered_map<std::uint64_t, int> m;
+        for(std::uint64_t i=0; i<10000; ++i)
+            m.emplace(i << 40, static_cast<int>(i));
+        assert(m.stats().max_chain < 16);
+        for(std::uint64_t i=0; i<10000; ++i)
+            assert(m.at(i << 40) == static_cast<int>(i));
+
+        sc::regular::unordered_map<point, int> points;
+        points[{1, 2}] = 3;
+        assert(points.at({1, 2}) == 3 && !points.contains({2, 1}));
+    }
+
+    return 0;
+}
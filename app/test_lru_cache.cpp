@@ -0,0 +1,108 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "lru_cache.hpp"
+#include <cassert>
+#include <string>
+#include <utility>
+#include <vector>
+
+// the keys of a cache, the most recently used first
+template <class Cache>
+std::vector<int> keys(const Cache& cache){
+    std::vector<int> result;
+    cache.for_each([&result](int key, const auto&){ result.push_back(key);});
+    return result;
+}
+
+int main(){
+    using sc::regular::lru_cache;
+    using sc::regular::clock_cache;
+
+    {
+        lru_cache<int, std::string> c(3);
+        assert(c.empty() && c.capacity() == 3 && c.get(1) == nullptr);
+        std::vector<std::pair<int, std::string>> evicted;
+        c.on_evict([&evicted](int key, std::string& value){ evicted.emplace_back(key, std::move(value));});
+
+        for(int i=1; i<=3; ++i)
+            assert(*c.put(i, std::to_string(i)) == std::to_string(i));
+        assert(c.size() == 3 && c.weight() == 3 && (keys(c) == std::vector<int>{3, 2, 1}));
+
+        // a hit moves the entry to the front, the back is evicted
+        assert(*c.get(1) == "1" && (keys(c) == std::vector<int>{1, 3, 2}));
+        c.put(4, "4");
+        assert(!c.contains(2) && (keys(c) == std::vector<int>{4, 1, 3}));
+        assert(evicted.size() == 1 && evicted[0].first == 2 && evicted[0].second == "2");
+
+        // peek neither moves nor counts, put of a cached key assigns it
+        assert(*c.peek(3) == "3" && (keys(c) == std::vector<int>{4, 1, 3}));
+        assert(*c.put(3, "three") == "three" && c.size() == 3 && (keys(c) == std::vector<int>{3, 4, 1}));
+
+        auto stats = c.stats();
+        assert(stats.hits == 1 && stats.misses == 1 && stats.insertions == 4 && stats.evictions == 1);
+        assert(stats.hit_rate() == 0.5);
+
+        int loads = 0;
+        auto load = [&loads]{ ++loads; return std::string("loaded");};
+        assert(c.get_or_load(5, load) == "loaded" && loads == 1 && !c.contains(1));
+        assert(c.get_or_load(5, load) == "loaded" && loads == 1);
+
+        // erase and clear don't call the callback
+        assert(c.erase(4) && !c.erase(4) && c.size() == 2 && evicted.size() == 2);
+        c.set_capacity(1);
+        assert(c.size() == 1 && c.contains(5) && evicted.size() == 3 && evicted.back().first == 3);
+        c.clear();
+        assert(c.empty() && c.weight() == 0 && evicted.size() == 3);
+        c.reset_stats();
+        assert(c.stats().hits == 0 && c.stats().evictions == 0);
+    }
+
+    {
+        // the capacity is in bytes, the heavy entries push out several light ones
+        lru_cache<int, std::string, std::hash<int>, std::equal_to<int>, sc::utils::lru_eviction, sc::utils::memory_weight> c(2000);
+        for(int i=0; i<100; ++i)
+            c.put(i, std::string(10, 'x'));
+        assert(c.weight() <= 2000 && c.size() < 100 && c.contains(99));
+        std::size_t before = c.size();
+        c.put(1000, std::string(1000, 'y'));
+        assert(c.weight() <= 2000 && c.size() < before - 10 && c.contains(1000));
+
+        // an entry heavier than the capacity is evicted at once
+        int evicted = 0;
+        c.on_evict([&evicted](int, std::string&){ ++evicted;});
+        assert(c.put(2000, std::string(5000, 'z')) == nullptr && !c.contains(2000));
+        assert(c.empty() && c.weight() == 0 && evicted > 1);
+    }
+
+    {
+        // the clock evicts the first entry the hand finds without a hit
+        clock_cache<int, int> c(4);
+        for(int i=1; i<=4; ++i)
+            c.put(i, i);
+        assert(*c.get(1) == 1 && *c.get(3) == 3);
+        // a hit relinks nothing
+        assert((keys(c) == std::vector<int>{1, 2, 3, 4}));
+        c.put(5, 5);
+        assert(!c.contains(2) && c.contains(1) && c.contains(3));
+        c.put(6, 6);
+        assert(!c.contains(4) && c.size() == 4);
+        // the hand is past 3 and reaches 5 first, then 1, which lost its second chance
+        c.put(7, 7);
+        assert(!c.contains(5) && c.contains(1));
+        c.put(8, 8);
+        assert(!c.contains(1) && c.contains(3) && c.contains(6) && c.contains(7) && c.contains(8));
+        assert(c.stats().evictions == 4 && c.stats().hits == 2);
+
+        for(int i=0; i<1000; ++i){
+            c.put(i, i);
+            if(i % 3 == 0)
+                (void)c.get(i / 2);
+            assert(c.size() <= 4 && c.contains(i));
+        }
+        c.erase(999);
+        c.put(-1, -1);
+        assert(c.size() == 4 && c.contains(-1));
+    }
+}
@@ -3,8 +3,89 @@
 //
 
 #include "rbtree.hpp"
+#include <cassert>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// counts the keys constructed from the lookups
+struct key: std::string{
+    using std::string::string;
+    key(const key& other): std::string(other){ ++copies;}
+    static inline int copies = 0;
+};
+
+// throws when it compares a key with the poisoned one
+struct fragile_less{
+    bool operator()(int a, int b) const {
+        if(a == poisoned || b == poisoned)
+            throw std::runtime_error("compare");
+        return a < b;
+    }
+    static inline int poisoned = -1;
+};
 
 int main()
 {
+    {
+        sc::regular::rbtree<int> t;
+        assert(t.empty() && t.search(1) == nullptr);
+
+        std::vector<int> keys(1000);
+        for(int i=0; i<1000; ++i)
+            keys[i] = i;
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+        for(int k: keys)
+            t.insert(k);
+        t.insert(5);
+        assert(t.size() == 1000 && t.minimum() == 0 && t.maximum() == 999);
+        for(int i=0; i<1000; ++i)
+            assert(*t.search(i) == i && *t.iterativeSearch(i) == i);
+        assert(t.search(1000) == nullptr && t.iterativeSearch(-1) == nullptr);
+
+        sc::regular::rbtree<int> copy(t);
+        for(int i=0; i<1000; i+=2)
+            assert(t.remove(i) == 1);
+        assert(t.remove(0) == 0 && t.size() == 500);
+        for(int i=0; i<1000; ++i){
+            assert((t.search(i) != nullptr) == (i % 2 == 1));
+            assert(*copy.search(i) == i);
+        }
+        for(int k: keys)
+            t.remove(k);
+        assert(t.empty() && copy.size() == 1000);
+    }
+
+    {
+        // a transparent comparator finds and removes the keys without constructing one
+        sc::regular::rbtree<key, std::less<>> t;
+        for(int i=0; i<100; ++i)
+            t.insert(key(std::to_string(i).c_str()));
+        key::copies = 0;
+        std::string_view view = "42";
+        assert(t.search(view) != nullptr && *t.search("7") == "7" && t.search("100") == nullptr);
+        assert(t.iterativeSearch(view) != nullptr);
+        assert(t.remove(view) == 1 && t.remove("42") == 0 && t.size() == 99);
+        assert(key::copies == 0);
+    }
 
-}
\ No newline at end of file
+    {
+        // a comparison which throws during insert leaves the tree as it was, the new node is freed
+        sc::regular::rbtree<int, fragile_less> t;
+        for(int i=0; i<100; ++i)
+            t.insert(i);
+        fragile_less::poisoned = 1000;
+        bool thrown = false;
+        try {
+            t.insert(1000);
+        }catch (const std::runtime_error&){
+            thrown = true;
+        }
+        fragile_less::poisoned = -1;
+        assert(thrown && t.size() == 100 && t.search(1000) == nullptr);
+        for(int i=0; i<100; ++i)
+            assert(*t.search(i) == i);
+    }
+}
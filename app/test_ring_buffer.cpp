@@ -0,0 +1,65 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "ring_buffer.hpp"
+#include <cassert>
+#include <algorithm>
+#include <numeric>
+
+template <class T>
+void do_test(){
+    using sc::regular::ring_buffer;
+
+    {
+        // bounded mode refuses to push into a full buffer
+        ring_buffer<T> r(4);
+        for(int i=0; i<4; ++i)
+            assert(r.push_back(i));
+        assert(r.full() && !r.push_back(4));
+        assert(r.front() == 0 && r.back() == 3);
+        assert(r.end() - r.begin() == 4);
+    }
+
+    {
+        // overwrite mode keeps the latest elements
+        ring_buffer<T> r(4, true);
+        for(int i=0; i<10; ++i)
+            r.push_back(i);
+        assert(r.size() == 4 && r.front() == 6 && r.back() == 9);
+        assert(r[0] == 6 && r.at(3) == 9);
+
+        // iteration follows the logical order across the wrap-around
+        T expected = 6;
+        for(auto iter = r.begin(); iter != r.end(); ++iter)
+            assert(*iter == expected++);
+        assert(std::is_sorted(r.begin(), r.end()));
+        assert(*(r.end() - 1) == 9 && r.begin()[2] == 8);
+
+        // the sequence is split into two contiguous halves
+        auto spans = r.as_spans();
+        assert(spans.first.size() + spans.second.size() == 4);
+        assert(spans.first[0] == 6 && !spans.second.empty());
+        assert(std::accumulate(spans.first.begin(), spans.first.end(), 0) +
+               std::accumulate(spans.second.begin(), spans.second.end(), 0) == 6+7+8+9);
+
+        // copy is linearized
+        ring_buffer<T> r2(r);
+        assert(r2 == r && r2.as_spans().second.empty());
+
+        r.pop_front();
+        r.pop_back();
+        assert(r.size() == 2 && r.front() == 7 && r.back() == 8);
+
+        ring_buffer<T> r3(1);
+        r3 = std::move(r2);
+        assert(r3.size() == 4 && r3.capacity() == 4);
+
+        r.clear();
+        assert(r.empty() && r.begin() == r.end());
+    }
+}
+
+int main(){
+    do_test<int>();
+}
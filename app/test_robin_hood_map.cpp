@@ -0,0 +1,113 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "robin_hood_map.hpp"
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// sends every key to the same home slot, so the elements form one probe chain
+struct one_home{
+    std::size_t operator()(int) const { return 0;}
+};
+
+// throws when it's constructed from an int while armed
+struct fragile{
+    static inline bool armed = false;
+
+    int value;
+
+    fragile(int v): value(v){
+        if(armed)
+            throw std::runtime_error("construct");
+    }
+    fragile(fragile&& other) noexcept : value(other.value){}
+};
+
+// the keys and the addresses of the elements, in the order of the slots
+template <class Map>
+std::vector<std::pair<const void*, int>> layout(const Map& m){
+    std::vector<std::pair<const void*, int>> result;
+    for(const auto& pair: m)
+        result.emplace_back(&pair, pair.first);
+    return result;
+}
+
+int main(){
+    using sc::regular::robin_hood_map;
+
+    {
+        // erase() shifts the rest of the chain back, the chain stays contiguous
+        robin_hood_map<int, std::string, one_home> m;
+        for(int i=0; i<10; ++i)
+            m.try_emplace(i, std::to_string(i));
+        auto before = layout(m);
+        std::size_t longest = m.max_distance();
+        assert(before.size() == 10);
+
+        assert(m.erase(4) == 1);
+        auto after = layout(m);
+        assert(after.size() == 9 && m.max_distance() == longest - 1);
+        // the slots of the elements are the first 9 of the chain, in the same order
+        for(std::size_t i=0; i<after.size(); ++i){
+            assert(after[i].first == before[i].first);
+            assert(after[i].second == static_cast<int>(i < 4 ? i : i + 1));
+        }
+        for(int i=0; i<10; ++i)
+            assert(m.contains(i) == (i != 4) && (i == 4 || m.at(i) == std::to_string(i)));
+
+        // the slot freed at the end of the chain is reused
+        m.try_emplace(4, "4");
+        assert(layout(m).back().first == before.back().first && m.max_distance() == longest);
+    }
+
+    {
+        // lookups hit and miss at a load factor of 0.9, after erasures too
+        robin_hood_map<int, int> m(1024, sc::utils::hash<int>(7));
+        int n = 0;
+        while(m.size() + 1 <= m.bucket_count() * 9 / 10){
+            m.try_emplace(n * 7919, n);
+            ++n;
+        }
+        assert(m.bucket_count() == 1024 && m.load_factor() > 0.89f);
+        assert(m.mean_distance() < 8 && m.max_distance() < 64);
+        for(int i=0; i<n; ++i){
+            assert(m.at(i * 7919) == i);
+            assert(!m.contains(i * 7919 + 1));
+        }
+        for(int i=0; i<n; i+=3)
+            m.erase(i * 7919);
+        for(int i=0; i<n; ++i)
+            assert(m.contains(i * 7919) == (i % 3 != 0));
+    }
+
+    {
+        // a value which throws while it's constructed leaves the map as it was,
+        // including the elements which moved to make room for it
+        robin_hood_map<int, fragile> m(1024, sc::utils::hash<int>(7));
+        int n = 0;
+        while(m.size() + 2 <= m.bucket_count() * 9 / 10){
+            m.try_emplace(n * 7919, n);
+            ++n;
+        }
+        auto before = layout(m);
+        fragile::armed = true;
+        int thrown = 0;
+        for(int i=n; i<n + 100; ++i){
+            try {
+                m.try_emplace(i * 7919, i);
+            }catch (const std::runtime_error&){
+                ++thrown;
+            }
+            assert(layout(m) == before);
+        }
+        fragile::armed = false;
+        assert(thrown == 100 && m.size() == static_cast<std::size_t>(n) && m.bucket_count() == 1024);
+        for(int i=0; i<n + 100; ++i)
+            assert(m.contains(i * 7919) == (i < n) && (i >= n || m.at(i * 7919).value == i));
+        assert(m.try_emplace(-1, -1).second && m.at(-1).value == -1);
+    }
+}
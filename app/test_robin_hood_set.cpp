@@ -0,0 +1,147 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "robin_hood_set.hpp"
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// sends every key into one of a few home slots
+struct few_homes{
+    std::size_t operator()(int key) const { return static_cast<std::size_t>(key % 4);}
+};
+
+// throws when a key is copied into the set
+struct fragile{
+    static inline int copies_left = 0;
+
+    int value;
+
+    explicit fragile(int v): value(v){}
+    fragile(const fragile& other): value(other.value){
+        if(copies_left-- == 0)
+            throw std::runtime_error("copy");
+    }
+    fragile(fragile&& other) noexcept : value(other.value){}
+
+    bool operator==(const fragile& other) const { return value == other.value;}
+};
+
+struct fragile_hash{
+    std::size_t operator()(const fragile& f) const { return static_cast<std::size_t>(f.value % 8);}
+};
+
+int main(){
+    using sc::regular::robin_hood_set;
+
+    {
+        robin_hood_set<int> s{1, 2, 3, 2, 1};
+        assert(s.size() == 3 && s.contains(2) && !s.contains(4));
+
+        for(int i=0; i<10000; ++i)
+            s.insert(i);
+        assert(s.size() == 10000 && s.count(9999) == 1 && s.count(10000) == 0);
+        // the distances stay short at a load factor of 0.9
+        s.rehash(0);
+        assert(s.load_factor() > 0.6f && s.mean_distance() < 8 && s.max_distance() < 64);
+
+        for(int i=0; i<10000; ++i){
+            if(i % 3 != 0)
+                s.erase(i);
+        }
+        assert(s.size() == 3334);
+        for(int i=0; i<10000; ++i)
+            assert(s.contains(i) == (i % 3 == 0));
+    }
+
+    {
+        // erase while iterating visits every element once, the next one may move into the erased slot
+        robin_hood_set<int> s;
+        for(int i=0; i<5000; ++i)
+            s.insert(i);
+        int visited = 0;
+        for(auto iter = s.begin(); iter != s.end(); ){
+            ++visited;
+            if(*iter % 2 == 0)
+                iter = s.erase(iter);
+            else
+                ++iter;
+        }
+        assert(visited == 5000 && s.size() == 2500);
+        for(int i=0; i<5000; ++i)
+            assert(s.contains(i) == (i % 2 == 1));
+
+        s.erase(s.begin(), s.end());
+        assert(s.empty() && s.begin() == s.end());
+    }
+
+    {
+        // long clusters: backward shift keeps every key reachable, with no tombstones
+        robin_hood_set<int, few_homes> s;
+        s.reserve(1000);
+        for(int i=0; i<200; ++i)
+            s.insert(i);
+        assert(s.max_distance() > 40);
+        for(int i=0; i<200; i+=2)
+            s.erase(i);
+        for(int i=0; i<200; ++i)
+            assert(s.contains(i) == (i % 2 == 1));
+        for(int i=0; i<200; i+=2)
+            s.insert(i);
+        assert(s.size() == 200);
+
+        // more than 255 keys in one home slot is more than the metadata byte can hold
+        robin_hood_set<int, few_homes> same;
+        bool thrown = false;
+        try {
+            for(int i=0; i<2000; i+=4)
+                same.insert(i);
+        }catch (const std::length_error&){
+            thrown = true;
+        }
+        assert(thrown && same.size() == 255);
+        for(int i=0; i<255 * 4; i+=4)
+            assert(same.contains(i));
+    }
+
+    {
+        // a throwing construction leaves the set as it was
+        robin_hood_set<fragile, fragile_hash> s;
+        s.reserve(100);
+        for(int i=0; i<40; ++i)
+            s.emplace(i);
+        fragile::copies_left = 0;
+        fragile f(100);
+        bool thrown = false;
+        try {
+            s.insert(f);
+        }catch (const std::runtime_error&){
+            thrown = true;
+        }
+        assert(thrown && s.size() == 40 && !s.contains(f));
+        for(int i=0; i<40; ++i)
+            assert(s.contains(fragile(i)));
+    }
+
+    {
+        // std::string keys are found by std::string_view without a copy
+        robin_hood_set<std::string, sc::utils::hash<std::string>, std::equal_to<>> s{"alpha", "beta"};
+        assert(s.contains(std::string_view("alpha")) && s.find(std::string_view("gamma")) == s.end());
+        assert(s.erase(std::string_view("beta")) == 1 && s.size() == 1);
+
+        robin_hood_set<std::string> a{"x", "y"}, b{"z"};
+        swap(a, b);
+        assert(a.size() == 1 && b.size() == 2 && b.contains("y"));
+        a = b;
+        assert(a == b);
+        a.clear();
+        assert(a.empty() && !a.contains("x"));
+        a.insert("x");
+        assert(a.contains("x"));
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "sharded_map.hpp"
+#include <cassert>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(){
+    using sc::lock_free::sharded_map;
+
+    {
+        sharded_map<int, std::string> m(5);
+        assert(m.shard_count() == 8 && m.empty() && !m.find(1));
+
+        for(int i=0; i<1000; ++i)
+            assert(m.insert(i, std::to_string(i)));
+        assert(!m.insert(5, "x") && *m.find(5) == "5");
+        assert(m.size() == 1000);
+        for(int i=0; i<1000; ++i)
+            assert(m.contains(i) && *m.find(i) == std::to_string(i) && m.shard_of(i) < 8);
+
+        // the keys are spread over every shard
+        std::vector<std::size_t> sizes;
+        m.for_each_shard([&sizes](const auto& shard){ sizes.push_back(shard.size());});
+        assert(sizes.size() == 8);
+        for(std::size_t size: sizes)
+            assert(size > 50);
+
+        assert(!m.insert_or_assign(7, "seven") && *m.find(7) == "seven");
+        assert(m.insert_or_assign(1000, "new") && m.size() == 1001);
+
+        std::size_t length = 0;
+        assert(m.visit(7, [&length](const std::string& s){ length = s.size();}) && length == 5);
+        assert(!m.visit(-1, [](const std::string&){}));
+
+        for(int i=0; i<1000; i+=2)
+            assert(m.erase(i) == 1);
+        assert(m.erase(0) == 0 && m.size() == 501);
+
+        m.clear();
+        assert(m.empty() && !m.contains(1));
+
+        sharded_map<int, int> one(1);
+        assert(one.shard_count() == 1 && one.shard_of(12345) == 0);
+    }
+
+    {
+        // the owners apply the operations of every producer, in the order of each producer
+        using map_type = sharded_map<int, int>;
+        using op = map_type::operation;
+        const int producers = 3, keys = 3000;
+        map_type m(4);
+        {
+            map_type::owner_group owners(m, producers, 16);
+            assert(owners.producer_count() == producers);
+            std::vector<std::thread> threads;
+            for(int p=0; p<producers; ++p){
+                threads.emplace_back([&owners, p]{
+                    std::vector<op> batch;
+                    for(int k=p; k<keys; k+=producers){
+                        batch.push_back(op::insert(k, k));
+                        batch.push_back(op::assign(k, -k));
+                        if(k % 3 == 0)
+                            batch.push_back(op::erase(k));
+                        if(batch.size() >= 64){
+                            owners.submit(p, batch.begin(), batch.end());
+                            batch.clear();
+                        }
+                    }
+                    owners.submit(p, batch.begin(), batch.end());
+                });
+            }
+            for(auto& t: threads)
+                t.join();
+            owners.flush();
+            for(int k=0; k<keys; ++k)
+                assert(m.find(k) == (k % 3 == 0 ? std::nullopt : std::optional<int>(-k)));
+
+            owners.submit(0, op::insert(-1, 1));
+        }
+        // the destructor applies the remaining operations
+        assert(*m.find(-1) == 1 && m.size() == keys - keys / 3 + 1);
+    }
+
+    {
+        // flush(p) returns once the operations of p are applied, while the other producers keep submitting
+        using map_type = sharded_map<int, int>;
+        using op = map_type::operation;
+        const int producers = 4, rounds = 200;
+        map_type m(4);
+        map_type::owner_group owners(m, producers, 8);
+        std::vector<std::thread> threads;
+        for(int p=0; p<producers; ++p){
+            threads.emplace_back([&owners, &m, p]{
+                std::vector<op> batch;
+                for(int r=0; r<rounds; ++r){
+                    batch.clear();
+                    for(int i=0; i<10; ++i)
+                        batch.push_back(op::assign((r * 10 + i) * producers + p, r));
+                    owners.submit(p, batch.begin(), batch.end());
+                    owners.flush(p);
+                    for(int i=0; i<10; ++i)
+                        assert(m.find((r * 10 + i) * producers + p) == std::optional<int>(r));
+                }
+            });
+        }
+        for(auto& t: threads)
+            t.join();
+        owners.flush();
+        assert(m.size() == producers * rounds * 10);
+
+        // the owners have parked by now, a submission wakes them
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        owners.submit(1, op::erase(1));
+        owners.flush(1);
+        assert(!m.contains(1) && m.size() == producers * rounds * 10 - 1);
+    }
+}
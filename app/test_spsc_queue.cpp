@@ -0,0 +1,84 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "spsc_queue.hpp"
+#include <cassert>
+#include <thread>
+#include <vector>
+
+template <class T>
+void do_test(){
+    using sc::lock_free::spsc_queue;
+
+    {
+        // capacity is rounded up to a power of two
+        spsc_queue<T> q(5);
+        assert(q.capacity() == 8);
+        assert(q.empty() && q.front() == nullptr);
+
+        for(int i=0; i<8; ++i)
+            assert(q.push(i));
+        assert(!q.push(8));
+        assert(q.size() == 8 && *q.front() == 0);
+
+        T value;
+        assert(q.pop(value) && value == 0);
+        q.pop();
+        assert(*q.front() == 2);
+    }
+
+    {
+        // batch functions wrap around the end of buffer
+        spsc_queue<T> q(8);
+        T in[6] = {0,1,2,3,4,5};
+        T out[6] = {};
+        assert(q.push_n(in, 6) == 6);
+        assert(q.pop_n(out, 4) == 4 && out[3] == 3);
+        assert(q.push_n(in, 6) == 6);
+        assert(q.push_n(in, 6) == 0);
+        assert(q.pop_n(out, 6) == 6);
+        assert(out[0] == 4 && out[1] == 5 && out[2] == 0 && out[5] == 3);
+        assert(q.size() == 2);
+    }
+
+    {
+        // one producer and one consumer, all elements arrive in order
+        const int count = 1000000;
+        spsc_queue<T> q(1024);
+
+        std::thread producer([&q, count](){
+            T batch[16];
+            int next = 0;
+            while(next < count){
+                int n = std::min(16, count - next);
+                for(int i=0; i<n; ++i)
+                    batch[i] = next + i;
+                auto pushed = q.push_n(batch, n);
+                if(pushed == 0)
+                    std::this_thread::yield();
+                next += pushed;
+            }
+        });
+
+        long long sum = 0;
+        int expected = 0;
+        T batch[32];
+        while(expected < count){
+            auto n = q.pop_n(batch, 32);
+            if(n == 0)
+                std::this_thread::yield();
+            for(std::size_t i=0; i<n; ++i, ++expected){
+                assert(batch[i] == expected);
+                sum += batch[i];
+            }
+        }
+        producer.join();
+        assert(sum == (long long)count * (count-1) / 2);
+        assert(q.empty());
+    }
+}
+
+int main(){
+    do_test<int>();
+}
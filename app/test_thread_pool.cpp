@@ -0,0 +1,126 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "thread_pool.hpp"
+#include "work_stealing_deque.hpp"
+#include "deque.hpp"
+#include <cassert>
+#include <stdexcept>
+#include <vector>
+
+// fork/join recursion, every call forks one half
+long fib(sc::lock_free::thread_pool& pool, int n){
+    if(n < 2)
+        return n;
+    long a = 0;
+    sc::lock_free::task_group group(pool);
+    group.run([&pool, &a, n]{ a = fib(pool, n-1);});
+    long b = fib(pool, n-2);
+    group.wait();
+    return a + b;
+}
+
+void test_deque(){
+    using sc::lock_free::work_stealing_deque;
+
+    {
+        // the owner pops in LIFO order, thieves steal in FIFO order
+        work_stealing_deque<int> d(2);
+        for(int i=0; i<10; ++i)
+            d.push(i);
+        assert(d.size() == 10 && d.capacity() == 16);
+        assert(*d.pop() == 9);
+        assert(*d.steal() == 0);
+        assert(d.size() == 8);
+        while(d.pop());
+        assert(d.empty() && !d.steal());
+    }
+
+    {
+        // every element is taken exactly once while the array grows
+        const int count = 200000;
+        work_stealing_deque<int> d(4);
+        std::atomic<long long> stolen(0);
+        std::atomic<bool> done(false);
+
+        std::vector<std::thread> thieves;
+        for(int i=0; i<3; ++i){
+            thieves.emplace_back([&]{
+                while(!done.load() || !d.empty()){
+                    if(auto v = d.steal())
+                        stolen += *v;
+                    else
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        long long popped = 0;
+        for(int i=0; i<count; ++i){
+            d.push(i);
+            if(i % 3 == 0){
+                if(auto v = d.pop())
+                    popped += *v;
+            }
+        }
+        while(auto v = d.pop())
+            popped += *v;
+        done = true;
+        for(auto& t: thieves)
+            t.join();
+        assert(popped + stolen == (long long)count * (count-1) / 2);
+    }
+}
+
+void test_pool(){
+    using sc::lock_free::thread_pool;
+    using sc::lock_free::task_group;
+
+    thread_pool pool(4);
+    assert(pool.size() == 4);
+
+    assert(fib(pool, 20) == 6765);
+
+    std::vector<int> v(10000, 1);
+    pool.parallel_for_each(v.begin(), v.end(), [](int& x){ x *= 2;}, 64);
+    for(int x: v)
+        assert(x == 2);
+
+    std::atomic<long long> sum(0);
+    pool.parallel_for(0, 10000, [&sum](int i){ sum += i;}, 100);
+    assert(sum == 10000LL * 9999 / 2);
+
+    // parallel algorithms over deque use the random access iterator
+    sc::regular::deque<int> dq(1);
+    for(int i=0; i<100; ++i)
+        dq.push_back(i);
+    std::atomic<int> dsum(0);
+    pool.parallel_for_each(dq.begin(), dq.end(), [&dsum](int x){ dsum += x;}, 7);
+    assert(dsum == 4950);
+
+    // an exception thrown by a task is rethrown by wait
+    task_group group(pool);
+    group.run([]{ throw std::runtime_error("task failed");});
+    bool caught = false;
+    try {
+        group.wait();
+    }catch (const std::runtime_error&){
+        caught = true;
+    }
+    assert(caught);
+
+    std::atomic<int> detached(0);
+    {
+        thread_pool p(2);
+        for(int i=0; i<100; ++i)
+            p.submit([&detached]{ ++detached;});
+    }
+    // the destructor runs the remaining tasks
+    assert(detached == 100);
+}
+
+int main(){
+    test_deque();
+    test_pool();
+}
@@ -3,3 +3,168 @@
 //
 
 #include "unordered_map.hpp"
+#include <cassert>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// counts the hashes computed by all maps
+struct counting_hash{
+    std::size_t operator()(int key) const { ++calls; return std::hash<int>()(key);}
+    static inline int calls = 0;
+};
+
+// counts the values constructed, copied and moved
+struct counted{
+    counted(int v = 0): v_(v){ ++constructed;}
+    counted(const counted& other): v_(other.v_){ ++constructed;}
+    counted(counted&& other) noexcept: v_(other.v_){ ++constructed;}
+    counted&operator=(const counted&) = default;
+    counted&operator=(counted&&) = default;
+    int v_;
+    static inline int constructed = 0;
+};
+
+template <class Layout, class BucketIndex>
+void do_test()
+{
+    using map = sc::regular::unordered_map<int, std::string, std::hash<int>, std::equal_to<int>, Layout, BucketIndex>;
+
+    {
+        map m;
+        for(int i=0; i<500; ++i)
+            assert(m.insert({i, std::to_string(i)}).second);
+        assert(!m.insert({1, "x"}).second && m.at(1) == "1");
+        assert(m.size() == 500);
+
+        m[1000] = "k";
+        assert(m.size() == 501 && m.at(1000) == "k");
+        m[1000] += "k";
+        assert(m[1000] == "kk" && m.size() == 501);
+        int key = 2000;
+        assert(m[std::move(key)].empty() && m.contains(2000));
+
+        bool thrown = false;
+        try {
+            m.at(-1);
+        }catch (const std::out_of_range&){
+            thrown = true;
+        }
+        assert(thrown);
+
+        for(auto& kv: m)
+            kv.second += "!";
+        assert(m.at(7) == "7!");
+
+        const map& cm = m;
+        assert(cm.find(7)->second == "7!" && cm.at(8) == "8!");
+
+        for(int i=0; i<500; ++i)
+            assert(m.erase(i) == 1);
+        assert(m.size() == 2);
+
+        map m2(m);
+        assert(m2 == m);
+        m2[1000] = "";
+        assert(m2 != m);
+        m = std::move(m2);
+        assert(m.at(1000).empty());
+    }
+
+    {
+        // the key of an extracted node can be changed before it's inserted again
+        map m{{1, "a"}, {2, "b"}};
+        auto nh = m.extract(1);
+        nh.key() = 3;
+        nh.mapped() = "c";
+        m.insert(std::move(nh));
+        assert(!m.contains(1) && m.at(3) == "c");
+
+        map m2{{3, "x"}, {4, "d"}};
+        m.merge(m2);
+        assert(m.size() == 3 && m.at(3) == "c" && m.at(4) == "d");
+        assert(m2.size() == 1 && m2.at(3) == "x");
+    }
+
+    {
+        // batches longer than a group, with keys repeated inside a group
+        std::vector<std::pair<int, std::string>> values;
+        for(int i=0; i<100; ++i)
+            values.emplace_back(i % 70, std::to_string(i));
+        map m;
+        assert(m.insert_batch(values.begin(), values.end()) == 70 && m.size() == 70);
+        assert(m.at(5) == "5" && m.insert_batch(values.begin(), values.end()) == 0);
+
+        std::vector<int> keys;
+        for(int i=-10; i<90; ++i)
+            keys.push_back(i);
+        std::vector<typename map::iterator> found;
+        m.find_batch(keys.begin(), keys.end(), std::back_inserter(found));
+        assert(found.size() == keys.size());
+        for(std::size_t i=0; i<keys.size(); ++i)
+            assert(found[i] == m.find(keys[i]));
+
+        const map& cm = m;
+        std::vector<typename map::const_iterator> cfound(keys.size());
+        assert(cm.find_batch(keys.begin(), keys.end(), cfound.begin()) == cfound.end());
+        assert(cfound[15]->second == "5" && cfound[0] == cm.end());
+
+        assert(m.erase_batch(keys.begin(), keys.end()) == 70 && m.empty());
+        assert(map().erase_batch(keys.begin(), keys.end()) == 0);
+    }
+
+    {
+        // every upsert hashes once, and constructs the mapped value only if it inserts
+        using counting_map = sc::regular::unordered_map<int, counted, counting_hash, std::equal_to<int>, Layout, BucketIndex>;
+        counting_map m;
+        m.reserve(100);
+        auto hashes = [](auto f){
+            int before = counting_hash::calls;
+            f();
+            return counting_hash::calls - before;
+        };
+        auto constructions = [](auto f){
+            int before = counted::constructed;
+            f();
+            return counted::constructed - before;
+        };
+
+        assert(hashes([&m]{ assert(m.try_emplace(1, 10).second);}) == 1);
+        assert(constructions([&m]{ assert(!m.try_emplace(1, 11).second);}) == 0);
+        assert(m.at(1).v_ == 10);
+
+        counted c(20);
+        assert(hashes([&]{ assert(m.insert_or_assign(2, std::move(c)).second);}) == 1);
+        assert(hashes([&]{ assert(!m.insert_or_assign(2, counted(21)).second);}) == 1);
+        assert(m.at(2).v_ == 21);
+
+        assert(hashes([&m]{ m[3].v_ = 30;}) == 1 && m.at(3).v_ == 30);
+        assert(constructions([&m]{ m[3].v_ += 1;}) == 0 && m.at(3).v_ == 31);
+
+        // emplace and insert of a key and a value look the key up before they allocate a node
+        assert(constructions([&m]{ assert(!m.emplace(1, 12).second);}) == 0);
+        assert(hashes([&m]{ assert(m.emplace(4, 40).second);}) == 1);
+        std::pair<int, counted> p(5, 50);
+        assert(hashes([&]{ assert(m.insert(p).second);}) == 1);
+        assert(constructions([&]{ assert(!m.insert(p).second);}) == 0);
+        assert(hashes([&m]{ assert(m.insert({6, counted(60)}).second);}) == 1);
+
+        // a key passed by rvalue is moved only if it's inserted
+        std::string key = "long enough not to fit in the small buffer";
+        sc::regular::unordered_map<std::string, int> strings;
+        strings.try_emplace(key, 1);
+        assert(!strings.try_emplace(std::move(key), 2).second && !key.empty());
+        assert(strings.insert_or_assign(std::move(key), 3).first->second == 3 && !key.empty());
+        assert(strings.try_emplace(strings.cbegin(), "other", 4)->second == 4 && strings.size() == 2);
+    }
+}
+
+int main()
+{
+    do_test<sc::utils::dinkumware_layout, sc::utils::power_of_two_index>();
+    do_test<sc::utils::forward_layout, sc::utils::prime_index>();
+    do_test<sc::utils::incremental_layout, sc::utils::power_of_two_index>();
+    do_test<sc::utils::treeify_layout<>, sc::utils::prime_index>();
+    do_test<sc::utils::filter_layout<>, sc::utils::power_of_two_index>();
+}
@@ -0,0 +1,83 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "unordered_multimap.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <vector>
+
+template <class Layout, class BucketIndex>
+void do_test()
+{
+    using map = sc::regular::unordered_multimap<std::string, int, std::hash<std::string>, std::equal_to<std::string>, Layout, BucketIndex>;
+
+    {
+        // an inverted index: every word maps to the documents which contain it
+        map index;
+        std::vector<std::vector<std::string>> documents = {
+                {"red", "green", "blue"}, {"red", "blue"}, {"green"}, {"red"}};
+        for(int doc=0; doc<static_cast<int>(documents.size()); ++doc){
+            for(const auto& word: documents[doc])
+                index.insert({word, doc});
+        }
+        assert(index.size() == 7 && index.count("red") == 3 && index.count("yellow") == 0);
+
+        auto range = index.equal_range("red");
+        std::vector<int> docs;
+        for(auto iter = range.first; iter != range.second; ++iter)
+            docs.push_back(iter->second);
+        std::sort(docs.begin(), docs.end());
+        assert((docs == std::vector<int>{0, 1, 3}));
+
+        // the mapped values can be modified through the iterators
+        for(auto iter = range.first; iter != range.second; ++iter)
+            iter->second += 10;
+        assert(index.find("red")->second >= 10);
+
+        index.emplace("blue", 2);
+        index.emplace(std::piecewise_construct, std::forward_as_tuple("blue"), std::forward_as_tuple(3));
+        assert(index.count("blue") == 4);
+        assert(index.erase("blue") == 4 && index.size() == 5);
+
+        map copy(index);
+        assert(copy == index);
+        copy.find("green")->second = -1;
+        assert(copy != index);
+        index = std::move(copy);
+        // the copy keeps the order of the values of a key
+        assert(index.find("green")->second == -1);
+    }
+
+    {
+        // many values for one key, and the rehashes keep each key in one group
+        map m;
+        for(int i=0; i<10000; ++i)
+            m.emplace(std::to_string(i % 10), i);
+        for(int k=0; k<10; ++k){
+            std::string key = std::to_string(k);
+            auto range = m.equal_range(key);
+            assert(m.count(key) == 1000 && std::distance(range.first, range.second) == 1000);
+            assert(std::all_of(range.first, range.second, [&key](const auto& kv){ return kv.first == key;}));
+        }
+
+        // the key of an extracted node can be changed before it's inserted again
+        auto nh = m.extract("3");
+        nh.key() = "x";
+        m.insert(std::move(nh));
+        assert(m.count("3") == 999 && m.count("x") == 1);
+    }
+}
+
+int main()
+{
+    do_test<sc::utils::dinkumware_layout, sc::utils::power_of_two_index>();
+    do_test<sc::utils::dinkumware_layout, sc::utils::prime_index>();
+    do_test<sc::utils::forward_layout, sc::utils::power_of_two_index>();
+    do_test<sc::utils::filter_layout<>, sc::utils::prime_index>();
+
+    return 0;
+}
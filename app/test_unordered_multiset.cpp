@@ -0,0 +1,191 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#include "unordered_multiset.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+
+// sends every key to the same bucket
+struct collide{
+    std::size_t operator()(int) const noexcept { return 0;}
+};
+
+// the keys of s are those of reference, and the equal keys are adjacent
+template <class Set>
+void check(const Set& s, const std::map<int, std::size_t>& reference)
+{
+    std::size_t total = 0;
+    for(const auto& [key, n]: reference){
+        assert(s.count(key) == n);
+        auto range = s.equal_range(key);
+        assert(static_cast<std::size_t>(std::distance(range.first, range.second)) == n);
+        assert(std::all_of(range.first, range.second, [key = key](int k){ return k == key;}));
+        total += n;
+    }
+    assert(s.size() == total && static_cast<std::size_t>(std::distance(s.begin(), s.end())) == total);
+    // a key which is adjacent to a different key starts a new group
+    std::size_t groups = 0;
+    for(auto iter = s.begin(); iter != s.end(); ++groups)
+        iter = s.equal_range(*iter).second;
+    assert(groups == reference.size());
+}
+
+template <class Layout, class BucketIndex, class Hash = std::hash<int>>
+void do_test()
+{
+    using set = sc::regular::unordered_multiset<int, Hash, std::equal_to<int>, Layout, BucketIndex>;
+
+    {
+        set s;
+        std::map<int, std::size_t> reference;
+        for(int i=0; i<1000; ++i){
+            s.insert(i % 100);
+            ++reference[i % 100];
+        }
+        // the table has rehashed several times
+        check(s, reference);
+        assert(s.count(-1) == 0 && s.equal_range(-1).first == s.end());
+
+        assert(s.erase(7) == 10 && s.erase(7) == 0);
+        reference.erase(7);
+        check(s, reference);
+
+        // erase the first, a middle and the last element of a group
+        for(int key: {3, 4, 5}){
+            auto range = s.equal_range(key);
+            auto iter = range.first;
+            std::advance(iter, key - 3 == 0 ? 0 : key - 4 == 0 ? 5 : 9);
+            s.erase(iter);
+            --reference[key];
+        }
+        check(s, reference);
+
+        // erase a whole group through iterators
+        auto range = s.equal_range(8);
+        assert(s.erase(range.first, range.second) == range.second);
+        reference.erase(8);
+        check(s, reference);
+
+        set s2(s);
+        check(s2, reference);
+        assert(s2 == s);
+        s2.insert(1);
+        assert(s2 != s);
+        s2.erase(s2.find(1));
+        assert(s2 == s);
+        s2.erase(s2.find(2));
+        s2.insert(3);
+        assert(s2 != s && s2.size() == s.size());
+
+        s.rehash(4096);
+        check(s, reference);
+        s.clear();
+        assert(s.empty() && s.count(1) == 0);
+    }
+
+    {
+        // random insertions and erasures against std::map of counts
+        std::mt19937 rng(42);
+        set s;
+        std::map<int, std::size_t> reference;
+        for(int i=0; i<20000; ++i){
+            int key = static_cast<int>(rng() % 64);
+            switch(rng() % 4){
+                case 0:
+                case 1:
+                    s.emplace(key);
+                    ++reference[key];
+                    break;
+                case 2:
+                    if(reference.count(key)){
+                        // erase a random element of the group
+                        auto range = s.equal_range(key);
+                        auto iter = range.first;
+                        std::advance(iter, rng() % reference[key]);
+                        s.erase(iter);
+                        if(--reference[key] == 0)
+                            reference.erase(key);
+                    }
+                    break;
+                default:
+                    if(rng() % 16 == 0){
+                        assert(s.erase(key) == (reference.count(key) ? reference[key] : 0));
+                        reference.erase(key);
+                    }
+            }
+            if(i % 1000 == 0)
+                check(s, reference);
+        }
+        check(s, reference);
+    }
+
+    {
+        // node handles and merge move the nodes without copying them
+        set s{1, 1, 2}, s2{1, 3};
+        const int* p = &*s.find(2);
+        auto nh = s.extract(2);
+        assert(!nh.empty() && nh.value() == 2 && s.size() == 2);
+        auto position = s2.insert(std::move(nh));
+        assert(&*position == p && nh.empty());
+        assert(s.extract(42).empty() && s2.insert(std::move(nh)) == s2.end());
+
+        auto nh1 = s.extract(1);
+        assert(s.count(1) == 1);
+        s2.insert(std::move(nh1));
+        s.insert({4, 4});
+        s2.merge(s);
+        assert(s.empty());
+        check(s2, {{1, 3}, {2, 1}, {3, 1}, {4, 2}});
+    }
+
+    {
+        set s;
+        int keys[] = {5, 6, 5, 7, 5, 6};
+        assert(s.insert_batch(std::begin(keys), std::end(keys)) == 6);
+        check(s, {{5, 3}, {6, 2}, {7, 1}});
+        int erased[] = {5, 7, 8};
+        assert(s.erase_batch(std::begin(erased), std::end(erased)) == 4);
+        check(s, {{6, 2}});
+    }
+
+    {
+        sc::regular::unordered_multiset<std::string, std::hash<std::string>, std::equal_to<std::string>, Layout, BucketIndex> s;
+        for(int i=0; i<300; ++i)
+            s.emplace(std::to_string(i % 30));
+        assert(s.count("7") == 10 && s.size() == 300);
+        assert(s.erase("7") == 10 && !s.contains("7"));
+    }
+
+    {
+        // the groups stay together when the erasures shrink the buckets
+        set s;
+        s.min_load_factor(0.25f);
+        for(int i=0; i<4000; ++i)
+            s.insert(i % 1000);
+        std::size_t peak = s.bucket_count();
+        for(int i=0; i<990; ++i)
+            assert(s.erase(i) == 4);
+        assert(s.bucket_count() < peak && s.size() == 40);
+        for(int i=990; i<1000; ++i)
+            assert(s.count(i) == 4);
+    }
+}
+
+int main()
+{
+    do_test<sc::utils::dinkumware_layout, sc::utils::power_of_two_index>();
+    do_test<sc::utils::dinkumware_layout, sc::utils::prime_index>();
+    do_test<sc::utils::forward_layout, sc::utils::power_of_two_index>();
+    do_test<sc::utils::forward_layout, sc::utils::prime_index>();
+    do_test<sc::utils::dinkumware_layout, sc::utils::power_of_two_index, collide>();
+    do_test<sc::utils::forward_layout, sc::utils::prime_index, collide>();
+    do_test<sc::utils::filter_layout<>, sc::utils::power_of_two_index>();
+    do_test<sc::utils::filter_layout<sc::regular::bloom_filter, sc::utils::forward_layout>, sc::utils::prime_index>();
+
+    return 0;
+}
@@ -3,14 +3,415 @@
 //
 
 #include "unordered_set.hpp"
+#include <cassert>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
 
-template <class T>
+// every key has the same hash, all keys fall into one bucket
+struct collide{
+    std::size_t operator()(int) const { return 42;}
+};
+
+// counts the keys constructed from strings
+struct key: std::string{
+    explicit key(const char* s): std::string(s){ ++constructed;}
+    static inline int constructed = 0;
+};
+
+// counts the keys compared
+struct counting_equal{
+    bool operator()(int a, int b) const { ++compared; return a == b;}
+    static inline int compared = 0;
+};
+
+// hashes a key and a string_view alike
+struct key_hash{
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>()(s);}
+};
+
+template <class Layout, class BucketIndex>
 void do_test()
 {
+    using set = sc::regular::unordered_set<int, std::hash<int>, std::equal_to<int>, Layout, BucketIndex>;
+
+    {
+        set s;
+        assert(s.empty() && s.begin() == s.end() && s.find(1) == s.end());
+
+        for(int i=0; i<1000; ++i)
+            assert(s.insert(i).second);
+        assert(!s.insert(5).second);
+        assert(s.size() == 1000 && s.load_factor() <= s.max_load_factor());
+
+        // references are stable across rehashing
+        const int* p = &*s.find(7);
+        s.rehash(5000);
+        assert(s.bucket_count() >= 5000 && &*s.find(7) == p);
+        assert(s.bucket_count() == BucketIndex::round(s.bucket_count()));
+
+        for(int i=0; i<1000; ++i)
+            assert(s.contains(i) && *s.find(i) == i);
+        assert(!s.contains(1000) && s.count(-1) == 0);
+
+        std::size_t n = 0;
+        for(auto iter = s.begin(); iter != s.end(); ++iter)
+            ++n;
+        assert(n == 1000);
+
+        // the buckets hold all elements, every element is in its own bucket
+        n = 0;
+        for(std::size_t b=0; b<s.bucket_count(); ++b){
+            std::size_t m = 0;
+            for(auto iter = s.begin(b); iter != s.end(b); ++iter, ++m)
+                assert(s.bucket(*iter) == b);
+            assert(m == s.bucket_size(b));
+            n += m;
+        }
+        assert(n == 1000);
+
+        // erase the even keys, the odd keys are still found
+        for(int i=0; i<1000; i+=2)
+            assert(s.erase(i) == 1);
+        assert(s.size() == 500 && s.erase(0) == 0);
+        for(int i=0; i<1000; ++i)
+            assert(s.contains(i) == (i % 2 == 1));
+
+        // erase through iterators
+        auto iter = s.begin();
+        while(iter != s.end())
+            iter = s.erase(iter);
+        assert(s.empty());
+
+        s.insert({1, 2, 3});
+        set s2(s);
+        set s3(std::move(s2));
+        assert(s3 == s && s2.empty());
+        s2.insert(9);
+        assert(s2.contains(9));
+        s3.insert(4);
+        assert(s3 != s);
+        s = s3;
+        assert(s.size() == 4);
+        swap(s2, s3);
+        assert(s2.size() == 4 && s3.size() == 1 && s3.contains(9) && s2.contains(4));
+
+        s.erase(s.find(2), s.end());
+        s.clear();
+        assert(s.empty() && !s.contains(1));
+        s.reserve(100);
+        std::size_t buckets = s.bucket_count();
+        for(int i=0; i<100; ++i)
+            s.insert(i);
+        assert(s.bucket_count() == buckets);
+    }
+
+    {
+        // all keys in one bucket
+        sc::regular::unordered_set<int, collide, std::equal_to<int>, Layout, BucketIndex> s;
+        for(int i=0; i<100; ++i)
+            s.insert(i);
+        for(int i=0; i<100; i+=3)
+            s.erase(i);
+        for(int i=0; i<100; ++i)
+            assert(s.contains(i) == (i % 3 != 0));
+        assert(s.bucket_size(s.bucket(0)) == s.size());
+    }
+
+    {
+        // node handles and merge move the nodes without copying them
+        set s{1, 2, 3}, s2{3, 4};
+        const int* p = &*s.find(2);
+        auto nh = s.extract(2);
+        assert(!nh.empty() && nh.value() == 2 && s.size() == 2);
+        auto result = s2.insert(std::move(nh));
+        assert(result.inserted && &*result.position == p && nh.empty());
+
+        auto nh3 = s.extract(3);
+        result = s2.insert(std::move(nh3));
+        assert(!result.inserted && result.node.value() == 3);
+        assert(s.extract(42).empty());
+
+        s.insert(5);
+        s2.merge(s);
+        assert(s.size() == 0 && s2.size() == 5);
+        for(int i=1; i<=5; ++i)
+            assert(s2.contains(i));
+    }
+
+    {
+        sc::regular::unordered_set<std::string, std::hash<std::string>, std::equal_to<std::string>, Layout, BucketIndex> s;
+        for(int i=0; i<200; ++i)
+            s.emplace(std::to_string(i));
+        assert(!s.emplace("7").second && s.size() == 200);
+        for(int i=0; i<200; i+=2)
+            s.erase(std::to_string(i));
+        assert(s.size() == 100 && s.contains("199") && !s.contains("198"));
+    }
+
+    {
+        // a burst of insertions, then the erasures shrink the buckets back
+        set s;
+        assert(s.min_load_factor() == 0.f);
+        s.min_load_factor(0.25f);
+        for(int i=0; i<100000; ++i)
+            s.insert(i);
+        std::size_t peak = s.bucket_count();
+        for(int i=0; i<99000; ++i)
+            assert(s.erase(i) == 1);
+        assert(s.bucket_count() < peak / 32 && s.load_factor() >= 0.25f);
+        for(int i=0; i<100000; ++i)
+            assert(s.contains(i) == (i >= 99000));
 
+        // the copy keeps the minimum, and erasing through iterators never rehashes
+        set s2(s);
+        assert(s2.min_load_factor() == 0.25f);
+        std::size_t buckets = s2.bucket_count();
+        for(auto iter = s2.begin(); iter != s2.end();)
+            iter = *iter % 10 != 0 ? s2.erase(iter) : std::next(iter);
+        assert(s2.size() == 100 && s2.bucket_count() == buckets);
+
+        s2.shrink_to_fit();
+        assert(s2.bucket_count() < buckets && s2.load_factor() <= s2.max_load_factor());
+        for(int i=99000; i<100000; ++i)
+            assert(s2.contains(i) == (i % 10 == 0));
+
+        // the hysteresis: erasing and inserting around one size doesn't rehash
+        buckets = s.bucket_count();
+        for(int round=0; round<100; ++round){
+            s.erase(99000 + round);
+            s.insert(99000 + round);
+        }
+        assert(s.bucket_count() == buckets);
+
+        // an empty table frees its buckets
+        std::vector<int> keys;
+        for(int i=99000; i<100000; ++i)
+            keys.push_back(i);
+        assert(s.erase_batch(keys.begin(), keys.end()) == 1000);
+        s.trim();
+        assert(s.empty() && s.bucket_count() == 0 && !s.contains(0));
+        s.insert(7);
+        assert(s.contains(7) && s.size() == 1);
+
+        // without a minimum the erasures keep the buckets
+        set s3;
+        for(int i=0; i<10000; ++i)
+            s3.insert(i);
+        // the erasures would end a move in progress, which drops the old buckets
+        s3.finish_rehash();
+        buckets = s3.bucket_count();
+        for(int i=0; i<10000; ++i)
+            s3.erase(i);
+        assert(s3.bucket_count() == buckets);
+    }
 }
 
 int main()
 {
-    do_test<int>();
+    do_test<sc::utils::dinkumware_layout, sc::utils::power_of_two_index>();
+    do_test<sc::utils::dinkumware_layout, sc::utils::prime_index>();
+    do_test<sc::utils::forward_layout, sc::utils::power_of_two_index>();
+    do_test<sc::utils::forward_layout, sc::utils::prime_index>();
+    do_test<sc::utils::incremental_layout, sc::utils::power_of_two_index>();
+    do_test<sc::utils::incremental_layout, sc::utils::prime_index>();
+    do_test<sc::utils::treeify_layout<>, sc::utils::power_of_two_index>();
+    do_test<sc::utils::treeify_layout<4>, sc::utils::prime_index>();
+    do_test<sc::utils::filter_layout<>, sc::utils::power_of_two_index>();
+    do_test<sc::utils::filter_layout<sc::regular::bloom_filter, sc::utils::forward_layout>, sc::utils::prime_index>();
+    do_test<sc::utils::filter_layout<sc::regular::cuckoo_filter, sc::utils::incremental_layout>, sc::utils::power_of_two_index>();
+
+    {
+        // while the nodes are moved, the old and the new buckets hold all elements
+        sc::regular::unordered_set<int, std::hash<int>, std::equal_to<int>, sc::utils::incremental_layout,
+                sc::utils::power_of_two_index> s;
+        bool moved = false;
+        for(int i=0; i<5000; ++i){
+            s.insert(i);
+            if(s.bucket_count() == sc::utils::power_of_two_index::round(s.bucket_count()))
+                continue;
+            moved = true;
+            assert(s.contains(i) && s.contains(i / 2) && !s.contains(-i - 1));
+            if(i % 97 != 0)
+                continue;
+            std::size_t n = 0;
+            for(std::size_t b=0; b<s.bucket_count(); ++b){
+                for(auto iter = s.begin(b); iter != s.end(b); ++iter, ++n)
+                    assert(s.bucket(*iter) == b);
+            }
+            assert(n == s.size() && static_cast<std::size_t>(std::distance(s.begin(), s.end())) == n);
+        }
+        assert(moved);
+        for(int i=0; i<5000; i+=2)
+            assert(s.erase(i) == 1);
+        for(int i=0; i<5000; ++i)
+            assert(s.contains(i) == (i % 2 == 1));
+        auto s2 = s;
+        s2.rehash(0);
+        assert(s2 == s && s2.bucket_count() == sc::utils::power_of_two_index::round(s2.bucket_count()));
+
+        // a move in progress is ended by erasures of keys, or by finish_rehash() in a table which only reads
+        auto is_moving = [](const auto& t){ return t.bucket_count() != sc::utils::power_of_two_index::round(t.bucket_count());};
+        decltype(s) erasing, reading;
+        int n = 0;
+        for(; !is_moving(erasing) || n < 100; ++n){
+            erasing.insert(n);
+            reading.insert(n);
+        }
+        assert(is_moving(erasing) && is_moving(reading));
+        for(int i=0; is_moving(erasing); ++i)
+            assert(erasing.erase(i) == 1);
+        reading.finish_rehash();
+        assert(!is_moving(reading) && reading.size() == static_cast<std::size_t>(n));
+        for(int i=0; i<n; ++i)
+            assert(reading.contains(i) && erasing.contains(i) == (static_cast<std::size_t>(i) >= n - erasing.size()));
+    }
+
+    {
+        // a bucket past the threshold is searched by its tree, and it's a chain again after it shrinks
+        using tree_set = sc::regular::unordered_set<int, collide, std::equal_to<int>, sc::utils::treeify_layout<>>;
+        tree_set s;
+        for(int i=0; i<8; ++i)
+            s.insert(i);
+        std::size_t chain_bytes = s.stats().bucket_bytes;
+        for(int i=8; i<3000; ++i)
+            assert(s.insert(i).second && !s.insert(i / 2).second);
+        assert(s.stats().bucket_bytes > chain_bytes + 2900 * sizeof(void*));
+        for(int i=-10; i<3010; ++i)
+            assert(s.contains(i) == (i >= 0 && i < 3000));
+
+        tree_set s2 = s;
+        s2.rehash(s2.bucket_count() * 4);
+        assert(s2 == s && s2.stats().max_chain == 3000);
+        for(int i=0; i<3000; i+=2)
+            assert(s2.erase(i) == 1);
+        for(int i=0; i<3000; ++i)
+            assert(s2.contains(i) == (i % 2 == 1) && s.contains(i));
+
+        for(int i=0; i<2995; ++i)
+            assert(s.erase(i) == 1);
+        tree_set chains(s.begin(), s.end(), s.bucket_count());
+        assert(chains.bucket_count() == s.bucket_count() && s.size() == 5);
+        assert(s.stats().bucket_bytes == chains.stats().bucket_bytes);
+        assert(s.contains(2995) && !s.contains(0) && std::distance(s.begin(), s.end()) == 5);
+        s.clear();
+        assert(s.empty() && !s.contains(2999));
+
+        // a key without operator< is stored like dinkumware_layout
+        struct unordered_key{ int v; bool operator==(const unordered_key& other) const { return v == other.v;}};
+        struct unordered_key_hash{ std::size_t operator()(const unordered_key& k) const { return k.v & 1;}};
+        sc::regular::unordered_set<unordered_key, unordered_key_hash, std::equal_to<unordered_key>, sc::utils::treeify_layout<>> u;
+        for(int i=0; i<100; ++i)
+            u.insert(unordered_key{i});
+        assert(u.size() == 100 && u.contains(unordered_key{99}) && !u.contains(unordered_key{100}));
+    }
+
+    // the bucket counts of the policies
+    assert(sc::utils::power_of_two_index::round(1000) == 1024);
+    assert(sc::utils::prime_index::round(1000) == 1543);
+    sc::utils::prime_index index(1543);
+    for(std::size_t h=0; h<100000; h+=7)
+        assert(index(h) == h % 1543);
+
+    // the singly-linked layout never calls a throwing hash function on erasure
+    sc::regular::unordered_set<int, std::hash<int>, std::equal_to<int>, sc::utils::forward_layout> s;
+    static_assert(noexcept(s.erase(s.cbegin())), "erase must not throw");
+    sc::regular::unordered_set<std::string, std::hash<std::string>, std::equal_to<std::string>, sc::utils::forward_layout> s2;
+    static_assert(noexcept(s2.erase(s2.cbegin())), "erase must not throw");
+
+    {
+        // a transparent hasher and comparator look up and erase by a string_view or a
+        // string literal, no key is constructed
+        sc::regular::unordered_set<key, key_hash, std::equal_to<>> s;
+        for(int i=0; i<100; ++i)
+            s.insert(key(std::to_string(i).c_str()));
+        key::constructed = 0;
+        std::string_view view = "42";
+        assert(s.contains(view) && s.count("7") == 1 && s.find("100") == s.end());
+        auto range = s.equal_range(view);
+        assert(range.first != range.second && *range.first == "42");
+        assert(s.erase(view) == 1 && s.erase("42") == 0 && s.size() == 99);
+        assert(key::constructed == 0);
+        auto nh = s.extract("7");
+        assert(!nh.empty() && !s.contains("7") && s.extract(view).empty());
+    }
+
+    {
+        // the stats show a hasher which puts every key into one bucket
+        sc::regular::unordered_set<int> good;
+        sc::regular::unordered_set<int, collide> bad;
+        for(int i=0; i<1000; ++i){
+            good.insert(i);
+            bad.insert(i);
+        }
+        // the sampling tick is shared by the tables of a thread
+        for(int i=0; i<10000; ++i)
+            (void)good.contains(i % 2000);
+        for(int i=0; i<10000; ++i)
+            (void)bad.contains(i % 2000);
+
+        auto gs = good.stats(), bs = bad.stats();
+        assert(gs.size == 1000 && gs.bucket_count == good.bucket_count() && gs.max_chain < 10);
+        assert(bs.max_chain == 1000 && bs.chain_histogram.back() == 1);
+        assert(bs.chain_histogram[0] == bad.bucket_count() - 1);
+        std::size_t buckets = 0;
+        for(std::size_t n: gs.chain_histogram)
+            buckets += n;
+        assert(buckets == good.bucket_count());
+        assert(gs.node_bytes >= 1000 * sizeof(int) && gs.bucket_bytes >= good.bucket_count() * sizeof(void*));
+#if SC_HASH_STATS
+        assert(gs.rehash_count > 0 && gs.rehash_count == bs.rehash_count);
+        assert(gs.sampled_hits > 0 && gs.sampled_misses > 0 && bs.sampled_hits > 0);
+        assert(gs.probes_per_hit < 3 && bs.probes_per_hit > 100 && bs.probes_per_miss > 100);
+        auto copy = bad;
+        assert(copy.stats().sampled_hits == 0 && copy.stats().max_chain == 1000);
+#endif
+    }
+
+    {
+        // the lookups which miss are answered by the filter without comparing a key
+        using filtered = sc::regular::unordered_set<int, std::hash<int>, counting_equal, sc::utils::filter_layout<>>;
+        filtered s;
+        for(int i=0; i<10000; ++i)
+            s.insert(i);
+        counting_equal::compared = 0;
+        for(int i=10000; i<110000; ++i)
+            assert(!s.contains(i));
+        assert(counting_equal::compared < 100);
+        for(int i=0; i<10000; ++i)
+            assert(s.contains(i));
+
+        // an erased key is erased from the cuckoo filter too
+        for(int i=0; i<10000; i+=2)
+            assert(s.erase(i) == 1);
+        counting_equal::compared = 0;
+        for(int i=0; i<10000; i+=2)
+            assert(!s.contains(i));
+        assert(counting_equal::compared < 10);
+        for(int i=1; i<10000; i+=2)
+            assert(s.contains(i));
+
+        auto st = s.stats();
+        assert(st.filter_bytes > 0 && st.filter_fpr > 0 && st.filter_fpr < 0.001);
+        filtered copy = s;
+        assert(copy == s && copy.contains(9999) && !copy.contains(0));
+        copy.clear();
+        assert(!copy.contains(9999) && s.contains(9999));
+
+        // a bloom filter keeps the bits of the erased keys, the keys are still erased
+        sc::regular::unordered_set<int, std::hash<int>, std::equal_to<int>,
+                sc::utils::filter_layout<sc::regular::bloom_filter>> b(s.begin(), s.end());
+        assert(b.size() == 5000 && b.erase(1) == 1 && !b.contains(1) && b.contains(3));
+        assert(b.stats().filter_fpr < 0.05);
+
+        // the keys of one hash overflow the cuckoo filter, which is then bypassed
+        sc::regular::unordered_set<int, collide, std::equal_to<int>, sc::utils::filter_layout<>> c;
+        for(int i=0; i<100; ++i)
+            c.insert(i);
+        assert(c.stats().filter_bytes == 0);
+        for(int i=0; i<200; ++i)
+            assert(c.contains(i) == (i < 100));
+    }
 }
@@ -0,0 +1,49 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_ALLOC_COUNTER_HPP
+#define STLCONTAINER_ALLOC_COUNTER_HPP
+
+/*
+ * Replaces the global operator new and operator delete of a benchmark to
+ * count the bytes of its live allocations. Include it from one translation
+ * unit only, the replacements can't be inline.
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+// the bytes of the live allocations, as rounded up by malloc
+static std::size_t allocated = 0;
+
+void* operator new(std::size_t size){
+    if(void* p = std::malloc(size)){
+        allocated += malloc_usable_size(p);
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align){
+    auto a = static_cast<std::size_t>(align);
+    if(void* p = std::aligned_alloc(a, (size + a - 1) / a * a)){
+        allocated += malloc_usable_size(p);
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    if(p != nullptr)
+        allocated -= malloc_usable_size(p);
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept { operator delete(p);}
+void operator delete(void* p, std::align_val_t) noexcept { operator delete(p);}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { operator delete(p);}
+
+#endif //STLCONTAINER_ALLOC_COUNTER_HPP
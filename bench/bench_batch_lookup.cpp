@@ -0,0 +1,85 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+/*
+ * Probing a table much larger than the cache, the way a hash join probes its
+ * build side: batches of 1024 random keys, half of them present. A loop of
+ * find() waits for the bucket, then the node, of one key before it hashes
+ * the next; find_batch() has the misses of a whole group in flight.
+ */
+
+#include "unordered_map.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+template <class Layout>
+void run(const char* name, std::size_t size, const std::vector<std::uint64_t>& probes){
+    using map_type = sc::regular::unordered_map<std::uint64_t, std::uint64_t, std::hash<std::uint64_t>,
+            std::equal_to<std::uint64_t>, Layout>;
+    const std::size_t batch = 1024;
+
+    // even keys are present, odd keys are not
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> values;
+    for(std::uint64_t k=0; k<size; ++k)
+        values.emplace_back(k * 2, k);
+    std::shuffle(values.begin(), values.end(), std::mt19937_64(7));
+
+    map_type map;
+    auto start = std::chrono::steady_clock::now();
+    for(auto& v: values)
+        map.insert(v);
+    auto end = std::chrono::steady_clock::now();
+    double insert_loop = std::chrono::duration<double, std::nano>(end - start).count() / size;
+
+    map_type batched;
+    start = std::chrono::steady_clock::now();
+    for(std::size_t i=0; i<values.size(); i+=batch)
+        batched.insert_batch(values.begin() + i, values.begin() + std::min(i + batch, values.size()));
+    end = std::chrono::steady_clock::now();
+    double insert_batch = std::chrono::duration<double, std::nano>(end - start).count() / size;
+
+    std::uint64_t sum = 0;
+    start = std::chrono::steady_clock::now();
+    for(std::uint64_t key: probes){
+        auto iter = map.find(key);
+        if(iter != map.end())
+            sum += iter->second;
+    }
+    end = std::chrono::steady_clock::now();
+    double find_loop = std::chrono::duration<double, std::nano>(end - start).count() / probes.size();
+
+    std::uint64_t batch_sum = 0;
+    std::vector<typename map_type::iterator> found(batch);
+    start = std::chrono::steady_clock::now();
+    for(std::size_t i=0; i<probes.size(); i+=batch){
+        map.find_batch(probes.begin() + i, probes.begin() + i + batch, found.begin());
+        for(auto iter: found){
+            if(iter != map.end())
+                batch_sum += iter->second;
+        }
+    }
+    end = std::chrono::steady_clock::now();
+    double find_batch = std::chrono::duration<double, std::nano>(end - start).count() / probes.size();
+
+    if(sum != batch_sum || batched.size() != map.size())
+        std::printf("wrong result\n");
+    std::printf("%-12s %10zu %12.1f %12.1f %12.1f %12.1f\n", name, size, insert_loop, insert_batch, find_loop, find_batch);
+}
+
+int main(){
+    const std::size_t probes_count = 1 << 22;
+    std::printf("%-12s %10s %12s %12s %12s %12s\n", "layout", "size", "insert ns", "insert_batch", "find ns", "find_batch");
+    for(std::size_t size: {std::size_t(1) << 16, std::size_t(1) << 22}){
+        std::mt19937_64 gen(42);
+        std::vector<std::uint64_t> probes(probes_count);
+        for(auto& p: probes)
+            p = gen() % (size * 2);
+        run<sc::utils::dinkumware_layout>("dinkumware", size, probes);
+        run<sc::utils::forward_layout>("forward", size, probes);
+    }
+}
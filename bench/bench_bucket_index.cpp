@@ -0,0 +1,102 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+/*
+ * Lookup speed of unordered_set with the bucket index policies.
+ *
+ * modulo_index is the plain hash % bucket_count with doubled bucket counts,
+ * which the table used before the policies existed. It's compared with
+ * power_of_two_index and prime_index, with a good hasher on random keys and
+ * with std::hash (the identity) on keys that are multiples of 4096, like
+ * aligned pointers.
+ */
+
+#include "unordered_set.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// hash % bucket_count, the bucket count is doubled
+class modulo_index{
+public:
+    explicit modulo_index(std::size_t count = 0): count_(count){}
+
+    static std::size_t round(std::size_t count){ return count;}
+
+    std::size_t operator()(std::size_t hash) const { return hash % count_;}
+
+private:
+    std::size_t count_;
+};
+
+// splitmix64 finalizer, every bit of the key affects every bit of the hash
+struct good_hash{
+    std::size_t operator()(std::uint64_t x) const noexcept {
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBull;
+        x ^= x >> 31;
+        return static_cast<std::size_t>(x);
+    }
+};
+
+template <class F>
+double measure(F f){
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <class Hash, class BucketIndex>
+void run(const char* hasher, const char* policy, const std::vector<std::uint64_t>& keys){
+    sc::regular::unordered_set<std::uint64_t, Hash, std::equal_to<std::uint64_t>,
+            sc::utils::forward_layout, BucketIndex> set;
+    for(auto key: keys)
+        set.insert(key);
+
+    std::size_t longest = 0;
+    for(std::size_t b=0; b<set.bucket_count(); ++b)
+        longest = std::max(longest, set.bucket_size(b));
+
+    // a bad distribution makes the lookups quadratic, measure a sample
+    std::size_t sample = std::min<std::size_t>(keys.size(), longest > 64 ? 4096 : keys.size());
+    std::size_t found = 0;
+    double ms = measure([&]{
+        for(int round=0; round<4; ++round)
+            for(std::size_t i=0; i<sample; ++i)
+                found += set.count(keys[i]);
+    });
+    if(found != 4 * sample)
+        std::printf("wrong result %zu\n", found);
+
+    std::printf("%-10s %-14s %12.1f %14zu\n", hasher, policy, ms / (4 * sample) * 1e6, longest);
+}
+
+int main(){
+    const std::size_t n = 1 << 20;
+    std::mt19937_64 rng(42);
+
+    // the modulo policy puts the aligned keys into a few buckets, which makes
+    // the insertions quadratic, so there are fewer of them
+    std::vector<std::uint64_t> random(n), aligned(n / 16);
+    for(std::size_t i=0; i<random.size(); ++i)
+        random[i] = rng();
+    for(std::size_t i=0; i<aligned.size(); ++i)
+        aligned[i] = (i + 1) * 4096;
+    // look up in an order unrelated to the insertion
+    std::shuffle(aligned.begin(), aligned.end(), rng);
+
+    std::printf("%-10s %-14s %12s %14s\n", "hasher", "bucket index", "ns/lookup", "longest bucket");
+    run<good_hash, modulo_index>("good", "modulo", random);
+    run<good_hash, sc::utils::power_of_two_index>("good", "power_of_two", random);
+    run<good_hash, sc::utils::prime_index>("good", "prime", random);
+    run<std::hash<std::uint64_t>, modulo_index>("identity", "modulo", aligned);
+    run<std::hash<std::uint64_t>, sc::utils::power_of_two_index>("identity", "power_of_two", aligned);
+    run<std::hash<std::uint64_t>, sc::utils::prime_index>("identity", "prime", aligned);
+}
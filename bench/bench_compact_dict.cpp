@@ -0,0 +1,113 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+/*
+ * 100k small JSON-like objects of 8 string keys, and one map of 1M
+ * integer keys, built as unordered_map, flat_hash_map and compact_dict.
+ *
+ * Reports the time to build the maps, to iterate them, to look up a key
+ * which is present, and the bytes of the maps per element, counted by a
+ * global operator new. The bytes of the strings are not counted.
+ */
+
+#include "alloc_counter.hpp"
+#include "compact_dict.hpp"
+#include "flat_hash_map.hpp"
+#include "unordered_map.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <malloc.h>
+#include <random>
+#include <string>
+#include <vector>
+
+static double ns_per(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end, std::size_t n){
+    return std::chrono::duration<double, std::nano>(end - start).count() / n;
+}
+
+// the objects share their key strings, which are built before counting
+template <class Map>
+void run_objects(const char* name, const std::vector<std::string>& keys, std::size_t objects){
+    const std::size_t fields = keys.size();
+    std::size_t before = allocated;
+    auto start = std::chrono::steady_clock::now();
+    auto maps = new std::vector<Map>(objects);
+    for(auto& m: *maps){
+        for(std::size_t f=0; f<fields; ++f)
+            m.emplace(keys[f], static_cast<int>(f));
+    }
+    auto built = std::chrono::steady_clock::now();
+    std::size_t bytes = allocated - before - malloc_usable_size(maps) + maps->size() * sizeof(Map);
+
+    std::uint64_t sum = 0;
+    for(const auto& m: *maps){
+        for(const auto& kv: m)
+            sum += kv.second;
+    }
+    auto iterated = std::chrono::steady_clock::now();
+
+    std::size_t lookups = 0;
+    for(const auto& m: *maps){
+        for(std::size_t f=0; f<fields; f += 3, ++lookups)
+            sum += m.find(keys[f])->second;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::printf("%-16s %10.1f %10.1f %10.1f %12.1f   (%llu)\n", name,
+                ns_per(start, built, objects * fields), ns_per(built, iterated, objects * fields),
+                ns_per(iterated, end, lookups), static_cast<double>(bytes) / (objects * fields),
+                static_cast<unsigned long long>(sum));
+    delete maps;
+}
+
+template <class Map>
+void run_integers(const char* name, const std::vector<std::uint64_t>& keys, const std::vector<std::uint64_t>& queries){
+    std::size_t before = allocated;
+    auto start = std::chrono::steady_clock::now();
+    auto map = new Map;
+    for(std::uint64_t k: keys)
+        map->emplace(k, k);
+    auto built = std::chrono::steady_clock::now();
+    std::size_t bytes = allocated - before;
+
+    std::uint64_t sum = 0;
+    for(const auto& kv: *map)
+        sum += kv.second;
+    auto iterated = std::chrono::steady_clock::now();
+
+    for(std::uint64_t q: queries)
+        sum += map->find(q)->second;
+    auto end = std::chrono::steady_clock::now();
+
+    std::printf("%-16s %10.1f %10.1f %10.1f %12.1f   (%llu)\n", name,
+                ns_per(start, built, keys.size()), ns_per(built, iterated, keys.size()),
+                ns_per(iterated, end, queries.size()), static_cast<double>(bytes) / keys.size(),
+                static_cast<unsigned long long>(sum));
+    delete map;
+}
+
+int main(){
+    std::vector<std::string> fields = {"id", "name", "email", "created_at", "updated_at", "status", "owner_id", "tags"};
+    std::printf("100k objects of %zu string keys\n", fields.size());
+    std::printf("%-16s %10s %10s %10s %12s\n", "map", "ns/insert", "ns/iter", "ns/find", "bytes/elem");
+    run_objects<sc::regular::unordered_map<std::string, int>>("unordered_map", fields, 100000);
+    run_objects<sc::regular::flat_hash_map<std::string, int>>("flat_hash_map", fields, 100000);
+    run_objects<sc::regular::compact_dict<std::string, int>>("compact_dict", fields, 100000);
+
+    std::mt19937_64 rng(42);
+    std::vector<std::uint64_t> keys(1 << 20);
+    for(auto& k: keys)
+        k = rng();
+    std::vector<std::uint64_t> queries(1 << 20);
+    for(auto& q: queries)
+        q = keys[rng() % keys.size()];
+
+    std::printf("\n1M integer keys\n");
+    std::printf("%-16s %10s %10s %10s %12s\n", "map", "ns/insert", "ns/iter", "ns/find", "bytes/elem");
+    run_integers<sc::regular::unordered_map<std::uint64_t, std::uint64_t>>("unordered_map", keys, queries);
+    run_integers<sc::regular::flat_hash_map<std::uint64_t, std::uint64_t>>("flat_hash_map", keys, queries);
+    run_integers<sc::regular::compact_dict<std::uint64_t, std::uint64_t>>("compact_dict", keys, queries);
+    return 0;
+}
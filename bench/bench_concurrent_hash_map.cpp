@@ -0,0 +1,110 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+/*
+ * Throughput of concurrent_hash_map against unordered_map guarded by a
+ * std::shared_mutex, from 1 to 32 threads.
+ *
+ * Every thread runs the same mix on a map of 1M keys: 90% find, 5%
+ * insert_or_assign, 5% erase followed by insert. A find takes the shared
+ * lock of the wrapper, which every reader writes, so the readers of the
+ * wrapper contend on one cache line even without writers.
+ *
+ * Results above the number of hardware threads show the overhead
+ * of oversubscription rather than speedup.
+ */
+
+#include "concurrent_hash_map.hpp"
+#include "unordered_map.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+// the wrapper the concurrent map replaces
+class locked_map{
+public:
+    bool find(std::uint64_t key) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return map_.find(key) != map_.end();
+    }
+
+    void insert_or_assign(std::uint64_t key, std::uint64_t value){
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        map_[key] = value;
+    }
+
+    void erase(std::uint64_t key){
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        map_.erase(key);
+    }
+
+private:
+    mutable std::shared_mutex mutex_;
+    sc::regular::unordered_map<std::uint64_t, std::uint64_t> map_;
+};
+
+struct concurrent_map{
+    bool find(std::uint64_t key) const { return map_.contains(key);}
+
+    void insert_or_assign(std::uint64_t key, std::uint64_t value){ map_.insert_or_assign(key, value);}
+
+    void erase(std::uint64_t key){ map_.erase(key);}
+
+    sc::lock_free::concurrent_hash_map<std::uint64_t, std::uint64_t> map_;
+};
+
+// xorshift, cheap enough not to dominate the operation
+std::uint64_t next(std::uint64_t& x){
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return x;
+}
+
+template <class Map>
+double run(int threads, std::size_t ops){
+    const std::uint64_t keys = 1 << 20;
+    Map map;
+    for(std::uint64_t k=0; k<keys; ++k)
+        map.insert_or_assign(k, k);
+
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for(int t=0; t<threads; ++t){
+        workers.emplace_back([&map, t, ops, threads, keys]{
+            std::uint64_t x = 88172645463325252ull + t;
+            std::size_t found = 0;
+            for(std::size_t i=0; i<ops / threads; ++i){
+                std::uint64_t r = next(x);
+                std::uint64_t key = r % keys;
+                unsigned op = static_cast<unsigned>(r >> 57) % 20;
+                if(op < 18){
+                    found += map.find(key);
+                } else if(op == 18){
+                    map.insert_or_assign(key, r);
+                } else{
+                    map.erase(key);
+                    map.insert_or_assign(key, r);
+                }
+            }
+            volatile std::size_t sink = found;
+            (void)sink;
+        });
+    }
+    for(auto& w: workers)
+        w.join();
+    auto end = std::chrono::steady_clock::now();
+    return ops / std::chrono::duration<double>(end - start).count() / 1e6;
+}
+
+int main(){
+    const std::size_t ops = 1 << 22;
+    std::printf("%8s %22s %22s\n", "threads", "shared_mutex (Mops/s)", "concurrent (Mops/s)");
+    for(int threads = 1; threads <= 32; threads *= 2)
+        std::printf("%8d %22.2f %22.2f\n", threads, run<locked_map>(threads, ops), run<concurrent_map>(threads, ops));
+}
@@ -0,0 +1,59 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+/*
+ * Lookup time of the 9 HTTP methods, and of as many misses, in a
+ * constexpr_map and in an unordered_map built at startup. Both hash the
+ * string_view of the probe; the constexpr_map then reads one displacement
+ * and compares one entry, unordered_map walks a bucket of nodes.
+ */
+
+#include "constexpr_map.hpp"
+#include "unordered_map.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string_view>
+#include <vector>
+
+constexpr auto methods = sc::regular::make_constexpr_map<std::string_view, int>({
+        {"GET", 0}, {"HEAD", 1}, {"POST", 2}, {"PUT", 3}, {"DELETE", 4},
+        {"CONNECT", 5}, {"OPTIONS", 6}, {"TRACE", 7}, {"PATCH", 8}});
+
+template <class Lookup>
+double run(const std::vector<std::string_view>& probes, Lookup lookup){
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(std::string_view p: probes)
+        sum += lookup(p);
+    auto end = std::chrono::steady_clock::now();
+    volatile long sink = sum;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(end - start).count() / probes.size();
+}
+
+int main(){
+    sc::regular::unordered_map<std::string_view, int> runtime;
+    for(const auto& entry: methods)
+        runtime.insert(entry);
+
+    const std::string_view words[] = {"GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH",
+                                      "get", "BREW", "PROPFIND", "MKCOL", "COPY", "MOVE", "LOCK", "UNLOCK", "SEARCH"};
+    std::mt19937 rng(42);
+    std::vector<std::string_view> probes(1 << 22);
+    for(auto& p: probes)
+        p = words[rng() % 18];
+
+    double c = run(probes, [](std::string_view p){
+        auto iter = methods.find(p);
+        return iter == methods.end() ? -1 : iter->second;
+    });
+    double u = run(probes, [&runtime](std::string_view p){
+        auto iter = runtime.find(p);
+        return iter == runtime.end() ? -1 : iter->second;
+    });
+    std::printf("%20s %12s\n", "map", "ns/lookup");
+    std::printf("%20s %12.2f\n", "constexpr_map", c);
+    std::printf("%20s %12.2f\n", "unordered_map", u);
+}
@@ -0,0 +1,84 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+/*
+ * The false-positive rate and the memory of bloom_filter and cuckoo_filter,
+ * and the time of unordered_set::contains when 90% of the lookups miss,
+ * without a filter and with filter_layout.
+ *
+ * The false-positive rate is measured with 1M keys which were not
+ * inserted, next to the rate computed by false_positive_rate(). The set
+ * holds strings longer than the small string buffer, a key compared by a
+ * lookup reads the node and the characters of the string. With integer
+ * keys and a load factor below 1 a chain is too short for the filter to
+ * save more than it costs.
+ */
+
+#include "bloom_filter.hpp"
+#include "cuckoo_filter.hpp"
+#include "unordered_set.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+template <class Filter>
+void report(const char* name, Filter& filter, std::uint64_t keys){
+    for(std::uint64_t k=0; k<keys; ++k)
+        filter.insert(k);
+    std::size_t reported = 0;
+    for(std::uint64_t k=keys; k<keys + (1 << 20); ++k)
+        reported += filter.contains(k);
+    std::printf("%-22s %12.3f%% %12.3f%% %14.2f\n", name, 100.0 * reported / (1 << 20),
+                100.0 * filter.false_positive_rate(), filter.bits_per_key());
+}
+
+// a key longer than the small string buffer, comparing it reads another allocation
+std::string make_key(std::uint64_t k){
+    return "user-session-" + std::to_string(k) + "-0000000000";
+}
+
+template <class Layout>
+double run(std::size_t size, const std::vector<std::string>& probes){
+    sc::regular::unordered_set<std::string, std::hash<std::string>, std::equal_to<std::string>, Layout> set;
+    for(std::uint64_t k=0; k<size; ++k)
+        set.insert(make_key(k * 10));
+
+    std::size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(const std::string& key: probes)
+        found += set.contains(key);
+    auto end = std::chrono::steady_clock::now();
+    volatile std::size_t sink = found;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(end - start).count() / probes.size();
+}
+
+int main(){
+    const std::uint64_t keys = 1 << 20;
+    std::printf("%-22s %13s %13s %14s\n", "filter", "measured fpr", "computed fpr", "bits per key");
+    for(double bits: {8.0, 10.0, 16.0}){
+        sc::regular::bloom_filter<std::uint64_t> bloom(keys, bits);
+        char name[32];
+        std::snprintf(name, sizeof(name), "bloom, %.0f bits", bits);
+        report(name, bloom, keys);
+    }
+    sc::regular::cuckoo_filter<std::uint64_t> cuckoo(keys);
+    report("cuckoo", cuckoo, keys);
+
+    // the keys are multiples of 10, 9 probes in 10 miss
+    std::printf("\n%10s %16s %16s %16s\n", "keys", "no filter (ns)", "bloom (ns)", "cuckoo (ns)");
+    std::mt19937_64 rng(42);
+    for(std::size_t size: {1u << 12, 1u << 16, 1u << 20}){
+        std::vector<std::string> probes(1 << 20);
+        for(auto& p: probes)
+            p = make_key(rng() % (size * 10));
+        std::printf("%10zu %16.1f %16.1f %16.1f\n", size,
+                    run<sc::utils::dinkumware_layout>(size, probes),
+                    run<sc::utils::filter_layout<sc::regular::bloom_filter>>(size, probes),
+                    run<sc::utils::filter_layout<sc::regular::cuckoo_filter>>(size, probes));
+    }
+}
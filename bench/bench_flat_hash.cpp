@@ -0,0 +1,102 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+/*
+ * Lookup speed and memory of flat_hash_set against a node-based table.
+ *
+ * std::unordered_set is the baseline, it has the same node-per-element
+ * layout as unordered_set. The memory of the node-based table is counted
+ * by its allocator, the memory of flat_hash_set is its slot array and
+ * control bytes.
+ */
+
+#include "flat_hash_set.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// counts the bytes allocated by a container
+static std::size_t allocated = 0;
+
+template <class T>
+struct counting_allocator{
+    using value_type = T;
+
+    counting_allocator() = default;
+    template <class U>
+    counting_allocator(const counting_allocator<U>&){}
+
+    T* allocate(std::size_t n){
+        allocated += n * sizeof(T);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n){
+        allocated -= n * sizeof(T);
+        ::operator delete(p);
+    }
+
+    template <class U>
+    bool operator==(const counting_allocator<U>&) const { return true;}
+    template <class U>
+    bool operator!=(const counting_allocator<U>&) const { return false;}
+};
+
+template <class F>
+double measure(F f){
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <class Key>
+void run(const char* name, const std::vector<Key>& keys, const std::vector<Key>& missing){
+    using node_set = std::unordered_set<Key, std::hash<Key>, std::equal_to<Key>, counting_allocator<Key>>;
+
+    allocated = 0;
+    node_set nodes(keys.begin(), keys.end());
+    double node_bytes = static_cast<double>(allocated) / nodes.size();
+
+    sc::regular::flat_hash_set<Key> flat(keys.begin(), keys.end());
+    double flat_bytes = static_cast<double>(flat.bucket_count() * (sizeof(Key) + 1)) / flat.size();
+
+    std::size_t found = 0;
+    double node_hit = measure([&]{ for(const auto& key: keys) found += nodes.count(key);});
+    double node_miss = measure([&]{ for(const auto& key: missing) found += nodes.count(key);});
+    double flat_hit = measure([&]{ for(const auto& key: keys) found += flat.count(key);});
+    double flat_miss = measure([&]{ for(const auto& key: missing) found += flat.count(key);});
+    if(found != 2 * keys.size())
+        std::printf("wrong result %zu\n", found);
+
+    double n = static_cast<double>(keys.size()) / 1e6;
+    std::printf("%-8s %14s %10.1f %10.1f %12.1f\n", name, "node-based", node_hit / n, node_miss / n, node_bytes);
+    std::printf("%-8s %14s %10.1f %10.1f %12.1f\n", name, "flat_hash_set", flat_hit / n, flat_miss / n, flat_bytes);
+}
+
+int main(){
+    const std::size_t n = 1 << 20;
+    std::mt19937_64 rng(42);
+
+    std::vector<std::uint64_t> ints(n), missing_ints(n);
+    for(std::size_t i=0; i<n; ++i){
+        // the even numbers are inserted, the odd numbers are missing
+        std::uint64_t x = rng() & ~std::uint64_t(1);
+        ints[i] = x;
+        missing_ints[i] = x | 1;
+    }
+
+    std::vector<std::string> strings(n), missing_strings(n);
+    for(std::size_t i=0; i<n; ++i){
+        strings[i] = "key/" + std::to_string(ints[i]);
+        missing_strings[i] = "key/" + std::to_string(missing_ints[i]);
+    }
+
+    std::printf("%-8s %14s %10s %10s %12s\n", "key", "table", "hit ms/M", "miss ms/M", "bytes/key");
+    run("uint64", ints, missing_ints);
+    run("string", strings, missing_strings);
+}
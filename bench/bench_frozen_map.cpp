@@ -0,0 +1,76 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+/*
+ * Startup and lookup cost of a dictionary of 2M string keys, built as an
+ * unordered_map from its elements at startup, against a frozen_map which
+ * maps the file written once by freeze().
+ *
+ * The file is in the page cache after freeze(), so the lookups of the
+ * frozen map are not slowed by the disk here. A cold start reads the
+ * pages a lookup touches from the disk instead.
+ */
+
+#include "frozen_map.hpp"
+#include "unordered_map.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+double ms_since(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(){
+    const std::size_t size = 1 << 21;
+    const std::string path = "bench_frozen_map.bin";
+    std::mt19937_64 gen(42);
+
+    std::vector<std::pair<std::string, std::uint64_t>> elements;
+    for(std::size_t i=0; i<size; ++i)
+        elements.emplace_back("term:" + std::to_string(gen()), i);
+    std::vector<std::string> probes;
+    for(std::size_t i=0; i<size; ++i)
+        probes.push_back(i % 2 == 0 ? elements[gen() % size].first : "term:" + std::to_string(gen()));
+
+    auto start = std::chrono::steady_clock::now();
+    sc::regular::unordered_map<std::string, std::uint64_t> map;
+    map.reserve(size);
+    for(const auto& element: elements)
+        map.insert(element);
+    double build = ms_since(start);
+
+    start = std::chrono::steady_clock::now();
+    sc::regular::freeze(map, path);
+    double freeze = ms_since(start);
+
+    start = std::chrono::steady_clock::now();
+    sc::regular::frozen_map<std::string, std::uint64_t> frozen(path);
+    double open = ms_since(start);
+
+    std::uint64_t sum = 0;
+    start = std::chrono::steady_clock::now();
+    for(const auto& key: probes){
+        auto iter = map.find(key);
+        if(iter != map.end())
+            sum += iter->second;
+    }
+    double map_find = ms_since(start) * 1e6 / probes.size();
+
+    std::uint64_t frozen_sum = 0;
+    start = std::chrono::steady_clock::now();
+    for(const auto& key: probes)
+        frozen_sum += frozen.find(key).value_or(0);
+    double frozen_find = ms_since(start) * 1e6 / probes.size();
+
+    if(sum != frozen_sum)
+        std::printf("wrong result\n");
+    std::printf("%zu keys: unordered_map built in %.0f ms, frozen in %.0f ms, frozen_map opened in %.3f ms\n",
+                size, build, freeze, open);
+    std::printf("find: unordered_map %.1f ns, frozen_map %.1f ns\n", map_find, frozen_find);
+    std::remove(path.c_str());
+}
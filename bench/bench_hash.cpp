@@ -0,0 +1,131 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+/*
+ * std::hash against sc::utils::hash.
+ *
+ * Throughput: the time to hash 64-bit integers, and strings of 8 bytes to
+ * 4 KiB.
+ *
+ * Distribution: 64K keys into 64K buckets by the low 16 bits of the hash,
+ * as a table which masks the hash without mixing it. Reports the longest
+ * chain and chi-square divided by its degrees of freedom, which is about
+ * 1 for a uniform hash.
+ *
+ * Lookup: unordered_set<std::string> of 1M URL-like keys with each hash.
+ */
+
+#include "hash.hpp"
+#include "unordered_set.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+template <class Hash, class Key>
+double ns_per_hash(const std::vector<Key>& keys, std::uint64_t& sink){
+    Hash hash;
+    const int rounds = 8;
+    auto start = std::chrono::steady_clock::now();
+    for(int r=0; r<rounds; ++r){
+        for(const auto& k: keys)
+            sink += hash(k);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (rounds * keys.size());
+}
+
+template <class Hash, class Key>
+void distribution(const char* name, const std::vector<Key>& keys){
+    const std::size_t buckets = 1 << 16;
+    std::vector<std::uint32_t> count(buckets);
+    Hash hash;
+    for(const auto& k: keys)
+        ++count[hash(k) & (buckets - 1)];
+    double expected = static_cast<double>(keys.size()) / buckets, chi = 0;
+    for(std::uint32_t c: count)
+        chi += (c - expected) * (c - expected) / expected;
+    std::printf("  %-14s max chain %6u   chi2/df %10.2f\n", name,
+                *std::max_element(count.begin(), count.end()), chi / (buckets - 1));
+}
+
+template <class Key>
+void compare_distribution(const char* keys_name, const std::vector<Key>& keys){
+    std::printf("%s\n", keys_name);
+    distribution<std::hash<Key>>("std::hash", keys);
+    distribution<sc::utils::hash<Key>>("sc::utils::hash", keys);
+}
+
+template <class Hash>
+void lookup(const char* name, const std::vector<std::string>& keys, const std::vector<std::string>& queries){
+    sc::regular::unordered_set<std::string, Hash> set(keys.begin(), keys.end());
+    auto start = std::chrono::steady_clock::now();
+    std::size_t found = 0;
+    for(const auto& q: queries)
+        found += set.count(q);
+    auto end = std::chrono::steady_clock::now();
+    std::printf("  %-14s %8.1f ns/find   (%zu)\n", name,
+                std::chrono::duration<double, std::nano>(end - start).count() / queries.size(), found);
+}
+
+int main(){
+    std::mt19937_64 rng(42);
+    std::uint64_t sink = 0;
+
+    std::printf("throughput, ns per hash\n");
+    std::printf("  %-10s %12s %16s\n", "key", "std::hash", "sc::utils::hash");
+    std::vector<std::uint64_t> integers(1 << 16);
+    for(auto& k: integers)
+        k = rng();
+    std::printf("  %-10s %12.2f %16.2f\n", "uint64",
+                ns_per_hash<std::hash<std::uint64_t>>(integers, sink),
+                ns_per_hash<sc::utils::hash<std::uint64_t>>(integers, sink));
+    for(std::size_t length: {8, 16, 32, 64, 256, 4096}){
+        std::vector<std::string> strings((1 << 20) / length);
+        for(auto& s: strings){
+            s.resize(length);
+            for(auto& c: s)
+                c = static_cast<char>('a' + rng() % 26);
+        }
+        std::printf("  %-10s %12.2f %16.2f\n", ("string " + std::to_string(length)).c_str(),
+                    ns_per_hash<std::hash<std::string>>(strings, sink),
+                    ns_per_hash<sc::utils::hash<std::string>>(strings, sink));
+    }
+
+    std::printf("\ndistribution, 64K keys into 64K buckets by the low bits\n");
+    std::vector<std::uint64_t> keys(1 << 16);
+    for(std::size_t i=0; i<keys.size(); ++i)
+        keys[i] = i;
+    compare_distribution("sequential integers", keys);
+    for(std::size_t i=0; i<keys.size(); ++i)
+        keys[i] = i * 4096;
+    compare_distribution("multiples of 4096", keys);
+    for(std::size_t i=0; i<keys.size(); ++i)
+        keys[i] = i << 32;
+    compare_distribution("integers in the high 32 bits", keys);
+    std::vector<std::string> names(1 << 16);
+    for(std::size_t i=0; i<names.size(); ++i)
+        names[i] = "user:" + std::to_string(i);
+    compare_distribution("strings user:0 to user:65535", names);
+
+    std::printf("\nlookup in unordered_set<std::string> of 1M keys\n");
+    std::vector<std::string> urls(1 << 20);
+    for(std::size_t i=0; i<urls.size(); ++i)
+        urls[i] = "https://example.com/items/" + std::to_string(rng() % 1000000) + "/" + std::to_string(i);
+    std::vector<std::string> queries(1 << 20);
+    for(auto& q: queries)
+        q = urls[rng() % urls.size()];
+    // each one twice, the first run of the set warms the allocator
+    for(int round=0; round<2; ++round){
+        lookup<std::hash<std::string>>("std::hash", urls, queries);
+        lookup<sc::utils::hash<std::string>>("sc::utils::hash", urls, queries);
+    }
+
+    std::printf("\n(%llu)\n", static_cast<unsigned long long>(sink));
+    return 0;
+}
@@ -0,0 +1,55 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+/*
+ * Insertion latency of unordered_map with forward_layout, which relinks all
+ * nodes when the table grows, and incremental_layout, which moves a few
+ * buckets per insertion after the table grows.
+ *
+ * Every insertion is timed on its own, the percentiles show the insertions
+ * which paid for a rehash. The mean shows what the incremental rehash costs.
+ */
+
+#include "unordered_map.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+template <class Layout>
+void run(const char* name, const std::vector<std::uint64_t>& keys){
+    sc::regular::unordered_map<std::uint64_t, std::uint64_t, std::hash<std::uint64_t>,
+            std::equal_to<std::uint64_t>, Layout> map;
+    std::vector<double> ns(keys.size());
+    double total = 0;
+
+    for(std::size_t i=0; i<keys.size(); ++i){
+        auto start = std::chrono::steady_clock::now();
+        map.emplace(keys[i], i);
+        auto end = std::chrono::steady_clock::now();
+        ns[i] = std::chrono::duration<double, std::nano>(end - start).count();
+        total += ns[i];
+    }
+    if(map.size() != keys.size())
+        std::printf("wrong size %zu\n", map.size());
+
+    std::sort(ns.begin(), ns.end());
+    auto percentile = [&ns](double p){ return ns[static_cast<std::size_t>(p * (ns.size() - 1))];};
+    std::printf("%-12s %8.1f %8.1f %8.1f %10.1f %10.1f %12.1f\n", name, total / ns.size(),
+                percentile(0.5), percentile(0.99), percentile(0.999), percentile(0.9999), ns.back());
+}
+
+int main(){
+    const std::size_t n = 1 << 22;
+    std::mt19937_64 rng(42);
+    std::vector<std::uint64_t> keys(n);
+    for(auto& key: keys)
+        key = rng();
+
+    std::printf("%-12s %8s %8s %8s %10s %10s %12s\n", "layout", "mean", "p50", "p99", "p99.9", "p99.99", "max (ns)");
+    run<sc::utils::forward_layout>("forward", keys);
+    run<sc::utils::incremental_layout>("incremental", keys);
+}
@@ -0,0 +1,98 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+/*
+ * An inverted index of 4M postings, built as an
+ * unordered_map<word, std::vector<doc>> and as an unordered_multimap<word, doc>.
+ * The words are drawn uniformly, with 1, 4 and 16 postings per word on
+ * average.
+ *
+ * Reports the time to build the index, the time to sum the postings of a
+ * random word, and the bytes of the index per posting, counted by a global
+ * operator new.
+ */
+
+#include "alloc_counter.hpp"
+#include "unordered_map.hpp"
+#include "unordered_multimap.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <malloc.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+using posting = std::pair<std::uint32_t, std::uint32_t>;
+
+struct vector_index{
+    sc::regular::unordered_map<std::uint32_t, std::vector<std::uint32_t>> map_;
+
+    void add(std::uint32_t word, std::uint32_t doc){ map_[word].push_back(doc);}
+
+    std::uint64_t sum(std::uint32_t word) const {
+        auto iter = map_.find(word);
+        std::uint64_t s = 0;
+        if(iter != map_.end()){
+            for(std::uint32_t doc: iter->second)
+                s += doc;
+        }
+        return s;
+    }
+};
+
+struct multimap_index{
+    sc::regular::unordered_multimap<std::uint32_t, std::uint32_t> map_;
+
+    void add(std::uint32_t word, std::uint32_t doc){ map_.emplace(word, doc);}
+
+    std::uint64_t sum(std::uint32_t word) const {
+        auto range = map_.equal_range(word);
+        std::uint64_t s = 0;
+        for(auto iter = range.first; iter != range.second; ++iter)
+            s += iter->second;
+        return s;
+    }
+};
+
+template <class Index>
+void run(const char* name, const std::vector<posting>& postings, const std::vector<std::uint32_t>& queries){
+    std::size_t before = allocated;
+    auto start = std::chrono::steady_clock::now();
+    auto index = new Index;
+    for(const auto& p: postings)
+        index->add(p.first, p.second);
+    auto built = std::chrono::steady_clock::now();
+    std::size_t bytes = allocated - before - malloc_usable_size(index);
+
+    std::uint64_t sum = 0;
+    for(std::uint32_t word: queries)
+        sum += index->sum(word);
+    auto end = std::chrono::steady_clock::now();
+
+    std::printf("%-14s %12.1f %12.1f %14.1f   (%llu)\n", name,
+                std::chrono::duration<double, std::nano>(built - start).count() / postings.size(),
+                std::chrono::duration<double, std::nano>(end - built).count() / queries.size(),
+                static_cast<double>(bytes) / postings.size(), static_cast<unsigned long long>(sum));
+    delete index;
+}
+
+int main(){
+    for(std::uint32_t per_word: {1, 4, 16}){
+        const std::uint32_t words = (1 << 22) / per_word;
+        std::mt19937_64 rng(42);
+        std::vector<posting> postings(1 << 22);
+        for(std::size_t i=0; i<postings.size(); ++i)
+            postings[i] = {static_cast<std::uint32_t>(rng() % words), static_cast<std::uint32_t>(i)};
+        std::vector<std::uint32_t> queries(1 << 20);
+        for(auto& q: queries)
+            q = postings[rng() % postings.size()].first;
+
+        std::printf("%u postings per word\n", per_word);
+        std::printf("%-14s %12s %12s %14s\n", "index", "ns/insert", "ns/query", "bytes/posting");
+        run<vector_index>("map+vector", postings, queries);
+        run<multimap_index>("multimap", postings, queries);
+    }
+    return 0;
+}
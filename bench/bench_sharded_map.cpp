@@ -0,0 +1,111 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+/*
+ * Ingest throughput of sharded_map against one unordered_map behind a
+ * std::mutex, from 1 to 16 producer threads.
+ *
+ * Every producer inserts or assigns random keys of a 1M key space. The
+ * sharded map is used in two ways: every call locks the shard of its key,
+ * or the producers submit batches of 256 operations to an owner_group, and
+ * one owner thread per shard applies them. The map has 16 shards.
+ *
+ * The owner_group runs 16 owner threads besides the producers, so it
+ * needs more hardware threads than producers to show its speedup.
+ */
+
+#include "sharded_map.hpp"
+#include "unordered_map.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using sharded = sc::lock_free::sharded_map<std::uint64_t, std::uint64_t>;
+
+// the wrapper the sharded map replaces
+class locked_map{
+public:
+    void insert_or_assign(std::uint64_t key, std::uint64_t value){
+        std::lock_guard<std::mutex> lock(mutex_);
+        map_.insert_or_assign(key, value);
+    }
+
+private:
+    std::mutex mutex_;
+    sc::regular::unordered_map<std::uint64_t, std::uint64_t> map_;
+};
+
+struct sharded_locked{
+    void insert_or_assign(std::uint64_t key, std::uint64_t value){ map_.insert_or_assign(key, value);}
+
+    sharded map_{16};
+};
+
+// xorshift, cheap enough not to dominate the operation
+std::uint64_t next(std::uint64_t& x){
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return x;
+}
+
+template <class Map>
+double run_locked(int threads, std::size_t ops){
+    Map map;
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for(int t=0; t<threads; ++t){
+        workers.emplace_back([&map, t, ops, threads]{
+            std::uint64_t x = 88172645463325252ull + t;
+            for(std::size_t i=0; i<ops / threads; ++i){
+                std::uint64_t r = next(x);
+                map.insert_or_assign(r & ((1 << 20) - 1), r);
+            }
+        });
+    }
+    for(auto& w: workers)
+        w.join();
+    auto end = std::chrono::steady_clock::now();
+    return ops / std::chrono::duration<double>(end - start).count() / 1e6;
+}
+
+double run_owned(int threads, std::size_t ops){
+    sharded map(16);
+    auto start = std::chrono::steady_clock::now();
+    {
+        sharded::owner_group owners(map, threads);
+        std::vector<std::thread> workers;
+        for(int t=0; t<threads; ++t){
+            workers.emplace_back([&owners, t, ops, threads]{
+                std::uint64_t x = 88172645463325252ull + t;
+                std::vector<sharded::operation> batch;
+                for(std::size_t i=0; i<ops / threads; ++i){
+                    std::uint64_t r = next(x);
+                    batch.push_back(sharded::operation::assign(r & ((1 << 20) - 1), r));
+                    if(batch.size() == 256){
+                        owners.submit(t, batch.begin(), batch.end());
+                        batch.clear();
+                    }
+                }
+                owners.submit(t, batch.begin(), batch.end());
+            });
+        }
+        for(auto& w: workers)
+            w.join();
+        owners.flush();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return ops / std::chrono::duration<double>(end - start).count() / 1e6;
+}
+
+int main(){
+    const std::size_t ops = 1 << 21;
+    std::printf("%8s %18s %18s %18s\n", "threads", "mutex (Mops/s)", "sharded (Mops/s)", "owners (Mops/s)");
+    for(int threads = 1; threads <= 16; threads *= 2)
+        std::printf("%8d %18.2f %18.2f %18.2f\n", threads, run_locked<locked_map>(threads, ops),
+                    run_locked<sharded_locked>(threads, ops), run_owned(threads, ops));
+}
@@ -0,0 +1,84 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+/*
+ * Scalability of thread_pool from 1 to 64 worker threads.
+ *
+ * Two workloads are measured:
+ * - parallel_for: a flat loop split into pieces of grain elements
+ * - fib: recursive fork/join, most tasks are tiny and are stolen
+ *
+ * Results above the number of hardware threads show the overhead
+ * of oversubscription rather than speedup.
+ */
+
+#include "thread_pool.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using sc::lock_free::thread_pool;
+using sc::lock_free::task_group;
+
+long fib(thread_pool& pool, int n){
+    // below the cutoff the recursion runs sequentially
+    if(n < 16){
+        long a = 0, b = 1;
+        for(int i=0; i<n; ++i){
+            long c = a + b;
+            a = b;
+            b = c;
+        }
+        // keep the sequential part as expensive as the recursion it replaces
+        volatile long sink = 0;
+        for(long i=0; i<(1L << (n/2)); ++i)
+            sink = sink + i;
+        return a;
+    }
+    long a = 0;
+    task_group group(pool);
+    group.run([&pool, &a, n]{ a = fib(pool, n-1);});
+    long b = fib(pool, n-2);
+    group.wait();
+    return a + b;
+}
+
+template <class F>
+double measure(F f){
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(){
+    const std::size_t n = 1 << 23;
+    std::vector<double> data(n, 1.0);
+
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    std::printf("%8s %16s %10s %12s %10s\n", "threads", "parallel_for ms", "speedup", "fib ms", "speedup");
+
+    double base_for = 0, base_fib = 0;
+    for(std::size_t threads = 1; threads <= 64; threads *= 2){
+        thread_pool pool(threads);
+
+        double t_for = measure([&]{
+            pool.parallel_for(std::size_t(0), n, [&data](std::size_t i){
+                data[i] = std::sqrt(data[i] * 1.0000001 + 0.5);
+            }, std::size_t(4096));
+        });
+
+        long result = 0;
+        double t_fib = measure([&]{ result = fib(pool, 32);});
+        if(result != 2178309)
+            std::printf("wrong result %ld\n", result);
+
+        if(threads == 1){
+            base_for = t_for;
+            base_fib = t_fib;
+        }
+        std::printf("%8zu %16.2f %10.2f %12.2f %10.2f\n", threads, t_for, base_for / t_for, t_fib, base_fib / t_fib);
+    }
+}
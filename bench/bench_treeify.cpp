@@ -0,0 +1,54 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+/*
+ * Lookup time under a hash function which maps every key to one of 4
+ * buckets, with dinkumware_layout, which walks the chain, and with
+ * treeify_layout, which searches the tree of the bucket. With a good hash
+ * function, both layouts do the same work except the check for a tree.
+ */
+
+#include "unordered_set.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// low-entropy keys, as if only 2 bits of them were hashed
+struct bad_hash{
+    std::size_t operator()(std::uint64_t key) const noexcept { return key & 3;}
+};
+
+template <class Hash, class Layout>
+double run(std::size_t size, const std::vector<std::uint64_t>& probes){
+    sc::regular::unordered_set<std::uint64_t, Hash, std::equal_to<std::uint64_t>, Layout> set;
+    for(std::uint64_t k=0; k<size; ++k)
+        set.insert(k);
+
+    std::size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(std::uint64_t key: probes)
+        found += set.count(key % (size * 2));
+    auto end = std::chrono::steady_clock::now();
+    volatile std::size_t sink = found;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(end - start).count() / probes.size();
+}
+
+int main(){
+    std::mt19937_64 gen(42);
+    std::vector<std::uint64_t> probes(1 << 16);
+    for(auto& p: probes)
+        p = gen();
+
+    std::printf("%8s %18s %18s %18s %18s\n", "size", "bad dinkumware", "bad treeify", "good dinkumware", "good treeify");
+    for(std::size_t size: {64, 1024, 16384}){
+        std::printf("%8zu %18.1f %18.1f %18.1f %18.1f\n", size,
+                    run<bad_hash, sc::utils::dinkumware_layout>(size, probes),
+                    run<bad_hash, sc::utils::treeify_layout<>>(size, probes),
+                    run<std::hash<std::uint64_t>, sc::utils::dinkumware_layout>(size, probes),
+                    run<std::hash<std::uint64_t>, sc::utils::treeify_layout<>>(size, probes));
+    }
+}
@@ -0,0 +1,237 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_BLOOM_FILTER_HPP
+#define STLCONTAINER_BLOOM_FILTER_HPP
+
+/*
+ * Blocked Bloom filter.
+ *
+ * A Bloom filter answers whether a key may have been inserted: a key which
+ * was inserted is always reported, a key which was not is reported with a
+ * small probability. The keys can't be erased or enumerated.
+ *
+ * A classic Bloom filter sets k bits spread over the whole array, so a
+ * lookup misses the cache k times. Here the bits of a key are in one block
+ * of one cache line: the block is chosen by the high bits of the mixed
+ * hash, and the block holds 8 words of 64 bits, one bit is set in every
+ * word. A lookup reads one cache line and tests 8 words, which the
+ * compiler turns into a few vector instructions. The blocks fill unevenly,
+ * so a blocked filter needs about one more bit per key than a classic one
+ * for the same false-positive rate.
+ *
+ * The filter is sized by the number of keys and the bits per key. With 10
+ * bits per key the false-positive rate is about 1%, with 16 bits about 0.1%.
+ * false_positive_rate() computes the rate of the current bits, so it also
+ * holds when more keys than the capacity were inserted.
+ *
+ * The functions taking a hash are used by a table which has hashed its key
+ * already, see filter_layout.hpp.
+ *
+ * references: Putze, F., Sanders, P., Singler, J. Cache-, hash- and space-efficient bloom filters. 2007.
+ *             https://github.com/apache/parquet-format/blob/master/BloomFilter.md
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <utility>
+#include "cache_line.hpp"
+#include "hash.hpp"
+#include "perfect_hash.hpp"
+
+namespace sc::regular{
+
+    template <class Key, class Hash = sc::utils::hash<Key>>
+    class bloom_filter{
+    public:
+
+        using key_type = Key;
+
+        using size_type = std::size_t;
+
+        using hasher = Hash;
+
+        // the words of a block, one bit is set in every word
+        static constexpr size_type WORDS = 8;
+
+        static constexpr size_type BLOCK_BITS = WORDS * 64;
+
+        // an empty filter, every insertion fails until it's resized
+        bloom_filter(): blocks_(nullptr), count_(0), size_(0){}
+
+        // enough blocks for capacity keys with bits_per_key bits each
+        explicit bloom_filter(size_type capacity, double bits_per_key = 10, const Hash& hash = Hash());
+
+        bloom_filter(const bloom_filter& other);
+        bloom_filter(bloom_filter&& other) noexcept : bloom_filter() { swap(other);}
+
+        // use copy-and-swap idiom
+        bloom_filter&operator=(bloom_filter other) noexcept { swap(other); return *this;}
+
+        ~bloom_filter(){ std::free(blocks_);}
+
+        /*
+         * Modifiers
+         */
+
+        // returns false if the filter has no block
+        bool insert(const Key& key) noexcept { return insert_hash(hash_(key));}
+
+        bool insert_hash(std::size_t hash) noexcept ;
+
+        // unsets every bit
+        void clear() noexcept ;
+
+        void swap(bloom_filter& other) noexcept ;
+
+        /*
+         * Look-up
+         */
+
+        // false if key was never inserted
+        bool contains(const Key& key) const noexcept { return contains_hash(hash_(key));}
+
+        bool contains_hash(std::size_t hash) const noexcept ;
+
+        /*
+         * Capacity
+         */
+
+        // the insertions, an insertion of the same key is counted again
+        size_type size() const { return size_;}
+
+        bool empty() const { return size_ == 0;}
+
+        size_type block_count() const { return count_;}
+
+        size_type memory() const { return count_ * sizeof(block);}
+
+        double bits_per_key() const { return size_ == 0 ? 0 : 8.0 * memory() / size_;}
+
+        // the probability that a key which was not inserted is reported: the
+        // average over the blocks of the product of the fill of their words
+        double false_positive_rate() const;
+
+        hasher hash_function() const { return hash_;}
+
+    private:
+        struct alignas(CACHE_LINE_SIZE) block{
+            std::uint64_t words_[WORDS];
+        };
+
+        // the block of a mixed hash, by multiplying its high 32 bits instead of dividing
+        size_type block_of(std::uint64_t h) const {
+            return static_cast<size_type>(((h >> 32) * count_) >> 32);
+        }
+
+        // the bit of word i, chosen by the low 32 bits of a mixed hash
+        static std::uint64_t mask(std::uint64_t h, size_type i){
+            // odd constants, each one spreads the low bits to a different top 6 bits
+            static constexpr std::uint32_t SALT[WORDS] = {
+                    0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+                    0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+            std::uint32_t x = static_cast<std::uint32_t>(h) * SALT[i];
+            return std::uint64_t(1) << (x >> 26);
+        }
+
+        static block* allocate(size_type count);
+
+        block* blocks_;
+        size_type count_; // the number of blocks
+        size_type size_; // the number of insertions
+        Hash hash_;
+    };
+
+    template <class Key, class Hash>
+    bloom_filter<Key, Hash>::bloom_filter(size_type capacity, double bits_per_key, const Hash &hash):
+            blocks_(nullptr), count_(0), size_(0), hash_(hash) {
+        double bits = std::ceil(static_cast<double>(capacity) * bits_per_key);
+        count_ = std::max<size_type>(1, static_cast<size_type>(bits / BLOCK_BITS) + 1);
+        blocks_ = allocate(count_);
+    }
+
+    template <class Key, class Hash>
+    bloom_filter<Key, Hash>::bloom_filter(const bloom_filter &other):
+            blocks_(nullptr), count_(other.count_), size_(other.size_), hash_(other.hash_) {
+        blocks_ = allocate(count_);
+        std::copy(other.blocks_, other.blocks_ + count_, blocks_);
+    }
+
+    template <class Key, class Hash>
+    bool bloom_filter<Key, Hash>::insert_hash(std::size_t hash) noexcept {
+        if(count_ == 0)
+            return false;
+        std::uint64_t h = sc::utils::mix64(hash);
+        block& b = blocks_[block_of(h)];
+        for(size_type i=0; i<WORDS; ++i)
+            b.words_[i] |= mask(h, i);
+        ++size_;
+        return true;
+    }
+
+    template <class Key, class Hash>
+    bool bloom_filter<Key, Hash>::contains_hash(std::size_t hash) const noexcept {
+        if(count_ == 0)
+            return false;
+        std::uint64_t h = sc::utils::mix64(hash);
+        const block& b = blocks_[block_of(h)];
+        // no early exit, the 8 tests are vectorized
+        bool all = true;
+        for(size_type i=0; i<WORDS; ++i)
+            all &= (b.words_[i] & mask(h, i)) != 0;
+        return all;
+    }
+
+    template <class Key, class Hash>
+    void bloom_filter<Key, Hash>::clear() noexcept {
+        std::fill(blocks_, blocks_ + count_, block{});
+        size_ = 0;
+    }
+
+    template <class Key, class Hash>
+    void bloom_filter<Key, Hash>::swap(bloom_filter &other) noexcept {
+        std::swap(blocks_, other.blocks_);
+        std::swap(count_, other.count_);
+        std::swap(size_, other.size_);
+        std::swap(hash_, other.hash_);
+    }
+
+    template <class Key, class Hash>
+    double bloom_filter<Key, Hash>::false_positive_rate() const {
+        if(count_ == 0)
+            return 0;
+        double sum = 0;
+        for(size_type b=0; b<count_; ++b){
+            double p = 1;
+            for(size_type i=0; i<WORDS; ++i)
+                p *= __builtin_popcountll(blocks_[b].words_[i]) / 64.0;
+            sum += p;
+        }
+        return sum / count_;
+    }
+
+    template <class Key, class Hash>
+    typename bloom_filter<Key, Hash>::block *bloom_filter<Key, Hash>::allocate(size_type count) {
+        // zeroed blocks on their own cache lines
+        void* p = std::aligned_alloc(CACHE_LINE_SIZE, count * sizeof(block));
+        if(p == nullptr)
+            throw std::bad_alloc();
+        auto blocks = static_cast<block*>(p);
+        std::fill(blocks, blocks + count, block{});
+        return blocks;
+    }
+
+    template <class Key, class Hash>
+    void swap(bloom_filter<Key, Hash>& lhs, bloom_filter<Key, Hash>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+}
+
+#endif //STLCONTAINER_BLOOM_FILTER_HPP
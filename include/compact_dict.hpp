@@ -0,0 +1,591 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_COMPACT_DICT_HPP
+#define STLCONTAINER_COMPACT_DICT_HPP
+
+/*
+ * Insertion-ordered hash map, laid out like the dict of CPython 3.6.
+ *
+ * The key-value pairs are appended to a dense array of entries, in the
+ * order of insertion, and every entry stores the hash of its key in a
+ * parallel array. The hash table is a separate open-addressed index of
+ * small integers: a slot is empty, deleted, or the position of an entry.
+ * The index has a power-of-two number of slots, at least 3/2 of the
+ * entries, and probes linearly. Its slots take 1, 2, 4 or 8 bytes, the
+ * fewest which hold the position of the last entry, so a map of 200
+ * entries has an index of 1-byte slots.
+ *
+ * An entry costs the pair, its hash, and 1.5 to 3 slots of the index,
+ * where a node of unordered_map costs the pair, two links and a bucket
+ * pointer, plus the rounding of malloc. Iterating is a linear scan of the
+ * entries, in insertion order.
+ *
+ * erase() destroys the pair but leaves its entry as a tombstone, so the
+ * other entries keep their order and position; its index slot is marked
+ * deleted. The tombstones are dropped when the entries are full and the
+ * index is rebuilt, or by compact(). Rebuilding moves the pairs but never
+ * calls the hash function, the stored hashes are reused.
+ *
+ * The pairs move when the entries are rebuilt, so an insertion which
+ * rebuilds invalidates the references to the elements, like vector.
+ *
+ * references: https://mail.python.org/pipermail/python-dev/2012-December/123028.html
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "dict_iterator.hpp"
+#include "hash.hpp"
+#include "key_of_value.hpp"
+#include "map_modifiers.hpp"
+#include "perfect_hash.hpp"
+
+namespace sc::regular{
+
+    template <
+            class Key,
+            class T,
+            class Hash = sc::utils::hash<Key>,
+            class KeyEqual = std::equal_to<Key>
+    >
+    class compact_dict: public sc::utils::map_modifiers<compact_dict<Key, T, Hash, KeyEqual>, Key, T,
+                                                        sc::utils::dict_iterator<std::pair<const Key, T>>,
+                                                        sc::utils::dict_iterator<const std::pair<const Key, T>>>{
+
+        using modifiers = sc::utils::map_modifiers<compact_dict, Key, T, sc::utils::dict_iterator<std::pair<const Key, T>>,
+                                                   sc::utils::dict_iterator<const std::pair<const Key, T>>>;
+
+        // calls emplace_key()
+        friend modifiers;
+
+    public:
+
+        using key_type = Key;
+
+        using mapped_type = T;
+
+        using value_type = std::pair<const Key, T>;
+
+        using size_type = std::size_t;
+
+        using difference_type = std::ptrdiff_t;
+
+        using hasher = Hash;
+
+        using key_equal = KeyEqual;
+
+        using reference = value_type &;
+
+        using const_reference = const value_type &;
+
+        using iterator = sc::utils::dict_iterator<value_type>;
+
+        using const_iterator = sc::utils::dict_iterator<const value_type>;
+
+        compact_dict(): compact_dict(size_type(0)){}
+
+        // room for count entries
+        explicit compact_dict(size_type count, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual());
+
+        template <class InputIt>
+        compact_dict(InputIt first, InputIt last, size_type count = 0,
+                const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual()): compact_dict(count, hash, equal) {
+            insert(first, last);
+        }
+
+        compact_dict(std::initializer_list<value_type> init, size_type count = 0,
+                const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual()):
+                compact_dict(init.begin(), init.end(), count, hash, equal){}
+
+        // the copy has no tombstone
+        compact_dict(const compact_dict& other);
+        compact_dict(compact_dict&& other) noexcept : compact_dict() { swap(other);}
+
+        // use copy-and-swap idiom
+        compact_dict&operator=(compact_dict other) noexcept { swap(other); return *this;}
+
+        ~compact_dict();
+
+        /*
+         * Iterators
+         * in insertion order
+         */
+
+        iterator begin() noexcept { return iterator(hashes_, hashes_ + used_, entries_);}
+        const_iterator begin() const noexcept { return const_iterator(hashes_, hashes_ + used_, entries_);}
+        const_iterator cbegin() const noexcept { return begin();}
+
+        iterator end() noexcept { return iterator(hashes_ + used_, hashes_ + used_, entries_ + used_);}
+        const_iterator end() const noexcept { return const_iterator(hashes_ + used_, hashes_ + used_, entries_ + used_);}
+        const_iterator cend() const noexcept { return end();}
+
+        /*
+         * Capacity
+         */
+
+        bool empty() const { return size_ == 0;}
+
+        size_type size() const { return size_;}
+
+        // the entries which can be appended before the index is rebuilt, tombstones included
+        size_type capacity() const { return capacity_;}
+
+        // the erased entries which still take room in the array
+        size_type tombstones() const { return used_ - size_;}
+
+        // the bytes of the entries, the hashes and the index
+        size_type memory() const { return capacity_ * (sizeof(value_type) + sizeof(size_type)) + index_count_ * width_;}
+
+        // the bytes of a slot of the index
+        size_type index_width() const { return width_;}
+
+        /*
+         * Element access
+         */
+
+        // returns the value mapped to key, throws std::out_of_range if key is not found
+        T& at(const Key& key);
+        const T& at(const Key& key) const;
+
+        // returns the value mapped to key, a value-initialized one is appended if key is not found
+        T& operator[](const Key& key) { return this->try_emplace(key).first->second;}
+        T& operator[](Key&& key) { return this->try_emplace(std::move(key)).first->second;}
+
+        /*
+         * Modifiers
+         * a new key is appended after the others, an existing key keeps its position
+         */
+
+        // the elements are destroyed, the memory is kept
+        void clear() noexcept ;
+
+        std::pair<iterator, bool> insert(const value_type& value) { return emplace_key(value.first, value);}
+        std::pair<iterator, bool> insert(value_type&& value) { return emplace_key(value.first, std::move(value));}
+
+        template <class P, class = std::enable_if_t<std::is_constructible_v<value_type, P&&>>>
+        std::pair<iterator, bool> insert(P&& value) { return emplace(std::forward<P>(value));}
+
+        template <class InputIt>
+        void insert(InputIt first, InputIt last) {
+            for(; first != last; ++first)
+                insert(*first);
+        }
+
+        void insert(std::initializer_list<value_type> init) { insert(init.begin(), init.end());}
+
+        // the value is constructed before the key is looked up
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args&&... args) {
+            value_type value(std::forward<Args>(args)...);
+            return emplace_key(value.first, std::move(value));
+        }
+
+        // try_emplace() and insert_or_assign() come from map_modifiers
+
+        // leaves a tombstone, the other elements keep their positions
+        size_type erase(const Key& key);
+        iterator erase(const_iterator pos) noexcept ;
+
+        // removes the tombstones, the elements move down to the front of the entries
+        void compact();
+
+        // room for count entries
+        void reserve(size_type count);
+
+        void swap(compact_dict& other) noexcept ;
+
+        /*
+         * Look-up
+         */
+
+        iterator find(const Key& key) { return find_key(key);}
+        const_iterator find(const Key& key) const { return const_cast<compact_dict*>(this)->find_key(key);}
+
+        size_type count(const Key& key) const { return find(key) == end() ? 0 : 1;}
+
+        bool contains(const Key& key) const { return find(key) != end();}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = sc::utils::transparent_t<H, E>>
+        iterator find(const K& key) { return find_key(key);}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = sc::utils::transparent_t<H, E>>
+        const_iterator find(const K& key) const { return const_cast<compact_dict*>(this)->find_key(key);}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = sc::utils::transparent_t<H, E>>
+        bool contains(const K& key) const { return find(key) != end();}
+
+        /*
+         * Observers
+         */
+
+        hasher hash_function() const { return hash_;}
+
+        key_equal key_eq() const { return equal_;}
+
+    private:
+        // the values of an index slot, an entry at position i is i + FIRST
+        static constexpr size_type EMPTY = 0;
+        static constexpr size_type DELETED = 1;
+        static constexpr size_type FIRST = 2;
+
+        // the slots of the smallest index
+        static constexpr size_type MIN_INDEX = 8;
+
+        static constexpr size_type ALIGNMENT = std::max(alignof(value_type), alignof(size_type));
+
+        // the entries of an index of count slots, which is at most 2/3 full
+        static size_type usable(size_type count) { return count * 2 / 3;}
+
+        // the smallest index which has room for count entries
+        static size_type index_for(size_type count){
+            size_type n = MIN_INDEX;
+            while(usable(n) < count)
+                n *= 2;
+            return n;
+        }
+
+        // the hash stored for key, never DICT_TOMBSTONE
+        template <class K>
+        size_type hash_of(const K& key) const {
+            size_type hash = hash_(key);
+            return hash == sc::utils::DICT_TOMBSTONE ? hash - 1 : hash;
+        }
+
+        size_type slot(size_type i) const {
+            switch(width_){
+                case 1: return reinterpret_cast<const std::uint8_t*>(index_)[i];
+                case 2: return reinterpret_cast<const std::uint16_t*>(index_)[i];
+                case 4: return reinterpret_cast<const std::uint32_t*>(index_)[i];
+                default: return reinterpret_cast<const std::uint64_t*>(index_)[i];
+            }
+        }
+
+        void set_slot(size_type i, size_type value){
+            switch(width_){
+                case 1: reinterpret_cast<std::uint8_t*>(index_)[i] = static_cast<std::uint8_t>(value); break;
+                case 2: reinterpret_cast<std::uint16_t*>(index_)[i] = static_cast<std::uint16_t>(value); break;
+                case 4: reinterpret_cast<std::uint32_t*>(index_)[i] = static_cast<std::uint32_t>(value); break;
+                default: reinterpret_cast<std::uint64_t*>(index_)[i] = value;
+            }
+        }
+
+        // the first slot of the probe of hash
+        size_type home(size_type hash) const { return sc::utils::mix64(hash) & (index_count_ - 1);}
+
+        // returns the slot of key and true, or the slot where key would be inserted and false
+        template <class K>
+        std::pair<size_type, bool> probe(const K& key, size_type hash) const;
+
+        // the slot of the entry at position e
+        size_type slot_of(size_type e) const noexcept ;
+
+        // the first empty or deleted slot of the probe of hash
+        size_type find_free(size_type hash) const noexcept ;
+
+        template <class K>
+        iterator find_key(const K& key);
+
+        // inserts the value constructed by args, if key is not in the dict
+        template <class K, class... Args>
+        std::pair<iterator, bool> emplace_key(const K& key, Args&&... args);
+
+        // appends the value constructed by args with its hash, there must be room for it
+        template <class... Args>
+        void append(size_type hash, Args&&... args);
+
+        iterator make_iterator(size_type e) { return iterator(hashes_ + e, hashes_ + used_, entries_ + e);}
+
+        // replaces the arrays by ones of an index of count slots, without tombstones
+        void rebuild(size_type count);
+
+        // allocates the arrays of an index of count slots, which must be empty
+        void allocate(size_type count);
+        void deallocate() noexcept ;
+
+        void destroy_entries() noexcept ;
+
+        value_type* entries_; // the pairs in insertion order, used_ of them are constructed or erased
+        size_type* hashes_; // the hash of every entry, DICT_TOMBSTONE if it's erased
+        unsigned char* index_; // index_count_ slots of width_ bytes
+        size_type index_count_; // 0, or a power of two
+        size_type width_; // the bytes of a slot
+        size_type capacity_; // the entries which fit in the arrays
+        size_type used_; // the entries appended, tombstones included
+        size_type size_; // the number of elements
+
+        Hash hash_;
+        KeyEqual equal_;
+    };
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    compact_dict<Key, T, Hash, KeyEqual>::compact_dict(size_type count, const Hash &hash, const KeyEqual &equal):
+            entries_(nullptr), hashes_(nullptr), index_(nullptr), index_count_(0), width_(1),
+            capacity_(0), used_(0), size_(0), hash_(hash), equal_(equal)
+    {
+        if(count > 0)
+            allocate(index_for(count));
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    compact_dict<Key, T, Hash, KeyEqual>::compact_dict(const compact_dict &other):
+            compact_dict(size_type(0), other.hash_, other.equal_)
+    {
+        // if throws, the destructor destroys the copied elements
+        if(other.size_ == 0)
+            return;
+        allocate(index_for(other.size_));
+        for(size_type e=0; e<other.used_; ++e){
+            if(other.hashes_[e] != sc::utils::DICT_TOMBSTONE)
+                append(other.hashes_[e], other.entries_[e]);
+        }
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    compact_dict<Key, T, Hash, KeyEqual>::~compact_dict() {
+        destroy_entries();
+        deallocate();
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    T &compact_dict<Key, T, Hash, KeyEqual>::at(const Key &key) {
+        auto iter = find(key);
+        if(iter == end())
+            throw std::out_of_range("compact_dict key not found");
+        return iter->second;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    const T &compact_dict<Key, T, Hash, KeyEqual>::at(const Key &key) const {
+        auto iter = find(key);
+        if(iter == end())
+            throw std::out_of_range("compact_dict key not found");
+        return iter->second;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    void compact_dict<Key, T, Hash, KeyEqual>::clear() noexcept {
+        destroy_entries();
+        if(index_count_ != 0)
+            std::memset(index_, 0, index_count_ * width_);
+        used_ = 0;
+        size_ = 0;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    typename compact_dict<Key, T, Hash, KeyEqual>::size_type compact_dict<Key, T, Hash, KeyEqual>::erase(const Key &key) {
+        auto iter = find(key);
+        if(iter == end())
+            return 0;
+        erase(const_iterator(iter));
+        return 1;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    typename compact_dict<Key, T, Hash, KeyEqual>::iterator
+    compact_dict<Key, T, Hash, KeyEqual>::erase(const_iterator pos) noexcept {
+        auto e = static_cast<size_type>(pos.hash_ - hashes_);
+        // the slot is found by the stored hash, without comparing keys
+        set_slot(slot_of(e), DELETED);
+        std::destroy_at(entries_ + e);
+        hashes_[e] = sc::utils::DICT_TOMBSTONE;
+        --size_;
+        return make_iterator(e);
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    void compact_dict<Key, T, Hash, KeyEqual>::compact() {
+        if(used_ != size_)
+            rebuild(index_count_);
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    void compact_dict<Key, T, Hash, KeyEqual>::reserve(size_type count) {
+        if(count > capacity_)
+            rebuild(index_for(std::max(count, size_)));
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    void compact_dict<Key, T, Hash, KeyEqual>::swap(compact_dict &other) noexcept {
+        std::swap(entries_, other.entries_);
+        std::swap(hashes_, other.hashes_);
+        std::swap(index_, other.index_);
+        std::swap(index_count_, other.index_count_);
+        std::swap(width_, other.width_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(used_, other.used_);
+        std::swap(size_, other.size_);
+        std::swap(hash_, other.hash_);
+        std::swap(equal_, other.equal_);
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    template<class K>
+    std::pair<typename compact_dict<Key, T, Hash, KeyEqual>::size_type, bool>
+    compact_dict<Key, T, Hash, KeyEqual>::probe(const K &key, size_type hash) const {
+        size_type mask = index_count_ - 1;
+        size_type free = index_count_;
+        for(size_type i = home(hash); ; i = (i + 1) & mask){
+            size_type value = slot(i);
+            if(value == EMPTY)
+                return std::pair<size_type, bool>(free != index_count_ ? free : i, false);
+            if(value == DELETED){
+                if(free == index_count_)
+                    free = i;
+                continue;
+            }
+            // the stored hash rejects most of the other keys without comparing them
+            size_type e = value - FIRST;
+            if(hashes_[e] == hash && equal_(entries_[e].first, key))
+                return std::pair<size_type, bool>(i, true);
+        }
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    typename compact_dict<Key, T, Hash, KeyEqual>::size_type
+    compact_dict<Key, T, Hash, KeyEqual>::slot_of(size_type e) const noexcept {
+        size_type mask = index_count_ - 1;
+        size_type i = home(hashes_[e]);
+        while(slot(i) != e + FIRST)
+            i = (i + 1) & mask;
+        return i;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    typename compact_dict<Key, T, Hash, KeyEqual>::size_type
+    compact_dict<Key, T, Hash, KeyEqual>::find_free(size_type hash) const noexcept {
+        size_type mask = index_count_ - 1;
+        size_type i = home(hash);
+        while(slot(i) > DELETED)
+            i = (i + 1) & mask;
+        return i;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    template<class K>
+    typename compact_dict<Key, T, Hash, KeyEqual>::iterator compact_dict<Key, T, Hash, KeyEqual>::find_key(const K &key) {
+        if(size_ == 0)
+            return end();
+        auto [i, found] = probe(key, hash_of(key));
+        return found ? make_iterator(slot(i) - FIRST) : end();
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    template<class K, class... Args>
+    std::pair<typename compact_dict<Key, T, Hash, KeyEqual>::iterator, bool>
+    compact_dict<Key, T, Hash, KeyEqual>::emplace_key(const K &key, Args &&... args) {
+        size_type hash = hash_of(key);
+        if(size_ != 0){
+            auto [i, found] = probe(key, hash);
+            if(found)
+                return std::pair<iterator, bool>(make_iterator(slot(i) - FIRST), false);
+        }
+        // the tombstones are dropped, and there's room for as many elements again
+        if(used_ == capacity_)
+            rebuild(index_for(std::max<size_type>(2 * size_, 1)));
+        append(hash, std::forward<Args>(args)...);
+        return std::pair<iterator, bool>(make_iterator(used_ - 1), true);
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    template<class... Args>
+    void compact_dict<Key, T, Hash, KeyEqual>::append(size_type hash, Args &&... args) {
+        // if throws, nothing is changed
+        ::new(static_cast<void*>(entries_ + used_)) value_type(std::forward<Args>(args)...);
+        hashes_[used_] = hash;
+        set_slot(find_free(hash), used_ + FIRST);
+        ++used_;
+        ++size_;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    void compact_dict<Key, T, Hash, KeyEqual>::rebuild(size_type count) {
+        // if throws, the new dict destroys the elements moved into it, and this one is unchanged
+        // unless a move constructor throws
+        compact_dict fresh(size_type(0), hash_, equal_);
+        fresh.allocate(count);
+        for(size_type e=0; e<used_; ++e){
+            if(hashes_[e] != sc::utils::DICT_TOMBSTONE)
+                fresh.append(hashes_[e], std::move_if_noexcept(entries_[e]));
+        }
+        swap(fresh);
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    void compact_dict<Key, T, Hash, KeyEqual>::allocate(size_type count) {
+        size_type capacity = usable(count);
+        size_type last = capacity + FIRST - 1;
+        size_type width = last <= UINT8_MAX ? 1 : last <= UINT16_MAX ? 2 : last <= UINT32_MAX ? 4 : 8;
+
+        // one allocation holds the entries, the hashes and the index
+        size_type entry_bytes = (capacity * sizeof(value_type) + alignof(size_type) - 1) / alignof(size_type) * alignof(size_type);
+        size_type bytes = entry_bytes + capacity * sizeof(size_type) + count * width;
+        void* memory = ::operator new(bytes, std::align_val_t(ALIGNMENT));
+
+        entries_ = static_cast<value_type*>(memory);
+        hashes_ = reinterpret_cast<size_type*>(static_cast<char*>(memory) + entry_bytes);
+        index_ = reinterpret_cast<unsigned char*>(hashes_ + capacity);
+        std::memset(index_, 0, count * width);
+        index_count_ = count;
+        width_ = width;
+        capacity_ = capacity;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    void compact_dict<Key, T, Hash, KeyEqual>::deallocate() noexcept {
+        if(entries_ != nullptr)
+            ::operator delete(entries_, std::align_val_t(ALIGNMENT));
+        entries_ = nullptr;
+        hashes_ = nullptr;
+        index_ = nullptr;
+        index_count_ = 0;
+        width_ = 1;
+        capacity_ = 0;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    void compact_dict<Key, T, Hash, KeyEqual>::destroy_entries() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<value_type>){
+            for(size_type e=0; e<used_; ++e){
+                if(hashes_[e] != sc::utils::DICT_TOMBSTONE)
+                    std::destroy_at(entries_ + e);
+            }
+        }
+    }
+
+    // the same keys mapped to equal values, in any order
+    template<class Key, class T, class Hash, class KeyEqual>
+    bool operator==(const compact_dict<Key, T, Hash, KeyEqual>& lhs, const compact_dict<Key, T, Hash, KeyEqual>& rhs){
+        if(lhs.size() != rhs.size())
+            return false;
+        for(const auto& kv: lhs){
+            auto iter = rhs.find(kv.first);
+            if(iter == rhs.end() || !(iter->second == kv.second))
+                return false;
+        }
+        return true;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    bool operator!=(const compact_dict<Key, T, Hash, KeyEqual>& lhs, const compact_dict<Key, T, Hash, KeyEqual>& rhs){
+        return !(lhs == rhs);
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    void swap(compact_dict<Key, T, Hash, KeyEqual>& lhs, compact_dict<Key, T, Hash, KeyEqual>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+}
+
+#endif //STLCONTAINER_COMPACT_DICT_HPP
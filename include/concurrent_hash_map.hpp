@@ -0,0 +1,450 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_CONCURRENT_HASH_MAP_HPP
+#define STLCONTAINER_CONCURRENT_HASH_MAP_HPP
+
+/*
+ * Concurrent hash map with lock-free readers and striped writer locks.
+ *
+ * The buckets are chains of nodes, linked by atomic pointers. A reader
+ * pins the epoch domain (epoch.hpp) and walks the chain of its bucket
+ * without a lock, so readers never block and never write a shared cache
+ * line. A published node is never modified except for its link: a new
+ * value replaces the whole node, and a reader sees either the old node
+ * or the new one. An unlinked node is retired to the epoch domain, and it
+ * is deleted after every reader which could still see it has unpinned.
+ *
+ * The writers lock one of STRIPES mutexes, chosen by the low bits of the
+ * hash. The bucket index is the low bits of the hash too, and the bucket
+ * count is a multiple of STRIPES, so the buckets of a stripe are the same
+ * in every table and a writer only needs the lock of its stripe.
+ *
+ * When the table grows, the writer locks every stripe in order, copies the
+ * nodes into a table with twice the buckets and publishes it. The readers
+ * keep reading the old table until they load the new pointer, and the old
+ * table with its nodes is retired. Writers wait for the resize, readers
+ * don't.
+ *
+ * find() returns a copy of the mapped value, because the node may be
+ * deleted once the reader unpins. visit() calls a function on the value
+ * in place.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include "cache_line.hpp"
+#include "epoch.hpp"
+#include "hash.hpp"
+
+namespace sc::lock_free{
+
+    template <class Key, class T, class Hash = sc::utils::hash<Key>, class KeyEqual = std::equal_to<Key>>
+    class concurrent_hash_map{
+
+        struct node{
+            template <class K, class... Args>
+            node(std::size_t hash, K&& key, Args&&... args): next_(nullptr), hash_(hash),
+                value_(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                       std::forward_as_tuple(std::forward<Args>(args)...)){}
+
+            std::atomic<node*> next_;
+            std::size_t hash_; // the mixed hash
+            std::pair<const Key, T> value_;
+        };
+
+        struct table{
+            explicit table(std::size_t count): mask_(count - 1), buckets_(new std::atomic<node*>[count]){
+                for(std::size_t i=0; i<count; ++i)
+                    buckets_[i].store(nullptr, std::memory_order_relaxed);
+            }
+
+            // a table owns the nodes linked in it
+            ~table(){
+                for(std::size_t i=0; i<=mask_; ++i){
+                    node* n = buckets_[i].load(std::memory_order_relaxed);
+                    while(n != nullptr){
+                        node* next = n->next_.load(std::memory_order_relaxed);
+                        delete n;
+                        n = next;
+                    }
+                }
+            }
+
+            std::atomic<node*>& bucket(std::size_t hash) const { return buckets_[hash & mask_];}
+
+            std::size_t count() const { return mask_ + 1;}
+
+            std::size_t mask_; // bucket count - 1
+            std::unique_ptr<std::atomic<node*>[]> buckets_;
+        };
+
+        struct alignas(CACHE_LINE_SIZE) stripe{
+            std::mutex mutex_;
+            std::atomic<std::size_t> size_{0}; // the elements of the stripe, written under mutex_
+        };
+
+    public:
+
+        using key_type = Key;
+
+        using mapped_type = T;
+
+        using value_type = std::pair<const Key, T>;
+
+        using size_type = std::size_t;
+
+        using hasher = Hash;
+
+        using key_equal = KeyEqual;
+
+        // the number of writer locks
+        static constexpr size_type STRIPES = 64;
+
+        // the bucket count is rounded up to a power of two, at least STRIPES
+        explicit concurrent_hash_map(size_type bucket_count = 0, const Hash& hash = Hash(),
+                                     const key_equal& equal = key_equal());
+
+        // the map is shared by several threads, it can not be copied or moved
+        concurrent_hash_map(const concurrent_hash_map&) = delete;
+        concurrent_hash_map&operator=(const concurrent_hash_map&) = delete;
+
+        // no other thread may use the map
+        ~concurrent_hash_map(){ delete table_.load(std::memory_order_relaxed);}
+
+        /*
+         * Readers, lock-free
+         */
+
+        // returns a copy of the mapped value of key, nullopt if it's not found
+        std::optional<T> find(const Key& key) const;
+
+        bool contains(const Key& key) const;
+
+        // calls f(const T&) on the mapped value of key, returns false if it's not found.
+        // the value may be replaced by a writer meanwhile, f sees the old one
+        template <class F>
+        bool visit(const Key& key, F f) const;
+
+        // exact if no writer runs at the same time
+        size_type size() const;
+
+        bool empty() const { return size() == 0;}
+
+        size_type bucket_count() const { return table_.load(std::memory_order_acquire)->count();}
+
+        /*
+         * Writers, lock the stripe of the key
+         */
+
+        // inserts the value constructed by args if key is not in the map, returns whether it's inserted
+        template <class... Args>
+        bool emplace(const Key& key, Args&&... args);
+
+        bool insert(const Key& key, const T& value) { return emplace(key, value);}
+        bool insert(const Key& key, T&& value) { return emplace(key, std::move(value));}
+
+        // inserts value, or replaces the mapped value of key. returns true if it's inserted
+        template <class M>
+        bool insert_or_assign(const Key& key, M&& value);
+
+        size_type erase(const Key& key);
+
+        // returns the mapped value of key. if key is not found, inserts f(key) and returns it.
+        // f is called at most once, with the lock of the stripe held, it must not use the map
+        template <class F>
+        T compute_if_absent(const Key& key, F f);
+
+        // locks every stripe
+        void clear();
+
+        // grows the table for count elements
+        void reserve(size_type count);
+
+        /*
+         * Observers
+         */
+
+        hasher hash_function() const { return hash_;}
+
+        key_equal key_eq() const { return equal_;}
+
+    private:
+        // the maximum load factor is 1
+        static size_type buckets_for(size_type count);
+
+        // a user-supplied std::hash of an integer is the identity, spread its bits over the stripes and the buckets
+        size_type hash_of(const Key& key) const;
+
+        stripe& stripe_of(size_type hash) const { return stripes_[hash & (STRIPES - 1)];}
+
+        // returns the link which points to the node of key, or the last link of the chain
+        std::atomic<node*>* find_link(std::atomic<node*>& bucket, const Key& key, size_type hash) const;
+
+        // publishes n at the front of its bucket, n is complete before it's reachable
+        void link_node(table* t, stripe& s, node* n);
+
+        // whether the insertion into the stripe s should grow the table first
+        bool overloaded(const stripe& s, const table* t) const;
+
+        // replaces t by a table with count buckets, unless another writer already replaced it
+        void grow(const table* t, size_type count);
+
+        // locks every stripe in order
+        class lock_all{
+        public:
+            explicit lock_all(const concurrent_hash_map& map): map_(map){
+                for(auto& s: map_.stripes_)
+                    s.mutex_.lock();
+            }
+            ~lock_all(){
+                for(auto& s: map_.stripes_)
+                    s.mutex_.unlock();
+            }
+        private:
+            const concurrent_hash_map& map_;
+        };
+
+        std::atomic<table*> table_;
+        mutable stripe stripes_[STRIPES];
+
+        Hash hash_;
+        KeyEqual equal_;
+    };
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    concurrent_hash_map<Key, T, Hash, KeyEqual>::concurrent_hash_map(size_type bucket_count, const Hash &hash,
+                                                                    const key_equal &equal):
+            table_(new table(buckets_for(bucket_count))), hash_(hash), equal_(equal){}
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    std::optional<T> concurrent_hash_map<Key, T, Hash, KeyEqual>::find(const Key &key) const {
+        std::optional<T> result;
+        visit(key, [&result](const T& value){ result.emplace(value);});
+        return result;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    bool concurrent_hash_map<Key, T, Hash, KeyEqual>::contains(const Key &key) const {
+        return visit(key, [](const T&){});
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    template<class F>
+    bool concurrent_hash_map<Key, T, Hash, KeyEqual>::visit(const Key &key, F f) const {
+        size_type hash = hash_of(key);
+        auto guard = sc::utils::epoch_domain::instance().pin();
+        const table* t = table_.load(std::memory_order_acquire);
+        for(node* n = t->bucket(hash).load(std::memory_order_acquire); n != nullptr;
+            n = n->next_.load(std::memory_order_acquire)){
+            if(n->hash_ == hash && equal_(n->value_.first, key)){
+                f(static_cast<const T&>(n->value_.second));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    typename concurrent_hash_map<Key, T, Hash, KeyEqual>::size_type
+    concurrent_hash_map<Key, T, Hash, KeyEqual>::size() const {
+        size_type size = 0;
+        for(auto& s: stripes_)
+            size += s.size_.load(std::memory_order_relaxed);
+        return size;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    template<class... Args>
+    bool concurrent_hash_map<Key, T, Hash, KeyEqual>::emplace(const Key &key, Args &&... args) {
+        size_type hash = hash_of(key);
+        stripe& s = stripe_of(hash);
+        std::unique_lock<std::mutex> lock(s.mutex_);
+        for(;;){
+            // the table is not replaced while the lock of the stripe is held
+            table* t = table_.load(std::memory_order_relaxed);
+            std::atomic<node*>* link = find_link(t->bucket(hash), key, hash);
+            if(link->load(std::memory_order_relaxed) != nullptr)
+                return false;
+            if(overloaded(s, t)){
+                // grow without the lock, then look up again in the new table
+                lock.unlock();
+                grow(t, t->count() * 2);
+                lock.lock();
+                continue;
+            }
+            link_node(t, s, new node(hash, key, std::forward<Args>(args)...));
+            return true;
+        }
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    template<class M>
+    bool concurrent_hash_map<Key, T, Hash, KeyEqual>::insert_or_assign(const Key &key, M &&value) {
+        size_type hash = hash_of(key);
+        stripe& s = stripe_of(hash);
+        std::unique_lock<std::mutex> lock(s.mutex_);
+        for(;;){
+            table* t = table_.load(std::memory_order_relaxed);
+            std::atomic<node*>* link = find_link(t->bucket(hash), key, hash);
+            node* old = link->load(std::memory_order_relaxed);
+            if(old != nullptr){
+                // the readers of the old node still see the old value
+                node* n = new node(hash, old->value_.first, std::forward<M>(value));
+                n->next_.store(old->next_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                link->store(n, std::memory_order_release);
+                sc::utils::epoch_domain::instance().retire(old);
+                return false;
+            }
+            if(overloaded(s, t)){
+                lock.unlock();
+                grow(t, t->count() * 2);
+                lock.lock();
+                continue;
+            }
+            link_node(t, s, new node(hash, key, std::forward<M>(value)));
+            return true;
+        }
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    typename concurrent_hash_map<Key, T, Hash, KeyEqual>::size_type
+    concurrent_hash_map<Key, T, Hash, KeyEqual>::erase(const Key &key) {
+        size_type hash = hash_of(key);
+        stripe& s = stripe_of(hash);
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        table* t = table_.load(std::memory_order_relaxed);
+        std::atomic<node*>* link = find_link(t->bucket(hash), key, hash);
+        node* n = link->load(std::memory_order_relaxed);
+        if(n == nullptr)
+            return 0;
+        // a reader at n still follows its link to the rest of the chain
+        link->store(n->next_.load(std::memory_order_relaxed), std::memory_order_release);
+        s.size_.store(s.size_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        sc::utils::epoch_domain::instance().retire(n);
+        return 1;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    template<class F>
+    T concurrent_hash_map<Key, T, Hash, KeyEqual>::compute_if_absent(const Key &key, F f) {
+        size_type hash = hash_of(key);
+        stripe& s = stripe_of(hash);
+        std::unique_lock<std::mutex> lock(s.mutex_);
+        for(;;){
+            table* t = table_.load(std::memory_order_relaxed);
+            std::atomic<node*>* link = find_link(t->bucket(hash), key, hash);
+            node* found = link->load(std::memory_order_relaxed);
+            if(found != nullptr)
+                return found->value_.second;
+            if(overloaded(s, t)){
+                lock.unlock();
+                grow(t, t->count() * 2);
+                lock.lock();
+                continue;
+            }
+            node* n = new node(hash, key, f(key));
+            link_node(t, s, n);
+            return n->value_.second;
+        }
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    void concurrent_hash_map<Key, T, Hash, KeyEqual>::clear() {
+        auto empty = new table(STRIPES);
+        lock_all lock(*this);
+        table* t = table_.exchange(empty, std::memory_order_acq_rel);
+        for(auto& s: stripes_)
+            s.size_.store(0, std::memory_order_relaxed);
+        sc::utils::epoch_domain::instance().retire(t);
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    void concurrent_hash_map<Key, T, Hash, KeyEqual>::reserve(size_type count) {
+        const table* t = table_.load(std::memory_order_acquire);
+        size_type buckets = buckets_for(count);
+        if(buckets > t->count())
+            grow(t, buckets);
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    typename concurrent_hash_map<Key, T, Hash, KeyEqual>::size_type
+    concurrent_hash_map<Key, T, Hash, KeyEqual>::buckets_for(size_type count) {
+        size_type n = STRIPES;
+        while(n < count)
+            n <<= 1;
+        return n;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    typename concurrent_hash_map<Key, T, Hash, KeyEqual>::size_type
+    concurrent_hash_map<Key, T, Hash, KeyEqual>::hash_of(const Key &key) const {
+        std::uint64_t hash = hash_(key);
+        hash ^= hash >> 32;
+        hash *= 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+        return static_cast<size_type>(hash);
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    std::atomic<typename concurrent_hash_map<Key, T, Hash, KeyEqual>::node *> *
+    concurrent_hash_map<Key, T, Hash, KeyEqual>::find_link(std::atomic<node *> &bucket, const Key &key,
+                                                            size_type hash) const {
+        // the chain only changes under the lock of the stripe, which is held
+        std::atomic<node*>* link = &bucket;
+        for(node* n = link->load(std::memory_order_relaxed); n != nullptr; n = link->load(std::memory_order_relaxed)){
+            if(n->hash_ == hash && equal_(n->value_.first, key))
+                break;
+            link = &n->next_;
+        }
+        return link;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    void concurrent_hash_map<Key, T, Hash, KeyEqual>::link_node(table *t, stripe &s, node *n) {
+        std::atomic<node*>& bucket = t->bucket(n->hash_);
+        n->next_.store(bucket.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        bucket.store(n, std::memory_order_release);
+        s.size_.store(s.size_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    bool concurrent_hash_map<Key, T, Hash, KeyEqual>::overloaded(const stripe &s, const table *t) const {
+        // a stripe holds count / STRIPES buckets. only if the stripe is full, the
+        // other stripes are counted, so the common insertion reads no other cache line
+        size_type share = t->count() / STRIPES;
+        return s.size_.load(std::memory_order_relaxed) + 1 > share && size() + 1 > t->count();
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    void concurrent_hash_map<Key, T, Hash, KeyEqual>::grow(const table *t, size_type count) {
+        lock_all lock(*this);
+        table* old = table_.load(std::memory_order_relaxed);
+        if(old != t || count <= old->count())
+            return;
+
+        // the new table is published complete, if a copy throws the old table is kept
+        auto bigger = std::make_unique<table>(count);
+        for(size_type b=0; b<old->count(); ++b){
+            for(node* n = old->buckets_[b].load(std::memory_order_relaxed); n != nullptr;
+                n = n->next_.load(std::memory_order_relaxed)){
+                node* copy = new node(n->hash_, n->value_.first, n->value_.second);
+                std::atomic<node*>& bucket = bigger->bucket(n->hash_);
+                copy->next_.store(bucket.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                bucket.store(copy, std::memory_order_relaxed);
+            }
+        }
+        table_.store(bigger.release(), std::memory_order_release);
+        sc::utils::epoch_domain::instance().retire(old);
+    }
+
+}
+
+#endif //STLCONTAINER_CONCURRENT_HASH_MAP_HPP
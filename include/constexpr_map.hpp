@@ -0,0 +1,328 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_CONSTEXPR_MAP_HPP
+#define STLCONTAINER_CONSTEXPR_MAP_HPP
+
+/*
+ * Immutable map whose perfect hash is built at compile time.
+ *
+ * The N keys are known when the program is compiled, e.g. the keywords of
+ * a protocol or the names of an enum. constexpr_map places them by the
+ * same hash-and-displace (CHD) scheme as perfect_hash.hpp, but in a
+ * constant expression: the keys are split into about N / 2 buckets by
+ * their hash, every bucket gets a displacement which sends all of its keys
+ * to free slots, and the entries are stored in the order of their slots.
+ * The map is an array of N entries and an array of displacements, in the
+ * data segment if the map is constexpr, and it never allocates.
+ *
+ * A lookup hashes the key once, reads one displacement, computes the slot
+ * and compares the key of the entry in it. A key which is not in the map
+ * maps to the slot of some other key, the comparison rejects it.
+ *
+ * Hash and KeyEqual follow the conventions of unordered_map: Hash returns
+ * a std::size_t and KeyEqual compares two keys, and if both define
+ * is_transparent, find() takes any key type they accept. They must be
+ * usable in a constant expression, which std::hash is not, so the default
+ * is constexpr_hash: a multiplicative hash of 8 characters at a time for a
+ * string_view, and the value of an integer or an enum. The map mixes the
+ * hash anyway.
+ *
+ * Two equal keys, or two keys with the same hash, can't be placed, and the
+ * construction is then not a constant expression, so a constexpr map of
+ * such keys doesn't compile.
+ *
+ * references: Belazzougui, D., Botelho, F. C., Dietzfelbinger, M. Hash, displace, and compress. 2009.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "key_of_value.hpp"
+#include "perfect_hash.hpp"
+
+namespace sc::utils{
+
+    // a hash which is evaluated at compile time, for the keys of constexpr_map
+    template <class Key, class = void>
+    struct constexpr_hash;
+
+    template <class Key>
+    struct constexpr_hash<Key, std::enable_if_t<std::is_integral_v<Key> || std::is_enum_v<Key>>>{
+        constexpr std::size_t operator()(Key key) const noexcept { return static_cast<std::size_t>(key);}
+    };
+
+    // 8 bytes per multiplication, the bytes are gathered by shifts since memcpy is not
+    // constexpr, and the compiler turns the shifts into one load
+    template <>
+    struct constexpr_hash<std::string_view>{
+        constexpr std::size_t operator()(std::string_view s) const noexcept {
+            std::uint64_t h = 0x9E3779B97F4A7C15ull ^ s.size();
+            std::size_t i = 0;
+            for(; i + 8 <= s.size(); i += 8)
+                h = (h ^ load(s, i, 8)) * 0xFF51AFD7ED558CCDull;
+            if(i < s.size())
+                h = (h ^ load(s, i, s.size() - i)) * 0xFF51AFD7ED558CCDull;
+            return static_cast<std::size_t>(h ^ (h >> 32));
+        }
+
+    private:
+        // n bytes of s from i, little-endian
+        static constexpr std::uint64_t load(std::string_view s, std::size_t i, std::size_t n){
+            std::uint64_t k = 0;
+            for(std::size_t j=0; j<n; ++j)
+                k |= static_cast<std::uint64_t>(static_cast<unsigned char>(s[i + j])) << (8 * j);
+            return k;
+        }
+    };
+
+}
+
+namespace sc::regular{
+
+    template <class Key, class T, std::size_t N,
+              class Hash = sc::utils::constexpr_hash<Key>, class KeyEqual = std::equal_to<Key>>
+    class constexpr_map{
+    public:
+
+        using key_type = Key;
+
+        using mapped_type = T;
+
+        using value_type = std::pair<Key, T>;
+
+        using size_type = std::size_t;
+
+        using hasher = Hash;
+
+        using key_equal = KeyEqual;
+
+        using const_reference = const value_type&;
+
+        using const_iterator = const value_type*;
+
+        using iterator = const_iterator;
+
+        // a displacement which is the slot of the only key of its bucket
+        static constexpr std::uint32_t DIRECT = std::uint32_t(1) << 31;
+
+        // the average keys per bucket
+        static constexpr size_type BUCKET_LOAD = 2;
+
+        static constexpr size_type BUCKETS = N < BUCKET_LOAD ? 1 : N / BUCKET_LOAD;
+
+        // the displacements tried for a bucket before the construction fails
+        static constexpr std::uint32_t MAX_DISPLACEMENT = std::uint32_t(1) << 16;
+
+        static_assert(N < DIRECT, "constexpr_map: too many keys");
+
+        // init is an array or a std::array of N key/value pairs
+        template <class Init>
+        constexpr explicit constexpr_map(const Init& init, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual()):
+                constexpr_map(init, place(init, hash, equal), hash, equal, std::make_index_sequence<N>()){}
+
+        /*
+         * Iterators, the entries in the order of their slots
+         */
+
+        constexpr const_iterator begin() const noexcept { return entries_.data();}
+        constexpr const_iterator cbegin() const noexcept { return begin();}
+
+        constexpr const_iterator end() const noexcept { return entries_.data() + N;}
+        constexpr const_iterator cend() const noexcept { return end();}
+
+        /*
+         * Capacity
+         */
+
+        constexpr bool empty() const noexcept { return N == 0;}
+
+        constexpr size_type size() const noexcept { return N;}
+
+        constexpr size_type max_size() const noexcept { return N;}
+
+        /*
+         * Look-up
+         */
+
+        constexpr const_iterator find(const Key& key) const { return find_key(key);}
+
+        constexpr size_type count(const Key& key) const { return find(key) == end() ? 0 : 1;}
+
+        constexpr bool contains(const Key& key) const { return find(key) != end();}
+
+        // throws std::out_of_range if key is not in the map
+        constexpr const T& at(const Key& key) const {
+            const_iterator iter = find(key);
+            if(iter == end())
+                throw std::out_of_range("constexpr_map: key not found");
+            return iter->second;
+        }
+
+        // the overloads for any key type K are enabled if Hash and KeyEqual are transparent
+
+        template <class K, class H = Hash, class E = KeyEqual, class = sc::utils::transparent_t<H, E>>
+        constexpr const_iterator find(const K& key) const { return find_key(key);}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = sc::utils::transparent_t<H, E>>
+        constexpr size_type count(const K& key) const { return find_key(key) == end() ? 0 : 1;}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = sc::utils::transparent_t<H, E>>
+        constexpr bool contains(const K& key) const { return find_key(key) != end();}
+
+        /*
+         * Observers
+         */
+
+        constexpr hasher hash_function() const { return hash_;}
+
+        constexpr key_equal key_eq() const { return equal_;}
+
+    private:
+        // the displacement of every bucket, and the key of every slot
+        struct placement{
+            std::array<std::uint32_t, BUCKETS> displacements_{};
+            std::array<size_type, N> order_{}; // order_[s] is the index in init of the key of slot s
+        };
+
+        template <class Init, size_type... I>
+        constexpr constexpr_map(const Init& init, const placement& p, const Hash& hash, const KeyEqual& equal,
+                                std::index_sequence<I...>):
+                hash_(hash), equal_(equal), displacements_(p.displacements_),
+                entries_{{value_type(init[p.order_[I]])...}}{}
+
+        // the bucket of a mixed hash, from its high 32 bits
+        static constexpr size_type bucket_of(std::uint64_t h){
+            return static_cast<size_type>(((h >> 32) * BUCKETS) >> 32);
+        }
+
+        // the slot of a mixed hash displaced by d
+        static constexpr size_type slot_of(std::uint64_t h, std::uint32_t d){
+            // one multiplication, h is mixed already
+            std::uint64_t x = (h ^ (d * 0x9E3779B97F4A7C15ull)) * 0xD6E8FEB86659FD93ull;
+            return static_cast<size_type>(((x >> 32) * N) >> 32);
+        }
+
+        template <class K>
+        constexpr const_iterator find_key(const K& key) const {
+            if constexpr (N == 0){
+                return end();
+            } else{
+                std::uint64_t h = sc::utils::mix64(hash_(key));
+                std::uint32_t d = displacements_[bucket_of(h)];
+                size_type s = (d & DIRECT) ? (d & ~DIRECT) : slot_of(h, d);
+                return equal_(entries_[s].first, key) ? &entries_[s] : end();
+            }
+        }
+
+        // places the keys of init, the largest bucket first. throws if two keys are
+        // equal or have the same hash, or a bucket can't be placed
+        template <class Init>
+        static constexpr placement place(const Init& init, const Hash& hash, const KeyEqual& equal);
+
+        Hash hash_;
+        KeyEqual equal_;
+        std::array<std::uint32_t, BUCKETS> displacements_;
+        std::array<value_type, N> entries_; // the entries in the order of their slots
+    };
+
+    template <class Key, class T, std::size_t N, class Hash, class KeyEqual>
+    template <class Init>
+    constexpr typename constexpr_map<Key, T, N, Hash, KeyEqual>::placement
+    constexpr_map<Key, T, N, Hash, KeyEqual>::place(const Init &init, const Hash &hash, const KeyEqual &equal) {
+        placement p;
+        std::array<std::uint64_t, N> hashes{};
+        for(size_type i=0; i<N; ++i)
+            hashes[i] = sc::utils::mix64(hash(init[i].first));
+
+        // the keys grouped by bucket, by a counting sort
+        std::array<size_type, BUCKETS + 1> start{};
+        for(size_type i=0; i<N; ++i)
+            ++start[bucket_of(hashes[i]) + 1];
+        size_type largest = 0;
+        for(size_type b=0; b<BUCKETS; ++b){
+            largest = start[b + 1] > largest ? start[b + 1] : largest;
+            start[b + 1] += start[b];
+        }
+        std::array<size_type, N> keys{};
+        std::array<size_type, BUCKETS> filled{};
+        for(size_type i=0; i<N; ++i){
+            size_type b = bucket_of(hashes[i]);
+            keys[start[b] + filled[b]++] = i;
+        }
+
+        // the keys of one hash are in one bucket
+        for(size_type b=0; b<BUCKETS; ++b){
+            for(size_type i = start[b]; i < start[b + 1]; ++i){
+                for(size_type j = start[b]; j < i; ++j){
+                    if(hashes[keys[i]] != hashes[keys[j]])
+                        continue;
+                    if(equal(init[keys[i]].first, init[keys[j]].first))
+                        throw std::invalid_argument("constexpr_map: duplicate key");
+                    throw std::invalid_argument("constexpr_map: two keys have the same hash");
+                }
+            }
+        }
+
+        std::array<bool, N> used{};
+        size_type next = 0; // the free slots before next are used by the buckets of one key
+        for(size_type size = largest; size > 0; --size){
+            for(size_type b=0; b<BUCKETS; ++b){
+                if(start[b + 1] - start[b] != size)
+                    continue;
+                if(size == 1){
+                    while(used[next])
+                        ++next;
+                    used[next] = true;
+                    p.order_[next] = keys[start[b]];
+                    p.displacements_[b] = DIRECT | static_cast<std::uint32_t>(next);
+                    continue;
+                }
+                std::uint32_t d = 1;
+                for(; d < MAX_DISPLACEMENT; ++d){
+                    bool free = true;
+                    for(size_type i = start[b]; i < start[b + 1] && free; ++i){
+                        size_type s = slot_of(hashes[keys[i]], d);
+                        free = !used[s];
+                        for(size_type j = start[b]; j < i && free; ++j)
+                            free = slot_of(hashes[keys[j]], d) != s;
+                    }
+                    if(free)
+                        break;
+                }
+                if(d == MAX_DISPLACEMENT)
+                    throw std::runtime_error("constexpr_map: a bucket can't be placed");
+                for(size_type i = start[b]; i < start[b + 1]; ++i){
+                    size_type s = slot_of(hashes[keys[i]], d);
+                    used[s] = true;
+                    p.order_[s] = keys[i];
+                }
+                p.displacements_[b] = d;
+            }
+        }
+        return p;
+    }
+
+    // deduces N from the number of pairs, e.g.
+    // constexpr auto m = make_constexpr_map<std::string_view, int>({{"GET", 1}, {"PUT", 2}});
+    template <class Key, class T, class Hash = sc::utils::constexpr_hash<Key>, class KeyEqual = std::equal_to<Key>, std::size_t N>
+    constexpr constexpr_map<Key, T, N, Hash, KeyEqual> make_constexpr_map(const std::pair<Key, T> (&init)[N],
+            const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual()){
+        return constexpr_map<Key, T, N, Hash, KeyEqual>(init, hash, equal);
+    }
+
+    template <class Key, class T, std::size_t N, class Hash = sc::utils::constexpr_hash<Key>, class KeyEqual = std::equal_to<Key>>
+    constexpr constexpr_map<Key, T, N, Hash, KeyEqual> make_constexpr_map(const std::array<std::pair<Key, T>, N>& init,
+            const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual()){
+        return constexpr_map<Key, T, N, Hash, KeyEqual>(init, hash, equal);
+    }
+
+}
+
+#endif //STLCONTAINER_CONSTEXPR_MAP_HPP
@@ -0,0 +1,306 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_CUCKOO_FILTER_HPP
+#define STLCONTAINER_CUCKOO_FILTER_HPP
+
+/*
+ * Cuckoo filter.
+ *
+ * Like a Bloom filter, it answers whether a key may have been inserted,
+ * but a key can also be erased. The filter stores a 16-bit fingerprint of
+ * every key in a cuckoo hash table of buckets of 4 slots. A fingerprint
+ * may be in two buckets: i1, chosen by the hash, and i2 = (hash(f) - i1)
+ * mod the bucket count, which is computed from either bucket and the
+ * fingerprint alone, so a fingerprint is moved without knowing its key.
+ * Unlike the XOR of the paper, this works for any bucket count, so the
+ * buckets are not rounded up to a power of two. An insertion which finds
+ * both buckets full kicks a random fingerprint out to its other bucket,
+ * up to MAX_KICKS times.
+ *
+ * A lookup reads two buckets of 8 bytes. A key which was not inserted is
+ * reported if one of the 8 fingerprints of its buckets matches, about
+ * 8 / 65535 = 0.012%. The table is filled to 95% at most, so a key takes
+ * about 17 bits, less than a Bloom filter of the same false-positive rate.
+ *
+ * erase() must only be called with a key which was inserted, otherwise it
+ * may remove the fingerprint of another key, which is then not reported.
+ * A key inserted twice is stored twice and must be erased twice. When an
+ * insertion fails, the last fingerprint kicked out is kept aside and the
+ * filter is full: it still reports every inserted key, but every following
+ * insertion fails.
+ *
+ * references: Fan, B., Andersen, D. G., Kaminsky, M., Mitzenmacher, M. D. Cuckoo filter: practically better than bloom. 2014.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "hash.hpp"
+#include "perfect_hash.hpp"
+
+namespace sc::regular{
+
+    template <class Key, class Hash = sc::utils::hash<Key>>
+    class cuckoo_filter{
+    public:
+
+        using key_type = Key;
+
+        using size_type = std::size_t;
+
+        using hasher = Hash;
+
+        using fingerprint_type = std::uint16_t;
+
+        // the slots of a bucket
+        static constexpr size_type SLOTS = 4;
+
+        // the fingerprints moved by an insertion before the filter is full
+        static constexpr size_type MAX_KICKS = 500;
+
+        // the load the buckets are sized for
+        static constexpr double MAX_LOAD = 0.95;
+
+        // an empty filter, every insertion fails until it's resized
+        cuckoo_filter(): count_(0), size_(0), victim_(0), victim_bucket_(0), seed_(0){}
+
+        // enough buckets for capacity keys at MAX_LOAD
+        explicit cuckoo_filter(size_type capacity, const Hash& hash = Hash());
+
+        cuckoo_filter(const cuckoo_filter& other);
+        cuckoo_filter(cuckoo_filter&& other) noexcept : cuckoo_filter() { swap(other);}
+
+        // use copy-and-swap idiom
+        cuckoo_filter&operator=(cuckoo_filter other) noexcept { swap(other); return *this;}
+
+        /*
+         * Modifiers
+         */
+
+        // returns false if the filter is full, the key is reported anyway
+        bool insert(const Key& key) noexcept { return insert_hash(hash_(key));}
+
+        bool insert_hash(std::size_t hash) noexcept ;
+
+        // removes one fingerprint of key, returns false if none is found.
+        // key must have been inserted
+        bool erase(const Key& key) noexcept { return erase_hash(hash_(key));}
+
+        bool erase_hash(std::size_t hash) noexcept ;
+
+        void clear() noexcept ;
+
+        void swap(cuckoo_filter& other) noexcept ;
+
+        /*
+         * Look-up
+         */
+
+        // false if key was never inserted, or erased as often as it was inserted
+        bool contains(const Key& key) const noexcept { return contains_hash(hash_(key));}
+
+        bool contains_hash(std::size_t hash) const noexcept ;
+
+        /*
+         * Capacity
+         */
+
+        // the fingerprints stored, the one kept aside included
+        size_type size() const { return size_;}
+
+        bool empty() const { return size_ == 0;}
+
+        // whether an insertion failed, no key is inserted until it's cleared
+        bool full() const { return victim_ != 0;}
+
+        size_type bucket_count() const { return count_;}
+
+        double load_factor() const { return bucket_count() == 0 ? 0 : static_cast<double>(size_) / (bucket_count() * SLOTS);}
+
+        size_type memory() const { return bucket_count() * sizeof(bucket);}
+
+        double bits_per_key() const { return size_ == 0 ? 0 : 8.0 * memory() / size_;}
+
+        // the probability that a key which was not inserted is reported: the
+        // occupied slots of its two buckets, each matching one fingerprint in 65535
+        double false_positive_rate() const {
+            return 2 * SLOTS * load_factor() / 65535.0;
+        }
+
+        hasher hash_function() const { return hash_;}
+
+    private:
+        struct bucket{
+            fingerprint_type slots_[SLOTS];
+        };
+
+        // the fingerprint and the first bucket of a hash
+        std::pair<fingerprint_type, size_type> locate(std::size_t hash) const {
+            std::uint64_t h = sc::utils::mix64(hash);
+            // 0 marks an empty slot
+            auto f = static_cast<fingerprint_type>(h >> 48);
+            if(f == 0)
+                f = 1;
+            return {f, reduce(h)};
+        }
+
+        // the other bucket of fingerprint f, from either of its buckets
+        size_type alternate(size_type b, fingerprint_type f) const {
+            size_type a = reduce(sc::utils::mix64(f)) + count_ - b;
+            return a >= count_ ? a - count_ : a;
+        }
+
+        // maps the low 32 bits of a mixed hash to a bucket, by multiplying instead of dividing
+        size_type reduce(std::uint64_t h) const {
+            return static_cast<size_type>((static_cast<std::uint32_t>(h) * static_cast<std::uint64_t>(count_)) >> 32);
+        }
+
+        bool add(size_type b, fingerprint_type f) noexcept ;
+
+        static bool has(const bucket& b, fingerprint_type f) noexcept {
+            // no early exit, the 4 tests are one 64-bit comparison after vectorizing
+            bool found = false;
+            for(size_type i=0; i<SLOTS; ++i)
+                found |= b.slots_[i] == f;
+            return found;
+        }
+
+        std::unique_ptr<bucket[]> buckets_;
+        size_type count_; // the number of buckets, below 2^32
+        size_type size_; // the fingerprints stored
+        fingerprint_type victim_; // the fingerprint kept aside by a failed insertion, 0 if none
+        size_type victim_bucket_; // one of the buckets of victim_
+        std::uint64_t seed_; // picks the slots kicked out
+        Hash hash_;
+    };
+
+    template <class Key, class Hash>
+    cuckoo_filter<Key, Hash>::cuckoo_filter(size_type capacity, const Hash &hash):
+            count_(0), size_(0), victim_(0), victim_bucket_(0), seed_(0), hash_(hash) {
+        auto count = static_cast<size_type>(static_cast<double>(capacity) / (SLOTS * MAX_LOAD)) + 1;
+        if(count > UINT32_MAX)
+            throw std::length_error("cuckoo_filter: too many keys");
+        buckets_.reset(new bucket[count]());
+        count_ = count;
+    }
+
+    template <class Key, class Hash>
+    cuckoo_filter<Key, Hash>::cuckoo_filter(const cuckoo_filter &other):
+            count_(other.count_), size_(other.size_), victim_(other.victim_),
+            victim_bucket_(other.victim_bucket_), seed_(other.seed_), hash_(other.hash_) {
+        if(other.buckets_){
+            buckets_.reset(new bucket[count_]);
+            std::copy(other.buckets_.get(), other.buckets_.get() + count_, buckets_.get());
+        }
+    }
+
+    template <class Key, class Hash>
+    bool cuckoo_filter<Key, Hash>::insert_hash(std::size_t hash) noexcept {
+        if(!buckets_ || full())
+            return false;
+        auto [f, i1] = locate(hash);
+        size_type i2 = alternate(i1, f);
+        if(add(i1, f) || add(i2, f)){
+            ++size_;
+            return true;
+        }
+        // kick a fingerprint out of a random slot of either bucket to its other bucket
+        size_type b = (seed_ & 1) ? i1 : i2;
+        for(size_type kick=0; kick<MAX_KICKS; ++kick){
+            seed_ = sc::utils::mix64(seed_ + 0x9E3779B97F4A7C15ull);
+            std::swap(f, buckets_[b].slots_[seed_ % SLOTS]);
+            b = alternate(b, f);
+            if(add(b, f)){
+                ++size_;
+                return true;
+            }
+        }
+        // f is still reported through victim_
+        victim_ = f;
+        victim_bucket_ = b;
+        ++size_;
+        return false;
+    }
+
+    template <class Key, class Hash>
+    bool cuckoo_filter<Key, Hash>::erase_hash(std::size_t hash) noexcept {
+        if(!buckets_)
+            return false;
+        auto [f, i1] = locate(hash);
+        size_type i2 = alternate(i1, f);
+        for(size_type b: {i1, i2}){
+            for(fingerprint_type& slot: buckets_[b].slots_){
+                if(slot == f){
+                    slot = 0;
+                    --size_;
+                    // the victim takes the free slot if it can
+                    if(full() && add(victim_bucket_, victim_))
+                        victim_ = 0;
+                    else if(full() && add(alternate(victim_bucket_, victim_), victim_))
+                        victim_ = 0;
+                    return true;
+                }
+            }
+        }
+        if(victim_ == f && (victim_bucket_ == i1 || victim_bucket_ == i2)){
+            victim_ = 0;
+            --size_;
+            return true;
+        }
+        return false;
+    }
+
+    template <class Key, class Hash>
+    bool cuckoo_filter<Key, Hash>::contains_hash(std::size_t hash) const noexcept {
+        if(!buckets_)
+            return false;
+        auto [f, i1] = locate(hash);
+        size_type i2 = alternate(i1, f);
+        return has(buckets_[i1], f) || has(buckets_[i2], f) ||
+               (victim_ == f && (victim_bucket_ == i1 || victim_bucket_ == i2));
+    }
+
+    template <class Key, class Hash>
+    void cuckoo_filter<Key, Hash>::clear() noexcept {
+        if(buckets_)
+            std::fill(buckets_.get(), buckets_.get() + count_, bucket{});
+        size_ = 0;
+        victim_ = 0;
+    }
+
+    template <class Key, class Hash>
+    void cuckoo_filter<Key, Hash>::swap(cuckoo_filter &other) noexcept {
+        std::swap(buckets_, other.buckets_);
+        std::swap(count_, other.count_);
+        std::swap(size_, other.size_);
+        std::swap(victim_, other.victim_);
+        std::swap(victim_bucket_, other.victim_bucket_);
+        std::swap(seed_, other.seed_);
+        std::swap(hash_, other.hash_);
+    }
+
+    template <class Key, class Hash>
+    bool cuckoo_filter<Key, Hash>::add(size_type b, fingerprint_type f) noexcept {
+        for(fingerprint_type& slot: buckets_[b].slots_){
+            if(slot == 0){
+                slot = f;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <class Key, class Hash>
+    void swap(cuckoo_filter<Key, Hash>& lhs, cuckoo_filter<Key, Hash>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+}
+
+#endif //STLCONTAINER_CUCKOO_FILTER_HPP
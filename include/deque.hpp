@@ -6,9 +6,16 @@
 #define STLCONTAINER_DEQUE_HPP
 
 #include <functional>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
 #include "deque_iterator.hpp"
+#include "deque_segment.hpp"
 
 
 namespace sc::regular{
@@ -39,6 +46,10 @@ namespace sc::regular{
 
         using const_iterator = sc::utils::deque_iterator<T const>;
 
+        using segments_type = sc::utils::deque_segments<T>;
+
+        using const_segments_type = sc::utils::deque_segments<T const>;
+
         /*
          * consturctors
          */
@@ -46,8 +57,10 @@ namespace sc::regular{
         //declare member functions
         //default constructor
 
+        // allocates the blocks for count elements, no element is constructed
         explicit deque(size_type count);
 
+        // the blocks are allocated up front and filled one block at a time
         template <class InputIt>
         deque( InputIt first, InputIt last);
 
@@ -103,6 +116,11 @@ namespace sc::regular{
         iterator end() {return finish_;}
         const_iterator end() const { return const_iterator(finish_);}
 
+        // returns a view of the elements split by blocks, each segment
+        // is a contiguous span which can be processed as a plain array
+        segments_type segments() {return segments_type(start_, finish_);}
+        const_segments_type segments() const {return const_segments_type(begin(), end());}
+
         /*
          * Capacity
          */
@@ -116,7 +134,8 @@ namespace sc::regular{
         // returns the maximum number of elements that can be held
         size_type max_size() const ;
 
-        // reduces memory usage by freeing unused memory
+        // reduces memory usage by freeing the blocks without elements.
+        // the blocks are relinked to a smaller map, the elements never move
         void shrink_to_fit();
 
         /*
@@ -130,6 +149,12 @@ namespace sc::regular{
         iterator insert(iterator iter, const value_type& value);
         const_iterator insert(const_iterator citer, const value_type& value);
 
+        // insert the elements in [first, last) before pos, return the iterator points to
+        // the first inserted element. the elements on the shorter side of pos are shifted
+        // this function invalidates iterators and references
+        template <class InputIt>
+        iterator insert(const_iterator pos, InputIt first, InputIt last);
+
         // construct the element directly at position before iter
         template <class... Args>
         reference emplace(const_iterator citer, Args&&... args);
@@ -143,6 +168,11 @@ namespace sc::regular{
         void push_back(const value_type& value);
         void push_back(value_type&& value);
 
+        // append the elements of range at the back, the order is preserved.
+        // the existing elements never move
+        template <class Range>
+        void append_range(Range&& range);
+
         // construct the element directly at the back of the container
         template <class... Args>
         reference emplace_back(Args&&... args);
@@ -154,6 +184,11 @@ namespace sc::regular{
         void push_front(const T& value);
         void push_front(T&& value);
 
+        // insert the elements of range at the front, the order is preserved.
+        // the existing elements never move
+        template <class Range>
+        void prepend_range(Range&& range);
+
         // construct an element at the front of queue
         template <class... Args>
         reference emplace_front(Args&&... args);
@@ -187,11 +222,64 @@ namespace sc::regular{
 
         friend bool operator>=(const deque&, const deque&);
 
-        friend void swap(deque& q1, deque& q2);
 
     private:
-        void growfront(size_type n);
-        void growrear(size_type n);
+        template <class It>
+        static constexpr bool is_forward = std::is_base_of_v<std::forward_iterator_tag,
+                typename std::iterator_traits<It>::iterator_category>;
+
+        // allocates the map and the blocks for count elements,
+        // start_ and finish_ point to the beginning of the first block
+        void allocate(size_type count);
+
+        // deallocates the blocks and the map, the elements must be destroyed before
+        void deallocate();
+
+        // shrink_to_fit() if at most a quarter of the blocks hold elements, called by pop and erase
+        void shrink_for_pop() noexcept ;
+
+        // allocates a block for every pointer in [first, last)
+        static void allocate_blocks(T** first, T** last);
+
+        // makes sure that n elements can be constructed after finish_ or before start_.
+        // only the map is reallocated and new blocks are added, the elements never move
+        void reserve_back(size_type n);
+        void reserve_front(size_type n);
+
+        // construct n elements in the uninitialized slots beginning at pos, one block at a time,
+        // construct(dest, count) constructs count elements at dest. returns the end of the new elements.
+        // if it throws, the elements constructed are destroyed
+        template <class Construct>
+        iterator construct_blocks(iterator pos, size_type n, Construct construct);
+
+        // construct n elements copied from the range beginning at first
+        template <class ForwardIt>
+        iterator construct_range(iterator pos, ForwardIt first, size_type n);
+
+        // assign n elements copied from the range beginning at first, one block at a time
+        template <class ForwardIt>
+        ForwardIt assign_range(iterator pos, ForwardIt first, size_type n);
+
+        // copy n elements to the uninitialized array dest, returns the iterator past the last copied one.
+        // contiguous trivially copyable elements are copied with memcpy
+        template <class ForwardIt>
+        static ForwardIt copy_block(ForwardIt first, size_type n, T* dest);
+
+        // destroy the elements in [first, last)
+        static void destroy(iterator first, iterator last);
+
+        // the bulk paths of append_range, prepend_range and insert
+        template <class ForwardIt>
+        void append_n(ForwardIt first, size_type n);
+        template <class ForwardIt>
+        void prepend_n(ForwardIt first, size_type n);
+
+        // insert n elements before the element at index, shifting the elements after or before it
+        template <class ForwardIt>
+        void insert_back(size_type index, ForwardIt first, size_type n);
+        template <class ForwardIt>
+        void insert_front(size_type index, ForwardIt first, size_type n);
+
         T** map_; // array of block pointers
         size_type size_; // the size of map array
         iterator start_; // iterator for first element in queue
@@ -201,88 +289,51 @@ namespace sc::regular{
 
     template <class T>
     deque<T>::deque(deque::size_type count) {
-        size_ = ceil((float)count / BLOCK_SIZE);
-        map_ = static_cast<T**>(::operator new(size_ * sizeof(T*)));
-        for(int i=0; i<size_; ++i){
-            *(map_+i) = static_cast<T*>(::operator new(BLOCK_SIZE * sizeof(T)));
-        }
-
-        // initialize start iterator
-        start_.set(map_);
-
-        //initialize finish iterator
-        //start_ and finish_ points to the same element
-        finish_.set(map_);
-
+        allocate(count);
     }
 
     template<class T>
     template<class InputIt>
     deque<T>::deque(InputIt first, InputIt last) {
-        size_type element_count = last - first;
-
-        size_ = ceil((float)element_count / BLOCK_SIZE);
-        size_type block_offset = element_count % BLOCK_SIZE;
-        map_ = static_cast<T**>(::operator new(size_ * sizeof(T*)));
-        for(int i=0; i<size_; ++i){
-            *(map_+i) = static_cast<T*>(::operator new(BLOCK_SIZE * sizeof(T)));
-        }
-
-        // inititialize start,finish iterator, at the beginning of map
-        start_.set(map_);
-        finish_.set(map_);
-
-        // provide strong exception guarantee
-        try {
-            for(auto iter=first; iter!=last; ++iter){
-                std::uninitialized_copy_n(iter,1,finish_.ptr_);
-                ++finish_;
+        if constexpr (is_forward<InputIt>){
+            // the number of elements is known, allocate all the blocks at once
+            size_type element_count = std::distance(first, last);
+            allocate(element_count);
+
+            // provide strong exception guarantee
+            try {
+                finish_ = construct_range(start_, first, element_count);
+            }catch (...){
+                // if throws, deallocates all allocated memory
+                deallocate();
+                throw;
             }
-//            for (int i=0, iter=first; i<size_; ++i) {
-//                if(i == size_-1){
-//                    // copy the last block
-//                    finish_.ptr_ = std::uninitialized_copy(iter, last, finish_.first_);
-//                    assert(last - iter == element_count % BLOCK_SIZE);
-//                } else {
-//                    // copy the entire block
-//                    std::uninitialized_copy(iter, iter + BLOCK_SIZE, finish_.first_);
-//                    finish_ += BLOCK_SIZE;
-//                }
-//            }
-        }catch (...){
-            // if throws, deallocates all allocated memory
-            for(int i=0; i<size_; ++i){
-                ::operator delete(*(map_+i));
+        } else{
+            // a single pass range is appended one by one
+            allocate(0);
+            try {
+                for(; first != last; ++first)
+                    push_back(*first);
+            }catch (...){
+                clear();
+                deallocate();
+                throw;
             }
-            ::operator delete(map_);
         }
-
     }
 
     template<class T>
     deque<T>::deque(const deque &other) {
-
-        size_ = other.size_;
-        map_ = static_cast<T**>(::operator new(size_ * sizeof(T*)));
-        for(int i=0; i<size_; ++i){
-            *(map_+i) = static_cast<T*>(::operator new(BLOCK_SIZE * sizeof(T)));
-        }
+        allocate(other.size());
 
         // provide strong exception guarantee
         try {
-            for (int i=0; i<size_; ++i) {
-                std::uninitialized_copy(*(other.map_+i), *(other.map_+i)+BLOCK_SIZE, *(map_+i));
-            }
+            finish_ = construct_range(start_, other.begin(), other.size());
         }catch (...){
             // if throws, deallocates all allocated memory
-            for(int i=0; i<size_; ++i){
-                ::operator delete(*(map_+i));
-            }
-            ::operator delete(map_);
+            deallocate();
+            throw;
         }
-        start_.set(map_ + (other.start_.block_-other.map_), other.start_.ptr_ - other.start_.first_);
-        finish_.set(map_ + (other.finish_.block_-other.map_), other.finish_.ptr_ - other.finish_.first_);
-
     }
 
     template<class T>
@@ -293,22 +344,20 @@ namespace sc::regular{
         finish_ = std::move(other.finish_);
         size_ = other.size_;
         other.size_ = 0;
+        // the moved-from deque is empty, its destructor must not reach the moved elements
+        other.start_ = iterator();
+        other.finish_ = iterator();
     }
 
-    // this function has no-throw guarantee because std::swap does not throw
     template <class T>
     void swap(deque<T> &q1, deque<T> &q2) {
-        // by swapping the pointers, the two containers are effectively swapped
-        std::swap(q1.map_, q2.map_);
-        std::swap(q1.size_, q2.size_);
-        std::swap(q1.start_, q2.start_);
-        std::swap(q1.finish_, q2.finish_);
+        q1.swap(q2);
     }
 
     template<class T>
     deque<T> &deque<T>::operator=(deque other) {
         // use copy-and-swap idiom here
-        swap(*this, other);
+        this->swap(other);
 
         return *this;
     }
@@ -318,78 +367,39 @@ namespace sc::regular{
         // first clear the data
         clear();
         // second deallocate the memory
-        for(int i=0; i<size_; ++i){
-            ::operator delete(*(map_+i));
-        }
-        ::operator delete(map_);
+        deallocate();
     }
 
     template<class T>
     void deque<T>::assign(deque::size_type count, const value_type &value) {
-        //clear the deque first
+        //clear the deque first, and start from the first block
         clear();
+        start_.set(map_);
+        finish_ = start_;
 
         //adjust size
-        if(count > size())
-            growrear(count);
-
-        size_type block_offset = count % BLOCK_SIZE;
+        reserve_back(count);
 
-        // provide strong exception guarantee
-        try {
-            for(int i=0; i<size_; ++i){
-                if(i != size_ -1)
-                    std::uninitialized_fill_n(*(map_+i), BLOCK_SIZE, value);
-                else
-                    std::uninitialized_fill_n(*(map_+i), block_offset, value);
-            }
-            finish_.set(*(map_+size_-1), block_offset);
-        }catch (...){
-            for(int i=0; i<size_; ++i)
-                ::operator delete(*(map_+i));
-            ::operator delete(map_);
-        }
+        // if throws, the deque is left empty
+        finish_ = construct_blocks(finish_, count, [&value](T* dest, size_type n){
+            std::uninitialized_fill_n(dest, n, value);
+        });
     }
 
     template<class T>
     template<class InputIterator>
     void deque<T>::assign(InputIterator first, InputIterator last) {
-        //clear the deque first
+        //clear the deque first, and start from the first block
         clear();
+        start_.set(map_);
+        finish_ = start_;
 
-        size_type element_count = last-first;
-        size_ = ceil(element_count/BLOCK_SIZE);
-
-        //adjust size
-        if(last-first > size())
-            growrear(last-first);
-
-        // provide strong exception guarantee
-        try {
-            for(auto iter=first; iter!=last; ++iter){
-                std::uninitialized_copy_n(iter,1,finish_.ptr_);
-                ++finish_;
-            }
-//            auto iter = first;
-//            for (int i=0; i<size_; ++i) {
-//                if(i == size_-1){
-//                    // copy the last block
-//                    std::uninitialized_copy(iter, last, finish_.first_);
-//                    finish_ += (last - iter);
-//                    //assert((last - iter)%BLOCK_SIZE == element_count % BLOCK_SIZE);
-//                } else {
-//                    // copy the entire block
-//                    std::uninitialized_copy(iter, iter + BLOCK_SIZE, finish_.first_);
-//                    finish_ += BLOCK_SIZE;
-//                    iter += BLOCK_SIZE;
-//                }
-//            }
-        }catch (...){
-            // if throws, deallocates all allocated memory
-            for(int i=0; i<size_; ++i){
-                ::operator delete(*(map_+i));
-            }
-            ::operator delete(map_);
+        // if throws, the deque is left empty
+        if constexpr (is_forward<InputIterator>){
+            append_n(first, std::distance(first, last));
+        } else{
+            for(; first != last; ++first)
+                push_back(*first);
         }
     }
 
@@ -415,22 +425,22 @@ namespace sc::regular{
 
     template<class T>
     typename deque<T>::reference deque<T>::front() {
-        return *(start_.first_);
+        return *(start_.ptr_);
     }
 
     template<class T>
     typename deque<T>::const_ref deque<T>::front() const {
-        return *(start_.first_);
+        return *(start_.ptr_);
     }
 
     template<class T>
     typename deque<T>::reference deque<T>::back() {
-        return *(finish_.last_-1);
+        return *(finish_-1);
     }
 
     template<class T>
     typename deque<T>::const_ref deque<T>::back() const {
-        return *(finish_.last_-1);
+        return *(finish_-1);
     }
 
     template<class T>
@@ -445,187 +455,347 @@ namespace sc::regular{
 
     template<class T>
     void deque<T>::shrink_to_fit() {
-        // allocates memory for new map
-        difference_type new_size = finish_.block_-start_.block_+1;
-        T** new_map = static_cast<T**>(::operator new(new_size * sizeof(T*)));
-        for(int i=0; i<new_size; ++i)
-            *(new_map+i) = static_cast<T*>(::operator new(BLOCK_SIZE * sizeof(T)));
+        // a moved-from deque has no map
+        if(map_ == nullptr)
+            return;
 
-        difference_type start_offset = start_.ptr_ - start_.first_;
-        difference_type finish_offset = finish_.ptr_ - finish_.first_;
+        size_type used = finish_.block_ - start_.block_ + 1;
+        if(used == size_)
+            return;
 
-        // move the elements to the new container
-        try {
-            for(int i=0; i<new_size; ++i){
-                std::uninitialized_move(*(start_.block_+i), *(start_.block_+i)+BLOCK_SIZE, *(new_map+i));
-            }
-        }catch (...){
-            // if throws, deallocate new memory
-            for(int i=0; i<new_size; ++i)
-                ::operator delete(*(new_map+i));
-            ::operator delete(new_map);
-        }
+        // provide strong exception guarantee, nothing is changed before the new map is allocated
+        T** new_map = static_cast<T**>(::operator new(used * sizeof(T*)));
 
-        // deallocate the old container
-        for(int i=0; i<size_; ++i)
-            ::operator delete(*(map_+i));
-        ::operator delete(map_);
+        // the blocks without elements are freed, the others are relinked and the elements never move
+        for(T** block = map_; block != start_.block_; ++block)
+            ::operator delete(*block);
+        for(T** block = finish_.block_ + 1; block != map_ + size_; ++block)
+            ::operator delete(*block);
+        std::copy(start_.block_, finish_.block_ + 1, new_map);
+        finish_.block_ = new_map + (finish_.block_ - start_.block_);
+        start_.block_ = new_map;
 
-        size_ = new_size;
+        ::operator delete(map_);
         map_ = new_map;
-        start_.set(map_, start_offset);
-        finish_.set((map_+size_-1), finish_offset);
+        size_ = used;
+    }
 
+    template<class T>
+    void deque<T>::shrink_for_pop() noexcept {
+        // the map at least doubles when it grows, so it shrinks at a quarter to avoid
+        // shrinking and growing again on every push and pop around the boundary
+        if((finish_.block_ - start_.block_ + 1) * 4 > static_cast<difference_type>(size_))
+            return;
+        try {
+            shrink_to_fit();
+        }catch (const std::bad_alloc&){
+            // keeping the unused blocks is harmless
+        }
     }
 
     template<class T>
     void deque<T>::clear() {
-        for(int i=0; i<size_; ++i)
-            std::destroy_n(*(map_+i), BLOCK_SIZE);
-        std::destroy_n(map_, size_);
+        destroy(start_, finish_);
         finish_ = start_;
     }
 
     template<class T>
-    void deque<T>::growrear(deque::size_type n) {
-        assert(size_ > 0);
-        size_type new_size = ceil(n/BLOCK_SIZE);
-        if(new_size == size_)
-            return;
-
-        // allocate new memory
-        T** new_map = static_cast<T**>(::operator new(new_size* sizeof(T*)));
+    void deque<T>::allocate(deque::size_type count) {
+        // one more block than required, so that finish_ always points into a block
+        size_ = count / BLOCK_SIZE + 1;
+        map_ = static_cast<T**>(::operator new(size_ * sizeof(T*)));
+        try {
+            allocate_blocks(map_, map_ + size_);
+        }catch (...){
+            ::operator delete(map_);
+            throw;
+        }
 
-        for(int i=0; i<new_size; ++i)
-            *(new_map+i) = static_cast<T*>(::operator new(BLOCK_SIZE* sizeof(T)));
+        // inititialize start,finish iterator, at the beginning of map
+        start_.set(map_);
+        finish_.set(map_);
+    }
 
-        difference_type finish_offset = finish_.ptr_ - finish_.first_;
-        difference_type start_offset = start_.ptr_ - start_.first_;
+    template<class T>
+    void deque<T>::deallocate() {
+        for(size_type i=0; i<size_; ++i){
+            ::operator delete(*(map_+i));
+        }
+        ::operator delete(map_);
+    }
 
-        // move the elements
+    template<class T>
+    void deque<T>::allocate_blocks(T **first, T **last) {
+        T** iter = first;
         try {
-            if(new_size > size_) {
-                for (int i = 0; i < size_; ++i) {
-                    if (i == size_ - 1)
-                        std::uninitialized_move(finish_.first_, finish_.ptr_, *(new_map + i));
-                    else
-                        std::uninitialized_move(*(map_ + i), *(map_ + i) + BLOCK_SIZE, *(new_map + i));
-                }
-            }
-            else{ // if n is less than current size, destroy the extra elements
-                for(int i=0; i<new_size; ++i){
-                    std::uninitialized_move(*(map_+i), *(map_+i)+BLOCK_SIZE, *(new_map+i));
-                }
-                //destroy the extra elements
-                for(iterator i = *(map_+new_size); i!=end(); ++i)
-                    std::destroy_at(i.ptr_);
-            }
+            for(; iter != last; ++iter)
+                *iter = static_cast<T*>(::operator new(BLOCK_SIZE * sizeof(T)));
+        }catch (...){
+            // if throws, deallocates the blocks allocated so far
+            for(; first != iter; ++first)
+                ::operator delete(*first);
+            throw;
+        }
+    }
 
+    template<class T>
+    void deque<T>::reserve_back(deque::size_type n) {
+        // the free slots after finish_, the slot of finish_ itself is not counted
+        size_type available = (map_ + size_ - finish_.block_ - 1) * BLOCK_SIZE + (finish_.last_ - finish_.ptr_) - 1;
+        if(available >= n)
+            return;
+
+        // at least double the map, so that push_back is amortized O(1)
+        size_type blocks = std::max((n - available + BLOCK_SIZE - 1) / BLOCK_SIZE, size_);
+        T** new_map = static_cast<T**>(::operator new((size_ + blocks) * sizeof(T*)));
+        try {
+            allocate_blocks(new_map + size_, new_map + size_ + blocks);
         }catch (...){
-            // if move throws, deallocate these memory
-            for(int i=0; i<new_size; ++i)
-                ::operator delete(*(new_map+i));
             ::operator delete(new_map);
+            throw;
         }
 
-        //deallocates the old container
-        for(int i=0; i<size_; ++i)
-            ::operator delete(*(map_+i));
-        ::operator delete(map_);
-
-        //change the pointer to the new map;
+        // the old blocks keep their place at the beginning of the new map
+        std::copy(map_, map_ + size_, new_map);
+        start_.block_ = new_map + (start_.block_ - map_);
+        finish_.block_ = new_map + (finish_.block_ - map_);
 
+        ::operator delete(map_);
         map_ = new_map;
-        start_.set(new_map, start_offset);
-        finish_.set(new_map+size_-1, finish_offset);
-        size_ = new_size;
-
+        size_ += blocks;
     }
 
     template<class T>
-    void deque<T>::growfront(deque::size_type n) {
-        assert(size_ > 0);
-        size_type new_size = ceil(n/BLOCK_SIZE);
-
-        if(new_size == size_)
+    void deque<T>::reserve_front(deque::size_type n) {
+        // the free slots before start_
+        size_type available = (start_.block_ - map_) * BLOCK_SIZE + (start_.ptr_ - start_.first_);
+        if(available >= n)
             return;
 
-        // allocate new memory
-        T** new_map = static_cast<T**>(::operator new(new_size* sizeof(T*)));
+        // at least double the map, so that push_front is amortized O(1)
+        size_type blocks = std::max((n - available + BLOCK_SIZE - 1) / BLOCK_SIZE, size_);
+        T** new_map = static_cast<T**>(::operator new((size_ + blocks) * sizeof(T*)));
+        try {
+            allocate_blocks(new_map, new_map + blocks);
+        }catch (...){
+            ::operator delete(new_map);
+            throw;
+        }
 
-        for(int i=0; i<new_size; ++i)
-            *(new_map+i) = static_cast<T*>(::operator new(BLOCK_SIZE* sizeof(T)));
+        // the old blocks are moved behind the new ones
+        std::copy(map_, map_ + size_, new_map + blocks);
+        start_.block_ = new_map + blocks + (start_.block_ - map_);
+        finish_.block_ = new_map + blocks + (finish_.block_ - map_);
 
-        difference_type finish_offset = finish_.ptr_ - finish_.first_;
-        difference_type start_offset = start_.ptr_ - start_.first_;
+        ::operator delete(map_);
+        map_ = new_map;
+        size_ += blocks;
+    }
 
-        // move the elements
+    template<class T>
+    template<class Construct>
+    typename deque<T>::iterator deque<T>::construct_blocks(deque::iterator pos, deque::size_type n, Construct construct) {
+        iterator cur = pos;
         try {
-            if(new_size > size_) {
-                for (int i = 1; i <= size_; ++i) {
-                    std::uninitialized_move(*(map_+size_-i), *(map_+size_-i) + BLOCK_SIZE, *(new_map+new_size-i));
-                }
+            while(n > 0){
+                // fill the rest of the current block at once
+                size_type count = std::min<size_type>(n, cur.last_ - cur.ptr_);
+                construct(cur.ptr_, count);
+                cur += count;
+                n -= count;
             }
-            else{ // if n is less than current size, destroy the extra elements
-                for(int i=0; i<new_size; ++i){
-                    std::uninitialized_move(*(map_+i), *(map_+i)+BLOCK_SIZE, *(new_map+new_size-1-i));
-                }
-                //destroy the extra elements
-                for(iterator i= begin(); i != *(map_+(size_-new_size)-1)+BLOCK_SIZE; ++i)
-                    std::destroy_at(i.ptr_);
-            }
-
         }catch (...){
-            // if move throws, deallocate these memory
-            for(int i=0; i<new_size; ++i)
-                ::operator delete(*(new_map+i));
-            ::operator delete(new_map);
+            // if throws, destroy the elements in the blocks filled before
+            destroy(pos, cur);
+            throw;
         }
+        return cur;
+    }
 
-        //deallocates the old container
-        for(int i=0; i<size_; ++i)
-            ::operator delete(*(map_+i));
-        ::operator delete(map_);
+    template<class T>
+    template<class ForwardIt>
+    typename deque<T>::iterator deque<T>::construct_range(deque::iterator pos, ForwardIt first, deque::size_type n) {
+        return construct_blocks(pos, n, [&first](T* dest, size_type count){
+            first = copy_block(first, count, dest);
+        });
+    }
 
-        //change the pointer to the new map;
-        map_ = new_map;
-        finish_.set(new_map+new_size-1, finish_offset);
-        start_.set(finish_.block_-size_+1, start_offset);
-        size_ = new_size;
+    template<class T>
+    template<class ForwardIt>
+    ForwardIt deque<T>::assign_range(deque::iterator pos, ForwardIt first, deque::size_type n) {
+        while(n > 0){
+            size_type count = std::min<size_type>(n, pos.last_ - pos.ptr_);
+            ForwardIt last = std::next(first, count);
+            std::copy(first, last, pos.ptr_);
+            first = last;
+            pos += count;
+            n -= count;
+        }
+        return first;
+    }
 
+    template<class T>
+    template<class ForwardIt>
+    ForwardIt deque<T>::copy_block(ForwardIt first, deque::size_type n, T *dest) {
+        using source_type = typename std::iterator_traits<ForwardIt>::value_type;
+
+        if constexpr (std::is_pointer_v<ForwardIt> && std::is_same_v<source_type, T> && std::is_trivially_copyable_v<T>){
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+            return first + n;
+        } else{
+            ForwardIt last = std::next(first, n);
+            std::uninitialized_copy(first, last, dest);
+            return last;
+        }
     }
 
-    // insert invalidates iterators and references
     template<class T>
-    typename deque<T>::iterator deque<T>::insert(deque::iterator iter, const value_type &value) {
-        // if the container is full, double the size
-        if(finish_.block_ == map_+size_-1 && finish_.ptr_ == finish_.last_-1)
-            growrear(2 * BLOCK_SIZE * size_);
+    void deque<T>::destroy(deque::iterator first, deque::iterator last) {
+        if constexpr (!std::is_trivially_destructible_v<T>){
+            for(; first != last; ++first)
+                std::destroy_at(first.ptr_);
+        }
+    }
+
+    template<class T>
+    template<class ForwardIt>
+    void deque<T>::append_n(ForwardIt first, deque::size_type n) {
+        reserve_back(n);
+        finish_ = construct_range(finish_, first, n);
+    }
+
+    template<class T>
+    template<class ForwardIt>
+    void deque<T>::prepend_n(ForwardIt first, deque::size_type n) {
+        reserve_front(n);
+        iterator new_start = start_ - n;
+        construct_range(new_start, first, n);
+        start_ = new_start;
+    }
 
-        //shift from the end by 1
-        for(auto i = end(); i>iter; --i){
-            *i = *(i-1);
+    template<class T>
+    template<class Range>
+    void deque<T>::append_range(Range &&range) {
+        auto first = std::begin(range);
+        auto last = std::end(range);
+        if constexpr (is_forward<decltype(first)>){
+            append_n(first, std::distance(first, last));
+        } else{
+            for(; first != last; ++first)
+                push_back(*first);
         }
-        *iter = value;
+    }
 
-        ++finish_;
-        return iter;
+    template<class T>
+    template<class Range>
+    void deque<T>::prepend_range(Range &&range) {
+        auto first = std::begin(range);
+        auto last = std::end(range);
+        if constexpr (is_forward<decltype(first)>){
+            prepend_n(first, std::distance(first, last));
+        } else{
+            // a single pass range is buffered first
+            deque buffer(first, last);
+            prepend_n(std::make_move_iterator(buffer.begin()), buffer.size());
+        }
+    }
+
+    template<class T>
+    template<class InputIt>
+    typename deque<T>::iterator deque<T>::insert(deque::const_iterator pos, InputIt first, InputIt last) {
+        size_type index = pos - const_iterator(start_);
+
+        if constexpr (is_forward<InputIt>){
+            size_type n = std::distance(first, last);
+            if(index == size())
+                append_n(first, n);
+            else if(index == 0)
+                prepend_n(first, n);
+            else if(index < size() - index)
+                insert_front(index, first, n);
+            else
+                insert_back(index, first, n);
+            return start_ + index;
+        } else{
+            // a single pass range is buffered first
+            deque buffer(first, last);
+            return insert(pos, std::make_move_iterator(buffer.begin()), std::make_move_iterator(buffer.end()));
+        }
+    }
+
+    template<class T>
+    template<class ForwardIt>
+    void deque<T>::insert_back(deque::size_type index, ForwardIt first, deque::size_type n) {
+        reserve_back(n);
+        iterator pos = start_ + index;
+        iterator old_finish = finish_;
+        size_type elems_after = old_finish - pos;
+
+        if(elems_after > n){
+            // the last n elements move to the uninitialized slots, the others are shifted
+            finish_ = construct_range(old_finish, std::make_move_iterator(old_finish - n), n);
+            std::move_backward(pos, old_finish - n, old_finish);
+            assign_range(pos, first, n);
+        } else{
+            // the new elements beyond old_finish are constructed, followed by the moved elements
+            ForwardIt mid = std::next(first, elems_after);
+            iterator new_finish = construct_range(old_finish, mid, n - elems_after);
+            try {
+                finish_ = construct_range(new_finish, std::make_move_iterator(pos), elems_after);
+            }catch (...){
+                destroy(old_finish, new_finish);
+                throw;
+            }
+            assign_range(pos, first, elems_after);
+        }
+    }
+
+    template<class T>
+    template<class ForwardIt>
+    void deque<T>::insert_front(deque::size_type index, ForwardIt first, deque::size_type n) {
+        reserve_front(n);
+        iterator old_start = start_;
+        iterator new_start = start_ - n;
+        iterator pos = start_ + index;
+
+        if(index >= n){
+            // the first n elements move to the uninitialized slots, the others are shifted
+            construct_range(new_start, std::make_move_iterator(old_start), n);
+            start_ = new_start;
+            std::move(old_start + n, pos, old_start);
+            assign_range(pos - n, first, n);
+        } else{
+            // the moved elements are followed by the new elements before old_start
+            iterator mid = construct_range(new_start, std::make_move_iterator(old_start), index);
+            try {
+                construct_range(mid, first, n - index);
+            }catch (...){
+                destroy(new_start, mid);
+                throw;
+            }
+            start_ = new_start;
+            assign_range(old_start, std::next(first, n - index), index);
+        }
+    }
+
+    // insert invalidates iterators and references
+    template<class T>
+    typename deque<T>::iterator deque<T>::insert(deque::iterator iter, const value_type &value) {
+        // value may be an element of this deque, copy it before shifting
+        value_type copy(value);
+        return insert(const_iterator(iter), std::make_move_iterator(&copy), std::make_move_iterator(&copy + 1));
     }
 
     template<class T>
     typename deque<T>::iterator deque<T>::erase(deque::iterator iter) {
         difference_type n = iter - start_;
 
-        std::destroy_at((start_+n).ptr_);
-        for(iterator i = start_+n; i!=end(); ++i)
-            *i = *(i+1);
-
+        // the elements after iter are shifted, the last one is destroyed
+        std::move(start_+n+1, finish_, start_+n);
         --finish_;
         std::destroy_at(finish_.ptr_);
 
-        // if the unused space is more than half, shrink to fit
-        if(finish_-start_+1 <= size_*BLOCK_SIZE/2)
-            shrink_to_fit();
+        shrink_for_pop();
 
         return start_+n;
 
@@ -633,19 +803,17 @@ namespace sc::regular{
 
     template<class T>
     void deque<T>::push_back(const value_type &value) {
-        if(finish_.block_ == map_+size_-1 && finish_.ptr_ == finish_.last_-1)
-            growrear(2 * BLOCK_SIZE * size_);
+        reserve_back(1);
 
-        *(finish_.ptr_) = value;
+        ::new(static_cast<void*>(finish_.ptr_)) T(value);
         ++finish_;
     }
 
     template<class T>
     void deque<T>::push_back(value_type &&value) {
-        if(finish_.block_ == map_+size_-1 && finish_.ptr_ == finish_.last_-1)
-            growrear(2 * BLOCK_SIZE * size_);
+        reserve_back(1);
 
-        *(finish_.ptr_) = std::move(value);
+        ::new(static_cast<void*>(finish_.ptr_)) T(std::move(value));
         ++finish_;
     }
 
@@ -654,26 +822,24 @@ namespace sc::regular{
         --finish_;
         std::destroy_at(finish_.ptr_);
 
-        if(size() < size_*BLOCK_SIZE/2)
-            shrink_to_fit();
+        shrink_for_pop();
     }
 
     template<class T>
     void deque<T>::push_front(const T &value) {
-        if(start_.block_ == map_ && start_.ptr_ == start_.first_)
-            growfront(2 * BLOCK_SIZE * size_);
+        reserve_front(1);
 
+        // construct first, so that a throw leaves start_ unchanged
+        ::new(static_cast<void*>((start_-1).ptr_)) T(value);
         --start_;
-        *(start_.ptr_) = value;
     }
 
     template<class T>
     void deque<T>::push_front(T &&value) {
-        if(start_.block_ == map_ && start_.ptr_ == start_.first_)
-            growfront(2 * BLOCK_SIZE * size_);
+        reserve_front(1);
 
+        ::new(static_cast<void*>((start_-1).ptr_)) T(std::move(value));
         --start_;
-        *(start_.ptr_) = std::move(value);
     }
 
     template<class T>
@@ -681,39 +847,47 @@ namespace sc::regular{
         std::destroy_at(start_.ptr_);
         ++start_;
 
-        if(size() < size_*BLOCK_SIZE/2)
-            shrink_to_fit();
-
+        shrink_for_pop();
     }
 
     template<class T>
     void deque<T>::resize(deque::size_type size) {
-        growrear(size);
-
-        if(size > this->size_){
-            std::uninitialized_default_construct(finish_.ptr_, finish_.last_);
-            for(int i=finish_.block_-start_.block_+1; i< size_; ++i){
-                std::uninitialized_default_construct_n(*(map_+i), BLOCK_SIZE);
-            }
+        size_type count = this->size();
+
+        if(size > count){
+            reserve_back(size - count);
+            finish_ = construct_blocks(finish_, size - count, [](T* dest, size_type n){
+                std::uninitialized_value_construct_n(dest, n);
+            });
+        } else{
+            destroy(start_ + size, finish_);
+            finish_ = start_ + size;
         }
     }
 
     template<class T>
     void deque<T>::resize(deque::size_type size, const value_type &value) {
-        growrear(size);
-
-        if(size > this->size_){
-            std::uninitialized_fill(finish_.ptr_, finish_.last_, value);
-            for(int i=finish_.block_-start_.block_+1; i< size_; ++i){
-                std::uninitialized_fill_n(*(map_+i), BLOCK_SIZE, value);
-            }
+        size_type count = this->size();
+
+        if(size > count){
+            reserve_back(size - count);
+            finish_ = construct_blocks(finish_, size - count, [&value](T* dest, size_type n){
+                std::uninitialized_fill_n(dest, n, value);
+            });
+        } else{
+            destroy(start_ + size, finish_);
+            finish_ = start_ + size;
         }
-
     }
 
+    // this function has no-throw guarantee because std::swap does not throw
     template<class T>
     void deque<T>::swap(deque &other) {
-        swap(*this, other);
+        // by swapping the pointers, the two containers are effectively swapped
+        std::swap(map_, other.map_);
+        std::swap(size_, other.size_);
+        std::swap(start_, other.start_);
+        std::swap(finish_, other.finish_);
     }
 
     //lexically compare two deque
@@ -0,0 +1,183 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_DEQUE_ALGORITHM_HPP
+#define STLCONTAINER_DEQUE_ALGORITHM_HPP
+
+/*
+ * Segmented algorithms over deque iterators.
+ *
+ * A generic algorithm which runs on deque_iterator pays a block-boundary
+ * check on every increment. These overloads split the range into the
+ * contiguous segments of each block (see deque_segment.hpp) and run the
+ * standard algorithm on plain pointers inside every segment, so the
+ * inner loop is as tight as the one over a vector.
+ *
+ * The interfaces correspond to the ones in <algorithm> and <numeric>.
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include "deque.hpp"
+
+namespace sc::regular{
+
+    using sc::utils::deque_iterator;
+    using sc::utils::deque_segments;
+    using sc::utils::deque_segment_iterator;
+
+    // applies f to every element in [first, last), returns f
+    template <class T, class UnaryFunction>
+    UnaryFunction for_each(deque_iterator<T> first, deque_iterator<T> last, UnaryFunction f){
+        for(auto segment: deque_segments<T>(first, last)){
+            for(T* ptr = segment.begin(); ptr != segment.end(); ++ptr)
+                f(*ptr);
+        }
+        return f;
+    }
+
+    // copies [first, last) to the range beginning at d_first
+    // returns the iterator to one-past-the-last copied element
+    template <class T, class OutputIt>
+    OutputIt copy(deque_iterator<T> first, deque_iterator<T> last, OutputIt d_first){
+        for(auto segment: deque_segments<T>(first, last))
+            d_first = std::copy(segment.begin(), segment.end(), d_first);
+        return d_first;
+    }
+
+    // copies [first, last) into a deque, the destination is filled block by block
+    template <class InputIt, class T>
+    deque_iterator<T> copy(InputIt first, InputIt last, deque_iterator<T> d_first){
+        using category = typename std::iterator_traits<InputIt>::iterator_category;
+
+        deque_segment_iterator<T> dest(d_first);
+        while(true){
+            auto segment = *dest;
+            T* out = segment.begin();
+
+            if constexpr (std::is_base_of_v<std::random_access_iterator_tag, category>){
+                // the number of elements is known, copy the whole block at once
+                auto n = std::min<std::ptrdiff_t>(last - first, segment.size());
+                out = std::copy_n(first, n, out);
+                first += n;
+            } else{
+                for(; out != segment.end() && first != last; ++out, ++first)
+                    *out = *first;
+            }
+
+            if(first == last){
+                if(out != segment.end())
+                    return segment.iterator_at(out);
+                // the copy ends at the end of a block, the result points to the next block
+                auto next = *(++dest);
+                return next.iterator_at(next.begin());
+            }
+            ++dest;
+        }
+    }
+
+    // copies between two deques, both ranges are walked segment by segment
+    template <class T, class U>
+    deque_iterator<U> copy(deque_iterator<T> first, deque_iterator<T> last, deque_iterator<U> d_first){
+        for(auto segment: deque_segments<T>(first, last))
+            d_first = sc::regular::copy(segment.begin(), segment.end(), d_first);
+        return d_first;
+    }
+
+    // assigns value to every element in [first, last)
+    template <class T, class V>
+    void fill(deque_iterator<T> first, deque_iterator<T> last, const V& value){
+        for(auto segment: deque_segments<T>(first, last))
+            std::fill(segment.begin(), segment.end(), value);
+    }
+
+    // returns the iterator to the first element equals to value, or last if not found
+    template <class T, class V>
+    deque_iterator<T> find(deque_iterator<T> first, deque_iterator<T> last, const V& value){
+        for(auto segment: deque_segments<T>(first, last)){
+            T* pos = std::find(segment.begin(), segment.end(), value);
+            if(pos != segment.end())
+                return segment.iterator_at(pos);
+        }
+        return last;
+    }
+
+    // returns the number of elements equal to value
+    template <class T, class V>
+    std::ptrdiff_t count(deque_iterator<T> first, deque_iterator<T> last, const V& value){
+        std::ptrdiff_t n = 0;
+        for(auto segment: deque_segments<T>(first, last))
+            n += std::count(segment.begin(), segment.end(), value);
+        return n;
+    }
+
+    // sums up the elements with init, in the order of the range
+    template <class T, class V>
+    V accumulate(deque_iterator<T> first, deque_iterator<T> last, V init){
+        for(auto segment: deque_segments<T>(first, last))
+            init = std::accumulate(segment.begin(), segment.end(), std::move(init));
+        return init;
+    }
+
+    template <class T, class V, class BinaryOperation>
+    V accumulate(deque_iterator<T> first, deque_iterator<T> last, V init, BinaryOperation op){
+        for(auto segment: deque_segments<T>(first, last))
+            init = std::accumulate(segment.begin(), segment.end(), std::move(init), op);
+        return init;
+    }
+
+    // returns true if [first1, last1) equals to the range beginning at first2
+    template <class T, class InputIt2, class BinaryPredicate>
+    bool equal(deque_iterator<T> first1, deque_iterator<T> last1, InputIt2 first2, BinaryPredicate p){
+        using category = typename std::iterator_traits<InputIt2>::iterator_category;
+
+        for(auto segment: deque_segments<T>(first1, last1)){
+            if constexpr (std::is_base_of_v<std::random_access_iterator_tag, category>){
+                if(!std::equal(segment.begin(), segment.end(), first2, p))
+                    return false;
+                first2 += segment.size();
+            } else{
+                for(T* in = segment.begin(); in != segment.end(); ++in, ++first2){
+                    if(!p(*in, *first2))
+                        return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // both ranges are deques, the comparison runs on the overlapping part of two segments
+    template <class T, class U, class BinaryPredicate>
+    bool equal(deque_iterator<T> first1, deque_iterator<T> last1, deque_iterator<U> first2, BinaryPredicate p){
+        deque_segment_iterator<U> dest(first2);
+        auto other = *dest;
+        U* out = other.begin();
+
+        for(auto segment: deque_segments<T>(first1, last1)){
+            T* in = segment.begin();
+            while(in != segment.end()){
+                // only step into the next block when there is something to compare
+                if(out == other.end()){
+                    other = *(++dest);
+                    out = other.begin();
+                }
+                auto n = std::min(segment.end() - in, other.end() - out);
+                if(!std::equal(in, in + n, out, p))
+                    return false;
+                in += n;
+                out += n;
+            }
+        }
+        return true;
+    }
+
+    template <class T, class InputIt2>
+    bool equal(deque_iterator<T> first1, deque_iterator<T> last1, InputIt2 first2){
+        return sc::regular::equal(first1, last1, first2, std::equal_to<>());
+    }
+
+}
+
+#endif //STLCONTAINER_DEQUE_ALGORITHM_HPP
@@ -0,0 +1,97 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_FLAT_HASH_MAP_HPP
+#define STLCONTAINER_FLAT_HASH_MAP_HPP
+
+/*
+ * Open-addressing hash map.
+ *
+ * The key-value pairs are stored in a flat array of slots, there's no node
+ * and no bucket list. A lookup compares the tags of 16 slots at once and
+ * usually touches one group of control bytes and one slot.
+ *
+ * The interface is the one of unordered_map, except the node handles and
+ * the bucket interface, which have no meaning for a flat table.
+ * See flat_hash_table.hpp for the details.
+ */
+
+#include <stdexcept>
+#include "flat_hash_table.hpp"
+#include "map_modifiers.hpp"
+
+namespace sc::regular{
+
+    template <
+            class Key,
+            class T,
+            class Hash = sc::utils::hash<Key>,
+            class KeyEqual = std::equal_to<Key>
+    >
+    class flat_hash_map: public sc::utils::flat_hash_table<Key, std::pair<const Key, T>, sc::utils::key_of_pair, Hash, KeyEqual>,
+            public sc::utils::map_modifiers<flat_hash_map<Key, T, Hash, KeyEqual>, Key, T,
+                                            typename sc::utils::flat_hash_table<Key, std::pair<const Key, T>, sc::utils::key_of_pair, Hash, KeyEqual>::iterator,
+                                            typename sc::utils::flat_hash_table<Key, std::pair<const Key, T>, sc::utils::key_of_pair, Hash, KeyEqual>::const_iterator>{
+
+        using base = sc::utils::flat_hash_table<Key, std::pair<const Key, T>, sc::utils::key_of_pair, Hash, KeyEqual>;
+
+        using modifiers = sc::utils::map_modifiers<flat_hash_map, Key, T, typename base::iterator, typename base::const_iterator>;
+
+        // calls emplace_key()
+        friend modifiers;
+
+    public:
+        using mapped_type = T;
+
+        using typename base::iterator;
+
+        using typename base::const_iterator;
+
+        using base::base;
+
+        /*
+         * Element access
+         */
+
+        // returns the value mapped to key, throws std::out_of_range if key is not found
+        T& at(const Key& key);
+        const T& at( const Key& key) const;
+
+        // returns the value mapped to key, a value-initialized one is inserted if key is not found
+        T& operator[]( const Key& key) { return this->try_emplace(key).first->second;}
+        T& operator[]( Key&& key) { return this->try_emplace(std::move(key)).first->second;}
+
+        /*
+         * Modifiers
+         * try_emplace() and insert_or_assign() come from map_modifiers, each of them hashes
+         * the key once, and constructs the mapped value only if the key is inserted
+         */
+
+        void swap(flat_hash_map& other) noexcept { base::swap(other);}
+    };
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    T &flat_hash_map<Key, T, Hash, KeyEqual>::at(const Key &key) {
+        auto iter = this->find(key);
+        if(iter == this->end())
+            throw std::out_of_range("flat_hash_map key not found");
+        return iter->second;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    const T &flat_hash_map<Key, T, Hash, KeyEqual>::at(const Key &key) const {
+        auto iter = this->find(key);
+        if(iter == this->end())
+            throw std::out_of_range("flat_hash_map key not found");
+        return iter->second;
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    void swap(flat_hash_map<Key, T, Hash, KeyEqual>& lhs, flat_hash_map<Key, T, Hash, KeyEqual>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+}
+
+#endif //STLCONTAINER_FLAT_HASH_MAP_HPP
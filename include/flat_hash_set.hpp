@@ -0,0 +1,45 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_FLAT_HASH_SET_HPP
+#define STLCONTAINER_FLAT_HASH_SET_HPP
+
+/*
+ * Open-addressing hash set.
+ *
+ * The keys are stored in a flat array of slots, there's no node and no
+ * bucket list. A lookup compares the tags of 16 slots at once and usually
+ * touches one group of control bytes and one slot.
+ *
+ * The interface is the one of unordered_set, except the node handles and
+ * the bucket interface, which have no meaning for a flat table.
+ * See flat_hash_table.hpp for the details.
+ */
+
+#include "flat_hash_table.hpp"
+
+namespace sc::regular{
+
+    template <
+            class Key,
+            class Hash = sc::utils::hash<Key>,
+            class KeyEqual = std::equal_to<Key>
+    >class flat_hash_set: public sc::utils::flat_hash_table<Key, Key, sc::utils::key_of_identity, Hash, KeyEqual>{
+
+        using base = sc::utils::flat_hash_table<Key, Key, sc::utils::key_of_identity, Hash, KeyEqual>;
+
+    public:
+        using base::base;
+
+        void swap(flat_hash_set& other) noexcept { base::swap(other);}
+    };
+
+    template <class Key, class Hash, class KeyEqual>
+    void swap(flat_hash_set<Key, Hash, KeyEqual>& lhs, flat_hash_set<Key, Hash, KeyEqual>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+}
+
+#endif //STLCONTAINER_FLAT_HASH_SET_HPP
@@ -0,0 +1,422 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_FROZEN_MAP_HPP
+#define STLCONTAINER_FROZEN_MAP_HPP
+
+/*
+ * Immutable hash map read from a memory-mapped file.
+ *
+ * freeze() writes a map to a file once, frozen_map maps the file and looks
+ * the keys up in place, so opening a dictionary of any size costs one
+ * mmap() instead of rebuilding a table, and the pages are shared by every
+ * process which maps the file.
+ *
+ * The file holds:
+ *   - a header with the sizes, the offsets and the seed of the hash,
+ *   - the displacements of a minimal perfect hash (perfect_hash.hpp),
+ *   - the entries, one per slot of the perfect hash, a key and a value each,
+ *   - the arena with the bytes of the string keys and values, right after
+ *     the entries, since its strings are read unaligned anyway.
+ * The displacements and the entries start at offsets aligned to a cache line.
+ * Only offsets are stored, so the file can be mapped at any address.
+ *
+ * A key and a value are either trivially copyable, stored as they are, or
+ * std::string, stored as the offset and the size of its bytes in the
+ * arena. A trivially copyable key must have unique object representations
+ * (no padding, no floating point), because it's hashed and compared by its
+ * bytes. A string entry also keeps 32 bits of the hash of its key, which
+ * rejects most keys without reading the arena.
+ *
+ * find() reads one displacement and one entry, two cache misses, and a
+ * found string key or a string value reads the arena once more. The file
+ * is read on the machine which wrote it, or on one with the same
+ * endianness and the same layout of the key and the value types.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "perfect_hash.hpp"
+
+namespace sc::utils{
+
+    struct frozen_header{
+        static constexpr std::uint32_t VERSION = 1;
+
+        // the entries hold strings
+        static constexpr std::uint32_t STRING_KEY = 1;
+        static constexpr std::uint32_t STRING_VALUE = 2;
+
+        char magic_[8]; // "SCFROZEN"
+        std::uint32_t version_;
+        std::uint32_t order_; // 0x01020304 written in the byte order of the writer
+        std::uint32_t flags_;
+        std::uint32_t entry_size_;
+        std::uint64_t key_size_; // the size of the key field of an entry
+        std::uint64_t size_; // the number of entries
+        std::uint64_t seed_;
+        std::uint64_t bucket_count_; // the number of displacements
+        std::uint64_t displacements_; // the offsets of the sections from the start of the file
+        std::uint64_t entries_;
+        std::uint64_t arena_;
+        std::uint64_t file_size_;
+    };
+
+    // a string in the arena
+    struct frozen_string{
+        std::uint64_t offset_;
+        std::uint32_t size_;
+        std::uint32_t check_; // the high bits of the hash of a key, 0 for a value
+    };
+
+    template <class T>
+    using frozen_field = std::conditional_t<std::is_same_v<T, std::string>, frozen_string, T>;
+
+    template <class Key, class T>
+    struct frozen_entry{
+        frozen_field<Key> key_;
+        frozen_field<T> value_;
+    };
+
+    // whether a map with keys Key and values T can be frozen
+    template <class Key, class T>
+    constexpr bool is_freezable = (std::is_same_v<Key, std::string> ||
+                                   (std::is_trivially_copyable_v<Key> && std::has_unique_object_representations_v<Key>)) &&
+                                  (std::is_same_v<T, std::string> || std::is_trivially_copyable_v<T>);
+
+    inline std::uint64_t frozen_hash(std::string_view key, std::uint64_t seed){
+        return hash_bytes(key.data(), key.size(), seed);
+    }
+
+    template <class Key, class = std::enable_if_t<!std::is_convertible_v<const Key&, std::string_view>>>
+    std::uint64_t frozen_hash(const Key& key, std::uint64_t seed){
+        return hash_bytes(&key, sizeof(Key), seed);
+    }
+
+    // the offset of the first cache line at or after offset
+    inline std::uint64_t frozen_align(std::uint64_t offset){ return (offset + 63) & ~std::uint64_t(63);}
+
+}
+
+namespace sc::regular{
+
+    // writes the elements of map to the file at path, see frozen_map. the file is
+    // replaced atomically, through path + ".tmp".
+    // throws std::runtime_error if the file can't be written
+    template <class Map>
+    void freeze(const Map& map, const std::string& path);
+
+    template <class Key, class T>
+    class frozen_map{
+
+        static_assert(sc::utils::is_freezable<Key, T>,
+                "the key and the value must be std::string or trivially copyable, the key without padding");
+
+        using entry = sc::utils::frozen_entry<Key, T>;
+
+        using header = sc::utils::frozen_header;
+
+    public:
+
+        using key_type = Key;
+
+        using mapped_type = T;
+
+        using size_type = std::size_t;
+
+        // a string is a view of the mapped file, which is valid while the map is
+        using key_view = std::conditional_t<std::is_same_v<Key, std::string>, std::string_view, Key>;
+
+        using mapped_view = std::conditional_t<std::is_same_v<T, std::string>, std::string_view, T>;
+
+        // maps the file written by freeze(). throws std::system_error if it can't be
+        // mapped, std::runtime_error if it's not a frozen map of Key and T
+        explicit frozen_map(const std::string& path);
+
+        frozen_map(const frozen_map&) = delete;
+        frozen_map&operator=(const frozen_map&) = delete;
+
+        frozen_map(frozen_map&& other) noexcept: frozen_map(){ swap(other);}
+
+        frozen_map&operator=(frozen_map&& other) noexcept {
+            frozen_map tmp(std::move(other));
+            swap(tmp);
+            return *this;
+        }
+
+        ~frozen_map();
+
+        size_type size() const { return size_;}
+
+        bool empty() const { return size_ == 0;}
+
+        std::optional<mapped_view> find(const key_view& key) const;
+
+        bool contains(const key_view& key) const { return find(key).has_value();}
+
+        // throws std::out_of_range if key is not found
+        mapped_view at(const key_view& key) const;
+
+        // the element in slot i, for i in [0, size()). the slots are in no particular order
+        std::pair<key_view, mapped_view> element(size_type i) const {
+            return std::pair<key_view, mapped_view>(view(entries_[i].key_), view(entries_[i].value_));
+        }
+
+        void swap(frozen_map& other) noexcept {
+            std::swap(data_, other.data_);
+            std::swap(length_, other.length_);
+            std::swap(size_, other.size_);
+            std::swap(seed_, other.seed_);
+            std::swap(bucket_count_, other.bucket_count_);
+            std::swap(displacements_, other.displacements_);
+            std::swap(entries_, other.entries_);
+            std::swap(arena_, other.arena_);
+        }
+
+    private:
+        frozen_map(): data_(nullptr), length_(0), size_(0), seed_(0), bucket_count_(0),
+                      displacements_(nullptr), entries_(nullptr), arena_(nullptr){}
+
+        // checks the header against the file and the types, and the slots and
+        // the strings of the entries against the sections
+        void validate() const;
+
+        template <class Field>
+        auto view(const Field& field) const {
+            if constexpr (std::is_same_v<Field, sc::utils::frozen_string>)
+                return std::string_view(arena_ + field.offset_, field.size_);
+            else
+                return field;
+        }
+
+        bool equal(const entry& e, const key_view& key, std::uint64_t hash) const {
+            if constexpr (std::is_same_v<Key, std::string>){
+                return e.key_.check_ == static_cast<std::uint32_t>(hash >> 32) && e.key_.size_ == key.size() &&
+                       std::memcmp(arena_ + e.key_.offset_, key.data(), key.size()) == 0;
+            } else{
+                (void)hash;
+                return std::memcmp(&e.key_, &key, sizeof(Key)) == 0;
+            }
+        }
+
+        void* data_; // the mapping
+        size_type length_;
+        size_type size_;
+        std::uint64_t seed_;
+        size_type bucket_count_;
+        const std::uint64_t* displacements_;
+        const entry* entries_;
+        const char* arena_;
+    };
+
+    template <class Key, class T>
+    frozen_map<Key, T>::frozen_map(const std::string &path): frozen_map() {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+            throw std::system_error(errno, std::generic_category(), "frozen_map: can't open " + path);
+        struct stat st{};
+        if(::fstat(fd, &st) != 0){
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "frozen_map: can't stat " + path);
+        }
+        length_ = static_cast<size_type>(st.st_size);
+        if(length_ < sizeof(header)){
+            ::close(fd);
+            throw std::runtime_error("frozen_map: " + path + " is not a frozen map");
+        }
+        data_ = ::mmap(nullptr, length_, PROT_READ, MAP_SHARED, fd, 0);
+        // the mapping keeps the file open
+        ::close(fd);
+        if(data_ == MAP_FAILED){
+            data_ = nullptr;
+            throw std::system_error(errno, std::generic_category(), "frozen_map: can't map " + path);
+        }
+        // the lookups are random, reading ahead would only evict other pages
+        ::madvise(data_, length_, MADV_RANDOM);
+
+        auto base = static_cast<const char*>(data_);
+        auto h = reinterpret_cast<const header*>(base);
+        size_ = h->size_;
+        seed_ = h->seed_;
+        bucket_count_ = h->bucket_count_;
+        displacements_ = reinterpret_cast<const std::uint64_t*>(base + h->displacements_);
+        entries_ = reinterpret_cast<const entry*>(base + h->entries_);
+        arena_ = base + h->arena_;
+        // if throws, the destructor unmaps the file, the delegated constructor has finished
+        validate();
+    }
+
+    template <class Key, class T>
+    frozen_map<Key, T>::~frozen_map() {
+        if(data_ != nullptr)
+            ::munmap(data_, length_);
+    }
+
+    template <class Key, class T>
+    void frozen_map<Key, T>::validate() const {
+        auto h = static_cast<const header*>(data_);
+        std::uint32_t flags = (std::is_same_v<Key, std::string> ? header::STRING_KEY : 0) |
+                              (std::is_same_v<T, std::string> ? header::STRING_VALUE : 0);
+        bool valid = std::memcmp(h->magic_, "SCFROZEN", 8) == 0 && h->version_ == header::VERSION &&
+                     h->order_ == 0x01020304 && h->flags_ == flags && h->entry_size_ == sizeof(entry) &&
+                     h->key_size_ == sizeof(sc::utils::frozen_field<Key>) && h->file_size_ == length_ &&
+                     h->displacements_ % 64 == 0 && h->entries_ % 64 == 0 &&
+                     // each offset is bounded before a size is added to it, so the sums can't overflow
+                     h->displacements_ <= length_ && h->bucket_count_ > 0 &&
+                     h->bucket_count_ <= (length_ - h->displacements_) / sizeof(std::uint64_t) &&
+                     h->entries_ <= length_ && h->displacements_ + h->bucket_count_ * sizeof(std::uint64_t) <= h->entries_ &&
+                     h->size_ <= (length_ - h->entries_) / sizeof(entry) &&
+                     h->arena_ <= length_ && h->entries_ + h->size_ * sizeof(entry) <= h->arena_;
+        if(!valid)
+            throw std::runtime_error("frozen_map: the file is not a frozen map of these types");
+
+        // find() reads a slot and a string without bounds checks, so a truncated or
+        // corrupt file is rejected here, at the cost of reading every displacement and entry
+        for(size_type b=0; b<bucket_count_; ++b){
+            std::uint64_t d = displacements_[b];
+            if((d & sc::utils::perfect_hash::DIRECT) && (d & ~sc::utils::perfect_hash::DIRECT) >= size_)
+                throw std::runtime_error("frozen_map: a displacement is out of the entries");
+        }
+        std::uint64_t arena_size = length_ - h->arena_;
+        auto in_arena = [arena_size](const auto& field){
+            if constexpr (std::is_same_v<std::decay_t<decltype(field)>, sc::utils::frozen_string>)
+                return field.offset_ <= arena_size && field.size_ <= arena_size - field.offset_;
+            else
+                return true;
+        };
+        for(size_type i=0; i<size_; ++i){
+            if(!in_arena(entries_[i].key_) || !in_arena(entries_[i].value_))
+                throw std::runtime_error("frozen_map: a string is out of the arena");
+        }
+    }
+
+    template <class Key, class T>
+    std::optional<typename frozen_map<Key, T>::mapped_view> frozen_map<Key, T>::find(const key_view &key) const {
+        if(size_ == 0)
+            return std::nullopt;
+        std::uint64_t hash = sc::utils::frozen_hash(key, seed_);
+        const entry& e = entries_[sc::utils::perfect_hash::slot(hash, displacements_, bucket_count_, size_)];
+        if(!equal(e, key, hash))
+            return std::nullopt;
+        return view(e.value_);
+    }
+
+    template <class Key, class T>
+    typename frozen_map<Key, T>::mapped_view frozen_map<Key, T>::at(const key_view &key) const {
+        auto value = find(key);
+        if(!value)
+            throw std::out_of_range("frozen_map: key not found");
+        return *value;
+    }
+
+    template <class Map>
+    void freeze(const Map &map, const std::string &path) {
+        using Key = typename Map::key_type;
+        using T = typename Map::mapped_type;
+        using entry = sc::utils::frozen_entry<Key, T>;
+        static_assert(sc::utils::is_freezable<Key, T>,
+                "the key and the value must be std::string or trivially copyable, the key without padding");
+
+        std::vector<const typename Map::value_type*> elements;
+        elements.reserve(map.size());
+        for(const auto& value: map)
+            elements.push_back(&value);
+
+        sc::utils::perfect_hash hash;
+        hash.build(elements.size(), [&elements](std::uint64_t seed, std::size_t i){
+            return sc::utils::frozen_hash(elements[i]->first, seed);
+        });
+
+        // the arena is filled in the order of the slots, which is the order of the lookups
+        std::vector<entry> entries(elements.size());
+        std::vector<std::size_t> slot_of(elements.size());
+        for(std::size_t i=0; i<elements.size(); ++i){
+            std::uint64_t h = sc::utils::frozen_hash(elements[i]->first, hash.seed());
+            slot_of[sc::utils::perfect_hash::slot(h, hash.displacements().data(), hash.displacements().size(),
+                                                  hash.slot_count())] = i;
+        }
+        std::string arena;
+        auto store = [&arena](const auto& value, auto& field, std::uint32_t check){
+            if constexpr (std::is_same_v<std::decay_t<decltype(value)>, std::string>){
+                if(value.size() > UINT32_MAX)
+                    throw std::length_error("freeze: a string is too long");
+                field = sc::utils::frozen_string{arena.size(), static_cast<std::uint32_t>(value.size()), check};
+                arena += value;
+            } else{
+                (void)check;
+                field = value;
+            }
+        };
+        for(std::size_t s=0; s<entries.size(); ++s){
+            const auto& element = *elements[slot_of[s]];
+            std::uint64_t h = sc::utils::frozen_hash(element.first, hash.seed());
+            store(element.first, entries[s].key_, static_cast<std::uint32_t>(h >> 32));
+            store(element.second, entries[s].value_, 0);
+        }
+
+        sc::utils::frozen_header h{};
+        std::memcpy(h.magic_, "SCFROZEN", 8);
+        h.version_ = sc::utils::frozen_header::VERSION;
+        h.order_ = 0x01020304;
+        h.flags_ = (std::is_same_v<Key, std::string> ? sc::utils::frozen_header::STRING_KEY : 0) |
+                   (std::is_same_v<T, std::string> ? sc::utils::frozen_header::STRING_VALUE : 0);
+        h.entry_size_ = sizeof(entry);
+        h.key_size_ = sizeof(sc::utils::frozen_field<Key>);
+        h.size_ = entries.size();
+        h.seed_ = hash.seed();
+        h.bucket_count_ = hash.displacements().size();
+        h.displacements_ = sc::utils::frozen_align(sizeof(h));
+        h.entries_ = sc::utils::frozen_align(h.displacements_ + h.bucket_count_ * sizeof(std::uint64_t));
+        h.arena_ = h.entries_ + h.size_ * sizeof(entry);
+        h.file_size_ = h.arena_ + arena.size();
+
+        // the file is written next to path and renamed over it once it's on the disk, so
+        // a process which maps path sees either the old map or the new one, never a part
+        const std::string tmp = path + ".tmp";
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        const char zeros[64] = {};
+        auto pad_to = [&out, &zeros](std::uint64_t offset){
+            out.write(zeros, static_cast<std::streamsize>(offset - static_cast<std::uint64_t>(out.tellp())));
+        };
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        pad_to(h.displacements_);
+        out.write(reinterpret_cast<const char*>(hash.displacements().data()),
+                  static_cast<std::streamsize>(h.bucket_count_ * sizeof(std::uint64_t)));
+        pad_to(h.entries_);
+        out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(h.size_ * sizeof(entry)));
+        out.write(arena.data(), static_cast<std::streamsize>(arena.size()));
+        out.close();
+        bool written = static_cast<bool>(out);
+        if(written){
+            // ofstream can't fsync, the file is reopened for it
+            int fd = ::open(tmp.c_str(), O_RDONLY);
+            written = fd >= 0 && ::fsync(fd) == 0;
+            if(fd >= 0)
+                ::close(fd);
+        }
+        if(!written || std::rename(tmp.c_str(), path.c_str()) != 0){
+            std::remove(tmp.c_str());
+            throw std::runtime_error("freeze: can't write " + path);
+        }
+    }
+
+}
+
+#endif //STLCONTAINER_FROZEN_MAP_HPP
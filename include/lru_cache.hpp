@@ -0,0 +1,427 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_LRU_CACHE_HPP
+#define STLCONTAINER_LRU_CACHE_HPP
+
+/*
+ * Bounded cache which evicts the least recently used entries.
+ *
+ * A cache built from a list of the entries and an unordered_map from the
+ * keys to the list iterators stores every key twice, and allocates two
+ * nodes per entry. Here an entry is one node of a hash table which holds
+ * the key, the value and the links of an intrusive recency list, so the
+ * key is stored once and an insertion allocates once. The table's nodes
+ * never move, so the links stay valid when the table rehashes.
+ *
+ * Policy selects the eviction order:
+ *
+ * sc::utils::lru_eviction (default) moves an entry to the front of the
+ * list on every hit, by relinking it like list::splice, with no
+ * allocation. The back of the list is evicted.
+ *
+ * sc::utils::clock_eviction (CLOCK, second chance) only sets a reference
+ * bit on a hit, so a hit writes one byte of the entry instead of four
+ * links. The list is a circle swept by a hand: an entry whose bit is set
+ * gets its bit cleared and is skipped, the first entry whose bit is clear
+ * is evicted. A new entry is linked just behind the hand, so it's swept
+ * last.
+ *
+ * The capacity is a total weight. Weigher returns the weight of an entry,
+ * sc::utils::unit_weight (default) counts the entries, and
+ * sc::utils::memory_weight approximates the bytes of an entry with the
+ * memory owned by a string or a vector, so the capacity is in bytes.
+ * Entries are evicted when an insertion or an assignment exceeds the
+ * capacity, an entry heavier than the whole capacity is evicted at once.
+ * The callback set by on_evict() is called with the key and the value of
+ * every evicted entry, before it's destroyed; it's not called by erase()
+ * or clear().
+ *
+ * The entries link to each other and to the cache, so a cache can't be
+ * copied or moved.
+ */
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "hashtable.hpp"
+
+namespace sc::utils{
+
+    // moves an entry to the front of the recency list on every hit
+    struct lru_eviction{};
+
+    // sets the reference bit of an entry on a hit, the hand gives it a second chance
+    struct clock_eviction{};
+
+    // every entry weighs 1, the capacity is a number of entries
+    struct unit_weight{
+        template <class Key, class T>
+        std::size_t operator()(const Key&, const T&) const noexcept { return 1;}
+    };
+
+    // the bytes of a key and a value, with the memory owned by a string or a vector
+    struct memory_weight{
+        template <class Key, class T>
+        std::size_t operator()(const Key& key, const T& value) const noexcept {
+            return sizeof(Key) + sizeof(T) + owned(key) + owned(value);
+        }
+
+    private:
+        template <class U>
+        static std::size_t owned(const U& u) noexcept {
+            if constexpr (has_capacity<U>::value)
+                return u.capacity() * sizeof(typename U::value_type);
+            else
+                return 0;
+        }
+
+        template <class U, class = void>
+        struct has_capacity: std::false_type{};
+
+        template <class U>
+        struct has_capacity<U, std::void_t<decltype(std::declval<const U&>().capacity()), typename U::value_type>>: std::true_type{};
+    };
+
+    // the counters of a cache
+    struct cache_stats{
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t insertions = 0;
+        std::size_t evictions = 0;
+
+        double hit_rate() const { return hits + misses == 0 ? 0 : static_cast<double>(hits) / (hits + misses);}
+    };
+
+}
+
+namespace sc::regular{
+
+    template <
+            class Key,
+            class T,
+            class Hash = sc::utils::hash<Key>,
+            class KeyEqual = std::equal_to<Key>,
+            class Policy = sc::utils::lru_eviction,
+            class Weigher = sc::utils::unit_weight
+    >
+    class lru_cache{
+
+        // a link of the circular recency list
+        struct link{
+            link* prev_;
+            link* next_;
+        };
+
+        struct entry: link{
+            template <class... Args>
+            explicit entry(const Key& key, Args&&... args): link{nullptr, nullptr}, key_(key),
+                    value_(std::forward<Args>(args)...), weight_(0), referenced_(false){}
+
+            const Key key_;
+            T value_;
+            std::size_t weight_;
+            bool referenced_; // hit since the hand passed it, clock_eviction only
+        };
+
+        struct key_of_entry{
+            const Key& operator()(const entry& e) const { return e.key_;}
+        };
+
+        using table_type = sc::utils::hashtable<Key, entry, key_of_entry, Hash, KeyEqual,
+                sc::utils::dinkumware_layout, sc::utils::prime_index>;
+
+        static constexpr bool clock = std::is_same_v<Policy, sc::utils::clock_eviction>;
+
+    public:
+
+        using key_type = Key;
+
+        using mapped_type = T;
+
+        using size_type = std::size_t;
+
+        using hasher = Hash;
+
+        using key_equal = KeyEqual;
+
+        using weigher = Weigher;
+
+        using eviction_callback = std::function<void(const Key&, T&)>;
+
+        // capacity is the total weight of the entries
+        explicit lru_cache(size_type capacity, const Weigher& weigh = Weigher(),
+                           const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual());
+
+        lru_cache(const lru_cache&) = delete;
+        lru_cache&operator=(const lru_cache&) = delete;
+
+        /*
+         * Look-up
+         */
+
+        // returns the value of key and marks it used, nullptr if it's not cached. counts a hit or a miss
+        T* get(const Key& key);
+
+        // returns the value of key without marking it or counting
+        const T* peek(const Key& key) const;
+
+        bool contains(const Key& key) const { return peek(key) != nullptr;}
+
+        /*
+         * Modifiers
+         */
+
+        // inserts or assigns the value of key and marks it used, then evicts entries
+        // until the weight fits. returns the value, nullptr if it was evicted itself
+        template <class M>
+        T* put(const Key& key, M&& value);
+
+        // returns the value of key, inserting the one returned by load() if it's not cached
+        // counts a hit or a miss. if load() throws, nothing changes
+        template <class Load>
+        T& get_or_load(const Key& key, Load load);
+
+        // removes key without calling the eviction callback
+        bool erase(const Key& key);
+
+        void clear() noexcept ;
+
+        // evicts entries until the weight fits the new capacity
+        void set_capacity(size_type capacity);
+
+        // called with every entry evicted to make room, before it's destroyed
+        void on_evict(eviction_callback callback) { on_evict_ = std::move(callback);}
+
+        /*
+         * Capacity
+         */
+
+        bool empty() const { return table_.empty();}
+
+        size_type size() const { return table_.size();}
+
+        // the total weight of the entries
+        size_type weight() const { return weight_;}
+
+        size_type capacity() const { return capacity_;}
+
+        /*
+         * Recency
+         */
+
+        // calls f(const Key&, const T&) on every entry, the most recently used first.
+        // clock_eviction lists the entries in the order of the circle
+        template <class F>
+        void for_each(F f) const;
+
+        // the hits, misses, insertions and evictions since the construction or reset_stats()
+        sc::utils::cache_stats stats() const { return stats_;}
+
+        void reset_stats() { stats_ = sc::utils::cache_stats();}
+
+    private:
+        entry* find_entry(const Key& key) const {
+            auto iter = table_.find(key);
+            return iter == table_.end() ? nullptr : const_cast<entry*>(&*iter);
+        }
+
+        // marks e used by the policy
+        void touch(entry& e) noexcept {
+            if constexpr (clock){
+                e.referenced_ = true;
+            } else if(head_.next_ != &e){
+                unlink(&e);
+                link_before(&e, head_.next_);
+            }
+        }
+
+        // links a new entry, at the front, or behind the hand
+        void link_new(entry* e) noexcept {
+            if constexpr (clock)
+                link_before(e, hand_ == &head_ ? &head_ : hand_);
+            else
+                link_before(e, head_.next_);
+        }
+
+        static void link_before(link* l, link* next) noexcept {
+            l->next_ = next;
+            l->prev_ = next->prev_;
+            next->prev_->next_ = l;
+            next->prev_ = l;
+        }
+
+        static void unlink(link* l) noexcept {
+            l->prev_->next_ = l->next_;
+            l->next_->prev_ = l->prev_;
+        }
+
+        // the entry which the policy evicts next
+        entry* victim() noexcept ;
+
+        // evicts entries other than keep until the weight fits
+        void evict_to_fit(const entry* keep);
+
+        // unlinks and destroys e, calls the callback if evicted
+        void remove(entry* e, bool evicted);
+
+        table_type table_; // the entries, indexed by their keys
+        link head_; // the sentinel of the recency list, the most recent entry is head_.next_
+        link* hand_; // the next entry the clock looks at, &head_ if it's not started
+        size_type capacity_;
+        size_type weight_;
+        Weigher weigh_;
+        eviction_callback on_evict_;
+        sc::utils::cache_stats stats_;
+    };
+
+    // lru_cache which gives a second chance to the entries hit since the hand passed them
+    template <class Key, class T, class Hash = sc::utils::hash<Key>, class KeyEqual = std::equal_to<Key>, class Weigher = sc::utils::unit_weight>
+    using clock_cache = lru_cache<Key, T, Hash, KeyEqual, sc::utils::clock_eviction, Weigher>;
+
+    template <class Key, class T, class Hash, class KeyEqual, class Policy, class Weigher>
+    lru_cache<Key, T, Hash, KeyEqual, Policy, Weigher>::lru_cache(size_type capacity, const Weigher &weigh,
+            const Hash &hash, const KeyEqual &equal):
+            table_(0, hash, equal), head_{&head_, &head_}, hand_(&head_), capacity_(capacity), weight_(0), weigh_(weigh) {}
+
+    template <class Key, class T, class Hash, class KeyEqual, class Policy, class Weigher>
+    T *lru_cache<Key, T, Hash, KeyEqual, Policy, Weigher>::get(const Key &key) {
+        entry* e = find_entry(key);
+        if(e == nullptr){
+            ++stats_.misses;
+            return nullptr;
+        }
+        ++stats_.hits;
+        touch(*e);
+        return &e->value_;
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual, class Policy, class Weigher>
+    const T *lru_cache<Key, T, Hash, KeyEqual, Policy, Weigher>::peek(const Key &key) const {
+        entry* e = find_entry(key);
+        return e == nullptr ? nullptr : &e->value_;
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual, class Policy, class Weigher>
+    template <class M>
+    T *lru_cache<Key, T, Hash, KeyEqual, Policy, Weigher>::put(const Key &key, M &&value) {
+        entry* e = find_entry(key);
+        if(e != nullptr){
+            e->value_ = std::forward<M>(value);
+            touch(*e);
+        } else{
+            e = &*table_.emplace(key, std::forward<M>(value)).first;
+            link_new(e);
+            ++stats_.insertions;
+        }
+        weight_ -= e->weight_;
+        e->weight_ = weigh_(e->key_, e->value_);
+        weight_ += e->weight_;
+        evict_to_fit(e);
+        if(weight_ > capacity_){
+            remove(e, true);
+            return nullptr;
+        }
+        return &e->value_;
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual, class Policy, class Weigher>
+    template <class Load>
+    T &lru_cache<Key, T, Hash, KeyEqual, Policy, Weigher>::get_or_load(const Key &key, Load load) {
+        if(T* value = get(key))
+            return *value;
+        // the miss is counted by get()
+        entry* e = &*table_.emplace(key, load()).first;
+        link_new(e);
+        ++stats_.insertions;
+        e->weight_ = weigh_(e->key_, e->value_);
+        weight_ += e->weight_;
+        // the loaded entry is kept even if it's heavier than the capacity, it's returned by reference
+        evict_to_fit(e);
+        return e->value_;
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual, class Policy, class Weigher>
+    bool lru_cache<Key, T, Hash, KeyEqual, Policy, Weigher>::erase(const Key &key) {
+        entry* e = find_entry(key);
+        if(e == nullptr)
+            return false;
+        remove(e, false);
+        return true;
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual, class Policy, class Weigher>
+    void lru_cache<Key, T, Hash, KeyEqual, Policy, Weigher>::clear() noexcept {
+        table_.clear();
+        head_.prev_ = head_.next_ = &head_;
+        hand_ = &head_;
+        weight_ = 0;
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual, class Policy, class Weigher>
+    void lru_cache<Key, T, Hash, KeyEqual, Policy, Weigher>::set_capacity(size_type capacity) {
+        capacity_ = capacity;
+        evict_to_fit(nullptr);
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual, class Policy, class Weigher>
+    template <class F>
+    void lru_cache<Key, T, Hash, KeyEqual, Policy, Weigher>::for_each(F f) const {
+        for(const link* l = head_.next_; l != &head_; l = l->next_){
+            auto e = static_cast<const entry*>(l);
+            f(e->key_, static_cast<const T&>(e->value_));
+        }
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual, class Policy, class Weigher>
+    typename lru_cache<Key, T, Hash, KeyEqual, Policy, Weigher>::entry *
+    lru_cache<Key, T, Hash, KeyEqual, Policy, Weigher>::victim() noexcept {
+        if constexpr (clock){
+            // every entry is passed at most once before one is found with a clear bit
+            for(;;){
+                if(hand_ == &head_)
+                    hand_ = head_.next_;
+                auto e = static_cast<entry*>(hand_);
+                if(!e->referenced_)
+                    return e;
+                e->referenced_ = false;
+                hand_ = hand_->next_;
+            }
+        } else{
+            return static_cast<entry*>(head_.prev_);
+        }
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual, class Policy, class Weigher>
+    void lru_cache<Key, T, Hash, KeyEqual, Policy, Weigher>::evict_to_fit(const entry *keep) {
+        while(weight_ > capacity_ && table_.size() > (keep == nullptr ? 0 : 1)){
+            entry* e = victim();
+            if(e == keep){
+                // under lru_eviction keep is the front, it's never the victim of a longer list
+                hand_ = hand_->next_;
+                continue;
+            }
+            remove(e, true);
+        }
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual, class Policy, class Weigher>
+    void lru_cache<Key, T, Hash, KeyEqual, Policy, Weigher>::remove(entry *e, bool evicted) {
+        if(evicted){
+            ++stats_.evictions;
+            if(on_evict_)
+                on_evict_(e->key_, e->value_);
+        }
+        if(hand_ == e)
+            hand_ = hand_->next_;
+        unlink(e);
+        weight_ -= e->weight_;
+        // e's key is read by the table until its node is unlinked
+        table_.erase(e->key_);
+    }
+
+}
+
+#endif //STLCONTAINER_LRU_CACHE_HPP
@@ -5,8 +5,21 @@
 #ifndef STLCONTAINER_RBTREE_HPP
 #define STLCONTAINER_RBTREE_HPP
 
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
 #include "rbtreenode.hpp"
 
+/*
+ * Red-black tree of unique keys, ordered by Compare.
+ *
+ * The keys are passed by const reference. If Compare::is_transparent is
+ * defined (like std::less<>), search() and remove() also accept any type
+ * which Compare can compare with the keys, e.g. a std::string_view for
+ * std::string keys, without constructing a temporary key.
+ */
+
 namespace sc::regular{
 
     template <class T, class Compare=std::less<T>>
@@ -25,7 +38,7 @@ namespace sc::regular{
         using pointer = T*;
 
         rbtree():root_(nullptr), size_(0), comp_(Compare()){}
-        rbtree(const rbtree& other):root_(other.root_), size_(other.size_), comp_(other.comp_){}
+        rbtree(const rbtree& other):root_(copy(other.root_, nullptr)), size_(other.size_), comp_(other.comp_){}
         rbtree(rbtree&& other) noexcept {
             root_ = other.root_;
             other.root_ = nullptr;
@@ -37,6 +50,7 @@ namespace sc::regular{
             swap(*this, other);
             return *this;
         }
+        ~rbtree(){ destroy();}
 
         void preOrder();
 
@@ -44,9 +58,20 @@ namespace sc::regular{
 
         void postOrder();
 
-        pointer search(value_type key);
+        size_type size() const { return size_;}
+
+        bool empty() const { return size_ == 0;}
+
+        // returns the key equivalent to key, nullptr if it's not found
+        pointer search(const value_type& key) { return search(root_, key);}
+
+        template <class K, class C = Compare, class = typename C::is_transparent>
+        pointer search(const K& key) { return search(root_, key);}
 
-        pointer iterativeSearch(value_type key);
+        pointer iterativeSearch(const value_type& key) { return iterativeSearch(root_, key);}
+
+        template <class K, class C = Compare, class = typename C::is_transparent>
+        pointer iterativeSearch(const K& key) { return iterativeSearch(root_, key);}
 
         reference minimum() const;
 
@@ -58,15 +83,26 @@ namespace sc::regular{
         // predecessor: the max node that is smaller than node
         pointer predecessor(node_type* node);
 
-        void insert(value_type key);
+        // the key is not inserted if an equivalent key is in the tree
+        void insert(const value_type& key) { insert(new node_type(key));}
+
+        void insert(value_type&& key) { insert(new node_type(std::move(key)));}
+
+        // removes the key equivalent to key, returns the number of keys removed
+        size_type remove(const value_type& key) { return remove_key(key);}
 
-        void remove(value_type key);
+        template <class K, class C = Compare, class = typename C::is_transparent>
+        size_type remove(const K& key) { return remove_key(key);}
 
         void destroy();
 
         void print();
 
-        friend void swap(rbtree& rbt1, rbtree& rbt2);
+        friend void swap(rbtree& rbt1, rbtree& rbt2) noexcept {
+            std::swap(rbt1.root_, rbt2.root_);
+            std::swap(rbt1.size_, rbt2.size_);
+            std::swap(rbt1.comp_, rbt2.comp_);
+        }
 
     private:
         void preOrder(node_type* node) const;
@@ -75,21 +111,39 @@ namespace sc::regular{
 
         void postOrder(node_type* node) const;
 
-        pointer search(node_type* node, value_type key) const;
+        template <class K>
+        pointer search(node_type* node, const K& key) const;
+
+        template <class K>
+        pointer iterativeSearch(node_type* node, const K& key) const;
+
+        // returns the node of the key equivalent to key, nullptr if it's not found
+        template <class K>
+        node_type* find_node(const K& key) const;
 
-        pointer iterativeSearch(node_type* node, value_type key) const;
+        template <class K>
+        size_type remove_key(const K& key);
+
+        // copies the subtree of node, the copy's root has the parent parent
+        static node_type* copy(const node_type* node, node_type* parent);
+
+        static void destroy(node_type* node);
 
         void leftRotate(node_type* x);
 
         void rightRotate(node_type* x);
 
+        // replaces the subtree of u by the subtree of v
+        void transplant(node_type* u, node_type* v);
+
         void insert(node_type* node);
 
         void insertFixup(node_type* node);
 
         void remove(node_type* node);
 
-        void removeFixup(node_type* node);
+        // node may be a nullptr leaf, so its parent is passed too
+        void removeFixup(node_type* node, node_type* parent);
 
         node_type * root_;
 
@@ -153,6 +207,8 @@ namespace sc::regular{
         if(y->right_ != nullptr)
             y->right_->parent_ = x;
 
+        y->parent_ = x->parent_;
+        // change x's parent to y
         if(x == root_){
             assert(x->parent_ == nullptr);
             root_ = y;
@@ -169,108 +225,356 @@ namespace sc::regular{
 
     }
 
-    template <class T, class Compare>
-    void swap(rbtree<T,Compare> &rbt1, rbtree<T,Compare> &rbt2) {
-        std::swap(rbt1.root_, rbt2.root_);
-        std::swap(rbt1.size_, rbt2.size_);
-        std::swap(rbt1.comp_, rbt2.comp_);
+    template<class T, class Compare>
+    template<class K>
+    typename rbtree<T, Compare>::pointer rbtree<T, Compare>::search(node_type *node, const K &key) const {
+        if(node == nullptr)
+            return nullptr;
+        if(comp_(key, node->val_))
+            return search(node->left_, key);
+        if(comp_(node->val_, key))
+            return search(node->right_, key);
+        return &node->val_;
     }
 
     template<class T, class Compare>
-    void rbtree<T, Compare>::insert(rbtree::node_type *node) {
-        if(root_ == nullptr){
-            root_  = node;
-            return;
+    template<class K>
+    typename rbtree<T, Compare>::pointer rbtree<T, Compare>::iterativeSearch(node_type *node, const K &key) const {
+        while(node != nullptr){
+            if(comp_(key, node->val_))
+                node = node->left_;
+            else if(comp_(node->val_, key))
+                node = node->right_;
+            else
+                return &node->val_;
         }
+        return nullptr;
+    }
+
+    template<class T, class Compare>
+    template<class K>
+    typename rbtree<T, Compare>::node_type *rbtree<T, Compare>::find_node(const K &key) const {
+        node_type* node = root_;
+        while(node != nullptr){
+            if(comp_(key, node->val_))
+                node = node->left_;
+            else if(comp_(node->val_, key))
+                node = node->right_;
+            else
+                return node;
+        }
+        return nullptr;
+    }
+
+    template<class T, class Compare>
+    typename rbtree<T, Compare>::reference rbtree<T, Compare>::minimum() const {
+        assert(root_ != nullptr);
+        node_type* node = root_;
+        while(node->left_ != nullptr)
+            node = node->left_;
+        return node->val_;
+    }
+
+    template<class T, class Compare>
+    typename rbtree<T, Compare>::reference rbtree<T, Compare>::maximum() const {
+        assert(root_ != nullptr);
+        node_type* node = root_;
+        while(node->right_ != nullptr)
+            node = node->right_;
+        return node->val_;
+    }
+
+    template<class T, class Compare>
+    typename rbtree<T, Compare>::pointer rbtree<T, Compare>::successor(node_type *node) {
+        if(node->right_ != nullptr){
+            node = node->right_;
+            while(node->left_ != nullptr)
+                node = node->left_;
+            return &node->val_;
+        }
+        // the first ancestor which has node in its left subtree
+        node_type* parent = node->parent_;
+        while(parent != nullptr && node == parent->right_){
+            node = parent;
+            parent = parent->parent_;
+        }
+        return parent == nullptr ? nullptr : &parent->val_;
+    }
+
+    template<class T, class Compare>
+    typename rbtree<T, Compare>::pointer rbtree<T, Compare>::predecessor(node_type *node) {
+        if(node->left_ != nullptr){
+            node = node->left_;
+            while(node->right_ != nullptr)
+                node = node->right_;
+            return &node->val_;
+        }
+        // the first ancestor which has node in its right subtree
+        node_type* parent = node->parent_;
+        while(parent != nullptr && node == parent->left_){
+            node = parent;
+            parent = parent->parent_;
+        }
+        return parent == nullptr ? nullptr : &parent->val_;
+    }
+
+    template<class T, class Compare>
+    typename rbtree<T, Compare>::node_type *rbtree<T, Compare>::copy(const node_type *node, node_type *parent) {
+        if(node == nullptr)
+            return nullptr;
+        auto tmp = new node_type(*node);
+        tmp->parent_ = parent;
+        try {
+            tmp->left_ = copy(node->left_, tmp);
+            tmp->right_ = copy(node->right_, tmp);
+        }catch (...){
+            // if throws, destroy the copied part of the subtree
+            destroy(tmp);
+            throw;
+        }
+        return tmp;
+    }
+
+    template<class T, class Compare>
+    void rbtree<T, Compare>::destroy() {
+        destroy(root_);
+        root_ = nullptr;
+        size_ = 0;
+    }
+
+    template<class T, class Compare>
+    void rbtree<T, Compare>::destroy(node_type *node) {
+        if(node == nullptr)
+            return;
+        destroy(node->left_);
+        destroy(node->right_);
+        delete node;
+    }
+
+    template<class T, class Compare>
+    void rbtree<T, Compare>::transplant(node_type *u, node_type *v) {
+        if(u->parent_ == nullptr)
+            root_ = v;
+        else if(u == u->parent_->left_)
+            u->parent_->left_ = v;
+        else
+            u->parent_->right_ = v;
+        if(v != nullptr)
+            v->parent_ = u->parent_;
+    }
+
+    template<class T, class Compare>
+    void rbtree<T, Compare>::insert(rbtree::node_type *node) {
         // step1: search the node
         node_type* current = root_;
         node_type* pre = nullptr; // pre is set the record the parent of root
-        while(current != nullptr){
-            pre = current;
-            if(comp_(current->getValue(), node->getValue()) > 0)
-                current = current->right_;
-            else if(comp_(current->getValue(), node->getValue()) < 0)
-                current = current->left_;
-            else
-                return; // the node is already there
+        bool less = false;
+        try {
+            while(current != nullptr){
+                pre = current;
+                if(comp_(node->val_, current->val_)){
+                    less = true;
+                    current = current->left_;
+                } else if(comp_(current->val_, node->val_)){
+                    less = false;
+                    current = current->right_;
+                } else{
+                    // the key is already there
+                    delete node;
+                    return;
+                }
+            }
+        }catch (...){
+            // if comp_ throws, the node is not linked yet and the tree is unchanged
+            delete node;
+            throw;
         }
 
         // step2: insert the node
-        assert(current == nullptr);
         node->parent_ = pre;
-        if (comp_(pre->getValue(), node->getValue()) > 0) {
+        if(pre == nullptr)
+            root_ = node;
+        else if(less)
             pre->left_ = node;
-        } else if (comp_(pre->getValue(), node->getValue()) > 0) {
+        else
             pre->right_ = node;
-        } else throw;
+        ++size_;
 
         // step3: set the color to red
         node->setColor(utils::RED);
 
-        // step3: fix the tree
+        // step4: fix the tree
         insertFixup(node);
-
-    }
-
-    template<class T, class Compare>
-    void rbtree<T, Compare>::insert(value_type key) {
-        node_type* tmp = new node_type(key);
-
-        insert(tmp);
     }
 
     template<class T, class Compare>
     void rbtree<T, Compare>::insertFixup(rbtree::node_type *node) {
-        // 1. if node is root, make it black
-        if(node == root_) {
-            node->setColor(utils::BLACK);
-            return;
-        }
-
-        // 2. if parent is red
-        node_type * parent = node->parent_;
-        if(parent->isRed()){
-            // 2.1 if uncle is also red (i.e., both children are red)
-            // make them black, and set the grandparent red(same as node)
-            if(parent->parent_->left_->isRed() && parent->parent_->right_->isRed()){
-                parent->left_->setColor(utils::BLACK);
-                parent->right_->setColor(utils::BLACK);
-                parent->parent_->setColor(utils::RED);
-                node = parent->parent_;
+        // a red node must not have a red parent
+        while(isRed(node->parent_)){
+            node_type* parent = node->parent_;
+            // the parent is red, so it's not the root
+            node_type* grandparent = parent->parent_;
+            if(parent == grandparent->left_){
+                node_type* uncle = grandparent->right_;
+                if(isRed(uncle)){
+                    // 1. uncle is red: make parent and uncle black, the grandparent
+                    // red, and fix the grandparent
+                    parent->setColor(utils::BLACK);
+                    uncle->setColor(utils::BLACK);
+                    grandparent->setColor(utils::RED);
+                    node = grandparent;
+                } else{
+                    // 2. uncle is black, node is the right child: rotate it to case 3
+                    if(node == parent->right_){
+                        node = parent;
+                        leftRotate(node);
+                        parent = node->parent_;
+                    }
+                    // 3. uncle is black, node is the left child
+                    parent->setColor(utils::BLACK);
+                    grandparent->setColor(utils::RED);
+                    rightRotate(grandparent);
+                }
             } else{
-                // 2.2 if uncle is black
-                if(node == parent->left_){
-                    if(parent == parent->parent_->left_){
-                        // 2.2.1 node: left, uncle: left
-                        rightRotate(parent->parent_);
-                        swapColor(parent, parent->parent_);
-
-                    }else if(parent == parent->parent_->right_){
-                        // 2.2.2 node:left, uncle: right
-                        leftRotate(parent);
+                // mirror of the cases above
+                node_type* uncle = grandparent->left_;
+                if(isRed(uncle)){
+                    parent->setColor(utils::BLACK);
+                    uncle->setColor(utils::BLACK);
+                    grandparent->setColor(utils::RED);
+                    node = grandparent;
+                } else{
+                    if(node == parent->left_){
+                        node = parent;
                         rightRotate(node);
-                        swapColor(node, node->parent_);
+                        parent = node->parent_;
                     }
+                    parent->setColor(utils::BLACK);
+                    grandparent->setColor(utils::RED);
+                    leftRotate(grandparent);
+                }
+            }
+        }
+        root_->setColor(utils::BLACK);
+    }
 
-                }else if(node == parent->right_){
-                    if(parent == parent->parent_->left_){
-                        // 2.2.3 node:right, uncle: right
-                        leftRotate(parent);
-                        swapColor(parent, parent->parent_);
+    template<class T, class Compare>
+    template<class K>
+    typename rbtree<T, Compare>::size_type rbtree<T, Compare>::remove_key(const K &key) {
+        node_type* node = find_node(key);
+        if(node == nullptr)
+            return 0;
+        remove(node);
+        return 1;
+    }
 
-                    }else if(parent == parent->parent_->right_){
-                        // 2.2.4 node:right, uncle: left
-                        rightRotate(parent);
-                        leftRotate(node);
-                        swapColor(node, node->parent_);
+    template<class T, class Compare>
+    void rbtree<T, Compare>::remove(rbtree::node_type *node) {
+        // y is the node which is removed from its position: node itself if it has
+        // at most one child, otherwise its successor, which takes the place of node
+        node_type* y = node;
+        utils::rbcolor color = y->color_;
+        node_type* x; // the node which takes the place of y
+        node_type* parent; // the parent of x, x may be a nullptr leaf
+
+        if(node->left_ == nullptr){
+            x = node->right_;
+            parent = node->parent_;
+            transplant(node, node->right_);
+        } else if(node->right_ == nullptr){
+            x = node->left_;
+            parent = node->parent_;
+            transplant(node, node->left_);
+        } else{
+            y = node->right_;
+            while(y->left_ != nullptr)
+                y = y->left_;
+            color = y->color_;
+            x = y->right_;
+            if(y->parent_ == node){
+                parent = y;
+            } else{
+                parent = y->parent_;
+                transplant(y, y->right_);
+                y->right_ = node->right_;
+                y->right_->parent_ = y;
+            }
+            transplant(node, y);
+            y->left_ = node->left_;
+            y->left_->parent_ = y;
+            y->setColor(node->color_);
+        }
+        delete node;
+        --size_;
 
-                    }
+        // removing a black node leaves its paths one black node short
+        if(color == utils::BLACK)
+            removeFixup(x, parent);
+    }
 
+    template<class T, class Compare>
+    void rbtree<T, Compare>::removeFixup(rbtree::node_type *node, rbtree::node_type *parent) {
+        // node carries an extra black, move it up until it can be dropped
+        while(node != root_ && isBlack(node)){
+            if(node == parent->left_){
+                node_type* sibling = parent->right_;
+                if(isRed(sibling)){
+                    // 1. sibling is red: rotate to make it black
+                    sibling->setColor(utils::BLACK);
+                    parent->setColor(utils::RED);
+                    leftRotate(parent);
+                    sibling = parent->right_;
+                }
+                if(isBlack(sibling->left_) && isBlack(sibling->right_)){
+                    // 2. both children of sibling are black: move the extra black up
+                    sibling->setColor(utils::RED);
+                    node = parent;
+                    parent = node->parent_;
+                } else{
+                    // 3. the far child of sibling is black: rotate to case 4
+                    if(isBlack(sibling->right_)){
+                        sibling->left_->setColor(utils::BLACK);
+                        sibling->setColor(utils::RED);
+                        rightRotate(sibling);
+                        sibling = parent->right_;
+                    }
+                    // 4. the far child of sibling is red: rotate and drop the extra black
+                    sibling->setColor(parent->color_);
+                    parent->setColor(utils::BLACK);
+                    sibling->right_->setColor(utils::BLACK);
+                    leftRotate(parent);
+                    node = root_;
+                }
+            } else{
+                // mirror of the cases above
+                node_type* sibling = parent->left_;
+                if(isRed(sibling)){
+                    sibling->setColor(utils::BLACK);
+                    parent->setColor(utils::RED);
+                    rightRotate(parent);
+                    sibling = parent->left_;
+                }
+                if(isBlack(sibling->left_) && isBlack(sibling->right_)){
+                    sibling->setColor(utils::RED);
+                    node = parent;
+                    parent = node->parent_;
+                } else{
+                    if(isBlack(sibling->left_)){
+                        sibling->right_->setColor(utils::BLACK);
+                        sibling->setColor(utils::RED);
+                        leftRotate(sibling);
+                        sibling = parent->left_;
+                    }
+                    sibling->setColor(parent->color_);
+                    parent->setColor(utils::BLACK);
+                    sibling->left_->setColor(utils::BLACK);
+                    rightRotate(parent);
+                    node = root_;
                 }
             }
         }
-
-
+        if(node != nullptr)
+            node->setColor(utils::BLACK);
     }
 
 }
@@ -0,0 +1,345 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_RING_BUFFER_HPP
+#define STLCONTAINER_RING_BUFFER_HPP
+
+/*
+ * Fixed-capacity circular buffer.
+ *
+ * The elements are stored in one contiguous array which is allocated
+ * on construction and never grows. head_ is the position of the front
+ * element, the sequence continues to the end of the array and wraps
+ * around to the beginning of it.
+ *
+ * When the buffer is full, push_back either fails, or, in the overwrite
+ * mode, replaces the oldest element. The latter makes a bounded window
+ * over the latest values of a stream.
+ *
+ * as_spans() returns the sequence as at most two contiguous arrays, which
+ * can be handed to writev or processed as plain arrays without copying.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include "ring_iterator.hpp"
+#include "span.hpp"
+
+namespace sc::regular{
+
+    template <class T>
+    class ring_buffer{
+    public:
+
+        //declare member types
+        using value_type = T;
+
+        using size_type = std::size_t;
+
+        using difference_type = std::ptrdiff_t;
+
+        using reference = T&;
+
+        using const_ref = const T&;
+
+        using pointer = T*;
+
+        using const_ptr = const T*;
+
+        using iterator = sc::utils::ring_iterator<T>;
+
+        using const_iterator = sc::utils::ring_iterator<T const>;
+
+        using span_type = sc::utils::span<T>;
+
+        using const_span_type = sc::utils::span<T const>;
+
+        /*
+         * constructors
+         */
+
+        // allocates the storage for capacity elements.
+        // if overwrite is true, pushing into a full buffer replaces the oldest element
+        explicit ring_buffer(size_type capacity, bool overwrite = false);
+
+        //copy/move constructor
+        ring_buffer(const ring_buffer& other);
+        ring_buffer(ring_buffer&& other) noexcept ;
+
+        //copy/move assignment operator
+        //use copy-and-swap idiom and copy elision for better efficiency
+        ring_buffer&operator=(ring_buffer other);
+
+        ~ring_buffer();
+
+        /*
+         * element access
+         */
+
+        // the logical index 0 is the oldest element
+        reference at(size_type pos);
+        const_ref at(size_type pos) const;
+
+        reference operator[](size_type pos) { return buffer_[physical(pos)];}
+        const_ref operator[](size_type pos) const { return buffer_[physical(pos)];}
+
+        reference front() { return buffer_[head_];}
+        const_ref front() const { return buffer_[head_];}
+
+        reference back() { return buffer_[physical(size_-1)];}
+        const_ref back() const { return buffer_[physical(size_-1)];}
+
+        // returns the sequence as two contiguous arrays, the first one starts
+        // at the front element. the second one is empty unless the sequence
+        // wraps around the end of the storage
+        std::pair<span_type, span_type> as_spans();
+        std::pair<const_span_type, const_span_type> as_spans() const;
+
+        /*
+         * Iterators
+         */
+
+        iterator begin() { return iterator(buffer_, capacity_, head_, 0);}
+        const_iterator begin() const { return const_iterator(buffer_, capacity_, head_, 0);}
+
+        iterator end() { return iterator(buffer_, capacity_, head_, size_);}
+        const_iterator end() const { return const_iterator(buffer_, capacity_, head_, size_);}
+
+        /*
+         * Capacity
+         */
+
+        bool empty() const { return size_ == 0;}
+
+        bool full() const { return size_ == capacity_;}
+
+        size_type size() const { return size_;}
+
+        size_type capacity() const { return capacity_;}
+
+        size_type max_size() const { return capacity_;}
+
+        // whether pushing into a full buffer replaces the oldest element
+        bool overwrite() const { return overwrite_;}
+        void overwrite(bool overwrite) { overwrite_ = overwrite;}
+
+        /*
+         * Modifiers
+         */
+
+        void clear();
+
+        // append the element at the back. if the buffer is full, the oldest element
+        // is replaced in the overwrite mode, otherwise nothing is inserted.
+        // returns whether the element is inserted
+        bool push_back(const value_type& value);
+        bool push_back(value_type&& value);
+
+        template <class... Args>
+        bool emplace_back(Args&&... args);
+
+        // remove the oldest element
+        void pop_front();
+
+        // remove the newest element
+        void pop_back();
+
+        void swap(ring_buffer& other) noexcept ;
+
+        /*
+         * Non-member functions
+         */
+
+        template <class U>
+        friend bool operator==(const ring_buffer<U>& lhs, const ring_buffer<U>& rhs);
+
+        template <class U>
+        friend void swap(ring_buffer<U>& lhs, ring_buffer<U>& rhs) noexcept ;
+
+    private:
+        // the position in the storage of the logical index pos
+        size_type physical(size_type pos) const{
+            size_type p = head_ + pos;
+            return p >= capacity_ ? p - capacity_ : p;
+        }
+
+        T* buffer_; // the storage
+        size_type capacity_; // the length of the storage
+        size_type head_; // the position of the front element
+        size_type size_; // the number of elements
+        bool overwrite_; // replace the oldest element when full
+    };
+
+    template<class T>
+    ring_buffer<T>::ring_buffer(ring_buffer::size_type capacity, bool overwrite):
+        capacity_(capacity), head_(0), size_(0), overwrite_(overwrite)
+    {
+        buffer_ = static_cast<T*>(::operator new(capacity * sizeof(T)));
+    }
+
+    template<class T>
+    ring_buffer<T>::ring_buffer(const ring_buffer &other):
+        capacity_(other.capacity_), head_(0), size_(0), overwrite_(other.overwrite_)
+    {
+        buffer_ = static_cast<T*>(::operator new(capacity_ * sizeof(T)));
+
+        // the copy is linearized, the front element is at the beginning of storage
+        auto spans = other.as_spans();
+        try {
+            std::uninitialized_copy(spans.first.data(), spans.first.data() + spans.first.size(), buffer_);
+            size_ = spans.first.size();
+            std::uninitialized_copy(spans.second.data(), spans.second.data() + spans.second.size(), buffer_ + size_);
+            size_ += spans.second.size();
+        }catch (...){
+            // if throws, destroy the copied elements and deallocates the memory
+            std::destroy_n(buffer_, size_);
+            ::operator delete(buffer_);
+            throw;
+        }
+    }
+
+    template<class T>
+    ring_buffer<T>::ring_buffer(ring_buffer &&other) noexcept:
+        buffer_(other.buffer_), capacity_(other.capacity_), head_(other.head_), size_(other.size_), overwrite_(other.overwrite_)
+    {
+        other.buffer_ = nullptr;
+        other.capacity_ = 0;
+        other.head_ = 0;
+        other.size_ = 0;
+    }
+
+    template<class T>
+    ring_buffer<T> &ring_buffer<T>::operator=(ring_buffer other) {
+        // use copy-and-swap idiom here
+        swap(other);
+        return *this;
+    }
+
+    template<class T>
+    ring_buffer<T>::~ring_buffer() {
+        clear();
+        ::operator delete(buffer_);
+    }
+
+    template<class T>
+    typename ring_buffer<T>::reference ring_buffer<T>::at(ring_buffer::size_type pos) {
+        if(pos >= size_)
+            throw std::out_of_range("ring_buffer index out of range");
+        return buffer_[physical(pos)];
+    }
+
+    template<class T>
+    typename ring_buffer<T>::const_ref ring_buffer<T>::at(ring_buffer::size_type pos) const {
+        if(pos >= size_)
+            throw std::out_of_range("ring_buffer index out of range");
+        return buffer_[physical(pos)];
+    }
+
+    template<class T>
+    std::pair<typename ring_buffer<T>::span_type, typename ring_buffer<T>::span_type> ring_buffer<T>::as_spans() {
+        // the part from head to the end of storage
+        size_type first = std::min(size_, capacity_ - head_);
+        return std::pair<span_type, span_type>(span_type(buffer_ + head_, first), span_type(buffer_, size_ - first));
+    }
+
+    template<class T>
+    std::pair<typename ring_buffer<T>::const_span_type, typename ring_buffer<T>::const_span_type>
+    ring_buffer<T>::as_spans() const {
+        size_type first = std::min(size_, capacity_ - head_);
+        return std::pair<const_span_type, const_span_type>(const_span_type(buffer_ + head_, first),
+                const_span_type(buffer_, size_ - first));
+    }
+
+    template<class T>
+    void ring_buffer<T>::clear() {
+        auto spans = as_spans();
+        std::destroy_n(spans.first.data(), spans.first.size());
+        std::destroy_n(spans.second.data(), spans.second.size());
+        head_ = 0;
+        size_ = 0;
+    }
+
+    template<class T>
+    template<class... Args>
+    bool ring_buffer<T>::emplace_back(Args &&... args) {
+        if(capacity_ == 0)
+            return false;
+
+        if(size_ == capacity_){
+            if(!overwrite_)
+                return false;
+            // the slot of the oldest element becomes the back, construct the new
+            // element before destroying the old one, so that a throw leaves the buffer intact
+            T value(std::forward<Args>(args)...);
+            buffer_[head_] = std::move(value);
+            head_ = physical(1);
+            return true;
+        }
+
+        ::new(static_cast<void*>(buffer_ + physical(size_))) T(std::forward<Args>(args)...);
+        ++size_;
+        return true;
+    }
+
+    template<class T>
+    bool ring_buffer<T>::push_back(const value_type &value) {
+        return emplace_back(value);
+    }
+
+    template<class T>
+    bool ring_buffer<T>::push_back(value_type &&value) {
+        return emplace_back(std::move(value));
+    }
+
+    template<class T>
+    void ring_buffer<T>::pop_front() {
+        std::destroy_at(buffer_ + head_);
+        head_ = physical(1);
+        --size_;
+    }
+
+    template<class T>
+    void ring_buffer<T>::pop_back() {
+        std::destroy_at(buffer_ + physical(size_-1));
+        --size_;
+    }
+
+    // this function has no-throw guarantee because std::swap does not throw
+    template<class T>
+    void ring_buffer<T>::swap(ring_buffer &other) noexcept {
+        std::swap(buffer_, other.buffer_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+        std::swap(overwrite_, other.overwrite_);
+    }
+
+    template <class T>
+    void swap(ring_buffer<T> &lhs, ring_buffer<T> &rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    // compares the elements in the logical order
+    template <class T>
+    bool operator==(const ring_buffer<T> &lhs, const ring_buffer<T> &rhs) {
+        if(lhs.size() != rhs.size())
+            return false;
+        for(std::size_t i=0; i<lhs.size(); ++i){
+            if(!(lhs[i] == rhs[i]))
+                return false;
+        }
+        return true;
+    }
+
+    template <class T>
+    bool operator!=(const ring_buffer<T> &lhs, const ring_buffer<T> &rhs) {
+        return !(lhs == rhs);
+    }
+
+}
+
+#endif //STLCONTAINER_RING_BUFFER_HPP
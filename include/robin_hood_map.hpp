@@ -0,0 +1,100 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_ROBIN_HOOD_MAP_HPP
+#define STLCONTAINER_ROBIN_HOOD_MAP_HPP
+
+/*
+ * Open-addressing hash map with Robin Hood hashing.
+ *
+ * The key-value pairs are stored inline in one array of slots, each one after its
+ * metadata byte. An insertion keeps the distances of the elements from
+ * their home slots even, and erase() shifts the following elements back
+ * instead of leaving a tombstone, so the table stays fast at a load factor
+ * of 0.9 and a lookup, hit or miss, probes a few slots next to each other.
+ *
+ * The interface is the one of unordered_map, except the node handles and
+ * the bucket interface. An insertion or an erasure may move the other
+ * elements, which invalidates the references to them.
+ * See robin_hood_table.hpp for the details.
+ */
+
+#include <stdexcept>
+#include "robin_hood_table.hpp"
+#include "map_modifiers.hpp"
+
+namespace sc::regular{
+
+    template <
+            class Key,
+            class T,
+            class Hash = sc::utils::hash<Key>,
+            class KeyEqual = std::equal_to<Key>
+    >
+    class robin_hood_map: public sc::utils::robin_hood_table<Key, std::pair<const Key, T>, sc::utils::key_of_pair, Hash, KeyEqual>,
+            public sc::utils::map_modifiers<robin_hood_map<Key, T, Hash, KeyEqual>, Key, T,
+                                            typename sc::utils::robin_hood_table<Key, std::pair<const Key, T>, sc::utils::key_of_pair, Hash, KeyEqual>::iterator,
+                                            typename sc::utils::robin_hood_table<Key, std::pair<const Key, T>, sc::utils::key_of_pair, Hash, KeyEqual>::const_iterator>{
+
+        using base = sc::utils::robin_hood_table<Key, std::pair<const Key, T>, sc::utils::key_of_pair, Hash, KeyEqual>;
+
+        using modifiers = sc::utils::map_modifiers<robin_hood_map, Key, T, typename base::iterator, typename base::const_iterator>;
+
+        // calls emplace_key()
+        friend modifiers;
+
+    public:
+        using mapped_type = T;
+
+        using typename base::iterator;
+
+        using typename base::const_iterator;
+
+        using base::base;
+
+        /*
+         * Element access
+         */
+
+        // returns the value mapped to key, throws std::out_of_range if key is not found
+        T& at(const Key& key);
+        const T& at( const Key& key) const;
+
+        // returns the value mapped to key, a value-initialized one is inserted if key is not found
+        T& operator[]( const Key& key) { return this->try_emplace(key).first->second;}
+        T& operator[]( Key&& key) { return this->try_emplace(std::move(key)).first->second;}
+
+        /*
+         * Modifiers
+         * try_emplace() and insert_or_assign() come from map_modifiers, each of them hashes
+         * the key once, and constructs the mapped value only if the key is inserted
+         */
+
+        void swap(robin_hood_map& other) noexcept { base::swap(other);}
+    };
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    T &robin_hood_map<Key, T, Hash, KeyEqual>::at(const Key &key) {
+        auto iter = this->find(key);
+        if(iter == this->end())
+            throw std::out_of_range("robin_hood_map key not found");
+        return iter->second;
+    }
+
+    template<class Key, class T, class Hash, class KeyEqual>
+    const T &robin_hood_map<Key, T, Hash, KeyEqual>::at(const Key &key) const {
+        auto iter = this->find(key);
+        if(iter == this->end())
+            throw std::out_of_range("robin_hood_map key not found");
+        return iter->second;
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    void swap(robin_hood_map<Key, T, Hash, KeyEqual>& lhs, robin_hood_map<Key, T, Hash, KeyEqual>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+}
+
+#endif //STLCONTAINER_ROBIN_HOOD_MAP_HPP
@@ -0,0 +1,48 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_ROBIN_HOOD_SET_HPP
+#define STLCONTAINER_ROBIN_HOOD_SET_HPP
+
+/*
+ * Open-addressing hash set with Robin Hood hashing.
+ *
+ * The keys are stored inline in one array of slots, each one after its
+ * metadata byte. An insertion keeps the distances of the elements from
+ * their home slots even, and erase() shifts the following elements back
+ * instead of leaving a tombstone, so the table stays fast at a load factor
+ * of 0.9 and a lookup, hit or miss, probes a few slots next to each other.
+ *
+ * The interface is the one of unordered_set, except the node handles and
+ * the bucket interface. An insertion or an erasure may move the other
+ * elements, which invalidates the references to them.
+ * See robin_hood_table.hpp for the details.
+ */
+
+#include "robin_hood_table.hpp"
+
+namespace sc::regular{
+
+    template <
+            class Key,
+            class Hash = sc::utils::hash<Key>,
+            class KeyEqual = std::equal_to<Key>
+    >class robin_hood_set: public sc::utils::robin_hood_table<Key, Key, sc::utils::key_of_identity, Hash, KeyEqual>{
+
+        using base = sc::utils::robin_hood_table<Key, Key, sc::utils::key_of_identity, Hash, KeyEqual>;
+
+    public:
+        using base::base;
+
+        void swap(robin_hood_set& other) noexcept { base::swap(other);}
+    };
+
+    template <class Key, class Hash, class KeyEqual>
+    void swap(robin_hood_set<Key, Hash, KeyEqual>& lhs, robin_hood_set<Key, Hash, KeyEqual>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+}
+
+#endif //STLCONTAINER_ROBIN_HOOD_SET_HPP
@@ -0,0 +1,452 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_SHARDED_MAP_HPP
+#define STLCONTAINER_SHARDED_MAP_HPP
+
+/*
+ * Hash map split into independent shards.
+ *
+ * Every shard is an unordered_map with its own mutex, on its own cache
+ * lines, so the threads which work on different shards never touch the
+ * same lock. The shard of a key is chosen by the high bits of its mixed
+ * hash, and the unordered_map of the shard picks its bucket from the low
+ * bits, so the keys of a shard still spread over all of its buckets.
+ *
+ * The shards can also be owned: an owner_group starts one owner thread per
+ * shard, and the producers submit batches of operations instead of taking
+ * the locks. An operation is routed to the owner of its shard through a
+ * single-producer/single-consumer queue, one per producer and shard, so no
+ * two threads write the same queue or the same shard, and the owner
+ * applies a whole batch under one uncontended lock. The locked functions
+ * still work while the shards are owned, e.g. to read.
+ *
+ * Every queue counts the operations pushed by its producer and the ones
+ * applied by its owner, so flush() waits for exactly the queues it has to.
+ * An owner which finds its queues empty for a while parks on a condition
+ * variable, and a producer wakes it after pushing.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "cache_line.hpp"
+#include "hash.hpp"
+#include "spsc_queue.hpp"
+#include "unordered_map.hpp"
+
+namespace sc::lock_free{
+
+    template <class Key, class T, class Hash = sc::utils::hash<Key>, class KeyEqual = std::equal_to<Key>>
+    class sharded_map{
+
+        using map_type = sc::regular::unordered_map<Key, T, Hash, KeyEqual>;
+
+        struct alignas(CACHE_LINE_SIZE) shard{
+            std::mutex mutex_;
+            map_type map_;
+        };
+
+    public:
+
+        using key_type = Key;
+
+        using mapped_type = T;
+
+        using size_type = std::size_t;
+
+        using hasher = Hash;
+
+        using key_equal = KeyEqual;
+
+        // an update routed to the owner of its shard
+        struct operation{
+            enum kind_type{ INSERT, ASSIGN, ERASE};
+
+            static operation insert(Key key, T value){ return operation{INSERT, std::move(key), std::move(value)};}
+            static operation assign(Key key, T value){ return operation{ASSIGN, std::move(key), std::move(value)};}
+            static operation erase(Key key){ return operation{ERASE, std::move(key), T()};}
+
+            kind_type kind_;
+            Key key_;
+            T value_; // unused by ERASE
+        };
+
+        class owner_group;
+
+        // the shard count is rounded up to a power of two
+        explicit sharded_map(size_type shards = std::thread::hardware_concurrency(), const Hash& hash = Hash());
+
+        // the map is shared by several threads, it can not be copied or moved
+        sharded_map(const sharded_map&) = delete;
+        sharded_map&operator=(const sharded_map&) = delete;
+
+        size_type shard_count() const { return size_type(1) << bits_;}
+
+        // the shard of key
+        size_type shard_of(const Key& key) const {
+            if(bits_ == 0)
+                return 0;
+            // the low bits are used by the shard's own buckets
+            std::uint64_t h = static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+            return static_cast<size_type>(h >> (64 - bits_));
+        }
+
+        /*
+         * Locked functions, lock the shard of the key
+         */
+
+        // returns a copy of the mapped value of key, nullopt if it's not found
+        std::optional<T> find(const Key& key) const;
+
+        bool contains(const Key& key) const { return find(key).has_value();}
+
+        // calls f(const T&) on the mapped value of key with the lock held, returns false if it's not found
+        template <class F>
+        bool visit(const Key& key, F f) const;
+
+        // returns whether the value is inserted
+        template <class... Args>
+        bool try_emplace(const Key& key, Args&&... args);
+
+        bool insert(const Key& key, const T& value) { return try_emplace(key, value);}
+        bool insert(const Key& key, T&& value) { return try_emplace(key, std::move(value));}
+
+        template <class M>
+        bool insert_or_assign(const Key& key, M&& value);
+
+        size_type erase(const Key& key);
+
+        // exact if no other thread writes meanwhile
+        size_type size() const;
+
+        bool empty() const { return size() == 0;}
+
+        // locks one shard at a time
+        void clear();
+
+        // calls f(const map_type&) on every shard, with the lock of the shard held
+        template <class F>
+        void for_each_shard(F f) const;
+
+    private:
+        // applies op to its shard, the lock of the shard is held
+        static void apply(map_type& map, operation&& op);
+
+        shard& shard_for(const Key& key) const { return shards_[shard_of(key)];}
+
+        unsigned bits_; // log2 of the shard count
+        Hash hash_;
+        std::unique_ptr<shard[]> shards_;
+    };
+
+    // one owner thread per shard, and one queue per producer and shard.
+    // producer p is a thread which only calls submit(p, ...) with its own p
+    template <class Key, class T, class Hash, class KeyEqual>
+    class sharded_map<Key, T, Hash, KeyEqual>::owner_group{
+    public:
+
+        // the operations an owner applies under one lock
+        static constexpr size_type BATCH = 256;
+
+        // the empty rounds an owner yields for before it parks
+        static constexpr size_type IDLE_ROUNDS = 64;
+
+        owner_group(sharded_map& map, size_type producers, size_type queue_capacity = 1024);
+
+        owner_group(const owner_group&) = delete;
+        owner_group&operator=(const owner_group&) = delete;
+
+        // applies every submitted operation, then stops the owners
+        ~owner_group();
+
+        size_type producer_count() const { return producers_;}
+
+        // routes the operations in [first, last) to their owners, waits while a queue is full
+        template <class InputIt>
+        void submit(size_type producer, InputIt first, InputIt last);
+
+        void submit(size_type producer, operation op) { submit(producer, &op, &op + 1);}
+
+        // waits until the operations submitted by every producer before the call are applied
+        void flush() const { wait_applied(0, producers_);}
+
+        // waits until the operations submitted by producer before the call are applied
+        void flush(size_type producer) const { wait_applied(producer, producer + 1);}
+
+    private:
+        // the queue from a producer to an owner, and its counters
+        struct channel{
+            explicit channel(size_type capacity): queue_(capacity){}
+
+            spsc_queue<operation> queue_;
+            alignas(CACHE_LINE_SIZE) std::atomic<size_type> pushed_{0}; // written by the producer
+            alignas(CACHE_LINE_SIZE) std::atomic<size_type> applied_{0}; // written by the owner
+        };
+
+        // where the owner of a shard parks
+        struct alignas(CACHE_LINE_SIZE) owner_state{
+            std::mutex mutex_;
+            std::condition_variable wake_;
+            std::atomic<bool> parked_{false};
+        };
+
+        channel& channel_of(size_type producer, size_type s) const { return *channels_[producer * map_.shard_count() + s];}
+
+        // waits for the queues of the producers in [first, last), up to their counts at the call
+        void wait_applied(size_type first, size_type last) const;
+
+        // the loop of the owner of shard s
+        void own(size_type s);
+
+        // blocks the owner of shard s until a producer pushes to it or the group stops
+        void park(size_type s);
+
+        // wakes the owner of shard s if it's parked, the caller has pushed and issued a seq_cst fence
+        void wake(size_type s);
+
+        sharded_map& map_;
+        size_type producers_;
+        std::vector<std::unique_ptr<channel>> channels_; // producer-major
+        std::unique_ptr<owner_state[]> states_;
+        std::atomic<bool> stop_;
+        std::vector<std::thread> owners_;
+    };
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    sharded_map<Key, T, Hash, KeyEqual>::sharded_map(size_type shards, const Hash &hash): bits_(0), hash_(hash) {
+        while((size_type(1) << bits_) < shards)
+            ++bits_;
+        shards_.reset(new shard[shard_count()]);
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    std::optional<T> sharded_map<Key, T, Hash, KeyEqual>::find(const Key &key) const {
+        shard& s = shard_for(key);
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        auto iter = s.map_.find(key);
+        if(iter == s.map_.end())
+            return std::nullopt;
+        return iter->second;
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    template <class F>
+    bool sharded_map<Key, T, Hash, KeyEqual>::visit(const Key &key, F f) const {
+        shard& s = shard_for(key);
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        auto iter = s.map_.find(key);
+        if(iter == s.map_.end())
+            return false;
+        f(static_cast<const T&>(iter->second));
+        return true;
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    template <class... Args>
+    bool sharded_map<Key, T, Hash, KeyEqual>::try_emplace(const Key &key, Args &&... args) {
+        shard& s = shard_for(key);
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        return s.map_.try_emplace(key, std::forward<Args>(args)...).second;
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    template <class M>
+    bool sharded_map<Key, T, Hash, KeyEqual>::insert_or_assign(const Key &key, M &&value) {
+        shard& s = shard_for(key);
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        return s.map_.insert_or_assign(key, std::forward<M>(value)).second;
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    typename sharded_map<Key, T, Hash, KeyEqual>::size_type sharded_map<Key, T, Hash, KeyEqual>::erase(const Key &key) {
+        shard& s = shard_for(key);
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        return s.map_.erase(key);
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    typename sharded_map<Key, T, Hash, KeyEqual>::size_type sharded_map<Key, T, Hash, KeyEqual>::size() const {
+        size_type n = 0;
+        for_each_shard([&n](const map_type& map){ n += map.size();});
+        return n;
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    void sharded_map<Key, T, Hash, KeyEqual>::clear() {
+        for(size_type i=0; i<shard_count(); ++i){
+            std::lock_guard<std::mutex> lock(shards_[i].mutex_);
+            shards_[i].map_.clear();
+        }
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    template <class F>
+    void sharded_map<Key, T, Hash, KeyEqual>::for_each_shard(F f) const {
+        for(size_type i=0; i<shard_count(); ++i){
+            std::lock_guard<std::mutex> lock(shards_[i].mutex_);
+            f(static_cast<const map_type&>(shards_[i].map_));
+        }
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    void sharded_map<Key, T, Hash, KeyEqual>::apply(map_type &map, operation &&op) {
+        switch(op.kind_){
+            case operation::INSERT:
+                map.try_emplace(std::move(op.key_), std::move(op.value_));
+                break;
+            case operation::ASSIGN:
+                map.insert_or_assign(std::move(op.key_), std::move(op.value_));
+                break;
+            case operation::ERASE:
+                map.erase(op.key_);
+                break;
+        }
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    sharded_map<Key, T, Hash, KeyEqual>::owner_group::owner_group(sharded_map &map, size_type producers, size_type queue_capacity):
+            map_(map), producers_(producers), states_(new owner_state[map.shard_count()]), stop_(false) {
+        for(size_type i=0; i<producers * map.shard_count(); ++i)
+            channels_.emplace_back(new channel(queue_capacity));
+        try {
+            for(size_type s=0; s<map.shard_count(); ++s)
+                owners_.emplace_back([this, s]{ own(s);});
+        }catch (...){
+            // if throws, stop the owners which are started
+            stop_.store(true);
+            for(size_type s=0; s<owners_.size(); ++s){
+                std::lock_guard<std::mutex> lock(states_[s].mutex_);
+                states_[s].wake_.notify_one();
+            }
+            for(auto& owner: owners_)
+                owner.join();
+            throw;
+        }
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    sharded_map<Key, T, Hash, KeyEqual>::owner_group::~owner_group() {
+        stop_.store(true, std::memory_order_seq_cst);
+        for(size_type s=0; s<owners_.size(); ++s){
+            std::lock_guard<std::mutex> lock(states_[s].mutex_);
+            states_[s].wake_.notify_one();
+        }
+        for(auto& owner: owners_)
+            owner.join();
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    template <class InputIt>
+    void sharded_map<Key, T, Hash, KeyEqual>::owner_group::submit(size_type producer, InputIt first, InputIt last) {
+        for(; first != last; ++first){
+            operation op = *first;
+            size_type s = map_.shard_of(op.key_);
+            channel& c = channel_of(producer, s);
+            while(!c.queue_.push(std::move(op))){
+                // the owner may have parked before the queue filled up
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                wake(s);
+                std::this_thread::yield();
+            }
+            c.pushed_.store(c.pushed_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+        // one fence for the whole batch, pairs with the one in park()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for(size_type s=0; s<map_.shard_count(); ++s)
+            wake(s);
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    void sharded_map<Key, T, Hash, KeyEqual>::owner_group::wait_applied(size_type first, size_type last) const {
+        // the counts are taken before waiting, so the operations submitted meanwhile don't delay the call
+        size_type shards = map_.shard_count();
+        std::vector<size_type> pushed((last - first) * shards);
+        for(size_type i=0; i<pushed.size(); ++i)
+            pushed[i] = channel_of(first + i / shards, i % shards).pushed_.load(std::memory_order_acquire);
+        for(size_type i=0; i<pushed.size(); ++i){
+            const channel& c = channel_of(first + i / shards, i % shards);
+            while(c.applied_.load(std::memory_order_acquire) < pushed[i])
+                std::this_thread::yield();
+        }
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    void sharded_map<Key, T, Hash, KeyEqual>::owner_group::own(size_type s) {
+        shard& sh = map_.shards_[s];
+        size_type idle = 0;
+        for(;;){
+            // the queues are drained once more after stop_ is seen, the producers have returned by then
+            bool stopping = stop_.load(std::memory_order_acquire);
+            size_type applied = 0;
+            for(size_type p=0; p<producers_; ++p){
+                channel& c = channel_of(p, s);
+                if(c.queue_.empty())
+                    continue;
+                size_type n = 0;
+                {
+                    std::lock_guard<std::mutex> lock(sh.mutex_);
+                    for(; n<BATCH; ++n){
+                        operation* op = c.queue_.front();
+                        if(op == nullptr)
+                            break;
+                        apply(sh.map_, std::move(*op));
+                        c.queue_.pop();
+                    }
+                }
+                c.applied_.store(c.applied_.load(std::memory_order_relaxed) + n, std::memory_order_release);
+                applied += n;
+            }
+            if(applied > 0)
+                idle = 0;
+            else if(stopping)
+                return;
+            else if(++idle < IDLE_ROUNDS)
+                std::this_thread::yield();
+            else{
+                park(s);
+                idle = 0;
+            }
+        }
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    void sharded_map<Key, T, Hash, KeyEqual>::owner_group::park(size_type s) {
+        owner_state& state = states_[s];
+        std::unique_lock<std::mutex> lock(state.mutex_);
+        state.parked_.store(true, std::memory_order_relaxed);
+        // either a producer sees parked_ after its push, or the queues below show the push
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool empty = !stop_.load(std::memory_order_relaxed);
+        for(size_type p=0; empty && p<producers_; ++p)
+            empty = channel_of(p, s).queue_.empty();
+        // a spurious wakeup only costs one more round
+        if(empty)
+            state.wake_.wait(lock);
+        state.parked_.store(false, std::memory_order_relaxed);
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual>
+    void sharded_map<Key, T, Hash, KeyEqual>::owner_group::wake(size_type s) {
+        owner_state& state = states_[s];
+        if(!state.parked_.load(std::memory_order_relaxed))
+            return;
+        // the owner holds the mutex until it waits, so the notification can't come before the wait
+        {
+            std::lock_guard<std::mutex> lock(state.mutex_);
+        }
+        state.wake_.notify_one();
+    }
+
+}
+
+#endif //STLCONTAINER_SHARDED_MAP_HPP
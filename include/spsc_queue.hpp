@@ -0,0 +1,264 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_SPSC_QUEUE_HPP
+#define STLCONTAINER_SPSC_QUEUE_HPP
+
+/*
+ * Wait-free single-producer/single-consumer ring buffer.
+ *
+ * Exactly one thread may call the producer functions (push, emplace, push_n)
+ * and exactly one thread may call the consumer functions (front, pop, pop_n)
+ * at the same time. Every operation finishes in a bounded number of steps.
+ *
+ * The capacity is rounded up to a power of two, so an index is mapped into
+ * the buffer by a mask instead of a division. head_ and tail_ are counters
+ * that only grow, the number of elements is always tail_ - head_.
+ *
+ * head_ is written by the consumer and tail_ by the producer, they sit on
+ * separate cache lines. Each side also keeps a cached copy of the other
+ * side's index, and only reloads it (which pulls the other cache line)
+ * when the cached value says the queue is full or empty.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <algorithm>
+#include "cache_line.hpp"
+
+namespace sc::lock_free{
+
+    template <class T>
+    class spsc_queue{
+    public:
+
+        using value_type = T;
+
+        using size_type = std::size_t;
+
+        using reference = T&;
+
+        using pointer = T*;
+
+        // the capacity is rounded up to the next power of two
+        explicit spsc_queue(size_type capacity);
+
+        // the queue is shared by two threads, it can not be copied or moved
+        spsc_queue(const spsc_queue&) = delete;
+        spsc_queue&operator=(const spsc_queue&) = delete;
+
+        ~spsc_queue();
+
+        /*
+         * Producer
+         */
+
+        // append value at the tail, returns false if the queue is full
+        bool push(const value_type& value);
+        bool push(value_type&& value);
+
+        template <class... Args>
+        bool emplace(Args&&... args);
+
+        // append up to n elements from the contiguous range beginning at first,
+        // returns the number of elements appended. the elements are copied in
+        // at most two contiguous chunks and published at once
+        size_type push_n(const value_type* first, size_type n);
+
+        /*
+         * Consumer
+         */
+
+        // returns the pointer to the head element, nullptr if the queue is empty
+        pointer front();
+
+        // remove the head element, the queue must not be empty
+        void pop();
+
+        // move the head element into value, returns false if the queue is empty
+        bool pop(value_type& value);
+
+        // move up to n elements into the array beginning at out,
+        // returns the number of elements removed
+        size_type pop_n(value_type* out, size_type n);
+
+        /*
+         * Capacity
+         */
+
+        // these functions may be called from any thread,
+        // the result is only a snapshot while the other side is running
+        size_type size() const;
+
+        bool empty() const { return size() == 0;}
+
+        size_type capacity() const { return mask_ + 1;}
+
+    private:
+        // the number of free slots seen by the producer, reloads head_ if required
+        size_type writable(size_type tail, size_type n);
+
+        // the number of elements seen by the consumer, reloads tail_ if required
+        size_type readable(size_type head, size_type n);
+
+        // read only after construction, shared by both sides
+        alignas(CACHE_LINE_SIZE) T* buffer_;
+        size_type mask_;
+
+        // written by the consumer
+        alignas(CACHE_LINE_SIZE) std::atomic<size_type> head_;
+        size_type cached_tail_; // the last tail_ seen by the consumer
+
+        // written by the producer
+        alignas(CACHE_LINE_SIZE) std::atomic<size_type> tail_;
+        size_type cached_head_; // the last head_ seen by the producer
+    };
+
+    template<class T>
+    spsc_queue<T>::spsc_queue(spsc_queue::size_type capacity): head_(0), cached_tail_(0), tail_(0), cached_head_(0) {
+        size_type n = 1;
+        while(n < capacity)
+            n <<= 1;
+        mask_ = n - 1;
+        buffer_ = static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    template<class T>
+    spsc_queue<T>::~spsc_queue() {
+        // destroy the elements which are never consumed
+        size_type head = head_.load(std::memory_order_relaxed);
+        size_type tail = tail_.load(std::memory_order_relaxed);
+        for(; head != tail; ++head)
+            std::destroy_at(buffer_ + (head & mask_));
+        ::operator delete(buffer_);
+    }
+
+    template<class T>
+    typename spsc_queue<T>::size_type spsc_queue<T>::writable(size_type tail, size_type n) {
+        size_type free = capacity() - (tail - cached_head_);
+        if(free < n){
+            // acquire pairs with the release in pop, the slots are no longer read
+            cached_head_ = head_.load(std::memory_order_acquire);
+            free = capacity() - (tail - cached_head_);
+        }
+        return free;
+    }
+
+    template<class T>
+    typename spsc_queue<T>::size_type spsc_queue<T>::readable(size_type head, size_type n) {
+        size_type available = cached_tail_ - head;
+        if(available < n){
+            // acquire pairs with the release in push, the elements are fully constructed
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            available = cached_tail_ - head;
+        }
+        return available;
+    }
+
+    template<class T>
+    template<class... Args>
+    bool spsc_queue<T>::emplace(Args &&... args) {
+        size_type tail = tail_.load(std::memory_order_relaxed);
+        if(writable(tail, 1) == 0)
+            return false;
+
+        ::new(static_cast<void*>(buffer_ + (tail & mask_))) T(std::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<class T>
+    bool spsc_queue<T>::push(const value_type &value) {
+        return emplace(value);
+    }
+
+    template<class T>
+    bool spsc_queue<T>::push(value_type &&value) {
+        return emplace(std::move(value));
+    }
+
+    template<class T>
+    typename spsc_queue<T>::size_type spsc_queue<T>::push_n(const value_type *first, size_type n) {
+        size_type tail = tail_.load(std::memory_order_relaxed);
+        n = std::min(n, writable(tail, n));
+        if(n == 0)
+            return 0;
+
+        // the free slots may wrap around the end of buffer
+        size_type index = tail & mask_;
+        size_type chunk = std::min(n, capacity() - index);
+
+        std::uninitialized_copy_n(first, chunk, buffer_ + index);
+        try {
+            std::uninitialized_copy_n(first + chunk, n - chunk, buffer_);
+        }catch (...){
+            // nothing is published yet, destroy the first chunk
+            std::destroy_n(buffer_ + index, chunk);
+            throw;
+        }
+
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    template<class T>
+    typename spsc_queue<T>::pointer spsc_queue<T>::front() {
+        size_type head = head_.load(std::memory_order_relaxed);
+        if(readable(head, 1) == 0)
+            return nullptr;
+        return buffer_ + (head & mask_);
+    }
+
+    template<class T>
+    void spsc_queue<T>::pop() {
+        size_type head = head_.load(std::memory_order_relaxed);
+        std::destroy_at(buffer_ + (head & mask_));
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    template<class T>
+    bool spsc_queue<T>::pop(value_type &value) {
+        size_type head = head_.load(std::memory_order_relaxed);
+        if(readable(head, 1) == 0)
+            return false;
+
+        T* slot = buffer_ + (head & mask_);
+        value = std::move(*slot);
+        std::destroy_at(slot);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<class T>
+    typename spsc_queue<T>::size_type spsc_queue<T>::pop_n(value_type *out, size_type n) {
+        size_type head = head_.load(std::memory_order_relaxed);
+        n = std::min(n, readable(head, n));
+        if(n == 0)
+            return 0;
+
+        // the elements may wrap around the end of buffer
+        size_type index = head & mask_;
+        size_type chunk = std::min(n, capacity() - index);
+
+        std::move(buffer_ + index, buffer_ + index + chunk, out);
+        std::move(buffer_, buffer_ + (n - chunk), out + chunk);
+        std::destroy_n(buffer_ + index, chunk);
+        std::destroy_n(buffer_, n - chunk);
+
+        head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    template<class T>
+    typename spsc_queue<T>::size_type spsc_queue<T>::size() const {
+        // load head first, so that tail is never behind it
+        size_type head = head_.load(std::memory_order_acquire);
+        size_type tail = tail_.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+}
+
+#endif //STLCONTAINER_SPSC_QUEUE_HPP
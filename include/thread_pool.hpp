@@ -0,0 +1,394 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_THREAD_POOL_HPP
+#define STLCONTAINER_THREAD_POOL_HPP
+
+/*
+ * Fork/join thread pool built on work_stealing_deque.
+ *
+ * Every worker thread owns a work_stealing_deque of tasks. A task spawned
+ * by a worker is pushed to the bottom of its own deque, and the worker pops
+ * its newest task first, which keeps the working set in cache. An idle
+ * worker steals the oldest task from the top of a random victim, which is
+ * usually the biggest piece of work left.
+ *
+ * Tasks submitted from threads outside of the pool go into a shared queue
+ * guarded by a mutex, they are picked up by the workers when their own
+ * deques are empty.
+ *
+ * task_group is the fork/join interface: run() forks a task and wait()
+ * joins all of them. The waiting thread executes queued tasks until the
+ * group is done, so nested fork/join never blocks a worker.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "work_stealing_deque.hpp"
+
+namespace sc::lock_free{
+    class task_group;
+}
+
+namespace sc::utils{
+
+    // a unit of work scheduled by thread_pool
+    class task{
+    public:
+        explicit task(sc::lock_free::task_group* group): group_(group){}
+        virtual ~task() = default;
+
+        virtual void execute() = 0;
+
+        // the group which waits for this task, nullptr for a detached task
+        sc::lock_free::task_group* group_;
+    };
+
+    template <class F>
+    class function_task: public task{
+    public:
+        function_task(sc::lock_free::task_group* group, F f): task(group), f_(std::move(f)){}
+
+        void execute() override { f_();}
+
+    private:
+        F f_;
+    };
+
+}
+
+namespace sc::lock_free{
+
+    class thread_pool{
+    public:
+
+        using size_type = std::size_t;
+
+        // starts the worker threads, at least one
+        explicit thread_pool(size_type threads = std::thread::hardware_concurrency());
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool&operator=(const thread_pool&) = delete;
+
+        // runs the remaining tasks, then stops and joins the worker threads
+        ~thread_pool();
+
+        // the number of worker threads
+        size_type size() const { return workers_.size();}
+
+        // schedule a detached task, nobody waits for it
+        template <class F>
+        void submit(F f);
+
+        // calls f(i) for every i in [first, last). the range is split in halves
+        // recursively until a piece is not longer than grain
+        template <class Index, class F>
+        void parallel_for(Index first, Index last, const F& f, Index grain = 1);
+
+        // calls f(*iter) for every iter in [first, last)
+        template <class RandomIt, class F>
+        void parallel_for_each(RandomIt first, RandomIt last, const F& f, size_type grain = 1);
+
+        // runs one queued task on the calling thread, returns false if no task is found
+        bool run_one();
+
+    private:
+        friend class task_group;
+
+        // queue a task, to the own deque if called from a worker of this pool
+        void spawn(sc::utils::task* t);
+
+        // take a task: the own deque first, then the shared queue, then steal
+        sc::utils::task* find_task(size_type index);
+
+        void execute(sc::utils::task* t);
+
+        void worker_loop(size_type index);
+
+        template <class Index, class F>
+        void split(task_group& group, Index first, Index last, Index grain, const F& body);
+
+        // the index of the worker running on the calling thread, or npos
+        size_type current_index() const { return current_pool_ == this ? current_index_ : npos;}
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        static inline thread_local const thread_pool* current_pool_ = nullptr;
+        static inline thread_local size_type current_index_ = 0;
+
+        std::vector<std::unique_ptr<work_stealing_deque<sc::utils::task*>>> workers_;
+        std::vector<std::thread> threads_;
+
+        // tasks submitted from outside of the pool, guarded by mutex_
+        std::deque<sc::utils::task*> injected_;
+        std::atomic<size_type> injected_size_;
+
+        // idle workers sleep on cv_ until a task is queued
+        std::mutex mutex_;
+        std::condition_variable cv_;
+
+        // the number of tasks queued and not yet taken
+        alignas(CACHE_LINE_SIZE) std::atomic<size_type> queued_;
+        std::atomic<size_type> sleepers_;
+        std::atomic<bool> stop_;
+    };
+
+    class task_group{
+    public:
+
+        using size_type = std::size_t;
+
+        explicit task_group(thread_pool& pool): pool_(pool), pending_(0), failed_(false){}
+
+        task_group(const task_group&) = delete;
+        task_group&operator=(const task_group&) = delete;
+
+        // the tasks refer to the group, so the group waits for them
+        ~task_group(){ join();}
+
+        // fork: schedule f to run on the pool
+        template <class F>
+        void run(F f){
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            pool_.spawn(new sc::utils::function_task<F>(this, std::move(f)));
+        }
+
+        // join: run queued tasks until all tasks of the group are done.
+        // rethrows the first exception thrown by a task of the group
+        void wait(){
+            join();
+            if(failed_.load(std::memory_order_acquire)){
+                failed_.store(false, std::memory_order_relaxed);
+                std::rethrow_exception(std::move(exception_));
+            }
+        }
+
+    private:
+        friend class thread_pool;
+
+        void join(){
+            while(pending_.load(std::memory_order_acquire) != 0){
+                if(!pool_.run_one())
+                    std::this_thread::yield();
+            }
+        }
+
+        // keeps the first exception only
+        void set_exception(std::exception_ptr e){
+            std::lock_guard<std::mutex> lock(mutex_);
+            if(!failed_.load(std::memory_order_relaxed)){
+                exception_ = std::move(e);
+                failed_.store(true, std::memory_order_release);
+            }
+        }
+
+        thread_pool& pool_;
+        std::atomic<size_type> pending_;
+        std::atomic<bool> failed_;
+        std::mutex mutex_;
+        std::exception_ptr exception_;
+    };
+
+    inline thread_pool::thread_pool(size_type threads): injected_size_(0), queued_(0), sleepers_(0), stop_(false) {
+        if(threads == 0)
+            threads = 1;
+
+        // all deques exist before any thread starts stealing
+        for(size_type i=0; i<threads; ++i)
+            workers_.push_back(std::make_unique<work_stealing_deque<sc::utils::task*>>());
+        for(size_type i=0; i<threads; ++i)
+            threads_.emplace_back([this, i]{ worker_loop(i);});
+    }
+
+    inline thread_pool::~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_.store(true);
+        }
+        cv_.notify_all();
+        for(auto& thread: threads_)
+            thread.join();
+    }
+
+    template<class F>
+    void thread_pool::submit(F f) {
+        spawn(new sc::utils::function_task<F>(nullptr, std::move(f)));
+    }
+
+    inline void thread_pool::spawn(sc::utils::task *t) {
+        // count the task before it can be taken, so that queued_ never underflows
+        queued_.fetch_add(1);
+
+        size_type index = current_index();
+        if(index != npos){
+            workers_[index]->push(t);
+        } else{
+            std::lock_guard<std::mutex> lock(mutex_);
+            injected_.push_back(t);
+            injected_size_.fetch_add(1, std::memory_order_release);
+        }
+
+        // a sleeper checks queued_ under the mutex, taking the mutex
+        // here makes sure the notification is not lost
+        if(sleepers_.load() > 0){
+            { std::lock_guard<std::mutex> lock(mutex_);}
+            cv_.notify_one();
+        }
+    }
+
+    inline sc::utils::task *thread_pool::find_task(size_type index) {
+        sc::utils::task* t = nullptr;
+
+        if(index != npos){
+            if(auto popped = workers_[index]->pop())
+                t = *popped;
+        }
+
+        if(t == nullptr && injected_size_.load(std::memory_order_acquire) > 0){
+            std::lock_guard<std::mutex> lock(mutex_);
+            if(!injected_.empty()){
+                t = injected_.front();
+                injected_.pop_front();
+                injected_size_.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        if(t == nullptr){
+            // steal from the victims in turn, starting at a random one
+            static thread_local std::uint32_t seed = 0;
+            if(seed == 0){
+                // the first steal of the thread. a worker mixes its index, another thread the address
+                // of its seed, so that the idle workers don't try the same victims in the same order
+                std::uint64_t key = index != npos ? index + 1 : reinterpret_cast<std::uintptr_t>(&seed);
+                seed = static_cast<std::uint32_t>((key * 0x9E3779B97F4A7C15ull) >> 32) | 1u;
+            }
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+
+            size_type n = workers_.size();
+            size_type start = seed % n;
+            for(size_type i=0; i<n && t == nullptr; ++i){
+                size_type victim = (start + i) % n;
+                if(victim == index)
+                    continue;
+                if(auto stolen = workers_[victim]->steal())
+                    t = *stolen;
+            }
+        }
+
+        if(t != nullptr)
+            queued_.fetch_sub(1);
+        return t;
+    }
+
+    inline void thread_pool::execute(sc::utils::task *t) {
+        task_group* group = t->group_;
+        try {
+            t->execute();
+        }catch (...){
+            if(group != nullptr)
+                group->set_exception(std::current_exception());
+        }
+        delete t;
+
+        // the group may be destroyed as soon as pending_ reaches 0, this is the last access
+        if(group != nullptr)
+            group->pending_.fetch_sub(1, std::memory_order_release);
+    }
+
+    inline bool thread_pool::run_one() {
+        sc::utils::task* t = find_task(current_index());
+        if(t == nullptr)
+            return false;
+        execute(t);
+        return true;
+    }
+
+    inline void thread_pool::worker_loop(size_type index) {
+        current_pool_ = this;
+        current_index_ = index;
+
+        while(true){
+            sc::utils::task* t = find_task(index);
+
+            // spin a little before going to sleep, a task is likely to come soon
+            for(int i=0; i<64 && t == nullptr; ++i){
+                std::this_thread::yield();
+                t = find_task(index);
+            }
+
+            if(t != nullptr){
+                execute(t);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            sleepers_.fetch_add(1);
+            cv_.wait(lock, [this]{ return queued_.load() > 0 || stop_.load();});
+            sleepers_.fetch_sub(1);
+
+            // the remaining tasks are run before the pool stops
+            if(stop_.load() && queued_.load() == 0)
+                return;
+        }
+    }
+
+    template<class Index, class F>
+    void thread_pool::split(task_group &group, Index first, Index last, Index grain, const F &body) {
+        // fork the upper half and continue with the lower half
+        while(last - first > grain){
+            Index mid = first + (last - first) / 2;
+            group.run([this, &group, mid, last, grain, &body]{ split(group, mid, last, grain, body);});
+            last = mid;
+        }
+        body(first, last);
+    }
+
+    template<class Index, class F>
+    void thread_pool::parallel_for(Index first, Index last, const F &f, Index grain) {
+        if(!(first < last))
+            return;
+        if(grain < 1)
+            grain = 1;
+
+        // the forked tasks refer to body, it must outlive the group
+        auto body = [&f](Index lo, Index hi){
+            for(; lo != hi; ++lo)
+                f(lo);
+        };
+        task_group group(*this);
+        split(group, first, last, grain, body);
+        group.wait();
+    }
+
+    template<class RandomIt, class F>
+    void thread_pool::parallel_for_each(RandomIt first, RandomIt last, const F &f, size_type grain) {
+        size_type n = last - first;
+        if(n == 0)
+            return;
+        if(grain < 1)
+            grain = 1;
+
+        auto body = [&f, &first](size_type lo, size_type hi){
+            RandomIt iter = first + lo;
+            for(; lo != hi; ++lo, ++iter)
+                f(*iter);
+        };
+        task_group group(*this);
+        split(group, size_type(0), n, grain, body);
+        group.wait();
+    }
+
+}
+
+#endif //STLCONTAINER_THREAD_POOL_HPP
@@ -0,0 +1,62 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_UNORDERED_MULTIMAP_HPP
+#define STLCONTAINER_UNORDERED_MULTIMAP_HPP
+
+/*
+ * Node-based hash map with equal keys.
+ *
+ * The implementation is the one of unordered_multiset, the nodes hold the
+ * key-value pairs. A key with n values costs n nodes, where an
+ * unordered_map<Key, std::vector<T>> costs a node and a vector buffer.
+ */
+
+#include <type_traits>
+#include <utility>
+#include "multi_hashtable.hpp"
+
+namespace sc::regular{
+
+    template <
+            class Key,
+            class T,
+            class Hash = sc::utils::hash<Key>,
+            class KeyEqual = std::equal_to<Key>,
+            class Layout = sc::utils::dinkumware_layout,
+            class BucketIndex = sc::utils::prime_index
+    >
+    class unordered_multimap: public sc::utils::multi_hashtable<Key, std::pair<const Key, T>, sc::utils::key_of_pair, Hash, KeyEqual, Layout, BucketIndex>{
+
+        using base = sc::utils::multi_hashtable<Key, std::pair<const Key, T>, sc::utils::key_of_pair, Hash, KeyEqual, Layout, BucketIndex>;
+
+    public:
+        using mapped_type = T;
+
+        using iterator = typename base::iterator;
+
+        using const_iterator = typename base::const_iterator;
+
+        using base::base;
+
+        using base::insert;
+
+        // inserts a value constructed from value, which is a pair or converts to one
+        template <class P, class = std::enable_if_t<std::is_constructible_v<typename base::value_type, P&&>>>
+        iterator insert( P&& value) { return this->emplace(std::forward<P>(value));}
+
+        template <class P, class = std::enable_if_t<std::is_constructible_v<typename base::value_type, P&&>>>
+        iterator insert( const_iterator, P&& value) { return this->emplace(std::forward<P>(value));}
+
+        void swap(unordered_multimap& other) noexcept { base::swap(other);}
+    };
+
+    template <class Key, class T, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    void swap(unordered_multimap<Key, T, Hash, KeyEqual, Layout, BucketIndex>& lhs, unordered_multimap<Key, T, Hash, KeyEqual, Layout, BucketIndex>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+}
+
+#endif //STLCONTAINER_UNORDERED_MULTIMAP_HPP
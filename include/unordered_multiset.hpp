@@ -0,0 +1,47 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_UNORDERED_MULTISET_HPP
+#define STLCONTAINER_UNORDERED_MULTISET_HPP
+
+/*
+ * Node-based hash set with equal keys.
+ *
+ * The equal keys are adjacent in the node list and the first of them holds
+ * their number, so count() costs one lookup and equal_range() one lookup
+ * and a walk over the equal keys, see multi_hashtable.hpp. Layout is
+ * sc::utils::dinkumware_layout (default) or sc::utils::forward_layout, see
+ * unordered_set.hpp; the layouts with trees or incremental rehashing are
+ * not supported.
+ */
+
+#include "multi_hashtable.hpp"
+
+namespace sc::regular{
+
+    template <
+            class Key,
+            class Hash = sc::utils::hash<Key>,
+            class KeyEqual = std::equal_to<Key>,
+            class Layout = sc::utils::dinkumware_layout,
+            class BucketIndex = sc::utils::prime_index
+    >
+    class unordered_multiset: public sc::utils::multi_hashtable<Key, Key, sc::utils::key_of_identity, Hash, KeyEqual, Layout, BucketIndex>{
+
+        using base = sc::utils::multi_hashtable<Key, Key, sc::utils::key_of_identity, Hash, KeyEqual, Layout, BucketIndex>;
+
+    public:
+        using base::base;
+
+        void swap(unordered_multiset& other) noexcept { base::swap(other);}
+    };
+
+    template <class Key, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    void swap(unordered_multiset<Key, Hash, KeyEqual, Layout, BucketIndex>& lhs, unordered_multiset<Key, Hash, KeyEqual, Layout, BucketIndex>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+}
+
+#endif //STLCONTAINER_UNORDERED_MULTISET_HPP
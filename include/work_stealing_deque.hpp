@@ -0,0 +1,215 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_WORK_STEALING_DEQUE_HPP
+#define STLCONTAINER_WORK_STEALING_DEQUE_HPP
+
+/*
+ * Chase-Lev work-stealing deque.
+ *
+ * One thread owns the deque and pushes and pops elements at the bottom,
+ * like a stack. Any other thread may steal elements from the top. The
+ * owner only synchronizes with thieves when the deque holds one element,
+ * so the common push/pop path costs no atomic read-modify-write.
+ *
+ * The elements are stored in a circular array indexed by top_ and bottom_,
+ * which only grow. When the array is full, the owner copies the elements
+ * to an array of twice the size. A thief which has loaded the old array
+ * may still read from it, so the old array is retired instead of freed,
+ * and all retired arrays are freed when the deque is destroyed. Their total
+ * size is less than the size of the current array.
+ *
+ * The elements are read and written by several threads without locks,
+ * so T must be trivially copyable. Usually T is a pointer to a task.
+ *
+ * references: Chase, D., Lev, Y. Dynamic circular work-stealing deque. SPAA 2005.
+ *             Le, N. M. et al. Correct and efficient work-stealing for weak memory models. PPoPP 2013.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#include "cache_line.hpp"
+
+namespace sc::lock_free{
+
+    template <class T>
+    class work_stealing_deque{
+
+        static_assert(std::is_trivially_copyable_v<T>, "elements of work_stealing_deque must be trivially copyable");
+
+    public:
+
+        using value_type = T;
+
+        using size_type = std::size_t;
+
+        // the capacity is rounded up to the next power of two
+        explicit work_stealing_deque(size_type capacity = 64);
+
+        // the deque is shared by several threads, it can not be copied or moved
+        work_stealing_deque(const work_stealing_deque&) = delete;
+        work_stealing_deque&operator=(const work_stealing_deque&) = delete;
+
+        ~work_stealing_deque();
+
+        /*
+         * Owner
+         */
+
+        // push the value at the bottom, grows the array if it's full
+        void push(const value_type& value);
+
+        // pop the value at the bottom, returns an empty optional if the deque is empty
+        std::optional<value_type> pop();
+
+        /*
+         * Thieves
+         */
+
+        // steal the value at the top. returns an empty optional if the deque is
+        // empty or another thread took the value first
+        std::optional<value_type> steal();
+
+        /*
+         * Capacity
+         */
+
+        // the result is only a snapshot while other threads are running
+        size_type size() const;
+
+        bool empty() const { return size() == 0;}
+
+        size_type capacity() const { return array_.load(std::memory_order_relaxed)->capacity();}
+
+    private:
+
+        // fixed-size circular array, the index is masked into the array
+        class circular_array{
+        public:
+            explicit circular_array(std::int64_t capacity): mask_(capacity - 1), buffer_(new std::atomic<T>[capacity]){}
+
+            ~circular_array(){ delete[] buffer_;}
+
+            std::int64_t capacity() const { return mask_ + 1;}
+
+            T get(std::int64_t i) const { return buffer_[i & mask_].load(std::memory_order_relaxed);}
+
+            void put(std::int64_t i, const T& value) { buffer_[i & mask_].store(value, std::memory_order_relaxed);}
+
+            // returns a new array of twice the size which holds the elements in [top, bottom)
+            circular_array* grow(std::int64_t top, std::int64_t bottom) const{
+                auto array = new circular_array(2 * capacity());
+                for(std::int64_t i = top; i != bottom; ++i)
+                    array->put(i, get(i));
+                return array;
+            }
+
+        private:
+            std::int64_t mask_;
+            std::atomic<T>* buffer_;
+        };
+
+        // written by thieves
+        alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> top_;
+
+        // written by the owner
+        alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> bottom_;
+        std::atomic<circular_array*> array_;
+
+        // arrays replaced by grow, they may still be read by thieves. only touched by the owner
+        std::vector<circular_array*> retired_;
+    };
+
+    template<class T>
+    work_stealing_deque<T>::work_stealing_deque(size_type capacity): top_(0), bottom_(0) {
+        std::int64_t n = 1;
+        while(static_cast<size_type>(n) < capacity)
+            n <<= 1;
+        array_.store(new circular_array(n), std::memory_order_relaxed);
+    }
+
+    template<class T>
+    work_stealing_deque<T>::~work_stealing_deque() {
+        for(auto array: retired_)
+            delete array;
+        delete array_.load(std::memory_order_relaxed);
+    }
+
+    template<class T>
+    void work_stealing_deque<T>::push(const value_type &value) {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        circular_array* array = array_.load(std::memory_order_relaxed);
+
+        // if the array is full, move the elements to a bigger one
+        if(b - t > array->capacity() - 1){
+            circular_array* bigger = array->grow(t, b);
+            retired_.push_back(array);
+            array = bigger;
+            array_.store(array, std::memory_order_release);
+        }
+
+        array->put(b, value);
+        // the element must be visible before the new bottom
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    template<class T>
+    std::optional<T> work_stealing_deque<T>::pop() {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        circular_array* array = array_.load(std::memory_order_relaxed);
+
+        // reserve the bottom element before looking at top
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+
+        std::optional<T> result;
+        if(t <= b){
+            result = array->get(b);
+            if(t == b){
+                // the last element, race against the thieves for it
+                if(!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    result.reset();
+                bottom_.store(b + 1, std::memory_order_relaxed);
+            }
+        } else{
+            // the deque is empty, restore bottom
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    template<class T>
+    std::optional<T> work_stealing_deque<T>::steal() {
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom_.load(std::memory_order_acquire);
+
+        std::optional<T> result;
+        if(t < b){
+            circular_array* array = array_.load(std::memory_order_acquire);
+            result = array->get(t);
+            // another thief or the owner may have taken the element
+            if(!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                result.reset();
+        }
+        return result;
+    }
+
+    template<class T>
+    typename work_stealing_deque<T>::size_type work_stealing_deque<T>::size() const {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_type>(b - t) : 0;
+    }
+
+}
+
+#endif //STLCONTAINER_WORK_STEALING_DEQUE_HPP
@@ -5,6 +5,7 @@
 #ifndef STLCONTAINER_ARRAY_ITERATOR_HPP
 #define STLCONTAINER_ARRAY_ITERATOR_HPP
 
+#include <iterator>
 #include "iterator_base.hpp"
 
 namespace sc::utils{
@@ -12,12 +13,20 @@ namespace sc::utils{
     //array iterator is implicity random access
     template <class T>
     class array_iterator : public iterator_base<T, array_iterator<T>> {
+    public:
 
         // C++ doesn’t consider superclass templates for name resolution
         using iterator_base<T, array_iterator<T>>::ptr_;
         using typename iterator_base<T, array_iterator<T>>::difference_type ;
         using typename iterator_base<T, array_iterator<T>>::pointer;
         using typename iterator_base<T, array_iterator<T>>::reference;
+        using iterator_category = std::random_access_iterator_tag;
+
+        array_iterator(pointer ptr = nullptr): iterator_base<T, array_iterator<T>>(ptr){}
+
+        //forbids to copy a const iterator to a non-const iterator
+        template <class OtherT, class = std::enable_if_t<std::is_convertible_v<OtherT*, T*>>>
+        array_iterator(const array_iterator<OtherT>& other): iterator_base<T, array_iterator<T>>(other){}
 
         //forward
         array_iterator&operator++() {
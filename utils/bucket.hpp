@@ -14,29 +14,28 @@
  * references: http://bannalia.blogspot.com/2013/10/implementation-of-c-unordered.html
  */
 
-#include "list_node.hpp"
-
 // forward declare friend classes
-namespace sc::regular{
-    template <class> class list;
+namespace sc::utils{
+    template <class> class dinkumware_storage;
 }
 
 
 namespace sc::utils{
 
-    template <class T>
+    // the nodes of a bucket are adjacent in the list, the bucket
+    // points to the first and the last one. both are nullptr if it's empty
+    template <class Node>
     class bucket{
     public:
-        bucket(unsigned long hash): hash_(hash), first_(nullptr), last_(nullptr){}
+        bucket(): first_(nullptr), last_(nullptr){}
     private:
-        template <class> friend class sc::regular::list;
+        template <class> friend class sc::utils::dinkumware_storage;
 
     protected:
-        sc::utils::list_node<T>* first_;
-        sc::utils::list_node<T>* last_;
-        unsigned long hash_;
+        Node* first_;
+        Node* last_;
     };
 
 }
 
-#endif //STLCONTAINER_SET_NODE_HPP
+#endif //STLCONTAINER_BUCKET_HPP
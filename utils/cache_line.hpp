@@ -0,0 +1,29 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_CACHE_LINE_HPP
+#define STLCONTAINER_CACHE_LINE_HPP
+
+// the size of a cache line on common x86-64 and arm64 targets.
+// data written by different threads should sit on different
+// cache lines to avoid false sharing
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+namespace sc::utils{
+
+    // asks the cpu to load the cache line of ptr for a read. it's only a
+    // hint, ptr may be invalid or nullptr
+    inline void prefetch(const void* ptr){
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(ptr);
+#else
+        (void)ptr;
+#endif
+    }
+
+}
+
+#endif //STLCONTAINER_CACHE_LINE_HPP
@@ -5,6 +5,9 @@
 #ifndef STLCONTAINER_DEQUE_ITERATOR_HPP
 #define STLCONTAINER_DEQUE_ITERATOR_HPP
 
+#include <cassert>
+#include <cmath>
+#include <iterator>
 #include "iterator_base.hpp"
 
 #define BLOCK_SIZE 8
@@ -25,8 +28,9 @@ namespace sc::utils{
         using typename iterator_base<T, deque_iterator<T>>::difference_type ;
         using typename iterator_base<T, deque_iterator<T>>::pointer;
         using typename iterator_base<T, deque_iterator<T>>::reference;
+        using iterator_category = std::random_access_iterator_tag;
 
-        deque_iterator(T* ptr= nullptr, T** block = nullptr):iterator_base<T,deque_iterator>(ptr),
+        deque_iterator(T* ptr= nullptr, value_type** block = nullptr):iterator_base<T,deque_iterator>(ptr),
                 first_(block == nullptr? nullptr: *block),
                 last_(block == nullptr? nullptr: (*block+BLOCK_SIZE)),
                 block_(block){}
@@ -49,11 +53,9 @@ namespace sc::utils{
 //            other.block_ = nullptr;
 //        }
 
-        // copy and move assignment
-        deque_iterator operator=(deque_iterator other){
-            swap(*this, other);
-            return *this;
-        }
+        // copy and move, the members are plain pointers
+        deque_iterator(const deque_iterator&) = default;
+        deque_iterator&operator=(const deque_iterator&) = default;
 
         // initialize by a map pointer and a current pointer
         void set(T** block, difference_type offset=0){
@@ -109,57 +111,30 @@ namespace sc::utils{
         }
 
         deque_iterator&operator+=(difference_type n){
-            // the remaining space to end of block
-            difference_type remain = last_ - ptr_ - 1;
-
-            // the number of blocks to be jumped
-            difference_type blocknum = n>remain? ceil((float)(n-remain)/BLOCK_SIZE) : 0;
-            block_ += blocknum;
-            first_ = *block_;
-            last_ = first_+BLOCK_SIZE;
-            ptr_ = first_ + ((n-remain)%BLOCK_SIZE);
-            return *this;
-        }
-
-        deque_iterator&operator-=(difference_type n){
-            // the remaining space to the beginning of block
-            difference_type remain = ptr_ - first_;
-
-            // the number of blocks to be jumped
-            difference_type blocknum = n>remain? ceil((float)(n-remain)/BLOCK_SIZE) : 0;
+            // the offset of the target from the beginning of current block
+            difference_type offset = n + (ptr_ - first_);
 
-            //decrement out of bound is undefined behaviour
-            if(blocknum == 0)
-                ptr_ -= n;
-            else {
-                block_ -= blocknum;
+            if(offset >= 0 && offset < BLOCK_SIZE){
+                // the target is in the same block
+                ptr_ += n;
+            } else{
+                // the number of blocks to be jumped, rounded towards negative infinity
+                difference_type blocknum = offset > 0 ? offset / BLOCK_SIZE : -((-offset - 1) / BLOCK_SIZE) - 1;
+                block_ += blocknum;
                 first_ = *block_;
                 last_ = first_+BLOCK_SIZE;
-                ptr_ = last_ - ((n - remain) % BLOCK_SIZE);
+                ptr_ = first_ + (offset - blocknum * BLOCK_SIZE);
             }
-
             return *this;
         }
 
-        deque_iterator&operator[](difference_type n) const{
-            if(n>=0){
-                difference_type remain = last_ - ptr_ - 1;
-
-                difference_type blocknum = n>remain? ceil((float)(n-remain)/BLOCK_SIZE) : 0;
-
-                return *(*(block_+blocknum) + ((n-remain)%BLOCK_SIZE));
-            } else{
-                difference_type remain = ptr_ - first_;
-
-                if(n <= remain)
-                    return ptr_[n];
-                else{
-                    difference_type blocknum = ceil((-n-remain)/BLOCK_SIZE);
-
-                    return *(block_+blocknum)+ BLOCK_SIZE - (-n-remain)%BLOCK_SIZE;
-                }
+        deque_iterator&operator-=(difference_type n){
+            //decrement out of bound is undefined behaviour
+            return *this += -n;
+        }
 
-            }
+        reference operator[](difference_type n) const{
+            return *(*this + n);
         }
 
         deque_iterator operator+(difference_type n) const{
@@ -225,6 +200,8 @@ namespace sc::utils{
     private:
         template <class> friend class sc::regular::deque;
         template <class> friend class deque_iterator;
+        template <class> friend class deque_segments;
+        template <class> friend class deque_segment_iterator;
         // move to the next block
         void nextblock();
         // move to the previous block
@@ -0,0 +1,134 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_DEQUE_SEGMENT_HPP
+#define STLCONTAINER_DEQUE_SEGMENT_HPP
+
+/*
+ * A deque stores its elements in fixed-size blocks, every block
+ * is contiguous in memory. A range [first, last) of deque iterators
+ * can therefore be split into at most one run per block, which is
+ * called a segment here.
+ *
+ * Walking a range segment by segment moves the block-boundary check
+ * out of the inner loop: the inner loop runs on plain pointers and
+ * can be vectorized by the compiler, just like a loop over vector.
+ */
+
+#include <cstddef>
+#include "deque_iterator.hpp"
+
+namespace sc::utils{
+
+    // a contiguous run of elements inside a single block
+    template <class T>
+    class deque_segment{
+    public:
+        using value_type = std::remove_const_t<T>;
+
+        using size_type = std::size_t;
+
+        using pointer = T*;
+
+        using iterator = T*;
+
+        deque_segment(T* first, T* last, value_type** block): first_(first), last_(last), block_(block){}
+
+        // the segment can be used as a span in range-based for
+        iterator begin() const { return first_;}
+        iterator end() const { return last_;}
+
+        pointer data() const { return first_;}
+
+        size_type size() const { return last_ - first_;}
+
+        bool empty() const { return first_ == last_;}
+
+        // returns the deque iterator which points to ptr
+        // ptr must be inside [begin(), end()]
+        deque_iterator<T> iterator_at(T* ptr) const { return deque_iterator<T>(ptr, block_);}
+
+    private:
+        T* first_; // first element of the segment
+        T* last_; // one-past-the-last element of the segment
+        value_type** block_; // the block in the map that holds the segment
+    };
+
+    // forward iterator which yields the segments of a deque range
+    template <class T>
+    class deque_segment_iterator{
+    public:
+        using value_type = deque_segment<T>;
+
+        using block_type = std::remove_const_t<T>;
+
+        deque_segment_iterator(block_type** block, T* ptr, block_type** last_block, T* last_ptr):
+            block_(block), ptr_(ptr), last_block_(last_block), last_ptr_(last_ptr){}
+
+        // open-ended walk starting at iter, every segment runs to the end of its block.
+        // the caller is responsible for not walking past the allocated blocks
+        explicit deque_segment_iterator(const deque_iterator<T>& iter):
+            block_(iter.block_), ptr_(iter.ptr_), last_block_(nullptr), last_ptr_(nullptr){}
+
+        value_type operator*() const {
+            // only the last block is cut by the end of the range
+            T* last = block_ == last_block_ ? last_ptr_ : *block_ + BLOCK_SIZE;
+            return value_type(ptr_, last, block_);
+        }
+
+        deque_segment_iterator& operator++(){
+            if(block_ == last_block_){
+                // the only segment left is the last one, jump to end
+                ptr_ = last_ptr_;
+            } else{
+                ++block_;
+                ptr_ = *block_;
+            }
+            return *this;
+        }
+
+        deque_segment_iterator operator++(int){
+            deque_segment_iterator old(*this);
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const deque_segment_iterator& other) const{
+            return block_ == other.block_ && ptr_ == other.ptr_;
+        }
+
+        bool operator!=(const deque_segment_iterator& other) const{
+            return !(*this == other);
+        }
+
+    private:
+        block_type** block_; // the block of the current segment
+        T* ptr_; // first element of the current segment
+        block_type** last_block_; // the block which holds the end of range
+        T* last_ptr_; // the end of range
+    };
+
+    // view over the segments of [first, last)
+    // the finish iterator of a deque always points into a valid block,
+    // if the range ends at the beginning of a block, no empty segment is yielded
+    template <class T>
+    class deque_segments{
+    public:
+        using iterator = deque_segment_iterator<T>;
+
+        deque_segments(const deque_iterator<T>& first, const deque_iterator<T>& last):
+            first_(first.block_, first.ptr_, last.block_, last.ptr_),
+            last_(last.block_, last.ptr_, last.block_, last.ptr_){}
+
+        iterator begin() const { return first_;}
+        iterator end() const { return last_;}
+
+    private:
+        iterator first_;
+        iterator last_;
+    };
+
+}
+
+#endif //STLCONTAINER_DEQUE_SEGMENT_HPP
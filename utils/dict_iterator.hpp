@@ -0,0 +1,78 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_DICT_ITERATOR_HPP
+#define STLCONTAINER_DICT_ITERATOR_HPP
+
+#include <cstddef>
+#include <iterator>
+#include "iterator_base.hpp"
+
+namespace sc::regular{
+    template <class, class, class, class> class compact_dict;
+}
+
+namespace sc::utils{
+
+    // the stored hash of an erased entry, a key whose hash is this value is stored with another one
+    inline constexpr std::size_t DICT_TOMBSTONE = ~std::size_t(0);
+
+    // forward iterator of compact_dict. it walks the entries and their hashes
+    // side by side, skipping the erased entries
+    template <class T>
+    class dict_iterator: public iterator_base<T, dict_iterator<T>>{
+    public:
+
+        // C++ doesn’t consider superclass templates for name resolution
+        using iterator_base<T, dict_iterator<T>>::ptr_;
+        using typename iterator_base<T, dict_iterator<T>>::difference_type ;
+        using typename iterator_base<T, dict_iterator<T>>::pointer;
+        using typename iterator_base<T, dict_iterator<T>>::reference;
+        using iterator_category = std::forward_iterator_tag;
+
+        dict_iterator(): iterator_base<T, dict_iterator<T>>(nullptr), hash_(nullptr), end_(nullptr){}
+
+        // hash: the hash of the entry, end: the end of the hashes.
+        // if the entry is erased, the iterator moves to the next one which is not
+        dict_iterator(const std::size_t* hash, const std::size_t* end, pointer entry):
+            iterator_base<T, dict_iterator<T>>(entry), hash_(hash), end_(end){
+            skip();
+        }
+
+        //forbids to copy a const iterator to a non-const iterator
+        template <class OtherT, class = std::enable_if_t<std::is_convertible_v<OtherT*, T*>>>
+        dict_iterator(const dict_iterator<OtherT>& other): iterator_base<T, dict_iterator<T>>(other),
+            hash_(other.hash_), end_(other.end_){}
+
+        dict_iterator&operator++(){
+            ++hash_;
+            ++ptr_;
+            skip();
+            return *this;
+        }
+
+        dict_iterator operator++(int){
+            dict_iterator old(*this);
+            ++(*this);
+            return old;
+        }
+
+    private:
+        template <class> friend class dict_iterator;
+        template <class, class, class, class> friend class sc::regular::compact_dict;
+
+        void skip(){
+            while(hash_ != end_ && *hash_ == DICT_TOMBSTONE){
+                ++hash_;
+                ++ptr_;
+            }
+        }
+
+        const std::size_t* hash_; // the hash of the current entry
+        const std::size_t* end_; // the end of the hashes
+    };
+
+}
+
+#endif //STLCONTAINER_DICT_ITERATOR_HPP
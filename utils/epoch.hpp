@@ -0,0 +1,249 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_EPOCH_HPP
+#define STLCONTAINER_EPOCH_HPP
+
+/*
+ * Epoch-based memory reclamation.
+ *
+ * A lock-free reader may still hold a pointer to an object which a writer
+ * has just unlinked, so the writer retires the object instead of deleting
+ * it. A reader pins the domain while it holds such pointers. The domain
+ * keeps a global epoch, and every pinned thread announces the epoch it saw
+ * when it pinned. The global epoch advances only when every pinned thread
+ * has announced the current one, so an object retired in epoch e can't be
+ * reached by any reader once the global epoch is e + 2, and it is deleted.
+ *
+ * Every thread owns a record with its announced epoch and its retired
+ * objects, so pinning and retiring touch no shared cache line. A record is
+ * reused by another thread after its thread exits, the objects left in it
+ * are handed to the domain. A thread finds its record in a thread_local,
+ * so there is a single domain, instance().
+ *
+ * references: Fraser, K. Practical lock-freedom. 2004.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "cache_line.hpp"
+
+namespace sc::utils{
+
+    class epoch_domain{
+
+        // an object waiting to be deleted
+        struct retired{
+            void* ptr_;
+            void (*deleter_)(void*);
+            std::uint64_t epoch_; // the global epoch when it was retired
+        };
+
+        struct alignas(CACHE_LINE_SIZE) record{
+            std::atomic<std::uint64_t> epoch_{0}; // the announced epoch, 0 if the thread is not pinned
+            std::atomic<bool> used_{false}; // owned by a thread
+            record* next_ = nullptr; // the next record of the domain, records are never removed
+            unsigned depth_ = 0; // nested pins of the owner thread
+            std::vector<retired> retired_; // retired by the owner thread
+        };
+
+    public:
+
+        using size_type = std::size_t;
+
+        // the pin of the current thread, the objects read while it's held are not deleted
+        class guard{
+        public:
+            guard(const guard&) = delete;
+            guard&operator=(const guard&) = delete;
+
+            ~guard(){ domain_->unpin(record_);}
+
+        private:
+            friend class epoch_domain;
+
+            guard(epoch_domain* domain, record* rec): domain_(domain), record_(rec){}
+
+            epoch_domain* domain_;
+            record* record_;
+        };
+
+        epoch_domain(const epoch_domain&) = delete;
+        epoch_domain&operator=(const epoch_domain&) = delete;
+
+        // all threads must have released their records
+        ~epoch_domain();
+
+        // the domain shared by the lock-free containers, the only one
+        static epoch_domain& instance(){
+            static epoch_domain domain;
+            return domain;
+        }
+
+        guard pin(){
+            record* rec = local();
+            if(rec->depth_++ == 0){
+                // the announcement must be visible before the shared pointers are read,
+                // a seq_cst exchange orders it like a store followed by a full fence
+                rec->epoch_.exchange(epoch_.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+            }
+            return guard(this, rec);
+        }
+
+        // delete ptr by deleter when no reader can hold it
+        void retire(void* ptr, void (*deleter)(void*));
+
+        template <class T>
+        void retire(T* ptr){ retire(ptr, [](void* p){ delete static_cast<T*>(p);});}
+
+        // try to advance the epoch and delete the objects retired by this thread
+        void collect(){ collect(local());}
+
+    private:
+        // a thread keeps its record in one thread_local, which can't tell domains apart,
+        // so there's one domain and it's constructed only by instance()
+        epoch_domain(): epoch_(1), records_(nullptr){}
+
+        // the objects a thread retires before it tries to delete them
+        static constexpr size_type COLLECT_THRESHOLD = 64;
+
+        void unpin(record* rec){
+            if(--rec->depth_ == 0)
+                rec->epoch_.store(0, std::memory_order_release);
+        }
+
+        // the record of the current thread, acquired at its first use
+        record* local();
+
+        record* acquire();
+
+        void release(record* rec);
+
+        // advance the global epoch if every pinned thread has announced it
+        std::uint64_t try_advance();
+
+        void collect(record* rec);
+
+        // deletes the objects of list retired before epoch - 1, keeps the others
+        static void free_before(std::vector<retired>& list, std::uint64_t epoch);
+
+        std::atomic<std::uint64_t> epoch_; // the global epoch, starts at 1
+        std::atomic<record*> records_; // the list of records
+
+        std::mutex mutex_; // guards orphans_
+        std::vector<retired> orphans_; // left by the threads which exited
+    };
+
+    inline epoch_domain::~epoch_domain() {
+        record* rec = records_.load(std::memory_order_acquire);
+        while(rec != nullptr){
+            record* next = rec->next_;
+            for(auto& r: rec->retired_)
+                r.deleter_(r.ptr_);
+            delete rec;
+            rec = next;
+        }
+        for(auto& r: orphans_)
+            r.deleter_(r.ptr_);
+    }
+
+    inline void epoch_domain::retire(void *ptr, void (*deleter)(void *)) {
+        record* rec = local();
+        // the epoch is read after ptr is unlinked, an earlier epoch would delete it too soon
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        rec->retired_.push_back(retired{ptr, deleter, epoch_.load(std::memory_order_relaxed)});
+        if(rec->retired_.size() >= COLLECT_THRESHOLD)
+            collect(rec);
+    }
+
+    inline epoch_domain::record *epoch_domain::local() {
+        // releases the record when the thread exits
+        struct holder{
+            epoch_domain* domain_ = nullptr;
+            record* record_ = nullptr;
+            ~holder(){
+                if(record_ != nullptr)
+                    domain_->release(record_);
+            }
+        };
+        thread_local holder h;
+        if(h.record_ == nullptr){
+            h.record_ = acquire();
+            h.domain_ = this;
+        }
+        return h.record_;
+    }
+
+    inline epoch_domain::record *epoch_domain::acquire() {
+        // reuse the record of a thread which exited
+        for(record* rec = records_.load(std::memory_order_acquire); rec != nullptr; rec = rec->next_){
+            bool used = false;
+            if(!rec->used_.load(std::memory_order_relaxed) &&
+               rec->used_.compare_exchange_strong(used, true, std::memory_order_acquire))
+                return rec;
+        }
+
+        auto rec = new record;
+        rec->used_.store(true, std::memory_order_relaxed);
+        record* head = records_.load(std::memory_order_relaxed);
+        do {
+            rec->next_ = head;
+        } while(!records_.compare_exchange_weak(head, rec, std::memory_order_release, std::memory_order_relaxed));
+        return rec;
+    }
+
+    inline void epoch_domain::release(record *rec) {
+        if(!rec->retired_.empty()){
+            std::lock_guard<std::mutex> lock(mutex_);
+            orphans_.insert(orphans_.end(), rec->retired_.begin(), rec->retired_.end());
+        }
+        rec->retired_.clear();
+        rec->retired_.shrink_to_fit();
+        rec->used_.store(false, std::memory_order_release);
+    }
+
+    inline std::uint64_t epoch_domain::try_advance() {
+        std::uint64_t epoch = epoch_.load(std::memory_order_acquire);
+        // pairs with the exchange of pin(): a thread which pinned before the fence is seen here,
+        // a thread which pins after it reads the pointers unlinked before it
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for(record* rec = records_.load(std::memory_order_acquire); rec != nullptr; rec = rec->next_){
+            // acquire: the reads of an unpinned thread happen before the objects are deleted
+            std::uint64_t e = rec->epoch_.load(std::memory_order_acquire);
+            if(e != 0 && e != epoch)
+                return epoch;
+        }
+        if(epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel))
+            return epoch + 1;
+        return epoch;
+    }
+
+    inline void epoch_domain::collect(record *rec) {
+        std::uint64_t epoch = try_advance();
+        free_before(rec->retired_, epoch);
+
+        // the orphans are collected by any thread, without waiting for the lock
+        std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+        if(lock.owns_lock())
+            free_before(orphans_, epoch);
+    }
+
+    inline void epoch_domain::free_before(std::vector<retired> &list, std::uint64_t epoch) {
+        auto keep = list.begin();
+        for(auto iter = list.begin(); iter != list.end(); ++iter){
+            if(iter->epoch_ + 2 <= epoch)
+                iter->deleter_(iter->ptr_);
+            else
+                *keep++ = *iter;
+        }
+        list.erase(keep, list.end());
+    }
+
+}
+
+#endif //STLCONTAINER_EPOCH_HPP
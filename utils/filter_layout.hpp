@@ -0,0 +1,123 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_FILTER_LAYOUT_HPP
+#define STLCONTAINER_FILTER_LAYOUT_HPP
+
+/*
+ * filter_layout: a layout whose table checks a filter before it walks a
+ * bucket.
+ *
+ * The filter holds the hashes of the keys of the table. A lookup whose
+ * hash is not in the filter returns at once, so a lookup which misses
+ * reads one cache line of the filter instead of the bucket and the nodes
+ * of its chain. A lookup which hits pays the filter on top of the walk, so
+ * the filter is worth it when most lookups miss. The insertions look their
+ * key up first, a new key skips its walk too.
+ *
+ * The table inserts the hash of a node into the filter when the node is
+ * linked, and erases it when the node is unlinked if the filter supports
+ * it: sc::regular::cuckoo_filter does, sc::regular::bloom_filter keeps the
+ * bits of the erased keys, which only raises its false-positive rate. The
+ * filter is rebuilt from the nodes, with room for the new bucket count,
+ * when the table rehashes. If an insertion into the filter fails, or the
+ * filter can't be allocated, the filter is bypassed until the next rehash,
+ * so the filter never makes a lookup miss a key or an insertion throw.
+ *
+ * stats() reports the memory and the false-positive rate of the filter.
+ */
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "bloom_filter.hpp"
+#include "cuckoo_filter.hpp"
+#include "hash_layout.hpp"
+
+namespace sc::utils{
+
+    // whether a filter erases a hash
+    template <class Filter, class = void>
+    struct filter_erases: std::false_type{};
+
+    template <class Filter>
+    struct filter_erases<Filter, std::void_t<decltype(std::declval<Filter&>().erase_hash(std::size_t()))>>: std::true_type{};
+
+    // the storage of the layout with a filter of the hashes of its nodes
+    template <class Storage, class Filter>
+    class filtered_storage: public Storage{
+    public:
+
+        using size_type = std::size_t;
+
+        using filter_type = Filter;
+
+        // the table checks the filter before the bucket
+        static constexpr bool filters = true;
+
+        filtered_storage(): bypassed_(true){}
+
+        // whether the table must look up hash in the buckets
+        bool may_contain(std::size_t hash) const noexcept { return bypassed_ || filter_.contains_hash(hash);}
+
+        void filter_insert(std::size_t hash) noexcept {
+            if(!bypassed_ && !filter_.insert_hash(hash))
+                bypassed_ = true;
+        }
+
+        void filter_erase(std::size_t hash) noexcept {
+            if constexpr (filter_erases<Filter>::value){
+                if(!bypassed_)
+                    filter_.erase_hash(hash);
+            }
+        }
+
+        // replaces the filter by one for capacity keys which holds the hashes of the nodes.
+        // the filter is bypassed if it can't be allocated or filled, or if hash_of throws
+        template <class HashOf>
+        void rebuild_filter(size_type capacity, HashOf hash_of) noexcept {
+            bypassed_ = true;
+            try {
+                Filter filter(capacity);
+                for(hash_link* link = this->first(); link != this->end_link(); link = link->next_){
+                    if(!filter.insert_hash(hash_of(link)))
+                        return;
+                }
+                filter_.swap(filter);
+                bypassed_ = false;
+            }catch (...){
+            }
+        }
+
+        const Filter& filter() const { return filter_;}
+
+        bool filter_bypassed() const { return bypassed_;}
+
+        void reset() noexcept {
+            Storage::reset();
+            filter_.clear();
+        }
+
+        void swap(filtered_storage& other) noexcept {
+            Storage::swap(other);
+            filter_.swap(other.filter_);
+            std::swap(bypassed_, other.bypassed_);
+        }
+
+    private:
+        Filter filter_;
+        bool bypassed_; // the filter is not up to date, every lookup walks its bucket
+    };
+
+    // Layout whose lookups check a filter first. Filter is a template of
+    // <Key, Hash>, sc::regular::bloom_filter or sc::regular::cuckoo_filter
+    template <template <class, class> class Filter = sc::regular::cuckoo_filter, class Layout = dinkumware_layout>
+    struct filter_layout{
+        template <class Value, class Key, class KeyOfValue, class Hash>
+        using storage = filtered_storage<typename Layout::template storage<Value, Key, KeyOfValue, Hash>, Filter<Key, Hash>>;
+    };
+
+}
+
+#endif //STLCONTAINER_FILTER_LAYOUT_HPP
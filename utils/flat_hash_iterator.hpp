@@ -0,0 +1,73 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_FLAT_HASH_ITERATOR_HPP
+#define STLCONTAINER_FLAT_HASH_ITERATOR_HPP
+
+#include <iterator>
+#include "iterator_base.hpp"
+
+namespace sc::utils{
+
+    template <class, class, class, class, class> class flat_hash_table;
+
+    // forward iterator of an open-addressing table. it walks the slot array
+    // and the control bytes side by side, skipping the slots that are not full
+    template <class T>
+    class flat_hash_iterator: public iterator_base<T, flat_hash_iterator<T>>{
+    public:
+
+        // C++ doesn’t consider superclass templates for name resolution
+        using iterator_base<T, flat_hash_iterator<T>>::ptr_;
+        using typename iterator_base<T, flat_hash_iterator<T>>::difference_type ;
+        using typename iterator_base<T, flat_hash_iterator<T>>::pointer;
+        using typename iterator_base<T, flat_hash_iterator<T>>::reference;
+        using iterator_category = std::forward_iterator_tag;
+
+        flat_hash_iterator(): iterator_base<T, flat_hash_iterator<T>>(nullptr), ctrl_(nullptr), end_(nullptr){}
+
+        // ctrl: the control byte of the slot, end: the end of the control bytes.
+        // if the slot is not full, the iterator moves to the next full one
+        flat_hash_iterator(const signed char* ctrl, const signed char* end, pointer slot):
+            iterator_base<T, flat_hash_iterator<T>>(slot), ctrl_(ctrl), end_(end){
+            skip();
+        }
+
+        //forbids to copy a const iterator to a non-const iterator
+        template <class OtherT, class = std::enable_if_t<std::is_convertible_v<OtherT*, T*>>>
+        flat_hash_iterator(const flat_hash_iterator<OtherT>& other): iterator_base<T, flat_hash_iterator<T>>(other),
+            ctrl_(other.ctrl_), end_(other.end_){}
+
+        flat_hash_iterator&operator++(){
+            ++ctrl_;
+            ++ptr_;
+            skip();
+            return *this;
+        }
+
+        flat_hash_iterator operator++(int){
+            flat_hash_iterator old(*this);
+            ++(*this);
+            return old;
+        }
+
+    private:
+        template <class> friend class flat_hash_iterator;
+        template <class, class, class, class, class> friend class flat_hash_table;
+
+        // empty and deleted slots have negative control bytes
+        void skip(){
+            while(ctrl_ != end_ && *ctrl_ < 0){
+                ++ctrl_;
+                ++ptr_;
+            }
+        }
+
+        const signed char* ctrl_; // the control byte of the current slot
+        const signed char* end_; // the end of the control bytes
+    };
+
+}
+
+#endif //STLCONTAINER_FLAT_HASH_ITERATOR_HPP
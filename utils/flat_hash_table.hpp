@@ -0,0 +1,853 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_FLAT_HASH_TABLE_HPP
+#define STLCONTAINER_FLAT_HASH_TABLE_HPP
+
+/*
+ * Open-addressing hash table shared by flat_hash_set and flat_hash_map.
+ *
+ * The elements are stored in one array of slots, which is split into groups
+ * of 16. Every slot has one control byte: empty, deleted, or the low 7 bits
+ * (the tag) of the hash of the element in a full slot. The other bits of the
+ * hash select the first group to probe, and the groups are probed in a
+ * triangular sequence, which visits every group because the number of
+ * groups is a power of two.
+ *
+ * A lookup loads the 16 control bytes of a group at once and compares all
+ * of them with the tag, with SSE2 when it's available. Only the slots with a
+ * matching tag are compared with the key, which is usually one slot. The
+ * probe stops at the first group that has an empty slot.
+ *
+ * A group which has an empty slot has never been full, so no probe has ever
+ * passed it. An element erased from such a group leaves an empty slot. Only
+ * an element erased from a full group leaves a tombstone (deleted), which
+ * is reused by insertion and dropped by the next rehash.
+ *
+ * The table grows when 7/8 of the slots are full or deleted. If tombstones
+ * take more than half of them, the table is rehashed at the same capacity.
+ *
+ * Rehashing moves the elements, so unlike unordered_set, the references
+ * to the elements are invalidated by an insertion that rehashes.
+ *
+ * references: https://abseil.io/about/design/swisstables
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "flat_hash_iterator.hpp"
+#include "hash.hpp"
+#include "key_of_value.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace sc::utils{
+
+    // the control bytes of one group of slots, which are matched at once
+    class flat_hash_group{
+    public:
+
+        using ctrl_type = signed char;
+
+        static constexpr std::size_t size = 16;
+
+        // the control bytes of the slots which are not full are negative
+        static constexpr ctrl_type EMPTY = -128;
+        static constexpr ctrl_type DELETED = -2;
+
+        // ctrl must be aligned to the size of group
+#ifdef __SSE2__
+        explicit flat_hash_group(const ctrl_type* ctrl): ctrl_(_mm_load_si128(reinterpret_cast<const __m128i*>(ctrl))){}
+
+        // returns a bitmask of the slots whose control byte is tag
+        unsigned match(ctrl_type tag) const {
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), ctrl_)));
+        }
+
+        // returns a bitmask of the empty and deleted slots
+        unsigned match_free() const {
+            return static_cast<unsigned>(_mm_movemask_epi8(ctrl_));
+        }
+#else
+        explicit flat_hash_group(const ctrl_type* ctrl): ctrl_(ctrl){}
+
+        unsigned match(ctrl_type tag) const {
+            unsigned mask = 0;
+            for(std::size_t i=0; i<size; ++i)
+                mask |= static_cast<unsigned>(ctrl_[i] == tag) << i;
+            return mask;
+        }
+
+        unsigned match_free() const {
+            unsigned mask = 0;
+            for(std::size_t i=0; i<size; ++i)
+                mask |= static_cast<unsigned>(ctrl_[i] < 0) << i;
+            return mask;
+        }
+#endif
+
+        // returns a bitmask of the empty slots
+        unsigned match_empty() const { return match(EMPTY);}
+
+        // the index of the lowest set bit, mask must not be 0
+        static std::size_t lowest(unsigned mask){
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_ctz(mask));
+#else
+            std::size_t i = 0;
+            for(; (mask & 1u) == 0; mask >>= 1)
+                ++i;
+            return i;
+#endif
+        }
+
+    private:
+#ifdef __SSE2__
+        __m128i ctrl_;
+#else
+        const ctrl_type* ctrl_;
+#endif
+    };
+
+    // KeyOfValue returns the key of a stored value
+    template <class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    class flat_hash_table{
+
+    public:
+        using key_type = Key;
+
+        using value_type = Value;
+
+        using size_type = std::size_t;
+
+        using difference_type = std::ptrdiff_t;
+
+        using hasher = Hash;
+
+        using key_equal = KeyEqual;
+
+        using reference = value_type &;
+
+        using const_reference = const value_type &;
+
+        using pointer = value_type *;
+
+        using const_pointer = const value_type *;
+
+        // the elements of a set are keys, which can not be modified by an iterator
+        using iterator = std::conditional_t<std::is_same_v<Key, Value>,
+                flat_hash_iterator<const Value>, flat_hash_iterator<Value>>;
+
+        using const_iterator = flat_hash_iterator<const Value>;
+
+        flat_hash_table(): flat_hash_table(size_type(0)){}
+
+        // allocates at least bucket_count slots
+        explicit flat_hash_table(size_type bucket_count,
+                const Hash& hash = Hash(),
+                const key_equal& equal = key_equal());
+
+        template <class InputIt>
+        flat_hash_table(InputIt first, InputIt last, size_type bucket_count = 0,
+                const Hash& hash = Hash(), const key_equal& equal = key_equal());
+
+        flat_hash_table(std::initializer_list<value_type> init, size_type bucket_count = 0,
+                const Hash& hash = Hash(), const key_equal& equal = key_equal());
+
+        // copy/move constructor
+        flat_hash_table(const flat_hash_table& other);
+        flat_hash_table(flat_hash_table&& other) noexcept ;
+
+        // copy/move assignment operator
+        // use copy-and-swap idiom and copy elision for better efficiency
+        flat_hash_table&operator=(flat_hash_table other);
+
+        ~flat_hash_table();
+
+        /*
+         * Iterators
+         */
+
+        iterator begin() noexcept { return iterator(ctrl_, ctrl_ + capacity_, slots_);}
+        const_iterator begin() const noexcept { return const_iterator(ctrl_, ctrl_ + capacity_, slots_);}
+        const_iterator cbegin() const noexcept { return begin();}
+
+        iterator end() noexcept { return iterator(ctrl_ + capacity_, ctrl_ + capacity_, slots_ + capacity_);}
+        const_iterator end() const noexcept { return const_iterator(ctrl_ + capacity_, ctrl_ + capacity_, slots_ + capacity_);}
+        const_iterator cend() const noexcept { return end();}
+
+        /*
+         * Capacity
+         */
+
+        bool empty() const { return size_ == 0;}
+
+        size_type size() const { return size_;}
+
+        size_type max_size() const { return std::numeric_limits<difference_type>::max() / (sizeof(value_type) + 1);}
+
+        /*
+         * Modifiers
+         */
+
+        void clear() noexcept ;
+
+        // inserts value if the key is not in the table.
+        // if rehashing occurs, all iterators and references are invalidated
+        std::pair<iterator,bool> insert( const value_type& value );
+        std::pair<iterator,bool> insert( value_type&& value );
+
+        // the hint is ignored, the position of an element is decided by its hash
+        iterator insert( const_iterator hint, const value_type& value );
+        iterator insert( const_iterator hint, value_type&& value );
+
+        template< class InputIt >
+        void insert( InputIt first, InputIt last );
+
+        void insert(std::initializer_list<value_type> init);
+
+        template <class... Args>
+        std::pair<iterator,bool> emplace( Args&&... args);
+
+        template <class... Args>
+        iterator emplace_hint(const_iterator hint, Args&&... args);
+
+        // erasure never moves the other elements, iterators to them stay valid
+        iterator erase( const_iterator pos);
+        iterator erase( const_iterator first, const_iterator last);
+        size_type erase( const key_type& key) { return erase_key(key);}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>,
+                  class = std::enable_if_t<!std::is_convertible_v<const K&, const_iterator>>>
+        size_type erase( const K& key) { return erase_key(key);}
+
+        void swap( flat_hash_table& other) noexcept ;
+
+        /*
+         * Look-up
+         */
+
+        size_type count( const Key& key) const { return find_index(key, hash_of(key)) == npos ? 0 : 1;}
+
+        iterator find(const Key& key);
+        const_iterator find(const Key& key) const;
+
+        bool contains( const Key& key) const { return count(key) != 0;}
+
+        std::pair<iterator, iterator> equal_range( const Key& key);
+        std::pair<const_iterator, const_iterator> equal_range(const Key& key) const;
+
+        // the overloads for any key type K are enabled if Hash and KeyEqual are transparent,
+        // then K is hashed and compared with the keys without constructing a Key
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        size_type count( const K& key) const { return find_index(key, hash_of(key)) == npos ? 0 : 1;}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        iterator find(const K& key) {
+            size_type index = find_index(key, hash_of(key));
+            return index == npos ? end() : iterator_at(index);
+        }
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        const_iterator find(const K& key) const {
+            size_type index = find_index(key, hash_of(key));
+            return index == npos ? end() : iterator_at(index);
+        }
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        bool contains( const K& key) const { return count(key) != 0;}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        std::pair<iterator, iterator> equal_range( const K& key) {
+            iterator first = find(key);
+            return std::pair<iterator, iterator>(first, first == end() ? first : std::next(first));
+        }
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        std::pair<const_iterator, const_iterator> equal_range( const K& key) const {
+            const_iterator first = find(key);
+            return std::pair<const_iterator, const_iterator>(first, first == end() ? first : std::next(first));
+        }
+
+        /*
+         * Bucket interface
+         */
+
+        // every slot is a bucket
+        size_type bucket_count() const { return capacity_;}
+
+        size_type max_bucket_count() const { return max_size();}
+
+        /*
+         * Hash policy
+         */
+
+        float load_factor() const { return capacity_ == 0 ? 0.f : static_cast<float>(size_) / capacity_;}
+
+        // the maximum load factor is fixed to 7/8, the setter has no effect
+        float max_load_factor() const { return 0.875f;}
+
+        void max_load_factor( float) {}
+
+        // rehash to at least count slots, and enough slots for size() elements
+        void rehash( size_type count);
+
+        // reserve the slots for count elements
+        void reserve( size_type count);
+
+        /*
+         * Observers
+         */
+
+        hasher hash_function() const { return hash_;}
+
+        key_equal key_eq() const { return equal_;}
+
+    protected:
+
+        // inserts the value constructed by args, if key is not in the table
+        template <class K, class... Args>
+        std::pair<iterator,bool> emplace_key(const K& key, Args&&... args);
+
+    private:
+        using ctrl_type = flat_hash_group::ctrl_type;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        static constexpr size_type GROUP_SIZE = flat_hash_group::size;
+
+        // the storage of control bytes and slots is aligned to both groups and values
+        static constexpr size_type ALIGNMENT = std::max(GROUP_SIZE, alignof(value_type));
+
+        // the control bytes of a table without slots, a lookup stops at it
+        static ctrl_type* empty_group();
+
+        // std::hash of an integer is the identity, spread its bits over the tag and the group index
+        template <class K>
+        size_type hash_of(const K& key) const;
+
+        static ctrl_type tag(size_type hash){ return static_cast<ctrl_type>(hash & 0x7F);}
+
+        // the number of elements which can be stored before growing
+        static size_type max_load(size_type capacity){ return capacity - capacity / 8;}
+
+        // the smallest capacity for count elements
+        static size_type capacity_for(size_type count);
+
+        // returns the slot index of the element with key, npos if it's not found
+        template <class K>
+        size_type find_index(const K& key, size_type hash) const;
+
+        template <class K>
+        size_type erase_key(const K& key);
+
+        // returns the index of the first empty or deleted slot in the probe sequence of hash
+        size_type find_free(size_type hash) const;
+
+        // allocates the control bytes and the slots, all slots are empty.
+        // the table is left without slots if capacity is 0
+        void allocate(size_type capacity);
+        void deallocate();
+
+        // destroy the elements in the full slots
+        void destroy_slots();
+
+        // move the elements to a table of new_capacity slots
+        void resize(size_type new_capacity);
+
+        // make room for one more element
+        void grow();
+
+        void erase_index(size_type index);
+
+        iterator iterator_at(size_type index){ return iterator(ctrl_ + index, ctrl_ + capacity_, slots_ + index);}
+        const_iterator iterator_at(size_type index) const { return const_iterator(ctrl_ + index, ctrl_ + capacity_, slots_ + index);}
+
+        ctrl_type* ctrl_; // capacity_ control bytes, followed by the slots
+        value_type* slots_; // the slots of elements
+        size_type capacity_; // 0, or a power of two which is a multiple of GROUP_SIZE
+        size_type group_mask_; // the number of groups - 1
+        size_type size_; // the number of elements
+        size_type growth_left_; // the number of empty slots which can be filled before growing
+
+        Hash hash_;
+        KeyEqual equal_;
+    };
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::flat_hash_table(
+            size_type bucket_count, const Hash &hash, const key_equal &equal):
+            size_(0), growth_left_(0), hash_(hash), equal_(equal)
+    {
+        allocate(0);
+        if(bucket_count > 0)
+            rehash(bucket_count);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class InputIt>
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::flat_hash_table(
+            InputIt first, InputIt last, size_type bucket_count, const Hash &hash, const key_equal &equal):
+            flat_hash_table(bucket_count, hash, equal)
+    {
+        insert(first, last);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::flat_hash_table(
+            std::initializer_list<value_type> init, size_type bucket_count, const Hash &hash, const key_equal &equal):
+            flat_hash_table(init.begin(), init.end(), bucket_count, hash, equal){}
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::flat_hash_table(const flat_hash_table &other):
+            size_(0), growth_left_(0), hash_(other.hash_), equal_(other.equal_)
+    {
+        allocate(other.capacity_);
+        if(capacity_ == 0)
+            return;
+
+        // the elements and the tombstones keep their slots, so the probe sequences stay the same
+        size_type i = 0;
+        try {
+            for(; i<capacity_; ++i){
+                if(other.ctrl_[i] >= 0)
+                    ::new(static_cast<void*>(slots_ + i)) value_type(other.slots_[i]);
+                ctrl_[i] = other.ctrl_[i];
+            }
+        }catch (...){
+            // if throws, destroy the copied elements and deallocates the memory
+            for(size_type j=0; j<i; ++j){
+                if(ctrl_[j] >= 0)
+                    std::destroy_at(slots_ + j);
+            }
+            deallocate();
+            throw;
+        }
+        size_ = other.size_;
+        growth_left_ = other.growth_left_;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::flat_hash_table(flat_hash_table &&other) noexcept:
+            ctrl_(other.ctrl_), slots_(other.slots_), capacity_(other.capacity_), group_mask_(other.group_mask_),
+            size_(other.size_), growth_left_(other.growth_left_),
+            hash_(std::move(other.hash_)), equal_(std::move(other.equal_))
+    {
+        // the moved-from table has no slots
+        other.allocate(0);
+        other.size_ = 0;
+        other.growth_left_ = 0;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual> &
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::operator=(flat_hash_table other) {
+        // use copy-and-swap idiom here
+        swap(other);
+        return *this;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::~flat_hash_table() {
+        destroy_slots();
+        deallocate();
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::clear() noexcept {
+        if(capacity_ == 0)
+            return;
+        destroy_slots();
+        std::memset(ctrl_, flat_hash_group::EMPTY, capacity_);
+        size_ = 0;
+        growth_left_ = max_load(capacity_);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    std::pair<typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator, bool>
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::insert(const value_type &value) {
+        return emplace_key(KeyOfValue()(value), value);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    std::pair<typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator, bool>
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::insert(value_type &&value) {
+        return emplace_key(KeyOfValue()(value), std::move(value));
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::insert(const_iterator, const value_type &value) {
+        return insert(value).first;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::insert(const_iterator, value_type &&value) {
+        return insert(std::move(value)).first;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class InputIt>
+    void flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::insert(InputIt first, InputIt last) {
+        for(; first != last; ++first)
+            insert(*first);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::insert(std::initializer_list<value_type> init) {
+        insert(init.begin(), init.end());
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class... Args>
+    std::pair<typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator, bool>
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::emplace(Args &&... args) {
+        // the key is only known after the value is constructed
+        value_type value(std::forward<Args>(args)...);
+        return emplace_key(KeyOfValue()(value), std::move(value));
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class... Args>
+    typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::emplace_hint(const_iterator, Args &&... args) {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class K, class... Args>
+    std::pair<typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator, bool>
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::emplace_key(const K &key, Args &&... args) {
+        size_type hash = hash_of(key);
+        size_type index = find_index(key, hash);
+        if(index != npos)
+            return std::pair<iterator, bool>(iterator_at(index), false);
+
+        if(growth_left_ == 0){
+            grow();
+        }
+        index = find_free(hash);
+
+        // the control byte is set after the construction, so that a throw leaves the table intact
+        ::new(static_cast<void*>(slots_ + index)) value_type(std::forward<Args>(args)...);
+        if(ctrl_[index] == flat_hash_group::EMPTY)
+            --growth_left_;
+        ctrl_[index] = tag(hash);
+        ++size_;
+        return std::pair<iterator, bool>(iterator_at(index), true);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::erase(const_iterator pos) {
+        size_type index = pos.ptr_ - slots_;
+        erase_index(index);
+        // the iterator moves to the next full slot
+        return iterator(ctrl_ + index + 1, ctrl_ + capacity_, slots_ + index + 1);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::erase(const_iterator first, const_iterator last) {
+        while(first != last)
+            first = erase(first);
+        return iterator_at(last.ptr_ - slots_);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class K>
+    typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::size_type
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::erase_key(const K &key) {
+        size_type index = find_index(key, hash_of(key));
+        if(index == npos)
+            return 0;
+        erase_index(index);
+        return 1;
+    }
+
+    // this function has no-throw guarantee because std::swap does not throw
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::swap(flat_hash_table &other) noexcept {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(group_mask_, other.group_mask_);
+        std::swap(size_, other.size_);
+        std::swap(growth_left_, other.growth_left_);
+        std::swap(hash_, other.hash_);
+        std::swap(equal_, other.equal_);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::find(const Key &key) {
+        size_type index = find_index(key, hash_of(key));
+        return index == npos ? end() : iterator_at(index);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::const_iterator
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::find(const Key &key) const {
+        size_type index = find_index(key, hash_of(key));
+        return index == npos ? end() : iterator_at(index);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    std::pair<typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator,
+              typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator>
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::equal_range(const Key &key) {
+        iterator first = find(key);
+        iterator last = first;
+        if(last != end())
+            ++last;
+        return std::pair<iterator, iterator>(first, last);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    std::pair<typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::const_iterator,
+              typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::const_iterator>
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::equal_range(const Key &key) const {
+        const_iterator first = find(key);
+        const_iterator last = first;
+        if(last != end())
+            ++last;
+        return std::pair<const_iterator, const_iterator>(first, last);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::rehash(size_type count) {
+        size_type capacity = 0;
+        if(count > 0){
+            capacity = GROUP_SIZE;
+            while(capacity < count)
+                capacity <<= 1;
+        }
+        capacity = std::max(capacity, capacity_for(size_));
+
+        // rehashing at the same capacity drops the tombstones
+        if(capacity != capacity_ || growth_left_ != max_load(capacity_) - size_)
+            resize(capacity);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::reserve(size_type count) {
+        size_type capacity = capacity_for(count);
+        if(capacity > capacity_)
+            resize(capacity);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::ctrl_type *
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::empty_group() {
+        alignas(GROUP_SIZE) static ctrl_type group[GROUP_SIZE] = {
+                flat_hash_group::EMPTY, flat_hash_group::EMPTY, flat_hash_group::EMPTY, flat_hash_group::EMPTY,
+                flat_hash_group::EMPTY, flat_hash_group::EMPTY, flat_hash_group::EMPTY, flat_hash_group::EMPTY,
+                flat_hash_group::EMPTY, flat_hash_group::EMPTY, flat_hash_group::EMPTY, flat_hash_group::EMPTY,
+                flat_hash_group::EMPTY, flat_hash_group::EMPTY, flat_hash_group::EMPTY, flat_hash_group::EMPTY
+        };
+        return group;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class K>
+    typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::size_type
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::hash_of(const K &key) const {
+        std::uint64_t hash = hash_(key);
+        hash ^= hash >> 32;
+        hash *= 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+        return static_cast<size_type>(hash);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::size_type
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::capacity_for(size_type count) {
+        if(count == 0)
+            return 0;
+        size_type capacity = GROUP_SIZE;
+        while(max_load(capacity) < count)
+            capacity <<= 1;
+        return capacity;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class K>
+    typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::size_type
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::find_index(const K &key, size_type hash) const {
+        ctrl_type h2 = tag(hash);
+        size_type group = (hash >> 7) & group_mask_;
+
+        // the table always has an empty slot, the probe ends
+        for(size_type step = 1; ; ++step){
+            flat_hash_group g(ctrl_ + group * GROUP_SIZE);
+            for(unsigned mask = g.match(h2); mask != 0; mask &= mask - 1){
+                size_type index = group * GROUP_SIZE + flat_hash_group::lowest(mask);
+                if(equal_(KeyOfValue()(slots_[index]), key))
+                    return index;
+            }
+            if(g.match_empty() != 0)
+                return npos;
+            group = (group + step) & group_mask_;
+        }
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::size_type
+    flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::find_free(size_type hash) const {
+        size_type group = (hash >> 7) & group_mask_;
+        for(size_type step = 1; ; ++step){
+            unsigned mask = flat_hash_group(ctrl_ + group * GROUP_SIZE).match_free();
+            if(mask != 0)
+                return group * GROUP_SIZE + flat_hash_group::lowest(mask);
+            group = (group + step) & group_mask_;
+        }
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::allocate(size_type capacity) {
+        if(capacity == 0){
+            ctrl_ = empty_group();
+            slots_ = nullptr;
+            capacity_ = 0;
+            group_mask_ = 0;
+            return;
+        }
+
+        // one allocation holds the control bytes followed by the slots
+        size_type offset = (capacity + alignof(value_type) - 1) / alignof(value_type) * alignof(value_type);
+        void* memory = ::operator new(offset + capacity * sizeof(value_type), std::align_val_t(ALIGNMENT));
+
+        ctrl_ = static_cast<ctrl_type*>(memory);
+        slots_ = reinterpret_cast<value_type*>(static_cast<char*>(memory) + offset);
+        capacity_ = capacity;
+        group_mask_ = capacity / GROUP_SIZE - 1;
+        std::memset(ctrl_, flat_hash_group::EMPTY, capacity);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::deallocate() {
+        if(capacity_ != 0)
+            ::operator delete(ctrl_, std::align_val_t(ALIGNMENT));
+        allocate(0);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::destroy_slots() {
+        if constexpr (!std::is_trivially_destructible_v<value_type>){
+            for(size_type i=0; i<capacity_; ++i){
+                if(ctrl_[i] >= 0)
+                    std::destroy_at(slots_ + i);
+            }
+        }
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::resize(size_type new_capacity) {
+        ctrl_type* old_ctrl = ctrl_;
+        value_type* old_slots = slots_;
+        size_type old_capacity = capacity_;
+        size_type old_mask = group_mask_;
+
+        allocate(new_capacity);
+
+        // provide strong exception guarantee if the elements are copied
+        size_type i = 0;
+        try {
+            for(; i<old_capacity; ++i){
+                if(old_ctrl[i] < 0)
+                    continue;
+                size_type hash = hash_of(KeyOfValue()(old_slots[i]));
+                size_type index = find_free(hash);
+                ::new(static_cast<void*>(slots_ + index)) value_type(std::move_if_noexcept(old_slots[i]));
+                ctrl_[index] = tag(hash);
+            }
+        }catch (...){
+            // if throws, deallocates the new table and restores the old one
+            destroy_slots();
+            deallocate();
+            ctrl_ = old_ctrl;
+            slots_ = old_slots;
+            capacity_ = old_capacity;
+            group_mask_ = old_mask;
+            throw;
+        }
+
+        // destroy the old elements and deallocates the old table
+        if(old_capacity != 0){
+            if constexpr (!std::is_trivially_destructible_v<value_type>){
+                for(size_type j=0; j<old_capacity; ++j){
+                    if(old_ctrl[j] >= 0)
+                        std::destroy_at(old_slots + j);
+                }
+            }
+            ::operator delete(old_ctrl, std::align_val_t(ALIGNMENT));
+        }
+        growth_left_ = max_load(capacity_) - size_;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::grow() {
+        if(capacity_ == 0)
+            resize(GROUP_SIZE);
+        else if(size_ <= max_load(capacity_) / 2)
+            resize(capacity_); // most of the used slots are tombstones
+        else
+            resize(capacity_ * 2);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>::erase_index(size_type index) {
+        std::destroy_at(slots_ + index);
+        --size_;
+
+        // if the group has never been full, no probe continues past it
+        if(flat_hash_group(ctrl_ + index / GROUP_SIZE * GROUP_SIZE).match_empty() != 0){
+            ctrl_[index] = flat_hash_group::EMPTY;
+            ++growth_left_;
+        } else{
+            ctrl_[index] = flat_hash_group::DELETED;
+        }
+    }
+
+    /*
+     * Non-member functions
+     */
+
+    // two tables are equal if they have the same elements, in any order
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    bool operator==(const flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>& lhs,
+            const flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>& rhs){
+        if(lhs.size() != rhs.size())
+            return false;
+        for(const auto& value: lhs){
+            auto iter = rhs.find(KeyOfValue()(value));
+            if(iter == rhs.end() || !(*iter == value))
+                return false;
+        }
+        return true;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    bool operator!=(const flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>& lhs,
+            const flat_hash_table<Key, Value, KeyOfValue, Hash, KeyEqual>& rhs){
+        return !(lhs == rhs);
+    }
+
+}
+
+#endif //STLCONTAINER_FLAT_HASH_TABLE_HPP
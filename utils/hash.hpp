@@ -0,0 +1,249 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_HASH_HPP
+#define STLCONTAINER_HASH_HPP
+
+/*
+ * Seeded hash function, the default Hash of the hash containers.
+ *
+ * std::hash of an integer is the identity in libstdc++, so a table which
+ * takes the low bits of the hash needs a mixer in front of it, and the
+ * bytes of a string are hashed by a loop which consumes one 8-byte word
+ * after another through a chain of multiplications.
+ *
+ * hash<T> follows wyhash: the core step multiplies two 64-bit words into
+ * a 128-bit product and folds its halves with xor (mum), which mixes every
+ * input bit into the whole result in one multiplication.
+ *  - an integer, enum or pointer is multiplied by the seed, and the two
+ *    halves of the product take one mum.
+ *  - a string of at most 16 bytes is read by two overlapping loads and
+ *    takes one mum. A longer one is read 48 bytes at a time into three
+ *    independent lanes, so three multiplications are in flight together
+ *    instead of one after another, then the tail of at most 48 bytes.
+ *  - a floating-point number hashes its bits, 0.0 and -0.0 alike.
+ *  - any other type mixes the value of std::hash<T>.
+ *
+ * Every hash starts from a seed which is drawn once per process, so an
+ * attacker who doesn't know it can't precompute keys which collide, and
+ * the iteration order of a table differs between runs. A hash object reads
+ * the seed when it's constructed, and hash<T>(seed) takes another one.
+ * Defining SC_HASH_SEED fixes the seed of the process for reproducible
+ * runs. The hashes are not stable across processes, perfect_hash uses
+ * hash_bytes() for that.
+ *
+ * The string hash is transparent: std::string, std::string_view and
+ * const char* of the same characters hash alike.
+ *
+ * references: Wang Yi. wyhash. https://github.com/wangyi-fudan/wyhash
+ *             Nicolas De Carli. rapidhash. https://github.com/Nicoshev/rapidhash
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace sc::utils{
+
+    // the constants of wyhash
+    inline constexpr std::uint64_t HASH_P0 = 0xa0761d6478bd642full;
+    inline constexpr std::uint64_t HASH_P1 = 0xe7037ed1a0b428dbull;
+    inline constexpr std::uint64_t HASH_P2 = 0x8ebc6af09c88c6e3ull;
+    inline constexpr std::uint64_t HASH_P3 = 0x589965cc75374cc3ull;
+
+    // the 128-bit product of a and b, in lo and hi
+    inline void mul128(std::uint64_t a, std::uint64_t b, std::uint64_t& lo, std::uint64_t& hi) noexcept {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+        lo = static_cast<std::uint64_t>(r);
+        hi = static_cast<std::uint64_t>(r >> 64);
+#else
+        std::uint64_t ha = a >> 32, la = static_cast<std::uint32_t>(a);
+        std::uint64_t hb = b >> 32, lb = static_cast<std::uint32_t>(b);
+        std::uint64_t hh = ha * hb, hl = ha * lb, lh = la * hb, ll = la * lb;
+        std::uint64_t mid = (ll >> 32) + static_cast<std::uint32_t>(hl) + static_cast<std::uint32_t>(lh);
+        lo = (mid << 32) | static_cast<std::uint32_t>(ll);
+        hi = hh + (hl >> 32) + (lh >> 32) + (mid >> 32);
+#endif
+    }
+
+    // the xor of the halves of the 128-bit product of a and b
+    inline std::uint64_t mum(std::uint64_t a, std::uint64_t b) noexcept {
+        std::uint64_t lo, hi;
+        mul128(a, b, lo, hi);
+        return lo ^ hi;
+    }
+
+    // the seed of every hash<T> in this process, drawn on the first call
+    inline std::uint64_t hash_seed() noexcept {
+#if defined(SC_HASH_SEED)
+        return static_cast<std::uint64_t>(SC_HASH_SEED);
+#else
+        static const std::uint64_t seed = []() noexcept {
+            static const int anchor = 0;
+            // the address differs between runs under ASLR, the clock differs anyway
+            auto s = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(&anchor)) ^
+                     static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+            try {
+                std::random_device device;
+                s ^= (static_cast<std::uint64_t>(device()) << 32) | device();
+            } catch (...){
+                // no entropy source, the address and the clock are kept
+            }
+            return mum(s ^ HASH_P0, HASH_P1);
+        }();
+        return seed;
+#endif
+    }
+
+    inline std::uint64_t read64(const unsigned char* p) noexcept {
+        std::uint64_t v;
+        std::memcpy(&v, p, 8);
+        return v;
+    }
+
+    inline std::uint64_t read32(const unsigned char* p) noexcept {
+        std::uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+
+    // wyhash of size bytes, with three lanes for the blocks of 48 bytes
+    inline std::uint64_t hash_string(const void* data, std::size_t size, std::uint64_t seed) noexcept {
+        auto p = static_cast<const unsigned char*>(data);
+        std::uint64_t a, b;
+        if(size <= 16){
+            if(size >= 4){
+                // two overlapping reads of 4 bytes from each end
+                a = (read32(p) << 32) | read32(p + ((size >> 3) << 2));
+                b = (read32(p + size - 4) << 32) | read32(p + size - 4 - ((size >> 3) << 2));
+            } else if(size > 0){
+                a = (std::uint64_t(p[0]) << 16) | (std::uint64_t(p[size >> 1]) << 8) | p[size - 1];
+                b = 0;
+            } else{
+                a = b = 0;
+            }
+        } else{
+            std::size_t i = size;
+            if(i > 48){
+                std::uint64_t see1 = seed, see2 = seed;
+                do{
+                    seed = mum(read64(p) ^ HASH_P1, read64(p + 8) ^ seed);
+                    see1 = mum(read64(p + 16) ^ HASH_P2, read64(p + 24) ^ see1);
+                    see2 = mum(read64(p + 32) ^ HASH_P3, read64(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                }while(i > 48);
+                seed ^= see1 ^ see2;
+            }
+            while(i > 16){
+                seed = mum(read64(p) ^ HASH_P1, read64(p + 8) ^ seed);
+                i -= 16;
+                p += 16;
+            }
+            // the last 16 bytes, which may overlap the ones already read
+            a = read64(p + i - 16);
+            b = read64(p + i - 8);
+        }
+        a ^= HASH_P1;
+        b ^= seed;
+        return mum(HASH_P1 ^ size, mum(a, b) ^ HASH_P0 ^ size);
+    }
+
+    // an integer and the seed multiplied, then both halves of the product mixed by one mum
+    inline std::uint64_t hash_integer(std::uint64_t value, std::uint64_t seed) noexcept {
+        std::uint64_t lo, hi;
+        mul128(value ^ HASH_P0, seed ^ HASH_P1, lo, hi);
+        return mum(lo ^ HASH_P0, hi ^ HASH_P1);
+    }
+
+    // the seed of a hash<T>, mixed once when the hash is constructed
+    class seeded_hash{
+    public:
+
+        explicit seeded_hash(std::uint64_t seed = hash_seed()) noexcept :
+                seed_(seed ^ mum(seed ^ HASH_P0, HASH_P1)){}
+
+    protected:
+        std::uint64_t seed_;
+    };
+
+    // std::hash<T> mixed with the seed
+    template <class T, class = void>
+    struct hash: seeded_hash{
+        using seeded_hash::seeded_hash;
+
+        std::size_t operator()(const T& value) const
+                noexcept(std::is_nothrow_invocable_v<std::hash<T>, const T&>) {
+            return static_cast<std::size_t>(hash_integer(std::hash<T>()(value), seed_));
+        }
+    };
+
+    template <class T>
+    struct hash<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>>>:
+            seeded_hash{
+        using seeded_hash::seeded_hash;
+
+        std::size_t operator()(T value) const noexcept {
+            std::uint64_t bits;
+            if constexpr (std::is_pointer_v<T>)
+                bits = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(value));
+            else
+                bits = static_cast<std::uint64_t>(value);
+            return static_cast<std::size_t>(hash_integer(bits, seed_));
+        }
+    };
+
+    template <class T>
+    struct hash<T, std::enable_if_t<std::is_floating_point_v<T>>>: seeded_hash{
+        using seeded_hash::seeded_hash;
+
+        std::size_t operator()(T value) const noexcept {
+            // 0.0 and -0.0 are equal, so they must hash alike
+            if(value == T(0))
+                value = T(0);
+            if constexpr (sizeof(T) <= 8){
+                std::uint64_t bits = 0;
+                std::memcpy(&bits, &value, sizeof(T));
+                return static_cast<std::size_t>(hash_integer(bits, seed_));
+            } else{
+                // long double has padding bytes, std::hash skips them
+                return static_cast<std::size_t>(hash_integer(std::hash<T>()(value), seed_));
+            }
+        }
+    };
+
+    template <class CharT, class Traits, class Allocator>
+    struct hash<std::basic_string<CharT, Traits, Allocator>>: seeded_hash{
+        using seeded_hash::seeded_hash;
+
+        using is_transparent = void;
+
+        std::size_t operator()(std::basic_string_view<CharT, Traits> s) const noexcept {
+            return static_cast<std::size_t>(hash_string(s.data(), s.size() * sizeof(CharT), seed_));
+        }
+
+        std::size_t operator()(const std::basic_string<CharT, Traits, Allocator>& s) const noexcept {
+            return operator()(std::basic_string_view<CharT, Traits>(s));
+        }
+
+        std::size_t operator()(const CharT* s) const noexcept {
+            return operator()(std::basic_string_view<CharT, Traits>(s));
+        }
+    };
+
+    template <class CharT, class Traits>
+    struct hash<std::basic_string_view<CharT, Traits>>: hash<std::basic_string<CharT, Traits>>{
+        using hash<std::basic_string<CharT, Traits>>::hash;
+    };
+
+}
+
+#endif //STLCONTAINER_HASH_HPP
@@ -0,0 +1,66 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_HASH_ITERATOR_HPP
+#define STLCONTAINER_HASH_ITERATOR_HPP
+
+#include <iterator>
+#include "iterator_base.hpp"
+#include "hash_node.hpp"
+
+namespace sc::utils{
+
+    // forward iterator of a node-based hash table. it follows the next_ links
+    // until the end link, which is the sentinel of the list or nullptr
+    template <class Node, class T>
+    class hash_iterator: public iterator_base<T, hash_iterator<Node, T>>{
+    public:
+
+        // C++ doesn’t consider superclass templates for name resolution
+        using iterator_base<T, hash_iterator<Node, T>>::ptr_;
+        using typename iterator_base<T, hash_iterator<Node, T>>::difference_type ;
+        using typename iterator_base<T, hash_iterator<Node, T>>::pointer;
+        using typename iterator_base<T, hash_iterator<Node, T>>::reference;
+        using iterator_category = std::forward_iterator_tag;
+
+        hash_iterator(): iterator_base<T, hash_iterator<Node, T>>(nullptr), node_(nullptr), end_(nullptr){}
+
+        // node: the link of the element, end: the link which ends the iteration
+        hash_iterator(const hash_link* node, const hash_link* end):
+            iterator_base<T, hash_iterator<Node, T>>(value_of(node, end)), node_(node), end_(end){}
+
+        //forbids to copy a const iterator to a non-const iterator
+        template <class OtherT, class = std::enable_if_t<std::is_convertible_v<OtherT*, T*>>>
+        hash_iterator(const hash_iterator<Node, OtherT>& other): iterator_base<T, hash_iterator<Node, T>>(other),
+            node_(other.node_), end_(other.end_){}
+
+        hash_iterator&operator++(){
+            node_ = node_->next_;
+            ptr_ = value_of(node_, end_);
+            return *this;
+        }
+
+        hash_iterator operator++(int){
+            hash_iterator old(*this);
+            ++(*this);
+            return old;
+        }
+
+    private:
+        template <class, class> friend class hash_iterator;
+        template <class, class, class, class, class, class, class> friend class hashtable;
+        template <class, class, class, class, class, class, class> friend class multi_hashtable;
+
+        // the end iterator points to no value, so that all end iterators compare equal
+        static pointer value_of(const hash_link* node, const hash_link* end){
+            return node == end ? nullptr : static_cast<Node*>(const_cast<hash_link*>(node))->value();
+        }
+
+        const hash_link* node_; // the link of the current node
+        const hash_link* end_; // the link which ends the iteration
+    };
+
+}
+
+#endif //STLCONTAINER_HASH_ITERATOR_HPP
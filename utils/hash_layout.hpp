@@ -0,0 +1,551 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_HASH_LAYOUT_HPP
+#define STLCONTAINER_HASH_LAYOUT_HPP
+
+/*
+ * Node layouts of the node-based hash tables.
+ *
+ * A layout decides how the nodes are linked and what a bucket points to.
+ * Its storage owns the bucket array and links the nodes; the table owns
+ * the nodes and decides which bucket a node belongs to. The functions
+ * which need the bucket of another node take bucket_of, which maps a link
+ * to the index of its bucket.
+ *
+ * dinkumware_layout (Microsoft Visual Studio): a doubly-linked list with a
+ * sentinel, every bucket points to its first and last node. The nodes of a
+ * bucket are adjacent in the list. Erasure finds the bucket of the node by
+ * hashing its key, so it throws if the hash function throws.
+ *
+ * forward_layout (Boost.unordered, libc++): a singly-linked list, every
+ * bucket points to the node before its first node, which is the node of
+ * another bucket or the before-begin link of the list. A node holds one
+ * pointer instead of two, and a bucket holds one pointer instead of two.
+ * The nodes cache the hash of their key, so erasure never calls the hash
+ * function and never throws; like libstdc++, the hash is not cached if the
+ * key is a scalar and the hash function is noexcept, which saves another
+ * 8 bytes per node.
+ *
+ * incremental_layout is forward_layout which rehashes like Redis. When the
+ * table grows, the new buckets are allocated but the nodes stay in the old
+ * ones, and every following insertion moves the nodes of a few old buckets.
+ * The old buckets are numbered before the new ones, and a node is in its
+ * old bucket until that bucket is moved, so a lookup still probes only one
+ * bucket. No single insertion relinks all nodes.
+ *
+ * references: http://bannalia.blogspot.com/2013/10/implementation-of-c-unordered.html
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "bucket.hpp"
+#include "cache_line.hpp"
+#include "hash_node.hpp"
+
+namespace sc::utils{
+
+    // the link of a doubly-linked list
+    struct dinkumware_link: public hash_link{
+        hash_link* prev_ = nullptr;
+    };
+
+    // the link of a singly-linked list, with the hash of the element
+    struct forward_link: public hash_link{
+        std::size_t hash_ = 0;
+    };
+
+    template <class Value>
+    class dinkumware_storage{
+    public:
+
+        using size_type = std::size_t;
+
+        using node_type = hash_node<Value, dinkumware_link>;
+
+        // the bucket of a node is found by hashing its key
+        static constexpr bool caches_hash = false;
+
+        static constexpr bool incremental = false;
+
+        // bucket_head() is the first node of the bucket
+        static constexpr bool head_is_before = false;
+
+        // find() only takes a predicate
+        static constexpr bool treeifies = false;
+
+        // no filter is checked before the buckets
+        static constexpr bool filters = false;
+
+        dinkumware_storage(): buckets_(nullptr), count_(0){ reset_list();}
+
+        dinkumware_storage(const dinkumware_storage&) = delete;
+        dinkumware_storage&operator=(const dinkumware_storage&) = delete;
+
+        ~dinkumware_storage(){ delete[] buckets_;}
+
+        hash_link* first() const { return head_.next_;}
+
+        // the sentinel ends the iteration
+        const hash_link* end_link() const { return &head_;}
+
+        size_type bucket_count() const { return count_;}
+
+        size_type bucket_bytes() const { return count_ * sizeof(bucket_type);}
+
+        // the entry of bucket b in the bucket array, find(b) reads it first
+        const void* bucket_address(size_type b) const { return &buckets_[b];}
+
+        // the link find(b) reads after the entry, nullptr if the bucket is empty
+        const hash_link* bucket_head(size_type b) const { return buckets_[b].first_;}
+
+        // the first node of bucket b and the link after its last node, both nullptr if the bucket is empty
+        template <class BucketOf>
+        std::pair<hash_link*, hash_link*> bucket_range(size_type b, BucketOf) const {
+            const bucket_type& bk = buckets_[b];
+            if(bk.first_ == nullptr)
+                return std::pair<hash_link*, hash_link*>(nullptr, nullptr);
+            return std::pair<hash_link*, hash_link*>(bk.first_, bk.last_->next_);
+        }
+
+        // returns the first node in bucket b which satisfies pred, or nullptr
+        template <class Pred, class BucketOf>
+        node_type* find(size_type b, Pred pred, BucketOf) const {
+            const bucket_type& bk = buckets_[b];
+            if(bk.first_ == nullptr)
+                return nullptr;
+            for(node_type* node = bk.first_; ; node = static_cast<node_type*>(node->next_)){
+                if(pred(node))
+                    return node;
+                if(node == bk.last_)
+                    return nullptr;
+            }
+        }
+
+        // link node as the first node of bucket b
+        template <class BucketOf>
+        void link(node_type* node, size_type b, BucketOf){
+            bucket_type& bk = buckets_[b];
+            // a bucket which was empty starts at the front of the list
+            link_before(node, bk.first_ != nullptr ? bk.first_ : head_.next_);
+            if(bk.last_ == nullptr)
+                bk.last_ = node;
+            bk.first_ = node;
+        }
+
+        // link node right after pos, which is in bucket b
+        template <class BucketOf>
+        void link_after(node_type* node, node_type* pos, size_type b, BucketOf){
+            link_before(node, pos->next_);
+            if(buckets_[b].last_ == pos)
+                buckets_[b].last_ = node;
+        }
+
+        // unlink node from bucket b, returns the link after it
+        template <class BucketOf>
+        hash_link* unlink(node_type* node, size_type b, BucketOf) noexcept {
+            bucket_type& bk = buckets_[b];
+            if(bk.first_ == node && bk.last_ == node){
+                bk.first_ = nullptr;
+                bk.last_ = nullptr;
+            } else if(bk.first_ == node){
+                bk.first_ = static_cast<node_type*>(node->next_);
+            } else if(bk.last_ == node){
+                bk.last_ = static_cast<node_type*>(node->prev_);
+            }
+
+            hash_link* next = node->next_;
+            node->prev_->next_ = next;
+            static_cast<dinkumware_link*>(next)->prev_ = node->prev_;
+            return next;
+        }
+
+        // relink all nodes into count new buckets, bucket_of maps them to the new buckets.
+        // if bucket_of throws, the nodes which are not relinked yet are lost
+        template <class BucketOf>
+        void rehash(size_type count, BucketOf bucket_of){
+            bucket_type* buckets = new bucket_type[count];
+            hash_link* node = head_.next_;
+            delete[] buckets_;
+            buckets_ = buckets;
+            count_ = count;
+            reset_list();
+
+            while(node != &head_){
+                hash_link* next = node->next_;
+                link(static_cast<node_type*>(node), bucket_of(node), bucket_of);
+                node = next;
+            }
+        }
+
+        // empty all buckets, the nodes are destroyed by the table
+        void reset() noexcept {
+            std::fill(buckets_, buckets_ + count_, bucket_type());
+            reset_list();
+        }
+
+        void swap(dinkumware_storage& other) noexcept {
+            bool empty = head_.next_ == &head_;
+            bool other_empty = other.head_.next_ == &other.head_;
+            std::swap(buckets_, other.buckets_);
+            std::swap(count_, other.count_);
+            std::swap(head_, other.head_);
+            // the first and the last node point to the sentinel
+            adopt(other_empty);
+            other.adopt(empty);
+        }
+
+        // the nodes never point to the storage except the sentinel, which is fixed by swap
+        template <class BucketOf>
+        void rebind(BucketOf) noexcept {}
+
+    private:
+        using bucket_type = bucket<node_type>;
+
+        void reset_list(){
+            head_.next_ = &head_;
+            head_.prev_ = &head_;
+        }
+
+        // after swapping the sentinels, point the nodes to this one
+        void adopt(bool empty){
+            if(empty){
+                reset_list();
+            } else{
+                static_cast<dinkumware_link*>(head_.next_)->prev_ = &head_;
+                head_.prev_->next_ = &head_;
+            }
+        }
+
+        void link_before(node_type* node, hash_link* next){
+            auto n = static_cast<dinkumware_link*>(next);
+            node->next_ = n;
+            node->prev_ = n->prev_;
+            n->prev_->next_ = node;
+            n->prev_ = node;
+        }
+
+        bucket_type* buckets_; // the array of buckets
+        size_type count_; // the number of buckets
+        dinkumware_link head_; // sentinel of the list
+    };
+
+    // if Incremental is true, begin_rehash() and step() move the nodes to the
+    // new buckets a few buckets at a time. while the nodes are moved, the old
+    // buckets and the new buckets are numbered in one sequence: the old ones
+    // first, then the new ones. the table decides which bucket a node is in
+    // by comparing its old bucket with cursor()
+    template <class Value, bool CacheHash, bool Incremental = false>
+    class forward_storage{
+    public:
+
+        using size_type = std::size_t;
+
+        using node_type = hash_node<Value, std::conditional_t<CacheHash, forward_link, hash_link>>;
+
+        // the bucket of a node is found by its cached hash, or by hashing its key
+        static constexpr bool caches_hash = CacheHash;
+
+        static constexpr bool incremental = Incremental;
+
+        // bucket_head() is the link before the first node of the bucket
+        static constexpr bool head_is_before = true;
+
+        static constexpr bool treeifies = false;
+
+        static constexpr bool filters = false;
+
+        forward_storage(): buckets_(nullptr), count_(0), old_(nullptr), old_count_(0), cursor_(0){}
+
+        forward_storage(const forward_storage&) = delete;
+        forward_storage&operator=(const forward_storage&) = delete;
+
+        ~forward_storage(){
+            std::free(buckets_);
+            std::free(old_);
+        }
+
+        hash_link* first() const { return before_begin_.next_;}
+
+        // the last node points to nullptr
+        const hash_link* end_link() const { return nullptr;}
+
+        // the old and the new buckets while the nodes are moved
+        size_type bucket_count() const { return old_count_ + count_;}
+
+        size_type bucket_bytes() const { return bucket_count() * sizeof(hash_link*);}
+
+        // whether the nodes are being moved to the new buckets
+        bool rehashing() const { return old_ != nullptr;}
+
+        // the number of old buckets, 0 if the nodes are not being moved
+        size_type old_count() const { return old_count_;}
+
+        // the old buckets before cursor() are moved
+        size_type cursor() const { return cursor_;}
+
+        // the entry of bucket b in the bucket array, find(b) reads it first
+        const void* bucket_address(size_type b) const { return &slot(b);}
+
+        // the link find(b) reads after the entry, nullptr if the bucket is empty
+        const hash_link* bucket_head(size_type b) const { return slot(b);}
+
+        // the first node of bucket b and the link after its last node, both nullptr if the bucket is empty
+        template <class BucketOf>
+        std::pair<hash_link*, hash_link*> bucket_range(size_type b, BucketOf bucket_of) const {
+            if(slot(b) == nullptr)
+                return std::pair<hash_link*, hash_link*>(nullptr, nullptr);
+            hash_link* first = slot(b)->next_;
+            hash_link* last = first;
+            while(last != nullptr && bucket_of(last) == b)
+                last = last->next_;
+            return std::pair<hash_link*, hash_link*>(first, last);
+        }
+
+        // returns the first node in bucket b which satisfies pred, or nullptr
+        template <class Pred, class BucketOf>
+        node_type* find(size_type b, Pred pred, BucketOf bucket_of) const {
+            if(slot(b) == nullptr)
+                return nullptr;
+            // the bucket ends at the first node of another bucket
+            for(hash_link* link = slot(b)->next_; link != nullptr; link = link->next_){
+                auto node = static_cast<node_type*>(link);
+                if(pred(node))
+                    return node;
+                if(bucket_of(link) != b)
+                    return nullptr;
+            }
+            return nullptr;
+        }
+
+        // link node as the first node of bucket b
+        template <class BucketOf>
+        void link(node_type* node, size_type b, BucketOf bucket_of){
+            if(slot(b) != nullptr){
+                node->next_ = slot(b)->next_;
+                slot(b)->next_ = node;
+            } else{
+                // a bucket which was empty starts at the front of the list,
+                // the bucket of the former front node now starts after node
+                node->next_ = before_begin_.next_;
+                before_begin_.next_ = node;
+                if(node->next_ != nullptr)
+                    slot(bucket_of(node->next_)) = node;
+                slot(b) = &before_begin_;
+            }
+        }
+
+        // link node right after pos, which is in bucket b
+        template <class BucketOf>
+        void link_after(node_type* node, node_type* pos, size_type b, BucketOf bucket_of){
+            node->next_ = pos->next_;
+            pos->next_ = node;
+            // pos was the last node of its bucket, the next bucket now starts after node
+            if(node->next_ != nullptr){
+                size_type next_bucket = bucket_of(node->next_);
+                if(next_bucket != b)
+                    slot(next_bucket) = node;
+            }
+        }
+
+        // unlink node from bucket b, returns the link after it.
+        // bucket_of reads the cached hashes or calls a noexcept hash function, so it never throws
+        template <class BucketOf>
+        hash_link* unlink(node_type* node, size_type b, BucketOf bucket_of) noexcept {
+            hash_link* prev = slot(b);
+            while(prev->next_ != node)
+                prev = prev->next_;
+
+            hash_link* next = node->next_;
+            size_type next_bucket = next != nullptr ? bucket_of(next) : b;
+            if(prev == slot(b)){
+                // node is the first node of its bucket
+                if(next == nullptr || next_bucket != b){
+                    // the bucket becomes empty, the next bucket now starts after prev
+                    if(next != nullptr)
+                        slot(next_bucket) = prev;
+                    slot(b) = nullptr;
+                }
+            } else if(next_bucket != b){
+                // node is the last node of its bucket
+                slot(next_bucket) = prev;
+            }
+            prev->next_ = next;
+            return next;
+        }
+
+        // relink all nodes into count new buckets, bucket_of maps them to the new buckets.
+        // the nodes must not be being moved
+        template <class BucketOf>
+        void rehash(size_type count, BucketOf bucket_of){
+            hash_link** buckets = allocate(count);
+            hash_link* link = before_begin_.next_;
+            std::free(buckets_);
+            buckets_ = buckets;
+            count_ = count;
+            before_begin_.next_ = nullptr;
+
+            // the bucket of the front node
+            size_type front = 0;
+            while(link != nullptr){
+                hash_link* next = link->next_;
+                size_type b = bucket_of(link);
+                if(buckets_[b] == nullptr){
+                    link->next_ = before_begin_.next_;
+                    before_begin_.next_ = link;
+                    buckets_[b] = &before_begin_;
+                    if(link->next_ != nullptr)
+                        buckets_[front] = link;
+                    front = b;
+                } else{
+                    link->next_ = buckets_[b]->next_;
+                    buckets_[b]->next_ = link;
+                }
+                link = next;
+            }
+        }
+
+        // allocate count new buckets, the nodes stay in the old buckets until they're moved by step().
+        // the nodes must not be being moved
+        void begin_rehash(size_type count){
+            hash_link** buckets = allocate(count);
+            old_ = buckets_;
+            old_count_ = count_;
+            buckets_ = buckets;
+            count_ = count;
+            cursor_ = 0;
+        }
+
+        // move the nodes of the next n old buckets to the new buckets, the old
+        // buckets are freed after the last one. bucket_of must read cursor(),
+        // the nodes of the old bucket at cursor() are moved after it's advanced
+        template <class BucketOf>
+        void step(size_type n, BucketOf bucket_of) noexcept {
+            // moving a bucket misses the cache on the link before it and on its
+            // first node, fetch the links two steps ahead and the nodes one step ahead
+            for(size_type i = cursor_ + n; i < cursor_ + 2 * n && i < old_count_; ++i){
+                if(old_[i] != nullptr)
+                    prefetch(old_[i]->next_);
+                if(i + n < old_count_ && old_[i + n] != nullptr)
+                    prefetch(old_[i + n]);
+            }
+            for(; n > 0 && cursor_ < old_count_; --n){
+                hash_link* prev = old_[cursor_];
+                if(prev == nullptr){
+                    ++cursor_;
+                    continue;
+                }
+
+                // the nodes of the bucket are adjacent, detach them from the list
+                hash_link* first = prev->next_;
+                hash_link* last = first;
+                while(last->next_ != nullptr && bucket_of(last->next_) == cursor_)
+                    last = last->next_;
+                hash_link* next = last->next_;
+                if(next != nullptr)
+                    slot(bucket_of(next)) = prev;
+                prev->next_ = next;
+                last->next_ = nullptr;
+                old_[cursor_] = nullptr;
+                ++cursor_;
+
+                while(first != nullptr){
+                    hash_link* link = first->next_;
+                    this->link(static_cast<node_type*>(first), bucket_of(first), bucket_of);
+                    first = link;
+                }
+            }
+
+            if(old_ != nullptr && cursor_ == old_count_){
+                std::free(old_);
+                old_ = nullptr;
+                old_count_ = 0;
+                cursor_ = 0;
+            }
+        }
+
+        // empty all buckets, the nodes are destroyed by the table
+        void reset() noexcept {
+            std::free(old_);
+            old_ = nullptr;
+            old_count_ = 0;
+            cursor_ = 0;
+            std::fill(buckets_, buckets_ + count_, nullptr);
+            before_begin_.next_ = nullptr;
+        }
+
+        void swap(forward_storage& other) noexcept {
+            std::swap(buckets_, other.buckets_);
+            std::swap(count_, other.count_);
+            std::swap(old_, other.old_);
+            std::swap(old_count_, other.old_count_);
+            std::swap(cursor_, other.cursor_);
+            std::swap(before_begin_.next_, other.before_begin_.next_);
+        }
+
+        // after swap, the bucket of the front node still points to the
+        // before-begin link of the other storage
+        template <class BucketOf>
+        void rebind(BucketOf bucket_of) noexcept {
+            if(before_begin_.next_ != nullptr)
+                slot(bucket_of(before_begin_.next_)) = &before_begin_;
+        }
+
+    private:
+        // the buckets are zeroed by calloc, which maps fresh zero pages for a
+        // big array instead of writing it, so allocating never touches the whole array
+        static hash_link** allocate(size_type count){
+            auto buckets = static_cast<hash_link**>(std::calloc(count, sizeof(hash_link*)));
+            if(buckets == nullptr && count != 0)
+                throw std::bad_alloc();
+            return buckets;
+        }
+
+        // bucket b in the sequence of the old and the new buckets
+        hash_link*& slot(size_type b) const {
+            if constexpr (Incremental){
+                if(b < old_count_)
+                    return old_[b];
+                return buckets_[b - old_count_];
+            } else{
+                return buckets_[b];
+            }
+        }
+
+        hash_link** buckets_; // the link before the first node of every bucket, nullptr if it's empty
+        size_type count_; // the number of buckets
+        hash_link** old_; // the old buckets while the nodes are moved, otherwise nullptr
+        size_type old_count_; // the number of old buckets
+        size_type cursor_; // the old buckets before cursor_ are moved
+        hash_link before_begin_; // its next_ is the front node
+    };
+
+    // doubly-linked list, every bucket points to its first and its last node
+    struct dinkumware_layout{
+        template <class Value, class Key, class KeyOfValue, class Hash>
+        using storage = dinkumware_storage<Value>;
+    };
+
+    // singly-linked list, every bucket points to the node before its first node.
+    // the hash is cached unless rehashing the key is cheap and never throws
+    struct forward_layout{
+        template <class Value, class Key, class KeyOfValue, class Hash>
+        using storage = forward_storage<Value,
+                !(std::is_scalar_v<Key> && std::is_nothrow_invocable_v<const Hash&, const Key&>)>;
+    };
+
+    // forward_layout which rehashes incrementally: the nodes are moved to the
+    // new buckets a few buckets at a time by the following insertions
+    struct incremental_layout{
+        template <class Value, class Key, class KeyOfValue, class Hash>
+        using storage = forward_storage<Value, true, true>;
+    };
+
+}
+
+#endif //STLCONTAINER_HASH_LAYOUT_HPP
@@ -0,0 +1,96 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_HASH_NODE_HPP
+#define STLCONTAINER_HASH_NODE_HPP
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sc::utils{
+
+    template <class, class, class, class, class, class, class> class hashtable;
+
+    template <class, class, class, class, class, class, class> class multi_hashtable;
+
+    // the link of the node list of a hash table. the nodes are chained
+    // by next_ in the order of iteration
+    struct hash_link{
+        hash_link* next_ = nullptr;
+    };
+
+    // a node of a hash table, Link decides the layout of the node list.
+    // the value is constructed and destroyed by the table, not by the node
+    template <class Value, class Link>
+    struct hash_node: public Link{
+
+        Value* value() { return std::launder(reinterpret_cast<Value*>(&storage_));}
+        const Value* value() const { return std::launder(reinterpret_cast<const Value*>(&storage_));}
+
+        alignas(Value) unsigned char storage_[sizeof(Value)];
+    };
+
+    // owns a node extracted from a hash table, until it's inserted into another one
+    template <class Node, class Value>
+    class hash_node_handle{
+    public:
+
+        using value_type = Value;
+
+        hash_node_handle() noexcept : node_(nullptr){}
+
+        hash_node_handle(hash_node_handle&& other) noexcept : node_(other.node_){ other.node_ = nullptr;}
+
+        hash_node_handle&operator=(hash_node_handle&& other) noexcept {
+            if(this != &other){
+                reset();
+                node_ = other.node_;
+                other.node_ = nullptr;
+            }
+            return *this;
+        }
+
+        ~hash_node_handle(){ reset();}
+
+        bool empty() const noexcept { return node_ == nullptr;}
+
+        explicit operator bool() const noexcept { return node_ != nullptr;}
+
+        // the element of a set node
+        value_type& value() const { return *node_->value();}
+
+        // the key of a map node, it can be modified while the node is not in a table
+        template <class V = Value>
+        std::remove_const_t<typename V::first_type>& key() const {
+            return const_cast<std::remove_const_t<typename V::first_type>&>(node_->value()->first);
+        }
+
+        // the mapped value of a map node
+        template <class V = Value>
+        typename V::second_type& mapped() const { return node_->value()->second;}
+
+        void swap(hash_node_handle& other) noexcept { std::swap(node_, other.node_);}
+
+    private:
+        template <class, class, class, class, class, class, class> friend class hashtable;
+        template <class, class, class, class, class, class, class> friend class multi_hashtable;
+
+        explicit hash_node_handle(Node* node): node_(node){}
+
+        void reset() noexcept {
+            if(node_ != nullptr){
+                std::destroy_at(node_->value());
+                delete node_;
+                node_ = nullptr;
+            }
+        }
+
+        Node* node_;
+    };
+
+}
+
+#endif //STLCONTAINER_HASH_NODE_HPP
@@ -0,0 +1,168 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_HASH_STATS_HPP
+#define STLCONTAINER_HASH_STATS_HPP
+
+/*
+ * Health report of a node-based hash table, see hashtable::stats().
+ *
+ * The shape of the table (chain lengths, memory) is measured when stats()
+ * is called. The lookups and the rehashes are counted as they happen: one
+ * lookup in SAMPLE_RATE per thread counts the nodes it compares, so a
+ * lookup which is not sampled costs an increment of a thread-local counter.
+ * The sampled counters are atomic, so const lookups from several threads
+ * are still safe.
+ *
+ * Define SC_HASH_STATS to 0 to remove the counting: the counters become an
+ * empty class, and stats() only reports the shape of the table.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <utility>
+
+#ifndef SC_HASH_STATS
+#define SC_HASH_STATS 1
+#endif
+
+namespace sc::utils{
+
+    struct hash_stats{
+
+        using size_type = std::size_t;
+
+        // the last entry of the histogram counts the longer chains
+        static constexpr size_type HISTOGRAM_SIZE = 16;
+
+        size_type size = 0;
+        size_type bucket_count = 0;
+        float load_factor = 0.f;
+
+        // chain_histogram[i] is the number of buckets with i elements
+        std::array<size_type, HISTOGRAM_SIZE> chain_histogram{};
+        size_type max_chain = 0;
+
+        // the nodes compared by a sampled lookup which found its key, and by one which didn't.
+        // a lookup of an insertion is counted too
+        size_type sampled_hits = 0;
+        size_type sampled_misses = 0;
+        double probes_per_hit = 0;
+        double probes_per_miss = 0;
+
+        // the rehashes since the table was constructed, and the time spent relinking.
+        // an incremental rehash counts the allocation only, its moves are spread over the insertions
+        size_type rehash_count = 0;
+        std::chrono::nanoseconds rehash_time{0};
+
+        size_type node_bytes = 0;
+        size_type bucket_bytes = 0;
+
+        // the filter of a filter_layout, 0 without a filter or while it's bypassed
+        size_type filter_bytes = 0;
+        double filter_fpr = 0;
+    };
+
+#if SC_HASH_STATS
+
+    class hash_counters{
+    public:
+
+        using size_type = std::size_t;
+
+        // one lookup in SAMPLE_RATE is counted
+        static constexpr unsigned SAMPLE_RATE = 64;
+
+        hash_counters() = default;
+
+        // a copied table starts its own history
+        hash_counters(const hash_counters&) noexcept {}
+        hash_counters&operator=(const hash_counters&) noexcept { return *this;}
+
+        // whether the current lookup is counted
+        static bool sample(){
+            thread_local unsigned tick = 0;
+            return ++tick % SAMPLE_RATE == 0;
+        }
+
+        void record_lookup(bool found, size_type probes) const {
+            if(found){
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                hit_probes_.fetch_add(probes, std::memory_order_relaxed);
+            } else{
+                misses_.fetch_add(1, std::memory_order_relaxed);
+                miss_probes_.fetch_add(probes, std::memory_order_relaxed);
+            }
+        }
+
+        void record_rehash(std::chrono::nanoseconds time){
+            ++rehashes_;
+            rehash_time_ += time;
+        }
+
+        // fills the counted fields of stats
+        void report(hash_stats& stats) const {
+            stats.sampled_hits = hits_.load(std::memory_order_relaxed);
+            stats.sampled_misses = misses_.load(std::memory_order_relaxed);
+            if(stats.sampled_hits > 0)
+                stats.probes_per_hit = static_cast<double>(hit_probes_.load(std::memory_order_relaxed)) / stats.sampled_hits;
+            if(stats.sampled_misses > 0)
+                stats.probes_per_miss = static_cast<double>(miss_probes_.load(std::memory_order_relaxed)) / stats.sampled_misses;
+            stats.rehash_count = rehashes_;
+            stats.rehash_time = rehash_time_;
+        }
+
+        // not atomic, the tables are not used by other threads while they're swapped
+        void swap(hash_counters& other) noexcept {
+            swap_atomic(hits_, other.hits_);
+            swap_atomic(hit_probes_, other.hit_probes_);
+            swap_atomic(misses_, other.misses_);
+            swap_atomic(miss_probes_, other.miss_probes_);
+            std::swap(rehashes_, other.rehashes_);
+            std::swap(rehash_time_, other.rehash_time_);
+        }
+
+    private:
+        static void swap_atomic(std::atomic<size_type>& a, std::atomic<size_type>& b) noexcept {
+            size_type value = a.load(std::memory_order_relaxed);
+            a.store(b.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            b.store(value, std::memory_order_relaxed);
+        }
+
+        // written by const lookups
+        mutable std::atomic<size_type> hits_{0};
+        mutable std::atomic<size_type> hit_probes_{0};
+        mutable std::atomic<size_type> misses_{0};
+        mutable std::atomic<size_type> miss_probes_{0};
+
+        size_type rehashes_ = 0;
+        std::chrono::nanoseconds rehash_time_{0};
+    };
+
+#else
+
+    // counts nothing, the calls are removed by the compiler
+    class hash_counters{
+    public:
+
+        using size_type = std::size_t;
+
+        static constexpr bool sample(){ return false;}
+
+        void record_lookup(bool, size_type) const {}
+
+        void record_rehash(std::chrono::nanoseconds){}
+
+        void report(hash_stats&) const {}
+
+        void swap(hash_counters&) noexcept {}
+    };
+
+#endif
+
+}
+
+#endif //STLCONTAINER_HASH_STATS_HPP
@@ -0,0 +1,1267 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_HASHTABLE_HPP
+#define STLCONTAINER_HASHTABLE_HPP
+
+/*
+ * Node-based hash table shared by unordered_set and unordered_map.
+ *
+ * Every element lives in its own node, and the nodes of all buckets form
+ * one list, so the iteration walks the list instead of the bucket array.
+ * The nodes never move: rehashing relinks them, which keeps the references
+ * to the elements valid.
+ *
+ * How the nodes are linked is decided by Layout, see hash_layout.hpp:
+ * dinkumware_layout keeps a doubly-linked list and two pointers per bucket,
+ * forward_layout keeps a singly-linked list and one pointer per bucket,
+ * and caches the hash in the node unless it's cheap to compute, which makes
+ * erase() noexcept. incremental_layout is forward_layout which moves the
+ * nodes to the new buckets a few buckets per insertion or erasure, after
+ * the new buckets are allocated, instead of relinking all of them at once.
+ * treeify_layout is dinkumware_layout which also indexes a long bucket by
+ * an rbtree, see tree_layout.hpp. filter_layout wraps another layout with
+ * a Bloom or cuckoo filter of the hashes, which a lookup checks before its
+ * bucket, see filter_layout.hpp.
+ *
+ * BucketIndex maps a hash to a bucket without a division, see
+ * bucket_index.hpp: prime_index (default) keeps a prime bucket count and
+ * uses Lemire's fastmod, power_of_two_index mixes the hash and masks it.
+ *
+ * The table grows when the load factor exceeds max_load_factor(), the
+ * number of buckets is at least doubled. rehash() and reserve() relink all
+ * nodes at once in every layout.
+ *
+ * An incremental_layout table moves a few old buckets on every insertion
+ * and every erase() of a key, so a table which only erases after it grew
+ * still ends the move. erase() of an iterator doesn't move them, which
+ * keeps erasing while iterating valid. A table which only reads keeps both
+ * bucket arrays allocated, and bucket_count() counts both, until
+ * finish_rehash() moves the rest at once. While the nodes are moved, an
+ * insertion or an erasure of a key may change the order of the iteration,
+ * but it invalidates no iterator.
+ *
+ * The table shrinks only if min_load_factor() is set, 0 by default. Then
+ * erase() of a key rehashes when the load factor falls below it, to the
+ * buckets for the load factor halfway between the minimum and the maximum,
+ * so the table doesn't shrink and grow again around one size. erase() of
+ * an iterator never rehashes, which keeps erasing while iterating valid.
+ * shrink_to_fit() and trim() shrink on demand.
+ *
+ * stats() reports the chain lengths, the sampled lookups, the rehashes and
+ * the memory of the table, see hash_stats.hpp.
+ *
+ * The keys are unique. multi_hashtable derives from it and keeps equal keys
+ * in adjacent nodes, see multi_hashtable.hpp.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include "bucket_index.hpp"
+#include "filter_layout.hpp"
+#include "hash.hpp"
+#include "hash_iterator.hpp"
+#include "hash_layout.hpp"
+#include "hash_node.hpp"
+#include "hash_stats.hpp"
+#include "key_of_value.hpp"
+#include "tree_layout.hpp"
+
+namespace sc::utils{
+
+    // KeyOfValue returns the key of a stored value, Layout links the nodes
+    // and BucketIndex maps a hash to a bucket
+    template <class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    class hashtable{
+    protected:
+
+        using storage_type = typename Layout::template storage<Value, Key, KeyOfValue, Hash>;
+
+        using node = typename storage_type::node_type;
+
+        // the bucket of a node is found without calling a throwing hash function
+        static constexpr bool nothrow_bucket = storage_type::caches_hash ||
+                std::is_nothrow_invocable_v<const Hash&, const Key&>;
+
+    public:
+        using key_type = Key;
+
+        using value_type = Value;
+
+        using size_type = std::size_t;
+
+        using difference_type = std::ptrdiff_t;
+
+        using hasher = Hash;
+
+        using key_equal = KeyEqual;
+
+        using reference = value_type &;
+
+        using const_reference = const value_type &;
+
+        using pointer = value_type *;
+
+        using const_pointer = const value_type *;
+
+        // the elements of a set are keys, which can not be modified by an iterator
+        using iterator = std::conditional_t<std::is_same_v<Key, Value>,
+                hash_iterator<node, const Value>, hash_iterator<node, Value>>;
+
+        using const_iterator = hash_iterator<node, const Value>;
+
+        //An iterator type whose category, value, difference, pointer and
+        //reference types are the same as iterator. This iterator
+        //can be used to iterate through a single bucket but not across buckets
+        using local_iterator = iterator;
+
+        using const_local_iterator = const_iterator;
+
+        using node_type = hash_node_handle<node, Value>;
+
+        struct insert_return_type{
+            iterator position;
+            bool inserted;
+            node_type node;
+        };
+
+        hashtable(): hashtable(size_type(0)){}
+
+        // allocates at least bucket_count buckets
+        explicit hashtable(size_type bucket_count,
+                const Hash& hash = Hash(),
+                const key_equal& equal = key_equal());
+
+        template <class InputIt>
+        hashtable(InputIt first, InputIt last, size_type bucket_count = 0,
+                const Hash& hash = Hash(), const key_equal& equal = key_equal());
+
+        hashtable(std::initializer_list<value_type> init, size_type bucket_count = 0,
+                const Hash& hash = Hash(), const key_equal& equal = key_equal());
+
+        // copy/move constructor
+        hashtable(const hashtable& other);
+        hashtable(hashtable&& other) noexcept ;
+
+        // copy/move assignment operator
+        // use copy-and-swap idiom and copy elision for better efficiency
+        hashtable&operator=(hashtable other);
+
+        ~hashtable();
+
+        /*
+         * Iterators
+         */
+
+        iterator begin() noexcept { return iterator(storage_.first(), storage_.end_link());}
+        const_iterator begin() const noexcept { return const_iterator(storage_.first(), storage_.end_link());}
+        const_iterator cbegin() const noexcept { return begin();}
+
+        iterator end() noexcept { return iterator(storage_.end_link(), storage_.end_link());}
+        const_iterator end() const noexcept { return const_iterator(storage_.end_link(), storage_.end_link());}
+        const_iterator cend() const noexcept { return end();}
+
+        /*
+         * Capacity
+         */
+
+        bool empty() const { return size_ == 0;}
+
+        size_type size() const { return size_;}
+
+        size_type max_size() const { return std::numeric_limits<difference_type>::max() / sizeof(node);}
+
+        /*
+         * Modifiers
+         */
+
+        void clear() noexcept ;
+
+        /*
+         * If rehashing occurs due to the insertion, all iterators are invalidated. Otherwise iterators are not affected.
+         * References are not invalidated.
+         * Rehashing occurs only if the new number of elements is greater than max_load_factor()*bucket_count()
+         */
+
+        // inserts value if the key is not in the table
+        std::pair<iterator,bool> insert( const value_type& value );
+        std::pair<iterator,bool> insert( value_type&& value );
+
+        // the hint is ignored, the position of an element is decided by its hash
+        iterator insert( const_iterator hint, const value_type& value );
+        iterator insert( const_iterator hint, value_type&& value );
+
+        template< class InputIt >
+        void insert( InputIt first, InputIt last );
+
+        void insert(std::initializer_list<value_type> init);
+
+        // If nh is an empty node handle, does nothing.
+        // Otherwise, inserts the element owned by nh into the container, if the container
+        // doesn't already contain an element with a key equivalent to the one of nh
+        insert_return_type insert(node_type&& nh);
+        iterator insert(const_iterator hint, node_type&& nh);
+
+        // if args are the key, the key and the mapped value, or a pair of them, the key is
+        // hashed and looked up first, and nothing is constructed if it's found
+        template <class... Args>
+        std::pair<iterator,bool> emplace( Args&&... args);
+
+        template <class... Args>
+        iterator emplace_hint(const_iterator hint, Args&&... args);
+
+        // only throws if the hash function throws when the bucket of the element is looked up
+        iterator erase( const_iterator pos) noexcept(nothrow_bucket);
+        iterator erase( const_iterator first, const_iterator last) noexcept(nothrow_bucket);
+        size_type erase( const key_type& key) { return erase_key(key);}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>,
+                  class = std::enable_if_t<!std::is_convertible_v<const K&, const_iterator>>>
+        size_type erase( const K& key) { return erase_key(key);}
+
+        void swap( hashtable& other) noexcept ;
+
+        // unlinks the node that contains the element pointed to by position
+        // and returns a node handle that owns it
+        // the second function overloaded by finding x
+        node_type extract( const_iterator position);
+        node_type extract( const key_type& x) { return extract_key(x);}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>,
+                  class = std::enable_if_t<!std::is_convertible_v<const K&, const_iterator>>>
+        node_type extract( const K& x) { return extract_key(x);}
+
+        // moves the nodes whose key is not in this table from source, no node is copied
+        template <class H2, class P2>
+        void merge(hashtable<Key, Value, KeyOfValue, H2, P2, Layout, BucketIndex>& source);
+
+        template <class H2, class P2>
+        void merge(hashtable<Key, Value, KeyOfValue, H2, P2, Layout, BucketIndex>&& source);
+
+        /*
+         * Look-up
+         */
+
+        size_type count( const Key& key) const { return find_node(key, hash_(key)) == nullptr ? 0 : 1;}
+
+        iterator find(const Key& key);
+        const_iterator find(const Key& key) const;
+
+        bool contains( const Key& key) const { return count(key) != 0;}
+
+        std::pair<iterator, iterator> equal_range( const Key& key);
+        std::pair<const_iterator, const_iterator> equal_range(const Key& key) const;
+
+        // the overloads for any key type K are enabled if Hash and KeyEqual are transparent,
+        // then K is hashed and compared with the keys without constructing a Key
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        size_type count( const K& key) const { return find_node(key, hash_(key)) == nullptr ? 0 : 1;}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        iterator find(const K& key) {
+            node* n = find_node(key, hash_(key));
+            return n == nullptr ? end() : make_iterator(n);
+        }
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        const_iterator find(const K& key) const {
+            node* n = find_node(key, hash_(key));
+            return n == nullptr ? end() : make_iterator(n);
+        }
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        bool contains( const K& key) const { return count(key) != 0;}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        std::pair<iterator, iterator> equal_range( const K& key) {
+            iterator first = find(key);
+            return std::pair<iterator, iterator>(first, first == end() ? first : std::next(first));
+        }
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        std::pair<const_iterator, const_iterator> equal_range( const K& key) const {
+            const_iterator first = find(key);
+            return std::pair<const_iterator, const_iterator>(first, first == end() ? first : std::next(first));
+        }
+
+        /*
+         * Batch operations
+         * the keys of a group are hashed first, then their buckets and first nodes
+         * are prefetched, so the cache misses of the group overlap instead of
+         * following one another. worth it when the table doesn't fit in the cache
+         */
+
+        // writes the iterator of each key in [first, last) to out, end() if the key is not found
+        template <class ForwardIt, class OutputIt>
+        OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out);
+
+        template <class ForwardIt, class OutputIt>
+        OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out) const;
+
+        // inserts the values in [first, last) whose keys are not in the table,
+        // returns the number of inserted values
+        template <class ForwardIt>
+        size_type insert_batch(ForwardIt first, ForwardIt last);
+
+        // erases the keys in [first, last), returns the number of erased elements
+        template <class ForwardIt>
+        size_type erase_batch(ForwardIt first, ForwardIt last);
+
+        /*
+         * Bucket interface
+         */
+
+        // return the local start/end iterator at the bucket of index n
+        local_iterator begin( size_type n);
+        const_local_iterator begin( size_type n) const;
+        const_local_iterator cbegin( size_type n) const { return begin(n);}
+
+        local_iterator end( size_type n);
+        const_local_iterator end( size_type n) const;
+        const_local_iterator cend( size_type n) const { return end(n);}
+
+        size_type bucket_count() const { return storage_.bucket_count();}
+
+        size_type max_bucket_count() const { return std::numeric_limits<difference_type>::max() / sizeof(void*);}
+
+        // returns the number of elements in the bucket with index n
+        size_type bucket_size( size_type n) const;
+
+        // returns the index of the bucket for key key
+        // The behavior is undefined if bucket_count() is zero.
+        size_type bucket( const Key& key) const { return bucket_index(hash_(key));}
+
+        /*
+         * Hash policy
+         */
+
+        float load_factor() const { return bucket_count() == 0 ? 0.f : static_cast<float>(size_) / bucket_count();}
+
+        float max_load_factor() const { return mlf_;}
+
+        // takes effect on the next insertion
+        void max_load_factor( float ml) { mlf_ = ml;}
+
+        // rehash to at least count buckets, and enough buckets for size() elements
+        void rehash( size_type count);
+
+        // reserve the buckets for count elements
+        void reserve( size_type count) { rehash(buckets_for(count));}
+
+        float min_load_factor() const { return min_lf_;}
+
+        // erase() of a key shrinks the table below this load factor, 0 (default) never shrinks.
+        // takes effect on the next erasure
+        void min_load_factor( float ml) { min_lf_ = ml;}
+
+        // rehash to the fewest buckets for size() elements, an empty table frees its buckets
+        void shrink_to_fit();
+
+        // shrink_to_fit(), then return the free memory of the allocator to the system where it
+        // supports it (malloc_trim of glibc), which includes the memory of the erased nodes
+        void trim();
+
+        // move the remaining nodes of an incremental rehash at once and free the old buckets.
+        // until then the old buckets stay allocated and count in bucket_count(), so a table
+        // which stops growing and erasing can call it to end the move
+        void finish_rehash() noexcept;
+
+        // walks every bucket, linear in size() and bucket_count()
+        hash_stats stats() const;
+
+        /*
+         * Observers
+         */
+
+        hasher hash_function() const { return hash_;}
+
+        key_equal key_eq() const { return equal_;}
+
+    protected:
+
+        // inserts the value constructed by args, if key is not in the table
+        template <class K, class... Args>
+        std::pair<iterator,bool> emplace_key(const K& key, Args&&... args);
+
+        // the helpers below are shared with multi_hashtable, which keeps equal keys
+        template <class, class, class, class, class, class, class> friend class hashtable;
+
+        // the number of buckets of the first allocation
+        static constexpr size_type MIN_BUCKETS = 8;
+
+        // the hash of the element in a node, cached by some layouts
+        size_type hash_of(const hash_link* link) const;
+
+        // maps a node to its bucket among count buckets
+        auto bucket_of(size_type count) const {
+            return [this, index = BucketIndex(count)](const hash_link* link){ return index(hash_of(link));};
+        }
+
+        auto bucket_of() const {
+            return [this](const hash_link* link){ return bucket_index(hash_of(link));};
+        }
+
+        // the bucket of a hash. while the nodes are moved, a node stays in its
+        // old bucket until the cursor passes it, the new buckets follow the old ones
+        size_type bucket_index(size_type hash) const;
+
+        // the buckets which the nodes are linked or moved to
+        size_type table_count() const;
+
+        // the number of buckets for count elements, before rounding by BucketIndex
+        size_type buckets_for(size_type count) const {
+            return static_cast<size_type>(std::ceil(static_cast<float>(count) / mlf_));
+        }
+
+        // returns the node of key, nullptr if it's not found
+        template <class K>
+        node* find_node(const K& key, size_type hash) const;
+
+        // searches bucket b for the node which satisfies pred, the tree of
+        // a treeified bucket is searched by key
+        template <class K, class Pred>
+        node* find_in(size_type b, const K& key, Pred pred) const {
+            if constexpr (storage_type::treeifies)
+                return storage_.find(b, key, pred, bucket_of());
+            else
+                return storage_.find(b, pred, bucket_of());
+        }
+
+        template <class K>
+        size_type erase_key(const K& key);
+
+        template <class K>
+        node_type extract_key(const K& key);
+
+        // whether the arguments of emplace() are a key, a key and a mapped value, or
+        // a pair of them, then the key is looked up before a node is allocated
+        template <class... Args>
+        static constexpr bool key_in_args(){
+            if constexpr (sizeof...(Args) == 0){
+                return false;
+            } else{
+                using first = std::decay_t<std::tuple_element_t<0, std::tuple<Args...>>>;
+                if constexpr (std::is_same_v<Key, Value>)
+                    return sizeof...(Args) == 1 && std::is_same_v<first, Key>;
+                else if constexpr (sizeof...(Args) == 2)
+                    return std::is_same_v<first, Key>;
+                else
+                    return sizeof...(Args) == 1 && is_pair_of_key<first, Key>::value;
+            }
+        }
+
+        template <class First, class... Rest>
+        static const First& first_of(const First& first, const Rest&...){ return first;}
+
+        // the keys of a batch which are looked up together
+        static constexpr size_type BATCH = 16;
+
+        // hashes the keys in [first, last) to hashes, at most BATCH of them, and prefetches
+        // their buckets and first nodes. returns the end of the group
+        template <class ForwardIt, class GetKey>
+        ForwardIt prefetch_group(ForwardIt first, ForwardIt last, size_type* hashes, GetKey get_key) const;
+
+        template <class... Args>
+        node* create_node(Args&&... args);
+
+        static void destroy_node(node* n) noexcept ;
+
+        // rehash if count elements exceed the maximum load factor
+        void grow_for(size_type count);
+
+        // shrink after an erasure if the load factor fell below the minimum. a failed
+        // allocation leaves the table as it is, so erase() doesn't throw for it
+        void shrink_for_erase() noexcept;
+
+        // link a node which is not in any table, there must be room for it
+        iterator link_node(node* n, size_type hash);
+
+        // link a node right after the node after, which has the same bucket.
+        // the layout must not rehash incrementally
+        iterator link_node(node* n, size_type hash, node* after);
+
+        // unlink a node from the table without destroying it, returns the link after it
+        hash_link* unlink_node(node* n) noexcept(nothrow_bucket);
+
+        // rehash to the bucket count which BucketIndex supports for count
+        void rehash_to(size_type count);
+
+        // move some old buckets of an incremental rehash, if one is in progress
+        void rehash_step(size_type n) noexcept {
+            if constexpr (storage_type::incremental){
+                if(storage_.rehashing())
+                    storage_.step(n, bucket_of());
+            }
+        }
+
+        // refill the filter of a filter_layout with room for the current buckets
+        void rebuild_filter() noexcept {
+            if constexpr (storage_type::filters){
+                auto capacity = std::max(size_, static_cast<size_type>(mlf_ * static_cast<float>(table_count())));
+                storage_.rebuild_filter(capacity, [this](const hash_link* link){ return hash_of(link);});
+            }
+        }
+
+        // the old buckets moved by an insertion or an erasure of a key while the table is rehashed incrementally
+        static constexpr size_type REHASH_STEP = 2;
+
+        iterator make_iterator(node* n) { return iterator(n, storage_.end_link());}
+        const_iterator make_iterator(node* n) const { return const_iterator(n, storage_.end_link());}
+
+        static node* node_of(const_iterator pos) { return static_cast<node*>(const_cast<hash_link*>(pos.node_));}
+
+        storage_type storage_; // the buckets and the list of nodes
+        BucketIndex index_; // maps a hash to its bucket
+        BucketIndex old_index_; // maps a hash to its old bucket, while the nodes are moved
+        size_type size_; // the number of elements
+        float mlf_; // the maximum load factor
+        float min_lf_; // the minimum load factor, 0 if the table never shrinks
+
+        Hash hash_;
+        KeyEqual equal_;
+
+        hash_counters counters_; // the sampled lookups and the rehashes
+    };
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::hashtable(
+            size_type bucket_count, const Hash &hash, const key_equal &equal):
+            size_(0), mlf_(1.0f), min_lf_(0.f), hash_(hash), equal_(equal)
+    {
+        if(bucket_count > 0)
+            rehash_to(bucket_count);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class InputIt>
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::hashtable(
+            InputIt first, InputIt last, size_type bucket_count, const Hash &hash, const key_equal &equal):
+            hashtable(bucket_count, hash, equal)
+    {
+        insert(first, last);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::hashtable(
+            std::initializer_list<value_type> init, size_type bucket_count, const Hash &hash, const key_equal &equal):
+            hashtable(init.begin(), init.end(), bucket_count, hash, equal){}
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::hashtable(const hashtable &other):
+            size_(0), mlf_(other.mlf_), min_lf_(other.min_lf_), hash_(other.hash_), equal_(other.equal_)
+    {
+        if(other.bucket_count() > 0)
+            rehash_to(other.table_count());
+
+        try {
+            for(const_iterator iter = other.begin(); iter != other.end(); ++iter)
+                link_node(create_node(*iter), other.hash_of(iter.node_));
+        }catch (...){
+            // if throws, destroy the copied elements, the buckets are freed by the storage
+            clear();
+            throw;
+        }
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::hashtable(hashtable &&other) noexcept:
+            size_(0), mlf_(other.mlf_), min_lf_(other.min_lf_), hash_(other.hash_), equal_(other.equal_)
+    {
+        swap(other);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex> &
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::operator=(hashtable other) {
+        // use copy-and-swap idiom here
+        swap(other);
+        return *this;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::~hashtable() {
+        clear();
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    void hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::clear() noexcept {
+        hash_link* link = storage_.first();
+        while(link != storage_.end_link()){
+            hash_link* next = link->next_;
+            destroy_node(static_cast<node*>(link));
+            link = next;
+        }
+        if(bucket_count() > 0)
+            storage_.reset();
+        size_ = 0;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    std::pair<typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator, bool>
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::insert(const value_type &value) {
+        return emplace_key(KeyOfValue()(value), value);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    std::pair<typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator, bool>
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::insert(value_type &&value) {
+        return emplace_key(KeyOfValue()(value), std::move(value));
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::insert(const_iterator, const value_type &value) {
+        return insert(value).first;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::insert(const_iterator, value_type &&value) {
+        return insert(std::move(value)).first;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class InputIt>
+    void hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::insert(InputIt first, InputIt last) {
+        for(; first != last; ++first)
+            insert(*first);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    void hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::insert(std::initializer_list<value_type> init) {
+        insert(init.begin(), init.end());
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::insert_return_type
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::insert(node_type &&nh) {
+        if(nh.empty())
+            return insert_return_type{end(), false, node_type()};
+
+        size_type hash = hash_(KeyOfValue()(*nh.node_->value()));
+        node* found = find_node(KeyOfValue()(*nh.node_->value()), hash);
+        if(found != nullptr)
+            return insert_return_type{make_iterator(found), false, std::move(nh)};
+
+        // if throws, the node is still owned by nh
+        grow_for(size_ + 1);
+        iterator position = link_node(nh.node_, hash);
+        nh.node_ = nullptr;
+        return insert_return_type{position, true, node_type()};
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::insert(const_iterator, node_type &&nh) {
+        return insert(std::move(nh)).position;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class... Args>
+    std::pair<typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator, bool>
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::emplace(Args &&... args) {
+        if constexpr (key_in_args<Args...>()){
+            const auto& first = first_of(args...);
+            if constexpr (is_pair_of_key<std::decay_t<decltype(first)>, Key>::value)
+                return emplace_key(first.first, std::forward<Args>(args)...);
+            else
+                return emplace_key(first, std::forward<Args>(args)...);
+        }
+
+        // otherwise the key is only known after the value is constructed
+        node* n = create_node(std::forward<Args>(args)...);
+        try {
+            size_type hash = hash_(KeyOfValue()(*n->value()));
+            node* found = find_node(KeyOfValue()(*n->value()), hash);
+            if(found != nullptr){
+                destroy_node(n);
+                return std::pair<iterator, bool>(make_iterator(found), false);
+            }
+            grow_for(size_ + 1);
+            return std::pair<iterator, bool>(link_node(n, hash), true);
+        }catch (...){
+            // provide strong exception guarantee
+            destroy_node(n);
+            throw;
+        }
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class... Args>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::emplace_hint(const_iterator, Args &&... args) {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class K, class... Args>
+    std::pair<typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator, bool>
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::emplace_key(const K &key, Args &&... args) {
+        size_type hash = hash_(key);
+        node* found = find_node(key, hash);
+        if(found != nullptr)
+            return std::pair<iterator, bool>(make_iterator(found), false);
+
+        node* n = create_node(std::forward<Args>(args)...);
+        try {
+            grow_for(size_ + 1);
+        }catch (...){
+            // provide strong exception guarantee
+            destroy_node(n);
+            throw;
+        }
+        return std::pair<iterator, bool>(link_node(n, hash), true);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::erase(const_iterator pos) noexcept(nothrow_bucket) {
+        node* n = node_of(pos);
+        hash_link* next = unlink_node(n);
+        destroy_node(n);
+        return iterator(next, storage_.end_link());
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::erase(const_iterator first, const_iterator last) noexcept(nothrow_bucket) {
+        while(first != last)
+            first = erase(first);
+        return iterator(last.node_, storage_.end_link());
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class K>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::size_type
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::erase_key(const K &key) {
+        node* n = find_node(key, hash_(key));
+        if(n == nullptr)
+            return 0;
+        unlink_node(n);
+        destroy_node(n);
+        rehash_step(REHASH_STEP);
+        shrink_for_erase();
+        return 1;
+    }
+
+    // this function has no-throw guarantee because std::swap does not throw
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    void hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::swap(hashtable &other) noexcept {
+        storage_.swap(other.storage_);
+        std::swap(index_, other.index_);
+        std::swap(old_index_, other.old_index_);
+        std::swap(size_, other.size_);
+        std::swap(mlf_, other.mlf_);
+        std::swap(min_lf_, other.min_lf_);
+        std::swap(hash_, other.hash_);
+        std::swap(equal_, other.equal_);
+        counters_.swap(other.counters_);
+        storage_.rebind(bucket_of());
+        other.storage_.rebind(other.bucket_of());
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::node_type
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::extract(const_iterator position) {
+        node* n = node_of(position);
+        unlink_node(n);
+        return node_type(n);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class K>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::node_type
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::extract_key(const K &key) {
+        node* n = find_node(key, hash_(key));
+        if(n == nullptr)
+            return node_type();
+        unlink_node(n);
+        return node_type(n);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class H2, class P2>
+    void hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::merge(
+            hashtable<Key, Value, KeyOfValue, H2, P2, Layout, BucketIndex> &source) {
+        if(static_cast<const void*>(&source) == static_cast<const void*>(this))
+            return;
+
+        auto iter = source.begin();
+        while(iter != source.end()){
+            node* n = node_of(iter);
+            ++iter;
+
+            size_type hash = hash_(KeyOfValue()(*n->value()));
+            if(find_node(KeyOfValue()(*n->value()), hash) != nullptr)
+                continue;
+
+            // make room before unlinking, so that a throw leaves the node in source
+            grow_for(size_ + 1);
+            source.unlink_node(n);
+            link_node(n, hash);
+        }
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class H2, class P2>
+    void hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::merge(
+            hashtable<Key, Value, KeyOfValue, H2, P2, Layout, BucketIndex> &&source) {
+        merge(source);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::find(const Key &key) {
+        node* n = find_node(key, hash_(key));
+        return n == nullptr ? end() : make_iterator(n);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::const_iterator
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::find(const Key &key) const {
+        node* n = find_node(key, hash_(key));
+        return n == nullptr ? end() : make_iterator(n);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    std::pair<typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator,
+              typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator>
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::equal_range(const Key &key) {
+        iterator first = find(key);
+        iterator last = first;
+        if(last != end())
+            ++last;
+        return std::pair<iterator, iterator>(first, last);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    std::pair<typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::const_iterator,
+              typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::const_iterator>
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::equal_range(const Key &key) const {
+        const_iterator first = find(key);
+        const_iterator last = first;
+        if(last != end())
+            ++last;
+        return std::pair<const_iterator, const_iterator>(first, last);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::local_iterator
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::begin(size_type n) {
+        auto range = storage_.bucket_range(n, bucket_of());
+        return local_iterator(range.first, range.second);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::const_local_iterator
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::begin(size_type n) const {
+        auto range = storage_.bucket_range(n, bucket_of());
+        return const_local_iterator(range.first, range.second);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::local_iterator
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::end(size_type n) {
+        auto range = storage_.bucket_range(n, bucket_of());
+        return local_iterator(range.second, range.second);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::const_local_iterator
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::end(size_type n) const {
+        auto range = storage_.bucket_range(n, bucket_of());
+        return const_local_iterator(range.second, range.second);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::size_type
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::bucket_size(size_type n) const {
+        auto range = storage_.bucket_range(n, bucket_of());
+        size_type count = 0;
+        for(hash_link* link = range.first; link != range.second; link = link->next_)
+            ++count;
+        return count;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    hash_stats hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::stats() const {
+        hash_stats stats;
+        stats.size = size_;
+        stats.bucket_count = bucket_count();
+        stats.load_factor = load_factor();
+        for(size_type b=0; b<bucket_count(); ++b){
+            size_type chain = bucket_size(b);
+            ++stats.chain_histogram[std::min(chain, hash_stats::HISTOGRAM_SIZE - 1)];
+            stats.max_chain = std::max(stats.max_chain, chain);
+        }
+        stats.node_bytes = size_ * sizeof(node);
+        stats.bucket_bytes = storage_.bucket_bytes();
+        if constexpr (storage_type::filters){
+            if(!storage_.filter_bypassed()){
+                stats.filter_bytes = storage_.filter().memory();
+                stats.filter_fpr = storage_.filter().false_positive_rate();
+            }
+        }
+        counters_.report(stats);
+        return stats;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    void hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::rehash(size_type count) {
+        count = std::max(count, buckets_for(size_));
+        if(count != 0 && BucketIndex::round(count) != table_count())
+            rehash_to(count);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    void hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::shrink_to_fit() {
+        if(size_ == 0){
+            // back to the buckets of a default-constructed table
+            storage_type empty;
+            storage_.swap(empty);
+            storage_.rebind(bucket_of());
+            index_ = BucketIndex();
+            old_index_ = BucketIndex();
+            return;
+        }
+        size_type count = buckets_for(size_);
+        if(BucketIndex::round(count) < table_count())
+            rehash_to(count);
+        else
+            finish_rehash();
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    void hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::trim() {
+        shrink_to_fit();
+#if defined(__GLIBC__)
+        ::malloc_trim(0);
+#endif
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::size_type
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::bucket_index(size_type hash) const {
+        if constexpr (storage_type::incremental){
+            if(storage_.rehashing()){
+                size_type b = old_index_(hash);
+                if(b >= storage_.cursor())
+                    return b;
+                return storage_.old_count() + index_(hash);
+            }
+        }
+        return index_(hash);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::size_type
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::table_count() const {
+        if constexpr (storage_type::incremental)
+            return bucket_count() - storage_.old_count();
+        else
+            return bucket_count();
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::size_type
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::hash_of(const hash_link *link) const {
+        auto n = static_cast<const node*>(link);
+        if constexpr (storage_type::caches_hash)
+            return n->hash_;
+        else
+            return hash_(KeyOfValue()(*n->value()));
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class K>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::node *
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::find_node(const K &key, size_type hash) const {
+        if(bucket_count() == 0)
+            return nullptr;
+        if constexpr (storage_type::filters){
+            if(!storage_.may_contain(hash))
+                return nullptr;
+        }
+
+        auto pred = [this, &key, hash](const node* n){
+            // a cached hash rejects most of the other keys without comparing them
+            if constexpr (storage_type::caches_hash){
+                if(n->hash_ != hash)
+                    return false;
+            }
+            return static_cast<bool>(equal_(KeyOfValue()(*n->value()), key));
+        };
+        if(hash_counters::sample()){
+            size_type probes = 0;
+            auto counted = [&pred, &probes](const node* n){
+                ++probes;
+                return pred(n);
+            };
+            node* found = find_in(bucket_index(hash), key, counted);
+            counters_.record_lookup(found != nullptr, probes);
+            return found;
+        }
+        return find_in(bucket_index(hash), key, pred);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class ForwardIt, class OutputIt>
+    OutputIt hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::find_batch(ForwardIt first, ForwardIt last, OutputIt out) {
+        size_type hashes[BATCH];
+        while(first != last){
+            ForwardIt group_end = prefetch_group(first, last, hashes, key_of_identity());
+            for(size_type i=0; first != group_end; ++first, ++i){
+                node* n = find_node(*first, hashes[i]);
+                *out++ = n == nullptr ? end() : make_iterator(n);
+            }
+        }
+        return out;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class ForwardIt, class OutputIt>
+    OutputIt hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::find_batch(ForwardIt first, ForwardIt last, OutputIt out) const {
+        size_type hashes[BATCH];
+        while(first != last){
+            ForwardIt group_end = prefetch_group(first, last, hashes, key_of_identity());
+            for(size_type i=0; first != group_end; ++first, ++i){
+                node* n = find_node(*first, hashes[i]);
+                *out++ = n == nullptr ? end() : make_iterator(n);
+            }
+        }
+        return out;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class ForwardIt>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::size_type
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::insert_batch(ForwardIt first, ForwardIt last) {
+        size_type hashes[BATCH];
+        size_type inserted = 0;
+        while(first != last){
+            ForwardIt group_end = first;
+            size_type n = 0;
+            for(; group_end != last && n < BATCH; ++group_end)
+                ++n;
+
+            // the buckets are prefetched after the table grows for the whole group
+            grow_for(size_ + n);
+            prefetch_group(first, group_end, hashes, KeyOfValue());
+            for(size_type i=0; first != group_end; ++first, ++i){
+                // an equal key earlier in the group is found here, it's linked already
+                if(find_node(KeyOfValue()(*first), hashes[i]) != nullptr)
+                    continue;
+                // if throws, the values before first stay inserted
+                link_node(create_node(*first), hashes[i]);
+                ++inserted;
+            }
+        }
+        return inserted;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class ForwardIt>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::size_type
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::erase_batch(ForwardIt first, ForwardIt last) {
+        size_type hashes[BATCH];
+        size_type erased = 0;
+        while(first != last){
+            ForwardIt group_end = prefetch_group(first, last, hashes, key_of_identity());
+            for(size_type i=0; first != group_end; ++first, ++i){
+                node* n = find_node(*first, hashes[i]);
+                if(n == nullptr)
+                    continue;
+                unlink_node(n);
+                destroy_node(n);
+                ++erased;
+            }
+        }
+        rehash_step(REHASH_STEP * erased);
+        shrink_for_erase();
+        return erased;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class ForwardIt, class GetKey>
+    ForwardIt hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::prefetch_group(ForwardIt first, ForwardIt last,
+                                                                                                   size_type *hashes, GetKey get_key) const {
+        size_type n = 0;
+        for(; first != last && n < BATCH; ++first)
+            hashes[n++] = hash_(get_key(*first));
+        if(bucket_count() == 0)
+            return first;
+
+        // each pass touches the lines which the previous pass requested, so
+        // the loads of one pass are in flight together
+        size_type buckets[BATCH];
+        for(size_type i=0; i<n; ++i){
+            buckets[i] = bucket_index(hashes[i]);
+            prefetch(storage_.bucket_address(buckets[i]));
+        }
+        for(size_type i=0; i<n; ++i)
+            prefetch(storage_.bucket_head(buckets[i]));
+        if constexpr (storage_type::head_is_before){
+            for(size_type i=0; i<n; ++i){
+                const hash_link* head = storage_.bucket_head(buckets[i]);
+                if(head != nullptr)
+                    prefetch(head->next_);
+            }
+        }
+        return first;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class... Args>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::node *
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::create_node(Args &&... args) {
+        node* n = new node;
+        try {
+            ::new(static_cast<void*>(n->value())) value_type(std::forward<Args>(args)...);
+        }catch (...){
+            // if throws, deallocates the memory
+            delete n;
+            throw;
+        }
+        return n;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    void hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::destroy_node(node *n) noexcept {
+        std::destroy_at(n->value());
+        delete n;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    void hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::grow_for(size_type count) {
+        if(static_cast<float>(count) <= mlf_ * static_cast<float>(table_count()))
+            return;
+        count = std::max({MIN_BUCKETS, table_count() * 2, buckets_for(count)});
+        if constexpr (storage_type::incremental){
+            // the following insertions move the nodes, only one rehash is in progress
+            if(size_ > 0){
+                auto start = std::chrono::steady_clock::now();
+                count = BucketIndex::round(count);
+                finish_rehash();
+                storage_.begin_rehash(count);
+                old_index_ = index_;
+                index_ = BucketIndex(count);
+                rebuild_filter();
+                counters_.record_rehash(std::chrono::steady_clock::now() - start);
+                return;
+            }
+        }
+        rehash_to(count);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    void hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::shrink_for_erase() noexcept {
+        // relinking must not call a throwing hash function, a throw would lose the nodes
+        if constexpr (nothrow_bucket){
+            if(static_cast<float>(size_) >= min_lf_ * static_cast<float>(table_count()) || table_count() <= MIN_BUCKETS)
+                return;
+            size_type count = std::max(MIN_BUCKETS, static_cast<size_type>(
+                    std::ceil(2.f * static_cast<float>(size_) / (min_lf_ + mlf_))));
+            if(BucketIndex::round(count) >= table_count())
+                return;
+            try {
+                rehash_to(count);
+            } catch (const std::bad_alloc&){
+                // the table keeps its buckets
+            }
+        }
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::link_node(node *n, size_type hash) {
+        if constexpr (storage_type::caches_hash)
+            n->hash_ = hash;
+        // move some old buckets before n is linked, so that n is linked to its bucket after the step
+        rehash_step(REHASH_STEP);
+        storage_.link(n, bucket_index(hash), bucket_of());
+        if constexpr (storage_type::filters)
+            storage_.filter_insert(hash);
+        ++size_;
+        return make_iterator(n);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator
+    hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::link_node(node *n, size_type hash, node *after) {
+        static_assert(!storage_type::incremental, "a node is linked after another one only without incremental rehashing");
+        if constexpr (storage_type::caches_hash)
+            n->hash_ = hash;
+        storage_.link_after(n, after, bucket_index(hash), bucket_of());
+        if constexpr (storage_type::filters)
+            storage_.filter_insert(hash);
+        ++size_;
+        return make_iterator(n);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    hash_link *hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::unlink_node(node *n) noexcept(nothrow_bucket) {
+        size_type hash = hash_of(n);
+        hash_link* next = storage_.unlink(n, bucket_index(hash), bucket_of());
+        if constexpr (storage_type::filters)
+            storage_.filter_erase(hash);
+        --size_;
+        return next;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    void hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::rehash_to(size_type count) {
+        auto start = std::chrono::steady_clock::now();
+        count = BucketIndex::round(count);
+        finish_rehash();
+        storage_.rehash(count, bucket_of(count));
+        index_ = BucketIndex(count);
+        rebuild_filter();
+        counters_.record_rehash(std::chrono::steady_clock::now() - start);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    void hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::finish_rehash() noexcept {
+        if constexpr (storage_type::incremental){
+            if(storage_.rehashing())
+                storage_.step(storage_.old_count(), bucket_of());
+        }
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    bool operator==(const hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>& lhs,
+                    const hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>& rhs){
+        if(lhs.size() != rhs.size())
+            return false;
+        for(const auto& value: lhs){
+            auto iter = rhs.find(KeyOfValue()(value));
+            if(iter == rhs.end() || !(*iter == value))
+                return false;
+        }
+        return true;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    bool operator!=(const hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>& lhs,
+                    const hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>& rhs){
+        return !(lhs == rhs);
+    }
+
+}
+
+#endif //STLCONTAINER_HASHTABLE_HPP
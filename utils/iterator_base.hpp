@@ -40,9 +40,9 @@ namespace sc::utils{
                 class = std::enable_if_t<std::is_convertible_v<OtherT*, T*>>>
                 iterator_base(const iterator_base<OtherT,OtherIter>& other): ptr_(other.ptr_) {}
 
-        reference operator*() {return *ptr_;}
+        reference operator*() const {return *ptr_;}
 
-        pointer operator->() {return ptr_;}
+        pointer operator->() const {return ptr_;}
 
         virtual Iterator&operator++() = 0;
 
@@ -64,7 +64,7 @@ namespace sc::utils{
         template <class> friend class sc::regular::list;
         //template <class> friend class list_iterator;
         //template <class> friend class array_iterator;
-        //template <class,class> friend class iterator_base;
+        template <class,class> friend class iterator_base;
         //template <class> friend class deque_iterator;
 
     protected:
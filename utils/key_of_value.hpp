@@ -0,0 +1,39 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_KEY_OF_VALUE_HPP
+#define STLCONTAINER_KEY_OF_VALUE_HPP
+
+#include <type_traits>
+#include <utility>
+
+namespace sc::utils{
+
+    // returns the key of a set element, which is the element itself
+    struct key_of_identity{
+        template <class T>
+        const T& operator()(const T& value) const { return value;}
+    };
+
+    // returns the key of a map element
+    struct key_of_pair{
+        template <class Pair>
+        const typename Pair::first_type& operator()(const Pair& value) const { return value.first;}
+    };
+
+    // whether T is a pair whose first member is a Key
+    template <class T, class Key>
+    struct is_pair_of_key: std::false_type{};
+
+    template <class First, class Second, class Key>
+    struct is_pair_of_key<std::pair<First, Second>, Key>: std::is_same<std::remove_cv_t<First>, Key>{};
+
+    // valid if Hash and KeyEqual both accept the keys of other types, like a
+    // std::string_view for std::string keys
+    template <class Hash, class KeyEqual>
+    using transparent_t = std::void_t<typename Hash::is_transparent, typename KeyEqual::is_transparent>;
+
+}
+
+#endif //STLCONTAINER_KEY_OF_VALUE_HPP
@@ -34,7 +34,6 @@ namespace sc::utils{
 
 
      private:
-         template <class, class, class> friend class sc::regular::unordered_set;
          template <class> friend class sc::regular::list;
          template <class> friend class list_iterator;
 
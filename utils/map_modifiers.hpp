@@ -0,0 +1,85 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_MAP_MODIFIERS_HPP
+#define STLCONTAINER_MAP_MODIFIERS_HPP
+
+/*
+ * try_emplace() and insert_or_assign() of the unique-key maps.
+ *
+ * A map derives from map_modifiers<Map, ...> and makes it a friend. The
+ * functions call Map::emplace_key(key, args...), which looks key up and
+ * constructs the element from args only if key is not found, so the key is
+ * hashed once and neither the key nor the value is moved from when the key
+ * is already in the map.
+ */
+
+#include <tuple>
+#include <utility>
+
+namespace sc::utils{
+
+    template <class Map, class Key, class T, class Iterator, class ConstIterator>
+    class map_modifiers{
+    public:
+
+        // inserts the value constructed by args if key is not found, otherwise neither key nor args are moved from
+        template <class... Args>
+        std::pair<Iterator, bool> try_emplace( const Key& key, Args&&... args) {
+            return derived().emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                     std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        template <class... Args>
+        std::pair<Iterator, bool> try_emplace( Key&& key, Args&&... args) {
+            // key is hashed before it's moved into the new element
+            return derived().emplace_key(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                     std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        template <class... Args>
+        Iterator try_emplace( ConstIterator, const Key& key, Args&&... args) {
+            return try_emplace(key, std::forward<Args>(args)...).first;
+        }
+
+        template <class... Args>
+        Iterator try_emplace( ConstIterator, Key&& key, Args&&... args) {
+            return try_emplace(std::move(key), std::forward<Args>(args)...).first;
+        }
+
+        // inserts obj if key is not found, otherwise assigns obj to the mapped value
+        template <class M>
+        std::pair<Iterator, bool> insert_or_assign( const Key& key, M&& obj) {
+            // obj is not moved from if the key is found
+            auto result = try_emplace(key, std::forward<M>(obj));
+            if(!result.second)
+                result.first->second = std::forward<M>(obj);
+            return result;
+        }
+
+        template <class M>
+        std::pair<Iterator, bool> insert_or_assign( Key&& key, M&& obj) {
+            auto result = try_emplace(std::move(key), std::forward<M>(obj));
+            if(!result.second)
+                result.first->second = std::forward<M>(obj);
+            return result;
+        }
+
+        template <class M>
+        Iterator insert_or_assign( ConstIterator, const Key& key, M&& obj) {
+            return insert_or_assign(key, std::forward<M>(obj)).first;
+        }
+
+        template <class M>
+        Iterator insert_or_assign( ConstIterator, Key&& key, M&& obj) {
+            return insert_or_assign(std::move(key), std::forward<M>(obj)).first;
+        }
+
+    private:
+        Map& derived() { return static_cast<Map&>(*this);}
+    };
+
+}
+
+#endif //STLCONTAINER_MAP_MODIFIERS_HPP
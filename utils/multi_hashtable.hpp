@@ -0,0 +1,554 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_MULTI_HASHTABLE_HPP
+#define STLCONTAINER_MULTI_HASHTABLE_HPP
+
+/*
+ * Node-based hash table with equal keys, shared by unordered_multiset and
+ * unordered_multimap.
+ *
+ * The nodes of equal keys form a group of adjacent nodes in the list, like
+ * the nodes of a bucket do. A lookup walks its bucket in list order, so it
+ * stops at the first node of the group, and the group ends a known number
+ * of nodes later: every node has a group_ field, the first node of a group
+ * holds the number of nodes of the group and the others hold 0. Then
+ * count() costs one lookup, equal_range() one lookup and a walk over the
+ * group, and erase(key) unlinks the group without comparing its keys.
+ * A new element is linked right after the first node of its group.
+ *
+ * Erasing the first node of a group moves the size to the next node.
+ * Erasing another node walks its bucket to find the first node of its
+ * group, which costs about as much as the lookup which found the node.
+ *
+ * The storages rehash by linking every node first in its new bucket, which
+ * reverses every group, so after a rehash the size of a group is in its
+ * last node. grouped_storage moves it back to the first node in one pass
+ * over the list, without comparing any key. The tree of treeify_layout
+ * doesn't keep groups and incremental_layout moves the buckets one at a
+ * time, so neither of them is supported.
+ *
+ * The first node of every group costs 8 more bytes than in hashtable, but
+ * a key with many values costs one node per value, instead of a node and a
+ * vector in an unordered_map<Key, std::vector<T>>.
+ *
+ * references: http://bannalia.blogspot.com/2013/10/implementation-of-c-unordered.html
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "hashtable.hpp"
+
+namespace sc::utils{
+
+    // the storage of Layout whose nodes also hold the size of their group
+    template <class Storage>
+    class grouped_storage: public Storage{
+
+        static_assert(!Storage::treeifies && !Storage::incremental,
+                "equal keys are kept only by non-incremental layouts without trees");
+
+        using base_node = typename Storage::node_type;
+
+    public:
+
+        using size_type = std::size_t;
+
+        // the first node of a group holds the number of nodes of the group, the others hold 0
+        struct node_type: public base_node{
+            size_type group_ = 0;
+        };
+
+        // returns the first node in bucket b which satisfies pred, or nullptr
+        template <class Pred, class BucketOf>
+        node_type* find(size_type b, Pred pred, BucketOf bucket_of) const {
+            auto found = Storage::find(b, [&pred](const base_node* n){ return pred(static_cast<const node_type*>(n));}, bucket_of);
+            return static_cast<node_type*>(found);
+        }
+
+        // relinks the nodes, then moves the size of every group back to its first node
+        template <class BucketOf>
+        void rehash(size_type count, BucketOf bucket_of){
+            Storage::rehash(count, bucket_of);
+            regroup();
+        }
+
+    private:
+        // the storage linked every node first in its bucket, so a group is
+        // reversed and its size is in its last node
+        void regroup() noexcept {
+            hash_link* first = this->first();
+            for(hash_link* link = first; link != this->end_link(); link = link->next_){
+                auto n = static_cast<node_type*>(link);
+                if(n->group_ == 0)
+                    continue;
+                if(link != first){
+                    static_cast<node_type*>(first)->group_ = n->group_;
+                    n->group_ = 0;
+                }
+                first = link->next_;
+            }
+        }
+    };
+
+    // Layout whose nodes are grouped by key
+    template <class Layout>
+    struct grouped_layout{
+        template <class Value, class Key, class KeyOfValue, class Hash>
+        using storage = grouped_storage<typename Layout::template storage<Value, Key, KeyOfValue, Hash>>;
+    };
+
+    // hashtable whose keys are not unique. Layout is dinkumware_layout,
+    // forward_layout, or filter_layout of one of them
+    template <class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    class multi_hashtable: public hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, grouped_layout<Layout>, BucketIndex>{
+
+        using base = hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, grouped_layout<Layout>, BucketIndex>;
+
+        using node = typename base::node;
+
+    public:
+        using typename base::key_type;
+
+        using typename base::value_type;
+
+        using typename base::size_type;
+
+        using typename base::hasher;
+
+        using typename base::key_equal;
+
+        using typename base::iterator;
+
+        using typename base::const_iterator;
+
+        using typename base::node_type;
+
+        multi_hashtable(): multi_hashtable(size_type(0)){}
+
+        // allocates at least bucket_count buckets
+        explicit multi_hashtable(size_type bucket_count,
+                const Hash& hash = Hash(),
+                const key_equal& equal = key_equal()): base(bucket_count, hash, equal){}
+
+        template <class InputIt>
+        multi_hashtable(InputIt first, InputIt last, size_type bucket_count = 0,
+                const Hash& hash = Hash(), const key_equal& equal = key_equal()): base(bucket_count, hash, equal) {
+            insert(first, last);
+        }
+
+        multi_hashtable(std::initializer_list<value_type> init, size_type bucket_count = 0,
+                const Hash& hash = Hash(), const key_equal& equal = key_equal()):
+                multi_hashtable(init.begin(), init.end(), bucket_count, hash, equal){}
+
+        // the copy has the groups of other, in the same order
+        multi_hashtable(const multi_hashtable& other);
+        multi_hashtable(multi_hashtable&& other) noexcept : base(std::move(other)){}
+
+        // use copy-and-swap idiom
+        multi_hashtable&operator=(multi_hashtable other) noexcept { this->swap(other); return *this;}
+
+        /*
+         * Modifiers
+         * an element is always inserted, right after the first element of its key
+         */
+
+        iterator insert( const value_type& value) { return emplace(value);}
+        iterator insert( value_type&& value) { return emplace(std::move(value));}
+
+        // the hint is ignored, the position of an element is decided by its key
+        iterator insert( const_iterator, const value_type& value) { return emplace(value);}
+        iterator insert( const_iterator, value_type&& value) { return emplace(std::move(value));}
+
+        template< class InputIt >
+        void insert( InputIt first, InputIt last) {
+            for(; first != last; ++first)
+                emplace(*first);
+        }
+
+        void insert(std::initializer_list<value_type> init) { insert(init.begin(), init.end());}
+
+        // inserts the element owned by nh, returns end() if nh is empty
+        iterator insert(node_type&& nh);
+        iterator insert(const_iterator, node_type&& nh) { return insert(std::move(nh));}
+
+        template <class... Args>
+        iterator emplace( Args&&... args);
+
+        template <class... Args>
+        iterator emplace_hint(const_iterator, Args&&... args) { return emplace(std::forward<Args>(args)...);}
+
+        // erasing an element which is not the first of its key walks its bucket
+        iterator erase( const_iterator pos) noexcept(base::nothrow_bucket);
+        iterator erase( const_iterator first, const_iterator last) noexcept(base::nothrow_bucket);
+
+        // erases every element of key, returns their number
+        size_type erase( const key_type& key) { return erase_key(key);}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>,
+                  class = std::enable_if_t<!std::is_convertible_v<const K&, const_iterator>>>
+        size_type erase( const K& key) { return erase_key(key);}
+
+        node_type extract( const_iterator position);
+
+        // extracts the first element of x
+        node_type extract( const key_type& x) { return extract_key(x);}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>,
+                  class = std::enable_if_t<!std::is_convertible_v<const K&, const_iterator>>>
+        node_type extract( const K& x) { return extract_key(x);}
+
+        // moves every node of source, no node is copied
+        template <class H2, class P2>
+        void merge(multi_hashtable<Key, Value, KeyOfValue, H2, P2, Layout, BucketIndex>& source);
+
+        template <class H2, class P2>
+        void merge(multi_hashtable<Key, Value, KeyOfValue, H2, P2, Layout, BucketIndex>&& source) { merge(source);}
+
+        /*
+         * Look-up
+         * find() returns the first element of the key
+         */
+
+        // one lookup, the size of the group is in its first node
+        size_type count( const Key& key) const { return count_key(key);}
+
+        // one lookup and a walk over the elements of key
+        std::pair<iterator, iterator> equal_range( const Key& key) { return range_of(key);}
+        std::pair<const_iterator, const_iterator> equal_range(const Key& key) const { return range_of(key);}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        size_type count( const K& key) const { return count_key(key);}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        std::pair<iterator, iterator> equal_range( const K& key) { return range_of(key);}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        std::pair<const_iterator, const_iterator> equal_range( const K& key) const { return range_of(key);}
+
+        /*
+         * Batch operations, see hashtable
+         */
+
+        // inserts every value in [first, last), returns their number
+        template <class ForwardIt>
+        size_type insert_batch(ForwardIt first, ForwardIt last);
+
+        // erases every element of the keys in [first, last), returns the number of erased elements
+        template <class ForwardIt>
+        size_type erase_batch(ForwardIt first, ForwardIt last);
+
+    private:
+        template <class, class, class, class, class, class, class> friend class multi_hashtable;
+
+        // links n after the first node of its key, or first in its bucket if
+        // the key is new. there must be room for it
+        iterator link_grouped(node* n, size_type hash);
+
+        // unlinks n and keeps the size of its group in the first node of the group
+        hash_link* unlink_grouped(node* n) noexcept(base::nothrow_bucket);
+
+        // the first node of the group of n, found by walking the bucket of n
+        node* head_of(node* n) const noexcept(base::nothrow_bucket);
+
+        // unlinks and destroys the group which starts at head, returns its size
+        size_type erase_group(node* head) noexcept(base::nothrow_bucket);
+
+        template <class K>
+        size_type erase_key(const K& key) {
+            node* head = this->find_node(key, this->hash_(key));
+            if(head == nullptr)
+                return 0;
+            size_type erased = erase_group(head);
+            this->shrink_for_erase();
+            return erased;
+        }
+
+        template <class K>
+        node_type extract_key(const K& key) {
+            node* head = this->find_node(key, this->hash_(key));
+            return head == nullptr ? node_type() : extract(this->make_iterator(head));
+        }
+
+        template <class K>
+        size_type count_key(const K& key) const {
+            node* head = this->find_node(key, this->hash_(key));
+            return head == nullptr ? 0 : head->group_;
+        }
+
+        template <class K>
+        std::pair<iterator, iterator> range_of(const K& key);
+
+        template <class K>
+        std::pair<const_iterator, const_iterator> range_of(const K& key) const;
+    };
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::multi_hashtable(const multi_hashtable &other):
+            base(size_type(0), other.hash_, other.equal_)
+    {
+        this->mlf_ = other.mlf_;
+        this->min_lf_ = other.min_lf_;
+        if(other.bucket_count() > 0)
+            this->rehash_to(other.table_count());
+
+        try {
+            // the first node of a group is linked first in its bucket, the others after the previous one
+            node* last = nullptr;
+            for(hash_link* link = other.storage_.first(); link != other.storage_.end_link(); link = link->next_){
+                auto source = static_cast<const node*>(link);
+                node* n = this->create_node(*source->value());
+                if(source->group_ != 0){
+                    n->group_ = source->group_;
+                    this->link_node(n, other.hash_of(link));
+                } else{
+                    this->link_node(n, other.hash_of(link), last);
+                }
+                last = n;
+            }
+        }catch (...){
+            // if throws, destroy the copied elements, the buckets are freed by the storage
+            this->clear();
+            throw;
+        }
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator
+    multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::insert(node_type &&nh) {
+        if(nh.empty())
+            return this->end();
+
+        // if throws, the node is still owned by nh
+        this->grow_for(this->size_ + 1);
+        iterator position = link_grouped(nh.node_, this->hash_(KeyOfValue()(*nh.node_->value())));
+        nh.node_ = nullptr;
+        return position;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class... Args>
+    typename multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator
+    multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::emplace(Args &&... args) {
+        node* n = this->create_node(std::forward<Args>(args)...);
+        try {
+            size_type hash = this->hash_(KeyOfValue()(*n->value()));
+            this->grow_for(this->size_ + 1);
+            return link_grouped(n, hash);
+        }catch (...){
+            // provide strong exception guarantee
+            this->destroy_node(n);
+            throw;
+        }
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator
+    multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::erase(const_iterator pos) noexcept(base::nothrow_bucket) {
+        node* n = base::node_of(pos);
+        hash_link* next = unlink_grouped(n);
+        this->destroy_node(n);
+        return iterator(next, this->storage_.end_link());
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator
+    multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::erase(const_iterator first, const_iterator last) noexcept(base::nothrow_bucket) {
+        while(first != last)
+            first = erase(first);
+        return iterator(last.node_, this->storage_.end_link());
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::node_type
+    multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::extract(const_iterator position) {
+        node* n = base::node_of(position);
+        unlink_grouped(n);
+        n->group_ = 0;
+        return node_type(n);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class H2, class P2>
+    void multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::merge(
+            multi_hashtable<Key, Value, KeyOfValue, H2, P2, Layout, BucketIndex> &source) {
+        if(static_cast<const void*>(&source) == static_cast<const void*>(this))
+            return;
+
+        // the nodes are moved in list order, so the node unlinked from source
+        // is always the first of its group
+        auto iter = source.begin();
+        while(iter != source.end()){
+            node* n = base::node_of(iter);
+            ++iter;
+
+            size_type hash = this->hash_(KeyOfValue()(*n->value()));
+            // make room before unlinking, so that a throw leaves the node in source
+            this->grow_for(this->size_ + 1);
+            node* head = this->find_node(KeyOfValue()(*n->value()), hash);
+            source.unlink_grouped(n);
+            if(head != nullptr){
+                ++head->group_;
+                n->group_ = 0;
+                this->link_node(n, hash, head);
+            } else{
+                n->group_ = 1;
+                this->link_node(n, hash);
+            }
+        }
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class K>
+    std::pair<typename multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator,
+              typename multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator>
+    multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::range_of(const K &key) {
+        node* head = this->find_node(key, this->hash_(key));
+        if(head == nullptr)
+            return std::pair<iterator, iterator>(this->end(), this->end());
+        hash_link* last = head;
+        for(size_type i=0; i<head->group_; ++i)
+            last = last->next_;
+        return std::pair<iterator, iterator>(this->make_iterator(head), iterator(last, this->storage_.end_link()));
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class K>
+    std::pair<typename multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::const_iterator,
+              typename multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::const_iterator>
+    multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::range_of(const K &key) const {
+        auto range = const_cast<multi_hashtable*>(this)->range_of(key);
+        return std::pair<const_iterator, const_iterator>(range.first, range.second);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class ForwardIt>
+    typename multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::size_type
+    multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::insert_batch(ForwardIt first, ForwardIt last) {
+        size_type hashes[base::BATCH];
+        size_type inserted = 0;
+        while(first != last){
+            ForwardIt group_end = first;
+            size_type n = 0;
+            for(; group_end != last && n < base::BATCH; ++group_end)
+                ++n;
+
+            // the buckets are prefetched after the table grows for the whole group
+            this->grow_for(this->size_ + n);
+            this->prefetch_group(first, group_end, hashes, KeyOfValue());
+            for(size_type i=0; first != group_end; ++first, ++i){
+                node* created = this->create_node(*first);
+                try {
+                    link_grouped(created, hashes[i]);
+                }catch (...){
+                    // the values before first stay inserted
+                    this->destroy_node(created);
+                    throw;
+                }
+                ++inserted;
+            }
+        }
+        return inserted;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    template<class ForwardIt>
+    typename multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::size_type
+    multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::erase_batch(ForwardIt first, ForwardIt last) {
+        size_type hashes[base::BATCH];
+        size_type erased = 0;
+        while(first != last){
+            ForwardIt group_end = this->prefetch_group(first, last, hashes, key_of_identity());
+            for(size_type i=0; first != group_end; ++first, ++i){
+                node* head = this->find_node(*first, hashes[i]);
+                if(head != nullptr)
+                    erased += erase_group(head);
+            }
+        }
+        this->shrink_for_erase();
+        return erased;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::iterator
+    multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::link_grouped(node *n, size_type hash) {
+        node* head = this->find_node(KeyOfValue()(*n->value()), hash);
+        if(head == nullptr){
+            n->group_ = 1;
+            return this->link_node(n, hash);
+        }
+        ++head->group_;
+        n->group_ = 0;
+        return this->link_node(n, hash, head);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    hash_link *multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::unlink_grouped(node *n) noexcept(base::nothrow_bucket) {
+        // every call which may throw comes before the first change
+        node* head = n->group_ == 0 ? head_of(n) : nullptr;
+        hash_link* next = this->unlink_node(n);
+        if(head != nullptr)
+            --head->group_;
+        else if(n->group_ > 1)
+            static_cast<node*>(next)->group_ = n->group_ - 1;
+        return next;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::node *
+    multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::head_of(node *n) const noexcept(base::nothrow_bucket) {
+        // the last first node of a group before n
+        node* head = nullptr;
+        auto pred = [n, &head](const node* m){
+            if(m->group_ != 0)
+                head = const_cast<node*>(m);
+            return m == n;
+        };
+        this->storage_.find(this->bucket_index(this->hash_of(n)), pred, this->bucket_of());
+        return head;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    typename multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::size_type
+    multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>::erase_group(node *head) noexcept(base::nothrow_bucket) {
+        // the first node is erased every time, so the group stays counted if a hash throws
+        size_type count = head->group_;
+        for(size_type i=0; i<count; ++i){
+            auto next = static_cast<node*>(unlink_grouped(head));
+            this->destroy_node(head);
+            head = next;
+        }
+        return count;
+    }
+
+    // the same elements for every key, in any order
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    bool operator==(const multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>& lhs,
+                    const multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>& rhs){
+        if(lhs.size() != rhs.size())
+            return false;
+        for(auto iter = lhs.begin(); iter != lhs.end(); ){
+            auto left = lhs.equal_range(KeyOfValue()(*iter));
+            auto right = rhs.equal_range(KeyOfValue()(*iter));
+            if(lhs.count(KeyOfValue()(*iter)) != rhs.count(KeyOfValue()(*iter)) ||
+               !std::is_permutation(left.first, left.second, right.first))
+                return false;
+            iter = left.second;
+        }
+        return true;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Layout, class BucketIndex>
+    bool operator!=(const multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>& lhs,
+                    const multi_hashtable<Key, Value, KeyOfValue, Hash, KeyEqual, Layout, BucketIndex>& rhs){
+        return !(lhs == rhs);
+    }
+
+}
+
+#endif //STLCONTAINER_MULTI_HASHTABLE_HPP
@@ -9,9 +9,6 @@
 
 namespace sc::regular{
     template <class> class list;
-    template <class,class,class> class unordered_set;
-    template <class, class, class, class> class unordered_map;
-    template <class,class> class rbtree;
 }
 
 namespace sc::utils{
@@ -43,9 +40,6 @@ namespace sc::utils{
         T getValue() const {return val_;}
 
     private:
-        template <class,class,class> friend class sc::regular::unordered_set;
-        template <class, class, class, class> friend class sc::regular::unordered_map;
-        template <class> friend class sc::regular::rbtree;
         template <class> friend class sc::regular::list;
         template <class> friend class list_iterator;
 
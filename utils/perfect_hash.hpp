@@ -0,0 +1,194 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_PERFECT_HASH_HPP
+#define STLCONTAINER_PERFECT_HASH_HPP
+
+/*
+ * Minimal perfect hash by hash-and-displace (CHD).
+ *
+ * The n keys are given by their 64-bit hashes. They are split into about
+ * n / 4 buckets by the hash, and every bucket gets a displacement: the
+ * slot of a key is mix(hash, displacement) % n. The buckets are placed from
+ * the largest one, each with the first displacement which sends all of its
+ * keys to free slots. A bucket of one key is placed directly into a free
+ * slot, its displacement holds the slot with DIRECT set, so the placement
+ * always terminates and the n keys fill the n slots exactly.
+ *
+ * A lookup reads one displacement and computes one slot, the key found in
+ * the slot must still be compared, a key which is not in the set maps to
+ * the slot of some other key.
+ *
+ * The hashes must be stable across processes, so hash_bytes() is used
+ * instead of std::hash. Two keys with the same 64-bit hash can't be
+ * separated, build() retries with another seed, which changes every hash.
+ *
+ * references: Belazzougui, D., Botelho, F. C., Dietzfelbinger, M. Hash, displace, and compress. 2009.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace sc::utils{
+
+    // the finalizer of MurmurHash3, every bit of x affects every bit of the result
+    constexpr std::uint64_t mix64(std::uint64_t x){
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDull;
+        x ^= x >> 33;
+        x *= 0xC4CEB9FE1A85EC53ull;
+        x ^= x >> 33;
+        return x;
+    }
+
+    // a hash of size bytes which is the same in every process and on every platform of the same endianness
+    inline std::uint64_t hash_bytes(const void* data, std::size_t size, std::uint64_t seed){
+        auto p = static_cast<const unsigned char*>(data);
+        std::uint64_t h = seed ^ (size * 0x9E3779B97F4A7C15ull);
+        for(; size >= 8; size -= 8, p += 8){
+            std::uint64_t k;
+            std::memcpy(&k, p, 8);
+            h = mix64(h ^ k) + 0x9E3779B97F4A7C15ull;
+        }
+        if(size > 0){
+            std::uint64_t k = 0;
+            std::memcpy(&k, p, size);
+            h = mix64(h ^ k ^ (std::uint64_t(size) << 56));
+        }
+        return mix64(h);
+    }
+
+    class perfect_hash{
+    public:
+
+        using size_type = std::size_t;
+
+        // a displacement which is the slot of the only key of its bucket
+        static constexpr std::uint64_t DIRECT = std::uint64_t(1) << 63;
+
+        // the average keys per bucket
+        static constexpr size_type BUCKET_LOAD = 4;
+
+        // the displacements tried for a bucket before build() gives up the seed
+        static constexpr std::uint64_t MAX_DISPLACEMENT = std::uint64_t(1) << 20;
+
+        perfect_hash(): seed_(0), slots_(0){}
+
+        // the seed is chosen by build(), the hashes of the keys are hash_bytes(key, seed())
+        std::uint64_t seed() const { return seed_;}
+
+        size_type slot_count() const { return slots_;}
+
+        const std::vector<std::uint64_t>& displacements() const { return displacements_;}
+
+        // builds the function of the keys hashed by hash(seed, i) for i in [0, n), trying
+        // a few seeds. throws std::runtime_error if no seed separates the keys, and
+        // std::length_error if n doesn't fit in 32 bits
+        template <class HashOf>
+        void build(size_type n, HashOf hash);
+
+        // the slot of a key, which is in [0, slot_count()) if slot_count() isn't 0
+        static size_type slot(std::uint64_t hash, const std::uint64_t* displacements,
+                              size_type bucket_count, size_type slot_count){
+            std::uint64_t d = displacements[hash % bucket_count];
+            if(d & DIRECT)
+                return static_cast<size_type>(d & ~DIRECT);
+            return static_cast<size_type>(mix64(hash ^ (d * 0x9E3779B97F4A7C15ull)) % slot_count);
+        }
+
+    private:
+        // places the keys of hashes, returns false if a bucket can't be placed
+        bool place(const std::vector<std::uint64_t>& hashes);
+
+        std::uint64_t seed_;
+        size_type slots_;
+        std::vector<std::uint64_t> displacements_;
+    };
+
+    template<class HashOf>
+    void perfect_hash::build(size_type n, HashOf hash) {
+        // the keys are numbered by 32 bits while they're placed
+        if(n > UINT32_MAX)
+            throw std::length_error("perfect_hash: too many keys");
+        std::vector<std::uint64_t> hashes(n);
+        for(std::uint64_t attempt = 0; attempt < 16; ++attempt){
+            seed_ = mix64(attempt + 1);
+            for(size_type i=0; i<n; ++i)
+                hashes[i] = hash(seed_, i);
+            if(place(hashes))
+                return;
+        }
+        throw std::runtime_error("perfect_hash: the keys can't be separated");
+    }
+
+    inline bool perfect_hash::place(const std::vector<std::uint64_t> &hashes) {
+        size_type n = hashes.size();
+        size_type bucket_count = std::max<size_type>(1, n / BUCKET_LOAD);
+        slots_ = n;
+        displacements_.assign(bucket_count, 0);
+        if(n == 0)
+            return true;
+
+        // the keys sorted by bucket, and the buckets sorted by size, the largest first
+        std::vector<std::uint32_t> keys(n);
+        std::iota(keys.begin(), keys.end(), 0);
+        std::sort(keys.begin(), keys.end(), [&hashes, bucket_count](std::uint32_t a, std::uint32_t b){
+            return hashes[a] % bucket_count < hashes[b] % bucket_count;
+        });
+        std::vector<std::pair<size_type, size_type>> runs; // the start and the end of every bucket in keys
+        for(size_type i=0; i<n; ){
+            size_type j = i + 1;
+            while(j < n && hashes[keys[j]] % bucket_count == hashes[keys[i]] % bucket_count)
+                ++j;
+            runs.emplace_back(i, j);
+            i = j;
+        }
+        std::stable_sort(runs.begin(), runs.end(), [](const auto& a, const auto& b){
+            return a.second - a.first > b.second - b.first;
+        });
+
+        std::vector<bool> used(n, false);
+        std::vector<size_type> slots;
+        auto run = runs.begin();
+        for(; run != runs.end() && run->second - run->first > 1; ++run){
+            std::uint64_t b = hashes[keys[run->first]] % bucket_count;
+            std::uint64_t d = 1;
+            for(; d < MAX_DISPLACEMENT; ++d){
+                slots.clear();
+                bool free = true;
+                for(size_type i = run->first; i < run->second && free; ++i){
+                    size_type s = static_cast<size_type>(mix64(hashes[keys[i]] ^ (d * 0x9E3779B97F4A7C15ull)) % n);
+                    free = !used[s] && std::find(slots.begin(), slots.end(), s) == slots.end();
+                    slots.push_back(s);
+                }
+                if(free)
+                    break;
+            }
+            if(d == MAX_DISPLACEMENT)
+                return false;
+            for(size_type s: slots)
+                used[s] = true;
+            displacements_[b] = d;
+        }
+
+        // the buckets of one key take the free slots in order
+        size_type next = 0;
+        for(; run != runs.end(); ++run){
+            while(used[next])
+                ++next;
+            used[next] = true;
+            displacements_[hashes[keys[run->first]] % bucket_count] = DIRECT | next;
+        }
+        return true;
+    }
+
+}
+
+#endif //STLCONTAINER_PERFECT_HASH_HPP
@@ -15,50 +15,34 @@ namespace sc::utils{
     };
 
     template <class T>
-    class rbtreenode: public treenode<T> {
+    class rbtreenode: public treenode<T, rbtreenode<T>> {
     public:
         rbcolor color_;
 
-        using treenode<T>::left_;
-        using treenode<T>::right_;
-        using treenode<T>::parent_;
-        using treenode<T>::val_;
+        using treenode<T, rbtreenode<T>>::left_;
+        using treenode<T, rbtreenode<T>>::right_;
+        using treenode<T, rbtreenode<T>>::parent_;
 
-        rbtreenode(T val, rbcolor color=RED): treenode<T>(val), color_(color) {}
-        rbtreenode(const rbtreenode& other): treenode<T>(other), color_(other.color_){}
-        rbtreenode(rbtreenode&& other): treenode<T>(std::move(other)), color_(std::move(other.color_)){}
-
-        rbtreenode& operator=(rbtreenode other){
-            swap(other, *this);
-            return *this;
-        }
+        explicit rbtreenode(const T& val, rbcolor color=RED): treenode<T, rbtreenode<T>>(val), color_(color) {}
+        explicit rbtreenode(T&& val, rbcolor color=RED): treenode<T, rbtreenode<T>>(std::move(val)), color_(color) {}
+        rbtreenode(const rbtreenode& other): treenode<T, rbtreenode<T>>(other), color_(other.color_){}
 
         void setColor(rbcolor color){
             color_ = color;
         }
 
-        bool isRed(){
-            return color_ == RED;
-        }
-
-        bool isBlack(){
-            return color_ == BLACK;
+        // a nullptr leaf is black
+        friend bool isRed(const rbtreenode* node){
+            return node != nullptr && node->color_ == RED;
         }
 
-        friend void swapColor(rbtreenode& tn1, rbtreenode& tn2){
-            std::swap(tn1.color_, tn2.color_);
+        friend bool isBlack(const rbtreenode* node){
+            return node == nullptr || node->color_ == BLACK;
         }
 
-        friend void swap(rbtreenode& tn1, rbtreenode tn2){
-            using std::swap;
-
-            swap(tn1.parent_, tn2.parent_);
-            swap(tn1.right_, tn2.right_);
-            swap(tn1.left_, tn2.left_);
-            swap(tn1.color_, tn2.color_);
-            swap(tn1.val_, tn2.val_);
+        friend void swapColor(rbtreenode* tn1, rbtreenode* tn2){
+            std::swap(tn1->color_, tn2->color_);
         }
-
     };
 
 }
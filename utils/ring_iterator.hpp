@@ -0,0 +1,170 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_RING_ITERATOR_HPP
+#define STLCONTAINER_RING_ITERATOR_HPP
+
+#include <iterator>
+#include "iterator_base.hpp"
+
+namespace sc::utils{
+
+    /*
+     * Random access iterator of a circular buffer.
+     *
+     * The elements are stored in a contiguous array, but the logical
+     * sequence may wrap around the end of the array. The iterator keeps
+     * the logical index of the element, so iterators compare in the order
+     * of the sequence rather than in the order of addresses, and the
+     * end iterator of a full buffer differs from the begin iterator.
+     *
+     * Stepping one element is a pointer increment with one wrap-around
+     * check. For contiguous processing use ring_buffer::as_spans().
+     */
+    template <class T>
+    class ring_iterator: public iterator_base<T, ring_iterator<T>>{
+    public:
+
+        // C++ doesn’t consider superclass templates for name resolution
+        using iterator_base<T, ring_iterator<T>>::ptr_;
+        using typename iterator_base<T, ring_iterator<T>>::difference_type ;
+        using typename iterator_base<T, ring_iterator<T>>::pointer;
+        using typename iterator_base<T, ring_iterator<T>>::reference;
+        using iterator_category = std::random_access_iterator_tag;
+
+        ring_iterator(): ring_iterator(nullptr, 0, 0, 0){}
+
+        // first: the beginning of the array, capacity: the length of the array,
+        // head: the position of logical index 0 in the array
+        ring_iterator(pointer first, difference_type capacity, difference_type head, difference_type index):
+            iterator_base<T, ring_iterator<T>>(nullptr), first_(first), capacity_(capacity), head_(head), index_(index){
+            locate();
+        }
+
+        //forbids to copy a const iterator to a non-const iterator
+        template <class OtherT, class = std::enable_if_t<std::is_convertible_v<OtherT*, T*>>>
+        ring_iterator(const ring_iterator<OtherT>& other): iterator_base<T, ring_iterator<T>>(other),
+            first_(other.first_), capacity_(other.capacity_), head_(other.head_), index_(other.index_){}
+
+        ring_iterator&operator++(){
+            ++index_;
+            // wrap around at the end of array
+            if(++ptr_ == first_ + capacity_)
+                ptr_ = first_;
+            return *this;
+        }
+
+        ring_iterator operator++(int){
+            ring_iterator old(*this);
+            ++(*this);
+            return old;
+        }
+
+        ring_iterator&operator--(){
+            --index_;
+            if(ptr_ == first_)
+                ptr_ = first_ + capacity_;
+            --ptr_;
+            return *this;
+        }
+
+        ring_iterator operator--(int){
+            ring_iterator old(*this);
+            --(*this);
+            return old;
+        }
+
+        ring_iterator&operator+=(difference_type n){
+            index_ += n;
+            locate();
+            return *this;
+        }
+
+        ring_iterator&operator-=(difference_type n){
+            return *this += -n;
+        }
+
+        reference operator[](difference_type n) const{
+            return *(*this + n);
+        }
+
+        ring_iterator operator+(difference_type n) const{
+            ring_iterator tmp(*this);
+            tmp += n;
+            return tmp;
+        }
+
+        ring_iterator operator-(difference_type n) const{
+            ring_iterator tmp(*this);
+            tmp -= n;
+            return tmp;
+        }
+
+        template <class OtherT>
+        difference_type operator-(const ring_iterator<OtherT>& other) const{
+            return index_ - other.index_;
+        }
+
+        /*
+         * Comparison
+         */
+
+        // iterators of the same buffer compare by the logical index
+        template <class OtherT>
+        bool operator==(const ring_iterator<OtherT>& other) const{
+            return first_ == other.first_ && index_ == other.index_;
+        }
+
+        template <class OtherT>
+        bool operator!=(const ring_iterator<OtherT>& other) const{
+            return !(*this == other);
+        }
+
+        template <class OtherT>
+        bool operator<(const ring_iterator<OtherT>& other) const{
+            return index_ < other.index_;
+        }
+
+        template <class OtherT>
+        bool operator>(const ring_iterator<OtherT>& other) const{
+            return index_ > other.index_;
+        }
+
+        template <class OtherT>
+        bool operator<=(const ring_iterator<OtherT>& other) const{
+            return index_ <= other.index_;
+        }
+
+        template <class OtherT>
+        bool operator>=(const ring_iterator<OtherT>& other) const{
+            return index_ >= other.index_;
+        }
+
+    private:
+        template <class> friend class ring_iterator;
+
+        // compute the address of the element at index_
+        void locate(){
+            if(capacity_ == 0)
+                return;
+            difference_type pos = (head_ + index_) % capacity_;
+            if(pos < 0)
+                pos += capacity_;
+            ptr_ = first_ + pos;
+        }
+
+        T* first_; // the beginning of the array
+        difference_type capacity_; // the length of the array
+        difference_type head_; // the position of the first element in the array
+        difference_type index_; // the logical index of the current element
+    };
+
+    template <class T>
+    ring_iterator<T> operator+(std::ptrdiff_t n, const ring_iterator<T>& iter) {
+        return iter + n;
+    }
+
+}
+
+#endif //STLCONTAINER_RING_ITERATOR_HPP
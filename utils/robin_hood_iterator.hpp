@@ -0,0 +1,86 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_ROBIN_HOOD_ITERATOR_HPP
+#define STLCONTAINER_ROBIN_HOOD_ITERATOR_HPP
+
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include "iterator_base.hpp"
+
+namespace sc::utils{
+
+    template <class, class, class, class, class> class robin_hood_table;
+
+    // a slot of robin_hood_table: the metadata byte, then the element.
+    // the element is constructed and destroyed by the table, not by the slot
+    template <class Value>
+    struct robin_hood_slot{
+
+        // the distance of the element from its home slot plus one, 0 if the slot is empty
+        unsigned char dist_;
+
+        Value* value() { return std::launder(reinterpret_cast<Value*>(&storage_));}
+        const Value* value() const { return std::launder(reinterpret_cast<const Value*>(&storage_));}
+
+        alignas(Value) unsigned char storage_[sizeof(Value)];
+    };
+
+    // forward iterator of robin_hood_table. it walks the slots, skipping the empty ones
+    template <class Slot, class T>
+    class robin_hood_iterator: public iterator_base<T, robin_hood_iterator<Slot, T>>{
+    public:
+
+        // C++ doesn’t consider superclass templates for name resolution
+        using iterator_base<T, robin_hood_iterator<Slot, T>>::ptr_;
+        using typename iterator_base<T, robin_hood_iterator<Slot, T>>::difference_type ;
+        using typename iterator_base<T, robin_hood_iterator<Slot, T>>::pointer;
+        using typename iterator_base<T, robin_hood_iterator<Slot, T>>::reference;
+        using iterator_category = std::forward_iterator_tag;
+
+        robin_hood_iterator(): iterator_base<T, robin_hood_iterator<Slot, T>>(nullptr), slot_(nullptr), end_(nullptr){}
+
+        // slot: the current slot, end: the end of the slots.
+        // if the slot is empty, the iterator moves to the next full one
+        robin_hood_iterator(const Slot* slot, const Slot* end):
+            iterator_base<T, robin_hood_iterator<Slot, T>>(nullptr), slot_(slot), end_(end){
+            skip();
+        }
+
+        //forbids to copy a const iterator to a non-const iterator
+        template <class OtherT, class = std::enable_if_t<std::is_convertible_v<OtherT*, T*>>>
+        robin_hood_iterator(const robin_hood_iterator<Slot, OtherT>& other): iterator_base<T, robin_hood_iterator<Slot, T>>(other),
+            slot_(other.slot_), end_(other.end_){}
+
+        robin_hood_iterator&operator++(){
+            ++slot_;
+            skip();
+            return *this;
+        }
+
+        robin_hood_iterator operator++(int){
+            robin_hood_iterator old(*this);
+            ++(*this);
+            return old;
+        }
+
+    private:
+        template <class, class> friend class robin_hood_iterator;
+        template <class, class, class, class, class> friend class robin_hood_table;
+
+        // the element pointer follows the slot, the end has none
+        void skip(){
+            while(slot_ != end_ && slot_->dist_ == 0)
+                ++slot_;
+            ptr_ = slot_ != end_ ? const_cast<Slot*>(slot_)->value() : nullptr;
+        }
+
+        const Slot* slot_; // the current slot
+        const Slot* end_; // the end of the slots
+    };
+
+}
+
+#endif //STLCONTAINER_ROBIN_HOOD_ITERATOR_HPP
@@ -0,0 +1,830 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_ROBIN_HOOD_TABLE_HPP
+#define STLCONTAINER_ROBIN_HOOD_TABLE_HPP
+
+/*
+ * Open-addressing hash table with Robin Hood hashing, shared by
+ * robin_hood_set and robin_hood_map.
+ *
+ * The elements are stored inline in one array of slots, and every slot
+ * starts with a metadata byte: 0 if it's empty, otherwise the distance of
+ * its element from the home slot of its hash, plus one. The probe is linear.
+ * An insertion takes the first slot whose element is closer to its home
+ * than the new one would be ("takes from the rich"), and the elements from
+ * there to the next empty slot move one slot further. So the elements stay
+ * sorted by their home slot and the distances stay short and even: at a
+ * load factor of 0.9 the mean distance is about 5 slots.
+ *
+ * A lookup stops at the first slot whose distance is shorter than the
+ * distance probed so far, the key can't be after it, so a miss is about as
+ * short as a hit.
+ *
+ * erase() shifts the following elements back by one slot until an empty
+ * slot or an element in its home slot (backward-shift deletion), so there
+ * is no tombstone and the distances are as if the element had never been
+ * inserted.
+ *
+ * The slots don't wrap around: after the capacity there are as many more
+ * slots as the longest distance, 254, or the capacity if it's less, and an
+ * empty sentinel. The table grows when the load factor exceeds
+ * max_load_factor(), 0.9 by default, or when an element would be further
+ * than 255 slots from its home.
+ *
+ * The elements move when the table grows and when another element is
+ * inserted or erased near them, so an insertion or an erasure invalidates
+ * the references to the elements. erase(pos) returns an iterator to the
+ * next element, which is valid for erasing while iterating. An element is
+ * moved by its move constructor and destroyed, the key of a map by a
+ * const_cast like the node handle of unordered_map, and the move
+ * constructors of the keys and the mapped values must not throw.
+ *
+ * references: Celis, P. Robin Hood Hashing. 1986.
+ *             https://codecapsule.com/2013/11/17/robin-hood-hashing-backward-shift-deletion/
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "hash.hpp"
+#include "key_of_value.hpp"
+#include "robin_hood_iterator.hpp"
+
+namespace sc::utils{
+
+    // KeyOfValue returns the key of a stored value
+    template <class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    class robin_hood_table{
+
+        using slot_type = robin_hood_slot<Value>;
+
+    public:
+        using key_type = Key;
+
+        using value_type = Value;
+
+        using size_type = std::size_t;
+
+        using difference_type = std::ptrdiff_t;
+
+        using hasher = Hash;
+
+        using key_equal = KeyEqual;
+
+        using reference = value_type &;
+
+        using const_reference = const value_type &;
+
+        using pointer = value_type *;
+
+        using const_pointer = const value_type *;
+
+        // the elements of a set are keys, which can not be modified by an iterator
+        using iterator = std::conditional_t<std::is_same_v<Key, Value>,
+                robin_hood_iterator<slot_type, const Value>, robin_hood_iterator<slot_type, Value>>;
+
+        using const_iterator = robin_hood_iterator<slot_type, const Value>;
+
+        robin_hood_table(): robin_hood_table(size_type(0)){}
+
+        // allocates at least bucket_count slots
+        explicit robin_hood_table(size_type bucket_count,
+                const Hash& hash = Hash(),
+                const key_equal& equal = key_equal());
+
+        template <class InputIt>
+        robin_hood_table(InputIt first, InputIt last, size_type bucket_count = 0,
+                const Hash& hash = Hash(), const key_equal& equal = key_equal());
+
+        robin_hood_table(std::initializer_list<value_type> init, size_type bucket_count = 0,
+                const Hash& hash = Hash(), const key_equal& equal = key_equal());
+
+        // copy/move constructor
+        robin_hood_table(const robin_hood_table& other);
+        robin_hood_table(robin_hood_table&& other) noexcept ;
+
+        // copy/move assignment operator
+        // use copy-and-swap idiom and copy elision for better efficiency
+        robin_hood_table&operator=(robin_hood_table other);
+
+        ~robin_hood_table();
+
+        /*
+         * Iterators
+         */
+
+        iterator begin() noexcept { return iterator(slots_, slots_ + count_);}
+        const_iterator begin() const noexcept { return const_iterator(slots_, slots_ + count_);}
+        const_iterator cbegin() const noexcept { return begin();}
+
+        iterator end() noexcept { return iterator(slots_ + count_, slots_ + count_);}
+        const_iterator end() const noexcept { return const_iterator(slots_ + count_, slots_ + count_);}
+        const_iterator cend() const noexcept { return end();}
+
+        /*
+         * Capacity
+         */
+
+        bool empty() const { return size_ == 0;}
+
+        size_type size() const { return size_;}
+
+        size_type max_size() const { return std::numeric_limits<difference_type>::max() / sizeof(slot_type);}
+
+        /*
+         * Modifiers
+         */
+
+        void clear() noexcept ;
+
+        // inserts value if the key is not in the table.
+        // all iterators and references are invalidated
+        std::pair<iterator,bool> insert( const value_type& value );
+        std::pair<iterator,bool> insert( value_type&& value );
+
+        // the hint is ignored, the position of an element is decided by its hash
+        iterator insert( const_iterator hint, const value_type& value );
+        iterator insert( const_iterator hint, value_type&& value );
+
+        template< class InputIt >
+        void insert( InputIt first, InputIt last );
+
+        void insert(std::initializer_list<value_type> init);
+
+        template <class... Args>
+        std::pair<iterator,bool> emplace( Args&&... args);
+
+        template <class... Args>
+        iterator emplace_hint(const_iterator hint, Args&&... args);
+
+        // the following elements move back, the references to them are invalidated.
+        // the returned iterator is the next element, which may be at pos now
+        iterator erase( const_iterator pos) noexcept ;
+        iterator erase( const_iterator first, const_iterator last) noexcept ;
+        size_type erase( const key_type& key) { return erase_key(key);}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>,
+                  class = std::enable_if_t<!std::is_convertible_v<const K&, const_iterator>>>
+        size_type erase( const K& key) { return erase_key(key);}
+
+        void swap( robin_hood_table& other) noexcept ;
+
+        /*
+         * Look-up
+         */
+
+        size_type count( const Key& key) const { return find_index(key, hash_of(key)) == npos ? 0 : 1;}
+
+        iterator find(const Key& key);
+        const_iterator find(const Key& key) const;
+
+        bool contains( const Key& key) const { return count(key) != 0;}
+
+        std::pair<iterator, iterator> equal_range( const Key& key);
+        std::pair<const_iterator, const_iterator> equal_range(const Key& key) const;
+
+        // the overloads for any key type K are enabled if Hash and KeyEqual are transparent,
+        // then K is hashed and compared with the keys without constructing a Key
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        size_type count( const K& key) const { return find_index(key, hash_of(key)) == npos ? 0 : 1;}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        iterator find(const K& key) {
+            size_type index = find_index(key, hash_of(key));
+            return index == npos ? end() : iterator_at(index);
+        }
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        const_iterator find(const K& key) const {
+            size_type index = find_index(key, hash_of(key));
+            return index == npos ? end() : iterator_at(index);
+        }
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        bool contains( const K& key) const { return count(key) != 0;}
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        std::pair<iterator, iterator> equal_range( const K& key) {
+            iterator first = find(key);
+            return std::pair<iterator, iterator>(first, first == end() ? first : std::next(first));
+        }
+
+        template <class K, class H = Hash, class E = KeyEqual, class = transparent_t<H, E>>
+        std::pair<const_iterator, const_iterator> equal_range( const K& key) const {
+            const_iterator first = find(key);
+            return std::pair<const_iterator, const_iterator>(first, first == end() ? first : std::next(first));
+        }
+
+        /*
+         * Bucket interface
+         */
+
+        // every home slot is a bucket, the overflow slots after them are not counted
+        size_type bucket_count() const { return capacity_;}
+
+        size_type max_bucket_count() const { return max_size();}
+
+        /*
+         * Hash policy
+         */
+
+        float load_factor() const { return capacity_ == 0 ? 0.f : static_cast<float>(size_) / capacity_;}
+
+        float max_load_factor() const { return mlf_;}
+
+        // clamped to [0.5, 0.95], takes effect on the next insertion
+        void max_load_factor( float ml) { mlf_ = std::clamp(ml, 0.5f, 0.95f);}
+
+        // rehash to at least count slots, and enough slots for size() elements
+        void rehash( size_type count);
+
+        // reserve the slots for count elements
+        void reserve( size_type count);
+
+        // the longest and the mean distance of the elements from their home slots,
+        // the slots probed by a successful lookup. walks every slot
+        size_type max_distance() const;
+        double mean_distance() const;
+
+        /*
+         * Observers
+         */
+
+        hasher hash_function() const { return hash_;}
+
+        key_equal key_eq() const { return equal_;}
+
+    protected:
+
+        // inserts the value constructed by args, if key is not in the table
+        template <class K, class... Args>
+        std::pair<iterator,bool> emplace_key(const K& key, Args&&... args);
+
+    private:
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        // the longest distance which fits in the metadata byte
+        static constexpr size_type MAX_DIST = 255;
+
+        // the home slots of the first allocation
+        static constexpr size_type MIN_CAPACITY = 8;
+
+        // the load factor below which an element which is too far from its home means
+        // that the hash sends too many keys to the same slots, growing would not help
+        static constexpr float MIN_OVERFLOW_LOAD = 0.25f;
+
+        // the elements are moved by relocate, which must not throw
+        static constexpr bool nothrow_relocate(){
+            if constexpr (is_pair_of_key<Value, Key>::value)
+                return std::is_nothrow_move_constructible_v<Key> && std::is_nothrow_move_constructible_v<typename Value::second_type>;
+            else
+                return std::is_nothrow_move_constructible_v<Value>;
+        }
+
+        // std::hash of an integer is the identity, spread its bits over the home slots
+        template <class K>
+        size_type hash_of(const K& key) const;
+
+        size_type home(size_type hash) const { return hash & (capacity_ - 1);}
+
+        // the number of elements which can be stored at capacity before growing
+        size_type max_load(size_type capacity) const {
+            return std::min(capacity, static_cast<size_type>(static_cast<float>(capacity) * mlf_));
+        }
+
+        // the smallest capacity for count elements
+        size_type capacity_for(size_type count) const;
+
+        // returns the slot index of the element with key, npos if it's not found
+        template <class K>
+        size_type find_index(const K& key, size_type hash) const;
+
+        template <class K>
+        size_type erase_key(const K& key);
+
+        // finds the slot of a new element with hash and moves the elements after it away,
+        // returns the empty slot and sets its distance, npos if the distances would overflow
+        size_type make_room(size_type hash) noexcept ;
+
+        // constructs dst from the element of src and destroys it
+        static void relocate(slot_type& dst, slot_type& src) noexcept ;
+
+        // allocates the slots, all of them empty. the table is left without slots if capacity is 0
+        void allocate(size_type capacity);
+        void deallocate() noexcept ;
+
+        // destroy the elements in the full slots
+        void destroy_slots() noexcept ;
+
+        // move the elements to a table of at least new_capacity home slots.
+        // if the hash function throws, the elements which are not moved yet are lost
+        void resize(size_type new_capacity);
+
+        void erase_index(size_type index) noexcept ;
+
+        iterator iterator_at(size_type index){ return iterator(slots_ + index, slots_ + count_);}
+        const_iterator iterator_at(size_type index) const { return const_iterator(slots_ + index, slots_ + count_);}
+
+        slot_type* slots_; // count_ slots, followed by an empty sentinel
+        size_type capacity_; // the home slots, 0 or a power of two
+        size_type count_; // the home slots and the overflow slots after them
+        size_type size_; // the number of elements
+        float mlf_; // the maximum load factor
+
+        Hash hash_;
+        KeyEqual equal_;
+    };
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::robin_hood_table(
+            size_type bucket_count, const Hash &hash, const key_equal &equal):
+            slots_(nullptr), capacity_(0), count_(0), size_(0), mlf_(0.9f), hash_(hash), equal_(equal)
+    {
+        static_assert(nothrow_relocate(), "the move constructors of the keys and the values of robin_hood_table must not throw");
+        if(bucket_count > 0)
+            rehash(bucket_count);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class InputIt>
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::robin_hood_table(
+            InputIt first, InputIt last, size_type bucket_count, const Hash &hash, const key_equal &equal):
+            robin_hood_table(bucket_count, hash, equal)
+    {
+        insert(first, last);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::robin_hood_table(
+            std::initializer_list<value_type> init, size_type bucket_count, const Hash &hash, const key_equal &equal):
+            robin_hood_table(init.begin(), init.end(), bucket_count, hash, equal){}
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::robin_hood_table(const robin_hood_table &other):
+            slots_(nullptr), capacity_(0), count_(0), size_(0), mlf_(other.mlf_), hash_(other.hash_), equal_(other.equal_)
+    {
+        allocate(other.capacity_);
+
+        // the elements keep their slots, so the distances stay the same
+        size_type i = 0;
+        try {
+            for(; i<count_; ++i){
+                if(other.slots_[i].dist_ == 0)
+                    continue;
+                ::new(static_cast<void*>(slots_[i].value())) value_type(*other.slots_[i].value());
+                slots_[i].dist_ = other.slots_[i].dist_;
+            }
+        }catch (...){
+            // if throws, destroy the copied elements and deallocates the memory
+            destroy_slots();
+            deallocate();
+            throw;
+        }
+        size_ = other.size_;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::robin_hood_table(robin_hood_table &&other) noexcept:
+            slots_(other.slots_), capacity_(other.capacity_), count_(other.count_), size_(other.size_), mlf_(other.mlf_),
+            hash_(std::move(other.hash_)), equal_(std::move(other.equal_))
+    {
+        // the moved-from table has no slots
+        other.slots_ = nullptr;
+        other.capacity_ = 0;
+        other.count_ = 0;
+        other.size_ = 0;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual> &
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::operator=(robin_hood_table other) {
+        // use copy-and-swap idiom here
+        swap(other);
+        return *this;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::~robin_hood_table() {
+        destroy_slots();
+        deallocate();
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::clear() noexcept {
+        destroy_slots();
+        for(size_type i=0; i<count_; ++i)
+            slots_[i].dist_ = 0;
+        size_ = 0;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    std::pair<typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator, bool>
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::insert(const value_type &value) {
+        return emplace_key(KeyOfValue()(value), value);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    std::pair<typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator, bool>
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::insert(value_type &&value) {
+        return emplace_key(KeyOfValue()(value), std::move(value));
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::insert(const_iterator, const value_type &value) {
+        return insert(value).first;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::insert(const_iterator, value_type &&value) {
+        return insert(std::move(value)).first;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class InputIt>
+    void robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::insert(InputIt first, InputIt last) {
+        for(; first != last; ++first)
+            insert(*first);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::insert(std::initializer_list<value_type> init) {
+        insert(init.begin(), init.end());
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class... Args>
+    std::pair<typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator, bool>
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::emplace(Args &&... args) {
+        // the key is only known after the value is constructed
+        value_type value(std::forward<Args>(args)...);
+        return emplace_key(KeyOfValue()(value), std::move(value));
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class... Args>
+    typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::emplace_hint(const_iterator, Args &&... args) {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class K, class... Args>
+    std::pair<typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator, bool>
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::emplace_key(const K &key, Args &&... args) {
+        size_type hash = hash_of(key);
+        size_type index = find_index(key, hash);
+        if(index != npos)
+            return std::pair<iterator, bool>(iterator_at(index), false);
+
+        if(size_ + 1 > max_load(capacity_))
+            resize(capacity_for(size_ + 1));
+        while((index = make_room(hash)) == npos){
+            // the elements near the home slot are too far from their homes
+            if(load_factor() < MIN_OVERFLOW_LOAD)
+                throw std::length_error("robin_hood_table: too many keys with the same hash");
+            resize(capacity_ * 2);
+        }
+
+        try {
+            ::new(static_cast<void*>(slots_[index].value())) value_type(std::forward<Args>(args)...);
+        }catch (...){
+            // if throws, the elements which made room move back
+            slots_[index].dist_ = 0;
+            size_type next = index + 1;
+            while(slots_[next].dist_ > 1){
+                relocate(slots_[next - 1], slots_[next]);
+                slots_[next - 1].dist_ = static_cast<unsigned char>(slots_[next].dist_ - 1);
+                slots_[next].dist_ = 0;
+                ++next;
+            }
+            throw;
+        }
+        ++size_;
+        return std::pair<iterator, bool>(iterator_at(index), true);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::erase(const_iterator pos) noexcept {
+        size_type index = pos.slot_ - slots_;
+        erase_index(index);
+        // the next element moved into the slot, or the iterator moves to the next full slot
+        return iterator_at(index);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::erase(const_iterator first, const_iterator last) noexcept {
+        // the elements after the range may move back into it, count them instead of comparing with last
+        size_type n = 0;
+        for(const_iterator iter = first; iter != last; ++iter)
+            ++n;
+        iterator iter = iterator_at(first.slot_ - slots_);
+        for(; n > 0; --n)
+            iter = erase(iter);
+        return iter;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class K>
+    typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::size_type
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::erase_key(const K &key) {
+        size_type index = find_index(key, hash_of(key));
+        if(index == npos)
+            return 0;
+        erase_index(index);
+        return 1;
+    }
+
+    // this function has no-throw guarantee because std::swap does not throw
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::swap(robin_hood_table &other) noexcept {
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(count_, other.count_);
+        std::swap(size_, other.size_);
+        std::swap(mlf_, other.mlf_);
+        std::swap(hash_, other.hash_);
+        std::swap(equal_, other.equal_);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::find(const Key &key) {
+        size_type index = find_index(key, hash_of(key));
+        return index == npos ? end() : iterator_at(index);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::const_iterator
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::find(const Key &key) const {
+        size_type index = find_index(key, hash_of(key));
+        return index == npos ? end() : iterator_at(index);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    std::pair<typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator,
+              typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::iterator>
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::equal_range(const Key &key) {
+        iterator first = find(key);
+        iterator last = first;
+        if(last != end())
+            ++last;
+        return std::pair<iterator, iterator>(first, last);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    std::pair<typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::const_iterator,
+              typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::const_iterator>
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::equal_range(const Key &key) const {
+        const_iterator first = find(key);
+        const_iterator last = first;
+        if(last != end())
+            ++last;
+        return std::pair<const_iterator, const_iterator>(first, last);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::rehash(size_type count) {
+        size_type capacity = 0;
+        if(count > 0){
+            capacity = MIN_CAPACITY;
+            while(capacity < count)
+                capacity <<= 1;
+        }
+        capacity = std::max(capacity, capacity_for(size_));
+        if(capacity != capacity_)
+            resize(capacity);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::reserve(size_type count) {
+        size_type capacity = capacity_for(count);
+        if(capacity > capacity_)
+            resize(capacity);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::size_type
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::max_distance() const {
+        size_type longest = 0;
+        for(size_type i=0; i<count_; ++i)
+            longest = std::max<size_type>(longest, slots_[i].dist_);
+        return longest;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    double robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::mean_distance() const {
+        if(size_ == 0)
+            return 0;
+        double total = 0;
+        for(size_type i=0; i<count_; ++i)
+            total += slots_[i].dist_;
+        return total / static_cast<double>(size_);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class K>
+    typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::size_type
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::hash_of(const K &key) const {
+        std::uint64_t hash = hash_(key);
+        hash ^= hash >> 32;
+        hash *= 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+        return static_cast<size_type>(hash);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::size_type
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::capacity_for(size_type count) const {
+        if(count == 0)
+            return 0;
+        size_type capacity = MIN_CAPACITY;
+        while(max_load(capacity) < count)
+            capacity <<= 1;
+        return capacity;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    template<class K>
+    typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::size_type
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::find_index(const K &key, size_type hash) const {
+        if(size_ == 0)
+            return npos;
+        // an element closer to its home than dist means the key is not further,
+        // the sentinel is empty and stops the probe
+        size_type i = home(hash);
+        for(size_type dist = 1; slots_[i].dist_ >= dist; ++i, ++dist){
+            if(slots_[i].dist_ == dist && equal_(KeyOfValue()(*slots_[i].value()), key))
+                return i;
+        }
+        return npos;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    typename robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::size_type
+    robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::make_room(size_type hash) noexcept {
+        // the first slot whose element is closer to its home than the new one
+        size_type index = home(hash);
+        size_type dist = 1;
+        for(; slots_[index].dist_ >= dist; ++index, ++dist){}
+        if(dist > MAX_DIST)
+            return npos;
+
+        // the elements up to the next empty slot move one slot further
+        size_type free = index;
+        for(; slots_[free].dist_ != 0; ++free){
+            if(slots_[free].dist_ == MAX_DIST)
+                return npos;
+        }
+        if(free == count_)
+            return npos;
+        for(; free != index; --free){
+            relocate(slots_[free], slots_[free - 1]);
+            slots_[free].dist_ = static_cast<unsigned char>(slots_[free - 1].dist_ + 1);
+        }
+        slots_[index].dist_ = static_cast<unsigned char>(dist);
+        return index;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::relocate(slot_type &dst, slot_type &src) noexcept {
+        if constexpr (is_pair_of_key<Value, Key>::value){
+            // the key is moved out of the element which is destroyed right after
+            auto& key = const_cast<Key&>(src.value()->first);
+            ::new(static_cast<void*>(dst.value())) value_type(std::piecewise_construct,
+                    std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::move(src.value()->second)));
+        } else{
+            ::new(static_cast<void*>(dst.value())) value_type(std::move(*src.value()));
+        }
+        std::destroy_at(src.value());
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::allocate(size_type capacity) {
+        if(capacity == 0){
+            slots_ = nullptr;
+            capacity_ = 0;
+            count_ = 0;
+            return;
+        }
+        // the overflow slots hold the elements whose probe passes the last home slot
+        size_type count = capacity + std::min(capacity, MAX_DIST - 1);
+        slots_ = static_cast<slot_type*>(::operator new((count + 1) * sizeof(slot_type), std::align_val_t(alignof(slot_type))));
+        for(size_type i=0; i<=count; ++i)
+            slots_[i].dist_ = 0;
+        capacity_ = capacity;
+        count_ = count;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::deallocate() noexcept {
+        if(slots_ != nullptr)
+            ::operator delete(slots_, std::align_val_t(alignof(slot_type)));
+        allocate(0);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::destroy_slots() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<value_type>){
+            for(size_type i=0; i<count_; ++i){
+                if(slots_[i].dist_ != 0)
+                    std::destroy_at(slots_[i].value());
+            }
+        }
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::resize(size_type new_capacity) {
+        robin_hood_table fresh(size_type(0), hash_, equal_);
+        fresh.mlf_ = mlf_;
+        fresh.allocate(new_capacity);
+
+        // if throws, the elements moved so far are kept, the others are destroyed
+        struct guard{
+            robin_hood_table* table;
+            robin_hood_table* fresh;
+            ~guard(){
+                if(fresh != nullptr){
+                    table->clear();
+                    table->swap(*fresh);
+                }
+            }
+        } g{this, &fresh};
+
+        for(size_type i=0; i<count_; ++i){
+            if(slots_[i].dist_ == 0)
+                continue;
+            size_type hash = fresh.hash_of(KeyOfValue()(*slots_[i].value()));
+            size_type index;
+            // the elements are too far from their homes in fresh, which grows again
+            while((index = fresh.make_room(hash)) == npos)
+                fresh.resize(fresh.capacity_ * 2);
+            relocate(fresh.slots_[index], slots_[i]);
+            slots_[i].dist_ = 0;
+            ++fresh.size_;
+        }
+        g.fresh = nullptr;
+        size_ = 0;
+        swap(fresh);
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    void robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>::erase_index(size_type index) noexcept {
+        std::destroy_at(slots_[index].value());
+        --size_;
+
+        // the following elements which are not in their home slots move back by one,
+        // the sentinel is empty and stops the shift
+        size_type next = index + 1;
+        for(; slots_[next].dist_ > 1; ++next){
+            relocate(slots_[next - 1], slots_[next]);
+            slots_[next - 1].dist_ = static_cast<unsigned char>(slots_[next].dist_ - 1);
+        }
+        slots_[next - 1].dist_ = 0;
+    }
+
+    /*
+     * Non-member functions
+     */
+
+    // two tables are equal if they have the same elements, in any order
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    bool operator==(const robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>& lhs,
+            const robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>& rhs){
+        if(lhs.size() != rhs.size())
+            return false;
+        for(const auto& value: lhs){
+            auto iter = rhs.find(KeyOfValue()(value));
+            if(iter == rhs.end() || !(*iter == value))
+                return false;
+        }
+        return true;
+    }
+
+    template<class Key, class Value, class KeyOfValue, class Hash, class KeyEqual>
+    bool operator!=(const robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>& lhs,
+            const robin_hood_table<Key, Value, KeyOfValue, Hash, KeyEqual>& rhs){
+        return !(lhs == rhs);
+    }
+
+}
+
+#endif //STLCONTAINER_ROBIN_HOOD_TABLE_HPP
@@ -0,0 +1,49 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_SPAN_HPP
+#define STLCONTAINER_SPAN_HPP
+
+#include <cstddef>
+#include "array_iterator.hpp"
+
+namespace sc::utils{
+
+    // non-owning view of a contiguous array, corresponds to std::span of C++ 20
+    template <class T>
+    class span{
+    public:
+        using value_type = std::remove_const_t<T>;
+
+        using size_type = std::size_t;
+
+        using pointer = T*;
+
+        using reference = T&;
+
+        using iterator = array_iterator<T>;
+
+        span(pointer data = nullptr, size_type size = 0): data_(data), size_(size){}
+
+        iterator begin() const { return iterator(data_);}
+        iterator end() const { return iterator(data_ + size_);}
+
+        reference operator[](size_type pos) const { return data_[pos];}
+
+        pointer data() const { return data_;}
+
+        size_type size() const { return size_;}
+
+        size_type size_bytes() const { return size_ * sizeof(T);}
+
+        bool empty() const { return size_ == 0;}
+
+    private:
+        pointer data_;
+        size_type size_;
+    };
+
+}
+
+#endif //STLCONTAINER_SPAN_HPP
@@ -0,0 +1,281 @@
+//
+// Created by NCY on 2026-10-19.
+//
+
+#ifndef STLCONTAINER_TREE_LAYOUT_HPP
+#define STLCONTAINER_TREE_LAYOUT_HPP
+
+/*
+ * treeify_layout: dinkumware_layout whose long buckets are indexed by a
+ * red-black tree, like the bins of HashMap since JDK 1.8.
+ *
+ * A hash function which maps many keys to one bucket makes every lookup of
+ * these keys walk a long chain. When a bucket grows past Threshold nodes,
+ * its nodes are also inserted into an rbtree ordered by their keys, and a
+ * lookup of the bucket searches the tree in O(log n) instead. The nodes
+ * stay in the list, so the iteration and the bucket interface don't change.
+ * The tree is dropped when the bucket shrinks to 3/4 of Threshold, so a
+ * bucket near the threshold doesn't convert back and forth.
+ *
+ * The keys must be ordered by operator<, and two keys are equivalent by
+ * operator< if and only if they're equal by KeyEqual. A key without
+ * operator< falls back to dinkumware_layout. A bucket whose tree can't be
+ * allocated stays a chain, so the trees never make an insertion throw.
+ *
+ * Every bucket also holds its size and its tree, 16 bytes more than a
+ * bucket of dinkumware_layout, in an array parallel to the buckets.
+ *
+ * references: https://openjdk.org/jeps/180
+ */
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "hash_layout.hpp"
+#include "rbtree.hpp"
+
+namespace sc::utils{
+
+    // whether two keys are compared by operator<
+    template <class Key, class = void>
+    struct is_ordered: std::false_type{};
+
+    template <class Key>
+    struct is_ordered<Key, std::void_t<decltype(std::declval<const Key&>() < std::declval<const Key&>())>>: std::true_type{};
+
+    template <class Value, class KeyOfValue, std::size_t Threshold>
+    class tree_storage{
+
+        using list_type = dinkumware_storage<Value>;
+
+    public:
+
+        using size_type = std::size_t;
+
+        using node_type = typename list_type::node_type;
+
+        using key_type = std::decay_t<decltype(KeyOfValue()(std::declval<const Value&>()))>;
+
+        static constexpr bool caches_hash = false;
+
+        static constexpr bool incremental = false;
+
+        static constexpr bool head_is_before = false;
+
+        // find() takes the key, to search the tree
+        static constexpr bool treeifies = true;
+
+        static constexpr bool filters = false;
+
+        static_assert(Threshold >= 4, "a tree of a few nodes is slower than a chain");
+
+        // the size of a bucket which drops its tree
+        static constexpr size_type UNTREEIFY = Threshold - Threshold / 4;
+
+        tree_storage(): chains_(nullptr){}
+
+        tree_storage(const tree_storage&) = delete;
+        tree_storage&operator=(const tree_storage&) = delete;
+
+        ~tree_storage(){ destroy_chains(chains_, list_.bucket_count());}
+
+        hash_link* first() const { return list_.first();}
+
+        const hash_link* end_link() const { return list_.end_link();}
+
+        size_type bucket_count() const { return list_.bucket_count();}
+
+        // the buckets, their sizes and the nodes of their trees
+        size_type bucket_bytes() const {
+            size_type bytes = list_.bucket_bytes() + bucket_count() * sizeof(chain);
+            for(size_type b=0; b<bucket_count(); ++b){
+                if(chains_[b].tree_ != nullptr)
+                    bytes += sizeof(tree_type) + chains_[b].tree_->size() * sizeof(typename tree_type::node_type);
+            }
+            return bytes;
+        }
+
+        const void* bucket_address(size_type b) const { return list_.bucket_address(b);}
+
+        const hash_link* bucket_head(size_type b) const { return list_.bucket_head(b);}
+
+        template <class BucketOf>
+        std::pair<hash_link*, hash_link*> bucket_range(size_type b, BucketOf bucket_of) const {
+            return list_.bucket_range(b, bucket_of);
+        }
+
+        template <class Pred, class BucketOf>
+        node_type* find(size_type b, Pred pred, BucketOf bucket_of) const {
+            return list_.find(b, pred, bucket_of);
+        }
+
+        // searches the tree of bucket b if it has one, pred confirms the node found by the tree.
+        // a key of another type than key_type is looked up in the chain
+        template <class K, class Pred, class BucketOf>
+        node_type* find(size_type b, const K& key, Pred pred, BucketOf bucket_of) const {
+            if constexpr (std::is_same_v<K, key_type>){
+                tree_type* tree = chains_[b].tree_;
+                if(tree != nullptr){
+                    node_type** found = tree->iterativeSearch(key);
+                    return found != nullptr && pred(*found) ? *found : nullptr;
+                }
+            }
+            return list_.find(b, pred, bucket_of);
+        }
+
+        template <class BucketOf>
+        void link(node_type* node, size_type b, BucketOf bucket_of){
+            chain& c = chains_[b];
+            if(c.tree_ != nullptr)
+                insert_tree(c, node);
+            list_.link(node, b, bucket_of);
+            if(++c.size_ > Threshold && c.tree_ == nullptr)
+                treeify(b, bucket_of);
+        }
+
+        template <class BucketOf>
+        hash_link* unlink(node_type* node, size_type b, BucketOf bucket_of) noexcept {
+            chain& c = chains_[b];
+            if(c.tree_ != nullptr){
+                if(c.size_ - 1 <= UNTREEIFY)
+                    drop_tree(c);
+                else
+                    remove_tree(c, node);
+            }
+            --c.size_;
+            return list_.unlink(node, b, bucket_of);
+        }
+
+        // relinks the nodes, then builds the trees of the buckets which are still long
+        template <class BucketOf>
+        void rehash(size_type count, BucketOf bucket_of){
+            size_type old_count = bucket_count();
+            chain* chains = new chain[count];
+            try {
+                list_.rehash(count, bucket_of);
+            }catch (...){
+                // if the buckets were not allocated nothing changed, otherwise the
+                // nodes which were relinked are counted, and the others are lost
+                if(list_.bucket_count() != count){
+                    delete[] chains;
+                    throw;
+                }
+                replace_chains(chains, old_count, bucket_of);
+                throw;
+            }
+            replace_chains(chains, old_count, bucket_of);
+            for(size_type b=0; b<count; ++b){
+                if(chains_[b].size_ > Threshold)
+                    treeify(b, bucket_of);
+            }
+        }
+
+        void reset() noexcept {
+            for(size_type b=0; b<bucket_count(); ++b){
+                drop_tree(chains_[b]);
+                chains_[b].size_ = 0;
+            }
+            list_.reset();
+        }
+
+        void swap(tree_storage& other) noexcept {
+            list_.swap(other.list_);
+            std::swap(chains_, other.chains_);
+        }
+
+        template <class BucketOf>
+        void rebind(BucketOf bucket_of) noexcept { list_.rebind(bucket_of);}
+
+        // whether bucket b is searched by its tree
+        bool treeified(size_type b) const { return chains_[b].tree_ != nullptr;}
+
+    private:
+
+        // orders the nodes by their keys, and a key with the nodes
+        struct node_less{
+            using is_transparent = void;
+
+            bool operator()(const node_type* a, const node_type* b) const { return key_of(a) < key_of(b);}
+            bool operator()(const node_type* a, const key_type& b) const { return key_of(a) < b;}
+            bool operator()(const key_type& a, const node_type* b) const { return a < key_of(b);}
+
+            static const key_type& key_of(const node_type* n){ return KeyOfValue()(*n->value());}
+        };
+
+        using tree_type = sc::regular::rbtree<node_type*, node_less>;
+
+        struct chain{
+            size_type size_ = 0; // the nodes of the bucket
+            tree_type* tree_ = nullptr; // the nodes ordered by their keys, nullptr if the bucket is short
+        };
+
+        // indexes the nodes of bucket b, it stays a chain if the tree can't be built
+        template <class BucketOf>
+        void treeify(size_type b, BucketOf bucket_of) noexcept {
+            try {
+                auto tree = new tree_type;
+                chains_[b].tree_ = tree;
+                auto range = list_.bucket_range(b, bucket_of);
+                for(hash_link* link = range.first; link != range.second; link = link->next_)
+                    tree->insert(static_cast<node_type*>(link));
+            }catch (...){
+                drop_tree(chains_[b]);
+            }
+        }
+
+        void insert_tree(chain& c, node_type* node) noexcept {
+            try {
+                c.tree_->insert(node);
+            }catch (...){
+                drop_tree(c);
+            }
+        }
+
+        void remove_tree(chain& c, node_type* node) noexcept {
+            try {
+                c.tree_->remove(node);
+            }catch (...){
+                drop_tree(c);
+            }
+        }
+
+        // replaces the chains of old_count buckets after the nodes are relinked
+        template <class BucketOf>
+        void replace_chains(chain* chains, size_type old_count, BucketOf bucket_of) noexcept {
+            destroy_chains(chains_, old_count);
+            chains_ = chains;
+            for(size_type b=0; b<bucket_count(); ++b){
+                auto range = list_.bucket_range(b, bucket_of);
+                for(hash_link* link = range.first; link != range.second; link = link->next_)
+                    ++chains_[b].size_;
+            }
+        }
+
+        static void drop_tree(chain& c) noexcept {
+            delete c.tree_;
+            c.tree_ = nullptr;
+        }
+
+        static void destroy_chains(chain* chains, size_type count) noexcept {
+            for(size_type b=0; b<count; ++b)
+                drop_tree(chains[b]);
+            delete[] chains;
+        }
+
+        list_type list_; // the buckets and the list of nodes
+        chain* chains_; // the size and the tree of every bucket
+    };
+
+    // doubly-linked list whose buckets longer than Threshold are also indexed by an rbtree.
+    // keys without operator< are stored like dinkumware_layout
+    template <std::size_t Threshold = 8>
+    struct treeify_layout{
+        template <class Value, class Key, class KeyOfValue, class Hash>
+        using storage = std::conditional_t<is_ordered<Key>::value,
+                tree_storage<Value, KeyOfValue, Threshold>, dinkumware_storage<Value>>;
+    };
+
+}
+
+#endif //STLCONTAINER_TREE_LAYOUT_HPP
@@ -5,39 +5,36 @@
 #ifndef STLCONTAINER_TREENODE_HPP
 #define STLCONTAINER_TREENODE_HPP
 
-#include "node_base.hpp"
+#include <utility>
 
+namespace sc::regular{
+    template <class,class> class rbtree;
+}
 
 namespace sc::utils{
 
-    template <class T>
-    class treenode: public node_base<T, treenode<T>>{
+    // binary tree node base, Node is the derived node type which the links point to
+    template <class T, class Node>
+    class treenode{
+    public:
+        Node* left_; //left child
+        Node* right_; //right child
+        Node* parent_; //parent node
 
-    protected:
-        using left_ = typename node_base<T, treenode<T>>::next_; //left child
-        using node_base<T, treenode<T>>::val_;
+        explicit treenode(const T& val): left_(nullptr), right_(nullptr), parent_(nullptr), val_(val){}
+        explicit treenode(T&& val): left_(nullptr), right_(nullptr), parent_(nullptr), val_(std::move(val)){}
 
-    public:
-        treenode* right_; //right child
-        treenode* parent_; //parent node
-        treenode(T val): node_base<T,treenode<T>>(val), right_(nullptr), parent_(nullptr){}
-
-        treenode(const treenode& other):node_base<T, treenode<T>>(other), right_(other.right_), parent_(other.parent_){}
-        treenode(treenode&& other):node_base<T, treenode<T>>(std::move(other)), right_(std::move(other.right)), parent_(std::move(other.parent_)) {}
-        treenode& operator=(treenode other){
-            swap(*this, other);
-            return *this;
-        }
-
-        friend void swap(treenode& tn1, treenode& tn2){
-            using std::swap;
-            swap(tn1.parent_, tn2.parent_);
-            swap(tn1.left_, tn2.left_);
-            swap(tn1.right_, tn2.right_);
-            swap(tn1.val_, tn2.val_);
-        }
+        // a copied node is not linked into any tree
+        treenode(const treenode& other): left_(nullptr), right_(nullptr), parent_(nullptr), val_(other.val_){}
 
+        treenode&operator=(const treenode&) = delete;
+
+        const T& getValue() const {return val_;}
+
+    protected:
+        template <class, class> friend class sc::regular::rbtree;
 
+        T val_;
     };
 }
 